@@ -28,20 +28,26 @@
 
 // Std
 #include <cstdint>
+#include <cstring>
 #include <algorithm>
+#include <bit>
 
 // Common
 #include <Common/Assert.h>
 
 /// Bit stream reader
+///   ! All reads are served from a single unaligned 64 bit window, of which at least kWindowBits are valid
 struct LLVMBitStreamReader {
     template<typename T>
     using ChunkType = std::conditional_t<(sizeof(T) > 4), uint64_t, uint32_t>;
 
+    /// Number of bits guaranteed to be valid in a window
+    static constexpr uint32_t kWindowBits = 56;
+
     LLVMBitStreamReader(const void *ptr, uint32_t length) :
-        start(reinterpret_cast<const uint64_t *>(ptr)),
-        ptr(reinterpret_cast<const uint64_t *>(ptr)),
-        end(reinterpret_cast<const uint64_t *>(ptr) + length) {
+        start(static_cast<const uint8_t *>(ptr)),
+        ptr(static_cast<const uint8_t *>(ptr)),
+        end(static_cast<const uint8_t *>(ptr) + length) {
         /* */
     }
 
@@ -94,26 +100,109 @@ struct LLVMBitStreamReader {
     /// \return accumulated value
     template<typename T>
     T VBR(uint8_t bitWidth) {
-        using TChunk = ChunkType<T>;
+        // Dispatch the common widths to the windowed decoders
+        //  ? Call sites typically pass constants, the switch folds away after inlining
+        switch (bitWidth) {
+            default:
+                return VBRChunked<T>(bitWidth);
+            case 6:
+                return VBRWindowed<T, 6>();
+            case 8:
+                return VBRWindowed<T, 8>();
+        }
+    }
 
-        T value = 0;
+    /// Consume an array of fixed width values
+    /// \param out destination values, length of [count]
+    /// \param count number of values to read
+    /// \param fixedWidth bit width of each value
+    void FixedArray(uint64_t* out, uint64_t count, uint8_t fixedWidth) {
+        ASSERT(fixedWidth <= 64, "Fixed width must be less or equal to 64 bits");
 
-        uint8_t chunkBitOffset = 1 << (bitWidth - 1);
+        // Zero width values are not encoded
+        if (!fixedWidth) {
+            std::fill_n(out, count, 0ull);
+            return;
+        }
 
-        TChunk mask = chunkBitOffset - 1;
+        // Wider than a window?
+        if (fixedWidth > kWindowBits) {
+            for (uint64_t i = 0; i < count; i++) {
+                out[i] = Variable<uint64_t>(fixedWidth);
+            }
+            return;
+        }
 
-        for (TChunk shift = 0;; shift += (bitWidth - 1)) {
-            auto chunk = Variable<TChunk>(bitWidth);
+        // Number of whole values per window
+        const uint32_t valuesPerWindow = kWindowBits / fixedWidth;
+        const uint64_t mask = Mask(fixedWidth);
 
-            value += (chunk & mask) << shift;
+        while (count) {
+            uint64_t window = Peek();
 
-            // Next chunk?
-            if (!(chunk & chunkBitOffset)) {
+            // Extract all values fully contained in the window
+            const uint32_t batch = static_cast<uint32_t>(std::min<uint64_t>(count, valuesPerWindow));
+            for (uint32_t i = 0; i < batch; i++) {
+                out[i] = window & mask;
+                window >>= fixedWidth;
+            }
+
+            // Advance past the batch
+            Advance(batch * fixedWidth);
+            out += batch;
+            count -= batch;
+        }
+    }
+
+    /// Consume an array of variable width values
+    /// \param out destination values, length of [count]
+    /// \param count number of values to read
+    /// \param bitWidth the bit width of each chunk
+    void VBRArray(uint64_t* out, uint64_t count, uint8_t bitWidth) {
+        switch (bitWidth) {
+            default: {
+                for (uint64_t i = 0; i < count; i++) {
+                    out[i] = VBRChunked<uint64_t>(bitWidth);
+                }
+                break;
+            }
+            case 6: {
+                VBRArrayWindowed<6>(out, count);
                 break;
             }
+            case 8: {
+                VBRArrayWindowed<8>(out, count);
+                break;
+            }
+        }
+    }
+
+    /// Consume an array of char6 values
+    /// \param out destination values, length of [count]
+    /// \param count number of values to read
+    void Char6Array(uint64_t* out, uint64_t count) {
+        FixedArray(out, count, 6);
+
+        // Expand all characters
+        for (uint64_t i = 0; i < count; i++) {
+            out[i] = static_cast<uint64_t>(kChar6Table[out[i]]);
         }
+    }
 
-        return value;
+    /// Consume a blob
+    ///   ! Aligns the stream before and after the blob contents
+    /// \param byteCount number of bytes in the blob
+    /// \return the blob data address
+    const uint8_t* Blob(uint64_t byteCount) {
+        AlignDWord();
+
+        // Assign data before skipping
+        const uint8_t* data = GetSafeData();
+        Skip(static_cast<uint32_t>(byteCount));
+
+        // LLVM blobs are tail padded to dwords
+        AlignDWord();
+        return data;
     }
 
     /// Decode a signed LLVM value
@@ -124,42 +213,19 @@ struct LLVMBitStreamReader {
 
     /// Align the stream to 32 bits
     void AlignDWord() {
-        if (bitOffset % 32 == 0) {
-            return;
-        }
+        uint64_t offset = static_cast<uint64_t>(ptr - start) * 8 + bitOffset;
 
-        // On dword boundary?
-        if (bitOffset < 32) {
-            bitOffset = 32;
-        } else {
-            bitOffset = 0;
-            ptr++;
-        }
+        // Round up to the next dword boundary
+        offset = (offset + 31) & ~31ull;
+        ptr = start + offset / 8;
+        bitOffset = 0;
     }
 
     /// Read the char6 value
     /// \return read value
     char Char6() {
-        auto encoded = Variable<uint8_t>(6);
-
-        if (encoded <= 25) {
-            return char('a' + encoded);
-        } else if (encoded <= 51) {
-            return char('A' + encoded - 26);
-        } else if (encoded <= 61) {
-            return char('0' + encoded - 52);
-        } else if (encoded == 62) {
-            return '.';
-        } else if (encoded == 63) {
-            return '_';
-        }
-
-        // Debugging
-        ASSERT(false, "Invalid Char6 in LLVM bit-stream");
-
-        // Mark as failed
-        errorState = true;
-        return 0x0;
+        // All 6 bit encodings are valid
+        return kChar6Table[Variable<uint8_t>(6)];
     }
 
     /// Read a variable width data type
@@ -168,23 +234,18 @@ struct LLVMBitStreamReader {
     /// \return read value
     template<typename T>
     T Variable(uint8_t count) {
-        uint8_t available = 64u - bitOffset;
-
-        T mask = static_cast<T>((1ull << count) - 1ull);
-
-        T data;
-        if (count > available) {
-            data = static_cast<T>((*ptr >> bitOffset) | (*(ptr + 1) << available));
-        } else {
-            data = static_cast<T>(*ptr >> bitOffset);
+        // Wider than a window? Split into two reads
+        if (count > kWindowBits) {
+            uint64_t low = Peek() & Mask(32);
+            Advance(32);
+            uint64_t high = Peek() & Mask(count - 32);
+            Advance(count - 32);
+            return static_cast<T>(low | (high << 32));
         }
 
-        bitOffset += count;
-
-        ptr += bitOffset / 64;
-        bitOffset = bitOffset % 64;
-
-        return data & mask;
+        T data = static_cast<T>(Peek() & Mask(count));
+        Advance(count);
+        return data;
     }
 
     /// Get the safe data address for a given bit offset
@@ -192,50 +253,212 @@ struct LLVMBitStreamReader {
     /// \return the data address
     const uint8_t* GetSafeData() const {
         ASSERT(bitOffset % 8 == 0, "Unaligned data access, align beforehand");
-        return reinterpret_cast<const uint8_t*>(ptr) + (bitOffset / 8);
+        return ptr;
     }
 
     /// Skip a number of bytes
     /// \param byteCount number of bytes to skip
     void Skip(uint32_t byteCount) {
-        uint32_t bits = byteCount * 8;
+        ptr += byteCount;
+    }
 
-        // Number of remaining bits
-        uint8_t boundaryBits = 64u - bitOffset;
+    /// Is this stream EOS?
+    bool IsEOS() const {
+        return ptr >= end;
+    }
+
+private:
+    /// Get the low bit mask for a width
+    /// \param count number of bits, [0, 64]
+    /// \return mask
+    static uint64_t Mask(uint32_t count) {
+        return count ? (~0ull >> (64u - count)) : 0ull;
+    }
 
-        // Within the boundary?
-        if (bits <= boundaryBits) {
-            bitOffset += bits;
+    /// Peek the window at the current bit offset
+    ///   ? Bytes beyond the end of the stream are read as zero
+    /// \return window, at least kWindowBits valid
+    uint64_t Peek() const {
+        uint64_t word = 0;
+
+        // Unaligned load, copy the tail near the end of the stream
+        if (ptr + sizeof(uint64_t) <= end) {
+            std::memcpy(&word, ptr, sizeof(uint64_t));
+        } else if (ptr < end) {
+            std::memcpy(&word, ptr, end - ptr);
+        }
 
-            // On the boundary?
-            if (bits == 64) {
-                ptr++;
-                bitOffset = 0;
+        return word >> bitOffset;
+    }
+
+    /// Advance the stream
+    /// \param bitCount number of bits to advance by
+    void Advance(uint32_t bitCount) {
+        uint32_t offset = bitOffset + bitCount;
+        ptr += offset / 8;
+        bitOffset = static_cast<uint8_t>(offset % 8);
+    }
+
+    /// Consume a variable width value, one chunk at a time
+    /// \tparam T type to be used, underlying type also used for expansion
+    /// \param bitWidth the bit width of each chunk
+    /// \return accumulated value
+    template<typename T>
+    T VBRChunked(uint8_t bitWidth) {
+        using TChunk = ChunkType<T>;
+
+        T value = 0;
+
+        TChunk chunkBitOffset = TChunk(1) << (bitWidth - 1);
+
+        TChunk mask = chunkBitOffset - 1;
+
+        for (TChunk shift = 0;; shift += (bitWidth - 1)) {
+            auto chunk = Variable<TChunk>(bitWidth);
+
+            value += static_cast<T>(chunk & mask) << shift;
+
+            // Next chunk?
+            if (!(chunk & chunkBitOffset)) {
+                break;
             }
-        } else {
-            // Push boundary
-            bits -= boundaryBits;
+        }
 
-            // Push number of full 64 advances (+1 for the boundary)
-            ptr += 1 + (bits / 64);
+        return value;
+    }
 
-            // Push remaining
-            bitOffset = bits % 64;
+    /// Get the continuation bits of all chunks within a window
+    /// \tparam W chunk bit width
+    /// \return continuation mask
+    template<uint8_t W>
+    static constexpr uint64_t ContinuationMask() {
+        uint64_t mask = 0;
+        for (uint32_t i = W - 1; i < kWindowBits; i += W) {
+            mask |= 1ull << i;
         }
+        return mask;
     }
 
-    /// Is this stream EOS?
-    bool IsEOS() const {
-        return ptr >= end;
+    /// Decode a number of chunks from a window
+    /// \tparam W chunk bit width
+    /// \param window source window, first chunk at bit zero
+    /// \param chunkCount number of chunks to decode
+    /// \return accumulated value
+    template<uint8_t W>
+    static uint64_t DecodeChunks(uint64_t window, uint32_t chunkCount) {
+        constexpr uint64_t kPayloadMask = (1ull << (W - 1)) - 1;
+
+        uint64_t value = window & kPayloadMask;
+        for (uint32_t i = 1; i < chunkCount; i++) {
+            value |= ((window >> (i * W)) & kPayloadMask) << (i * (W - 1));
+        }
+
+        return value;
+    }
+
+    /// Consume a variable width value from a single window
+    ///   Terminating chunk is located from the continuation bits, falls back to the chunked decoder
+    ///   if the value exceeds the window.
+    /// \tparam T type to be used, underlying type also used for expansion
+    /// \tparam W chunk bit width
+    /// \return accumulated value
+    template<typename T, uint8_t W>
+    T VBRWindowed() {
+        constexpr uint64_t kContinuationBit = 1ull << (W - 1);
+
+        uint64_t window = Peek();
+
+        // Single chunk values are the overwhelmingly common case
+        if (!(window & kContinuationBit)) {
+            Advance(W);
+            return static_cast<T>(window & (kContinuationBit - 1));
+        }
+
+        // Find the terminating chunk
+        uint64_t terminators = ~window & ContinuationMask<W>();
+        if (!terminators) {
+            return VBRChunked<T>(W);
+        }
+
+        // Decode all chunks up to and including the terminator
+        uint32_t chunkCount = static_cast<uint32_t>(std::countr_zero(terminators)) / W + 1;
+        Advance(chunkCount * W);
+        return static_cast<T>(DecodeChunks<W>(window, chunkCount));
+    }
+
+    /// Consume an array of variable width values, decodes all values within a window before refilling
+    /// \tparam W chunk bit width
+    /// \param out destination values, length of [count]
+    /// \param count number of values to read
+    template<uint8_t W>
+    void VBRArrayWindowed(uint64_t* out, uint64_t count) {
+        constexpr uint64_t kContinuationBit = 1ull << (W - 1);
+        constexpr uint32_t kChunksPerWindow = kWindowBits / W;
+
+        while (count) {
+            uint64_t window = Peek();
+
+            // Number of chunks left in this window
+            uint32_t available = kChunksPerWindow;
+
+            // Decode all values terminating within the window
+            while (count && available) {
+                // Single chunk value?
+                if (!(window & kContinuationBit)) {
+                    *out++ = window & (kContinuationBit - 1);
+                    count--;
+
+                    // Next chunk
+                    window >>= W;
+                    available--;
+                    continue;
+                }
+
+                // Find the next terminating chunk within the available chunks
+                uint64_t terminators = ~window & ContinuationMask<W>() & Mask(available * W);
+                if (!terminators) {
+                    break;
+                }
+
+                // Decode value
+                uint32_t chunkCount = static_cast<uint32_t>(std::countr_zero(terminators)) / W + 1;
+                *out++ = DecodeChunks<W>(window, chunkCount);
+                count--;
+
+                // Next value
+                window >>= chunkCount * W;
+                available -= chunkCount;
+            }
+
+            // Value spans beyond a fresh window?
+            if (available == kChunksPerWindow) {
+                *out++ = VBRChunked<uint64_t>(W);
+                count--;
+                continue;
+            }
+
+            // Advance past all decoded values
+            Advance((kChunksPerWindow - available) * W);
+        }
     }
 
 private:
+    /// Char6 decoding table
+    static constexpr char kChar6Table[64] = {
+        'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+        'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+        'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+        'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
+        '.', '_'
+    };
+
     /// Data pointers
-    const uint64_t *start;
-    const uint64_t *ptr;
-    const uint64_t *end;
+    const uint8_t *start;
+    const uint8_t *ptr;
+    const uint8_t *end;
 
-    /// Current bit offset
+    /// Current bit offset, within the current byte
     uint8_t bitOffset{0};
 
     /// Encountered an error?
@@ -1139,6 +1139,11 @@ void DXILPhysicalBlockFunction::ParseFunction(struct LLVMBlock *block) {
     }
 #endif // NDEBUG
 
+    // Immortalize all blocks, any later modification marks them dirty
+    for (IL::BasicBlock *fnBB: fn->GetBasicBlocks()) {
+        fnBB->Immortalize(fnBB->GetSourceSpan());
+    }
+
     // Only create value segments if there's more than one function, no need to branch if not
     if (RequiresValueMapSegmentation()) {
         // Create id map segment
@@ -2912,6 +2917,32 @@ static bool IsFunctionPostRecordDependentBlock(LLVMReservedBlock block) {
     }
 }
 
+/// Check if a function is unmodified since parsing
+/// \param fn function to check
+/// \param block source function block
+/// \return true if the original block layout and all instructions are intact
+static bool IsFunctionUnmodified(const IL::Function *fn, const LLVMBlock *block) {
+    // Any block addition or removal invalidates the source layout
+    for (const LLVMRecord &record: block->records) {
+        if (record.Is(LLVMFunctionRecord::DeclareBlocks)) {
+            if (record.Op32(0) != fn->GetBasicBlocks().GetBlockCount()) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    // Check all blocks
+    for (const IL::BasicBlock *bb: fn->GetBasicBlocks()) {
+        if (bb->IsModified()) {
+            return false;
+        }
+    }
+
+    // OK
+    return true;
+}
+
 void DXILPhysicalBlockFunction::CompileFunction(const DXCompileJob& job, struct LLVMBlock *block) {
     const uint32_t functionIndex = static_cast<uint32_t>(functionBlocks.Size());
 
@@ -2938,8 +2969,12 @@ void DXILPhysicalBlockFunction::CompileFunction(const DXCompileJob& job, struct
     // Get function
     IL::Function *fn = program.GetFunctionList()[functionIndex];
 
+    // Untouched functions keep their source block order and are re-emitted record by record,
+    // no dominance reordering and no instrumentation handles
+    const bool isUnmodified = IsFunctionUnmodified(fn, block);
+
     // Remap all blocks by dominance
-    if (!fn->ReorderByDominantBlocks(false)) {
+    if (!isUnmodified && !fn->ReorderByDominantBlocks(false)) {
         return;
     }
 
@@ -3005,7 +3040,9 @@ void DXILPhysicalBlockFunction::CompileFunction(const DXCompileJob& job, struct
     block->InsertRecord(block->elements.data(), declareBlocks);
 
     // Add binding handles
-    CreateHandles(job, block);
+    if (!isUnmodified) {
+        CreateHandles(job, block);
+    }
 
     // Compile all blocks
     for (const IL::BasicBlock *bb: fn->GetBasicBlocks()) {
@@ -301,9 +301,7 @@ DXILPhysicalBlockScan::ScanResult DXILPhysicalBlockScan::ScanUnabbreviatedRecord
     record.ops = recordAllocator.AllocateArray<uint64_t>(record.opCount);
 
     // Scan all ops
-    for (uint32_t i = 0; i < record.opCount; i++) {
-        record.ops[i] = stream.VBR<uint64_t>(6);
-    }
+    stream.VBRArray(record.ops, record.opCount, 6);
 
     // OK
     return ScanResult::OK;
@@ -380,9 +378,7 @@ DXILPhysicalBlockScan::ScanResult DXILPhysicalBlockScan::ScanUnabbreviatedInfoRe
     record.ops = recordAllocator.AllocateArray<uint64_t>(record.opCount);
 
     // Scan all ops
-    for (uint32_t i = 0; i < record.opCount; i++) {
-        record.ops[i] = stream.VBR<uint64_t>(6);
-    }
+    stream.VBRArray(record.ops, record.opCount, 6);
 
     // Handle type
     switch (record.id) {
@@ -538,21 +534,15 @@ DXILPhysicalBlockScan::ScanResult DXILPhysicalBlockScan::ScanRecord(LLVMBitStrea
                         break;
                     }
                     case LLVMAbbreviationEncoding::Fixed: {
-                        for (uint32_t elementIndex = 0; elementIndex < count; elementIndex++) {
-                            recordOperandCache[dataOffset + elementIndex] = stream.Fixed<uint64_t>(static_cast<uint32_t>(contained.value));
-                        }
+                        stream.FixedArray(recordOperandCache.data() + dataOffset, count, static_cast<uint8_t>(contained.value));
                         break;
                     }
                     case LLVMAbbreviationEncoding::VBR: {
-                        for (uint32_t elementIndex = 0; elementIndex < count; elementIndex++) {
-                            recordOperandCache[dataOffset + elementIndex] = stream.VBR<uint64_t>(static_cast<uint32_t>(contained.value));
-                        }
+                        stream.VBRArray(recordOperandCache.data() + dataOffset, count, static_cast<uint8_t>(contained.value));
                         break;
                     }
                     case LLVMAbbreviationEncoding::Char6: {
-                        for (uint32_t elementIndex = 0; elementIndex < count; elementIndex++) {
-                            recordOperandCache[dataOffset + elementIndex] = stream.Char6();
-                        }
+                        stream.Char6Array(recordOperandCache.data() + dataOffset, count);
                         break;
                     }
                 }
@@ -573,14 +563,8 @@ DXILPhysicalBlockScan::ScanResult DXILPhysicalBlockScan::ScanRecord(LLVMBitStrea
                 // Read size
                 record.blobSize = stream.VBR<uint64_t>(6);
 
-                // Align
-                stream.AlignDWord();
-
-                // Assign blob
-                record.blob = stream.GetSafeData();
-
-                // Skip blob (takes byte count)
-                stream.Skip(static_cast<uint32_t>(record.blobSize));
+                // Assign blob, handles alignment and tail padding
+                record.blob = stream.Blob(record.blobSize);
                 break;
             }
         }
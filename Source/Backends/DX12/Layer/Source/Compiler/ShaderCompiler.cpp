@@ -45,6 +45,7 @@
 #include <Backend/IFeature.h>
 #include <Backend/IShaderFeature.h>
 #include <Backend/IShaderExportHost.h>
+#include <Backend/IL/GuardPlan.h>
 #include <Backend/Diagnostic/DiagnosticBucketScope.h>
 
 // Common
@@ -216,6 +217,19 @@ bool ShaderCompiler::CompileShader(const ShaderJob &job) {
         shaderFeatures[i]->PreInject(*module->GetProgram(), *job.dependentSpecialization);
     }
 
+    // Shared guard plan, checks across features are fused per instruction
+    IL::GuardPlan guardPlan;
+
+    // Plan all guards
+    for (size_t i = 0; i < shaderFeatures.size(); i++) {
+        if (!(job.instrumentationKey.featureBitSet & (1ull << i))) {
+            continue;
+        }
+
+        // Plan marked shader feature
+        shaderFeatures[i]->PlanGuards(guardPlan, *module->GetProgram(), *job.dependentSpecialization);
+    }
+
     // Pass through all features
     for (size_t i = 0; i < shaderFeatures.size(); i++) {
         if (!(job.instrumentationKey.featureBitSet & (1ull << i))) {
@@ -226,6 +240,9 @@ bool ShaderCompiler::CompileShader(const ShaderJob &job) {
         shaderFeatures[i]->Inject(*module->GetProgram(), *job.dependentSpecialization);
     }
 
+    // Emit all fused guards
+    guardPlan.Apply(*module->GetProgram());
+
     // Instrumentation job
     DXCompileJob compileJob;
     compileJob.instrumentationKey = job.instrumentationKey;
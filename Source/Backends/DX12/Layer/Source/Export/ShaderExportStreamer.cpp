@@ -1172,6 +1172,9 @@ bool ShaderExportStreamer::ProcessSegment(ShaderExportStreamSegment *segment, Tr
         MessageStream messageStream;
         messageStream.SetSchema(streamInfo.typeInfo.messageSchema);
         messageStream.SetVersionID(segment->versionSegPoint.id);
+
+        // Bulk export data, may be dropped under transport overload
+        messageStream.SetLossy(true);
         messageStream.SetData(stream, size, static_cast<uint32_t>(size / streamInfo.typeInfo.typeSize));
 
         // Add output
@@ -0,0 +1,186 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+// Catch2
+#include <catch2/catch.hpp>
+
+// Layer
+#include <Backends/DX12/Compiler/DXStream.h>
+#include <Backends/DX12/Compiler/DXParseJob.h>
+#include <Backends/DX12/Compiler/DXCompileJob.h>
+#include <Backends/DX12/Compiler/DXBC/DXBCPhysicalBlockScan.h>
+#include <Backends/DX12/Compiler/DXIL/DXILModule.h>
+#include <Backends/DX12/Compiler/DXIL/DXILPhysicalBlockScan.h>
+
+// Backend
+#include <Backend/IL/Program.h>
+#include <Backend/IL/Emitters/Emitter.h>
+
+// Shaders
+#include <Data/HelloTriangleVSD3D12.h>
+#include <Data/HelloTrianglePSD3D12.h>
+
+// Std
+#include <vector>
+
+/// Container fixtures
+static const std::pair<const void*, uint64_t> kContainers[] = {
+    { kHelloTriangleVSD3D12, sizeof(kHelloTriangleVSD3D12) },
+    { kHelloTrianglePSD3D12, sizeof(kHelloTrianglePSD3D12) }
+};
+
+/// Get all function blocks of a scanned program
+static std::vector<const LLVMBlock*> GetFunctionBlocks(const DXILPhysicalBlockScan& scan) {
+    std::vector<const LLVMBlock*> blocks;
+
+    // Root only holds the module
+    const LLVMBlock& root = scan.GetRoot();
+    REQUIRE(root.blocks.size() == 1);
+
+    for (const LLVMBlock* child : root.blocks[0]->blocks) {
+        if (child->Is(LLVMReservedBlock::Function)) {
+            blocks.push_back(child);
+        }
+    }
+
+    return blocks;
+}
+
+/// Parse and recompile a program
+/// \param modify if true, split the first basic block of every function
+/// \param out destination stream
+static void Recompile(const Allocators& allocators, const DXBCPhysicalBlock* block, bool modify, DXStream& out) {
+    DXILModule module(allocators);
+
+    // Parse the program
+    DXParseJob parseJob;
+    parseJob.byteCode = block->ptr;
+    parseJob.byteLength = block->length;
+    REQUIRE(module.Parse(parseJob));
+
+    IL::Program* program = module.GetProgram();
+    REQUIRE(program->GetFunctionList().GetCount() >= 1);
+
+    // Freshly parsed blocks must not report modifications
+    for (IL::Function* fn : program->GetFunctionList()) {
+        for (IL::BasicBlock* bb : fn->GetBasicBlocks()) {
+            REQUIRE(!bb->IsModified());
+        }
+    }
+
+    // Optionally touch every function
+    if (modify) {
+        for (IL::Function* fn : program->GetFunctionList()) {
+            IL::BasicBlock* entryPoint = *fn->GetBasicBlocks().begin();
+            IL::BasicBlock* splitBlock = fn->GetBasicBlocks().AllocBlock();
+            entryPoint->Split(splitBlock, entryPoint->GetTerminator());
+
+            // Close the entry point
+            IL::Emitter<>(*program, *entryPoint).Branch(splitBlock);
+            REQUIRE(entryPoint->IsModified());
+        }
+    }
+
+    // Recompile without any instrumentation
+    DXCompileJob compileJob;
+    REQUIRE(module.Compile(compileJob, out));
+}
+
+TEST_CASE("DXIL.PassThrough.Unmodified") {
+    Allocators allocators;
+
+    for (auto&& [byteCode, byteLength] : kContainers) {
+        DXBCPhysicalBlockScan containerScan(allocators);
+        REQUIRE(containerScan.Scan(byteCode, byteLength));
+
+        // Must have a program
+        const DXBCPhysicalBlock* block = containerScan.GetPhysicalBlock(DXBCPhysicalBlockType::DXIL);
+        REQUIRE(block);
+
+        // Recompile untouched
+        DXStream stream(allocators);
+        Recompile(allocators, block, false, stream);
+
+        // Scan both programs
+        DXILPhysicalBlockScan sourceScan(allocators);
+        REQUIRE(sourceScan.Scan(block->ptr, block->length));
+
+        DXILPhysicalBlockScan compiledScan(allocators);
+        REQUIRE(compiledScan.Scan(stream.GetData(), stream.GetByteSize()));
+
+        std::vector<const LLVMBlock*> sourceFunctions = GetFunctionBlocks(sourceScan);
+        std::vector<const LLVMBlock*> compiledFunctions = GetFunctionBlocks(compiledScan);
+        REQUIRE(sourceFunctions.size() == compiledFunctions.size());
+
+        // Unmodified functions keep their source record layout, no reordering and no injected handles
+        for (size_t i = 0; i < sourceFunctions.size(); i++) {
+            const LLVMBlock* source = sourceFunctions[i];
+            const LLVMBlock* compiled = compiledFunctions[i];
+            REQUIRE(source->records.size() == compiled->records.size());
+
+            for (size_t recordIndex = 0; recordIndex < source->records.size(); recordIndex++) {
+                REQUIRE(source->records[recordIndex].id == compiled->records[recordIndex].id);
+                REQUIRE(source->records[recordIndex].opCount == compiled->records[recordIndex].opCount);
+            }
+
+            // Same basic block count
+            REQUIRE(source->records[0].Op(0) == compiled->records[0].Op(0));
+        }
+    }
+}
+
+TEST_CASE("DXIL.PassThrough.Modified") {
+    Allocators allocators;
+
+    for (auto&& [byteCode, byteLength] : kContainers) {
+        DXBCPhysicalBlockScan containerScan(allocators);
+        REQUIRE(containerScan.Scan(byteCode, byteLength));
+
+        // Must have a program
+        const DXBCPhysicalBlock* block = containerScan.GetPhysicalBlock(DXBCPhysicalBlockType::DXIL);
+        REQUIRE(block);
+
+        // Recompile with split entry blocks
+        DXStream stream(allocators);
+        Recompile(allocators, block, true, stream);
+
+        // Scan both programs
+        DXILPhysicalBlockScan sourceScan(allocators);
+        REQUIRE(sourceScan.Scan(block->ptr, block->length));
+
+        DXILPhysicalBlockScan compiledScan(allocators);
+        REQUIRE(compiledScan.Scan(stream.GetData(), stream.GetByteSize()));
+
+        std::vector<const LLVMBlock*> sourceFunctions = GetFunctionBlocks(sourceScan);
+        std::vector<const LLVMBlock*> compiledFunctions = GetFunctionBlocks(compiledScan);
+        REQUIRE(sourceFunctions.size() == compiledFunctions.size());
+
+        // Modified functions must go through the full compilation path, the split adds a block
+        for (size_t i = 0; i < sourceFunctions.size(); i++) {
+            REQUIRE(compiledFunctions[i]->records[0].Op(0) == sourceFunctions[i]->records[0].Op(0) + 1);
+        }
+    }
+}
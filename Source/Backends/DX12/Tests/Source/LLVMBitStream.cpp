@@ -0,0 +1,382 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+// Catch2
+#include <catch2/catch.hpp>
+
+// Layer
+#include <Backends/DX12/Compiler/DXStream.h>
+#include <Backends/DX12/Compiler/DXBC/DXBCPhysicalBlockScan.h>
+#include <Backends/DX12/Compiler/DXIL/DXILPhysicalBlockScan.h>
+#include <Backends/DX12/Compiler/DXIL/LLVM/LLVMBitStreamReader.h>
+#include <Backends/DX12/Compiler/DXIL/LLVM/LLVMBitStreamWriter.h>
+
+// Shaders
+#include <Data/HelloTriangleVSD3D12.h>
+#include <Data/HelloTrianglePSD3D12.h>
+
+// Std
+#include <algorithm>
+#include <random>
+#include <vector>
+
+/// Encoded operation
+struct BitStreamOperation {
+    /// Encoding type
+    enum class Type {
+        Fixed,
+        VBR,
+        FixedArray,
+        VBRArray,
+        Char6Array
+    } type;
+
+    /// Bit width of the value or elements
+    uint8_t width;
+
+    /// Values of this operation
+    std::vector<uint64_t> values;
+};
+
+/// Write a random set of operations
+static std::vector<BitStreamOperation> WriteOperations(LLVMBitStreamWriter& writer, uint32_t count, uint64_t seed) {
+    std::mt19937_64 engine(seed);
+    std::vector<BitStreamOperation> operations;
+
+    // Typical VBR widths
+    constexpr uint8_t kVBRWidths[] = { 3, 4, 5, 6, 7, 8 };
+
+    // Char6 alphabet
+    constexpr char kChar6[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789._";
+
+    for (uint32_t i = 0; i < count; i++) {
+        BitStreamOperation& op = operations.emplace_back();
+        op.type = static_cast<BitStreamOperation::Type>(engine() % 5);
+
+        // Single values or arrays
+        uint64_t valueCount = (op.type == BitStreamOperation::Type::Fixed || op.type == BitStreamOperation::Type::VBR) ? 1 : engine() % 48;
+
+        switch (op.type) {
+            case BitStreamOperation::Type::Fixed:
+            case BitStreamOperation::Type::FixedArray: {
+                op.width = static_cast<uint8_t>(1 + engine() % 64);
+
+                for (uint64_t j = 0; j < valueCount; j++) {
+                    uint64_t value = engine() & (~0ull >> (64 - op.width));
+                    writer.Fixed<uint64_t>(value, op.width);
+                    op.values.push_back(value);
+                }
+                break;
+            }
+            case BitStreamOperation::Type::VBR:
+            case BitStreamOperation::Type::VBRArray: {
+                op.width = kVBRWidths[engine() % std::size(kVBRWidths)];
+
+                for (uint64_t j = 0; j < valueCount; j++) {
+                    // Bias towards small values, as seen in practice
+                    uint64_t value = (engine() % 4) ? engine() % 32 : engine() >> (engine() % 64);
+                    writer.VBR<uint64_t>(value, op.width);
+                    op.values.push_back(value);
+                }
+                break;
+            }
+            case BitStreamOperation::Type::Char6Array: {
+                op.width = 6;
+
+                for (uint64_t j = 0; j < valueCount; j++) {
+                    char value = kChar6[engine() % 64];
+                    writer.Char6(value);
+                    op.values.push_back(static_cast<uint64_t>(value));
+                }
+                break;
+            }
+        }
+    }
+
+    return operations;
+}
+
+/// Get the DXIL program of a container
+static const DXBCPhysicalBlock* GetDXILBlock(DXBCPhysicalBlockScan& scan, const void* byteCode, uint64_t byteLength) {
+    if (!scan.Scan(byteCode, byteLength)) {
+        return nullptr;
+    }
+
+    return scan.GetPhysicalBlock(DXBCPhysicalBlockType::DXIL);
+}
+
+TEST_CASE("LLVMBitStream.RoundTrip") {
+    Allocators allocators;
+
+    for (uint64_t seed = 0; seed < 64; seed++) {
+        DXStream stream(allocators);
+
+        // Write all operations
+        LLVMBitStreamWriter writer(stream);
+        std::vector<BitStreamOperation> operations = WriteOperations(writer, 256, seed);
+        writer.Close();
+
+        // Read back all operations
+        LLVMBitStreamReader reader(stream.GetData(), stream.GetByteSize());
+        for (const BitStreamOperation& op : operations) {
+            std::vector<uint64_t> values(op.values.size());
+
+            switch (op.type) {
+                case BitStreamOperation::Type::Fixed:
+                    values[0] = reader.Fixed<uint64_t>(op.width);
+                    break;
+                case BitStreamOperation::Type::VBR:
+                    values[0] = reader.VBR<uint64_t>(op.width);
+                    break;
+                case BitStreamOperation::Type::FixedArray:
+                    reader.FixedArray(values.data(), values.size(), op.width);
+                    break;
+                case BitStreamOperation::Type::VBRArray:
+                    reader.VBRArray(values.data(), values.size(), op.width);
+                    break;
+                case BitStreamOperation::Type::Char6Array:
+                    reader.Char6Array(values.data(), values.size());
+                    break;
+            }
+
+            REQUIRE(values == op.values);
+        }
+
+        REQUIRE(!reader.IsError());
+    }
+}
+
+TEST_CASE("LLVMBitStream.Blob") {
+    Allocators allocators;
+    DXStream stream(allocators);
+
+    // Unaligned header, followed by a dword aligned blob
+    constexpr uint32_t kBlob[] = { 0xDEADBEEF, 0xC0DEC0DE, 0x12345678 };
+
+    LLVMBitStreamWriter writer(stream);
+    writer.VBR<uint64_t>(sizeof(kBlob), 6);
+    writer.AlignDWord();
+
+    // Write blob contents
+    for (uint32_t dword : kBlob) {
+        writer.Fixed<uint32_t>(dword);
+    }
+
+    writer.Fixed<uint32_t>(0x7, 3);
+    writer.Close();
+
+    // Blob must be addressable in place, and the stream resumed after it
+    LLVMBitStreamReader reader(stream.GetData(), stream.GetByteSize());
+    uint64_t size = reader.VBR<uint64_t>(6);
+    REQUIRE(size == sizeof(kBlob));
+    REQUIRE(std::memcmp(reader.Blob(size), kBlob, sizeof(kBlob)) == 0);
+    REQUIRE(reader.Fixed<uint32_t>(3) == 0x7);
+}
+
+/// Compare two scanned block hierarchies
+static void CompareBlocks(const LLVMBlock& lhs, const LLVMBlock& rhs) {
+    REQUIRE(lhs.id == rhs.id);
+    REQUIRE(lhs.blocks.size() == rhs.blocks.size());
+    REQUIRE(lhs.records.size() == rhs.records.size());
+    REQUIRE(lhs.elements.size() == rhs.elements.size());
+
+    // Same element order
+    for (size_t i = 0; i < lhs.elements.size(); i++) {
+        REQUIRE(lhs.elements[i].type == rhs.elements[i].type);
+        REQUIRE(lhs.elements[i].id == rhs.elements[i].id);
+    }
+
+    // Same record contents
+    for (size_t i = 0; i < lhs.records.size(); i++) {
+        const LLVMRecord& lhsRecord = lhs.records[i];
+        const LLVMRecord& rhsRecord = rhs.records[i];
+        REQUIRE(lhsRecord.id == rhsRecord.id);
+        REQUIRE(lhsRecord.opCount == rhsRecord.opCount);
+
+        for (uint32_t op = 0; op < lhsRecord.opCount; op++) {
+            REQUIRE(lhsRecord.Op(op) == rhsRecord.Op(op));
+        }
+    }
+
+    // Same hierarchy
+    for (size_t i = 0; i < lhs.blocks.size(); i++) {
+        CompareBlocks(*lhs.blocks[i], *rhs.blocks[i]);
+    }
+}
+
+TEST_CASE("LLVMBitStream.Containers") {
+    Allocators allocators;
+
+    // Container fixtures
+    const std::pair<const void*, uint64_t> containers[] = {
+        { kHelloTriangleVSD3D12, sizeof(kHelloTriangleVSD3D12) },
+        { kHelloTrianglePSD3D12, sizeof(kHelloTrianglePSD3D12) }
+    };
+
+    for (auto&& [byteCode, byteLength] : containers) {
+        DXBCPhysicalBlockScan containerScan(allocators);
+
+        // Must have a program
+        const DXBCPhysicalBlock* block = GetDXILBlock(containerScan, byteCode, byteLength);
+        REQUIRE(block);
+
+        // Scan the full block hierarchy
+        DXILPhysicalBlockScan scan(allocators);
+        REQUIRE(scan.Scan(block->ptr, block->length));
+
+        // Root must only hold the module
+        const LLVMBlock& root = scan.GetRoot();
+        REQUIRE(root.blocks.size() == 1);
+
+        const LLVMBlock& module = *root.blocks[0];
+        REQUIRE(module.Is(LLVMReservedBlock::Module));
+
+        // DXIL modules are always version 1
+        const LLVMRecord* version = nullptr;
+        for (const LLVMRecord& record : module.records) {
+            if (record.Is(LLVMModuleRecord::Version)) {
+                version = &record;
+            }
+        }
+        REQUIRE(version);
+        REQUIRE(version->opCount == 1);
+        REQUIRE(version->Op(0) == 1);
+
+        // Count function definitions, [type, callingConv, isPrototype, ...]
+        uint32_t definitionCount = 0;
+        for (const LLVMRecord& record : module.records) {
+            if (record.Is(LLVMModuleRecord::Function) && record.Op(2) == 0) {
+                definitionCount++;
+            }
+        }
+
+        // One function block per definition
+        uint32_t functionBlockCount = 0;
+        for (const LLVMBlock* child : module.blocks) {
+            if (!child->Is(LLVMReservedBlock::Function)) {
+                continue;
+            }
+
+            functionBlockCount++;
+
+            // Function bodies open with the basic block declaration
+            REQUIRE(!child->records.empty());
+            REQUIRE(child->records[0].id == 1u);
+            REQUIRE(child->records[0].opCount == 1);
+            REQUIRE(child->records[0].Op(0) >= 1);
+        }
+        REQUIRE(definitionCount >= 1);
+        REQUIRE(functionBlockCount == definitionCount);
+
+        // Mandatory module blocks
+        REQUIRE(std::count_if(module.blocks.begin(), module.blocks.end(), [](const LLVMBlock* child) { return child->Is(LLVMReservedBlock::Type); }) == 1);
+        REQUIRE(std::count_if(module.blocks.begin(), module.blocks.end(), [](const LLVMBlock* child) { return child->Is(LLVMReservedBlock::Metadata); }) >= 1);
+
+        // Elements reference every record and block exactly once
+        uint32_t elementRecordCount = 0;
+        uint32_t elementBlockCount = 0;
+        for (const LLVMBlockElement& element : module.elements) {
+            elementRecordCount += element.Is(LLVMBlockElementType::Record);
+            elementBlockCount += element.Is(LLVMBlockElementType::Block);
+        }
+        REQUIRE(elementRecordCount == module.records.size());
+        REQUIRE(elementBlockCount == module.blocks.size());
+
+        // Rescanning with a new scanner over the same allocators must yield the same hierarchy
+        DXILPhysicalBlockScan rescan(allocators);
+        REQUIRE(rescan.Scan(block->ptr, block->length));
+        CompareBlocks(scan.GetRoot(), rescan.GetRoot());
+    }
+}
+
+TEST_CASE("LLVMBitStream.Benchmark") {
+    Allocators allocators;
+
+    // Synthetic stream
+    DXStream stream(allocators);
+    LLVMBitStreamWriter writer(stream);
+    std::vector<BitStreamOperation> operations = WriteOperations(writer, 16384, 0);
+    writer.Close();
+
+    // Destination, large enough for any array
+    std::vector<uint64_t> values(64);
+
+    BENCHMARK("Synthetic.Scalar") {
+        LLVMBitStreamReader reader(stream.GetData(), stream.GetByteSize());
+
+        for (const BitStreamOperation& op : operations) {
+            for (size_t i = 0; i < op.values.size(); i++) {
+                switch (op.type) {
+                    case BitStreamOperation::Type::Fixed:
+                    case BitStreamOperation::Type::FixedArray:
+                        values[i] = reader.Fixed<uint64_t>(op.width);
+                        break;
+                    case BitStreamOperation::Type::VBR:
+                    case BitStreamOperation::Type::VBRArray:
+                        values[i] = reader.VBR<uint64_t>(op.width);
+                        break;
+                    case BitStreamOperation::Type::Char6Array:
+                        values[i] = reader.Char6();
+                        break;
+                }
+            }
+        }
+
+        return values[0];
+    };
+
+    BENCHMARK("Synthetic.Bulk") {
+        LLVMBitStreamReader reader(stream.GetData(), stream.GetByteSize());
+
+        for (const BitStreamOperation& op : operations) {
+            switch (op.type) {
+                case BitStreamOperation::Type::Fixed:
+                case BitStreamOperation::Type::FixedArray:
+                    reader.FixedArray(values.data(), op.values.size(), op.width);
+                    break;
+                case BitStreamOperation::Type::VBR:
+                case BitStreamOperation::Type::VBRArray:
+                    reader.VBRArray(values.data(), op.values.size(), op.width);
+                    break;
+                case BitStreamOperation::Type::Char6Array:
+                    reader.Char6Array(values.data(), op.values.size());
+                    break;
+            }
+        }
+
+        return values[0];
+    };
+
+    // Container throughput
+    DXBCPhysicalBlockScan containerScan(allocators);
+    const DXBCPhysicalBlock* block = GetDXILBlock(containerScan, kHelloTrianglePSD3D12, sizeof(kHelloTrianglePSD3D12));
+    REQUIRE(block);
+
+    BENCHMARK("Container.Scan") {
+        DXILPhysicalBlockScan scan(allocators);
+        return scan.Scan(block->ptr, block->length);
+    };
+}
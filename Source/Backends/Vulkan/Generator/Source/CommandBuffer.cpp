@@ -230,7 +230,7 @@ bool Generators::CommandBuffer(const GeneratorInfo& info, TemplateEngine& templa
             hooks << "\tif (ApplyFeatureHook<FeatureHook_" << name << ">(\n";
             hooks << "\t\t" << wrappedObject << ",\n";
             hooks << "\t\t&" << wrappedObject << "->userContext,\n";
-            hooks << "\t\t" << wrappedObject  << "->dispatchTable.featureBitSet_" << name << ",\n";
+            hooks << "\t\t" << wrappedObject  << "->dispatchTable.featureDispatch_" << name << ",\n";
             hooks << "\t\t" << wrappedObject  << "->dispatchTable.featureHooks_" << name << "\n";
             hooks << "\t\t";
 
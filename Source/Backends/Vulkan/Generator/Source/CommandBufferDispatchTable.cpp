@@ -131,6 +131,9 @@ bool Generators::CommandBufferDispatchTable(const GeneratorInfo& info, TemplateE
 
             // Generate feature callbacks
             callbacks << "\tFeatureHook_" << name << "::Hook featureHooks_" << name << "[64];\n";
+
+            // Generate compiled feature dispatch
+            callbacks << "\tFeatureHookDispatch featureDispatch_" << name << ";\n";
         }
     }
 
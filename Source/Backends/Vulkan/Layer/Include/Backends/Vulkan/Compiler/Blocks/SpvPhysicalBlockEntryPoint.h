@@ -62,6 +62,18 @@ public:
     /// \param id identifier to be added to entry point interfaces
     void AddInterface(SpvStorageClass storageClass, SpvId id);
 
+    /// Get the number of entry points
+    uint32_t GetEntryPointCount() const {
+        return static_cast<uint32_t>(entryPoints.size());
+    }
+
+    /// Get the function identifier of an entry point
+    /// \param index entry point index
+    /// \return function identifier
+    SpvId GetEntryPointFunction(uint32_t index) const {
+        return entryPoints[index].id;
+    }
+
 private:
     struct ExecutionMode {
         /// Execution modes may use different opcodes
@@ -86,6 +86,11 @@ struct SpvPhysicalBlockFunction : public SpvPhysicalBlockSection {
     /// \return success state
     bool CompileBasicBlock(const SpvJob& job, SpvIdMap& idMap, IL::Function& fn, IL::BasicBlock* bb, bool isModifiedScope);
 
+    /// Check if a function is unmodified since parsing, and may be re-emitted from its source span
+    /// \param fn the function to check
+    /// \return true if verbatim
+    bool IsVerbatimFunction(const IL::Function& fn) const;
+
     /// Copy to a new block
     /// \param remote the remote table
     /// \param out destination function
@@ -137,6 +142,16 @@ public:
     std::vector<IdentifierMetadata> identifierMetadata;
 
 private:
+    /// Collect all functions that must be lifted to IL
+    /// Functions unreachable from any entry point, and not calling any lifted function, are kept verbatim
+    /// \param out destination set
+    void CollectLiftedFunctions(std::set<IL::ID>& out);
+
+    /// Check if a parsed function may be kept verbatim, must be called before loop patching
+    /// \param function the parsed function
+    /// \return true if no recompilation is required
+    bool IsVerbatimCandidate(IL::Function* function);
+
     /// Patch all loop continues
     /// \param fn function
     void PostPatchLoops(IL::Function* fn);
@@ -37,6 +37,7 @@
 
 // Std
 #include <mutex>
+#include <filesystem>
 
 class Dispatcher;
 struct DispatcherBucket;
@@ -62,6 +63,10 @@ public:
     /// Install this compiler
     bool Install();
 
+    /// Uninstall this compiler, serializes the pipeline cache
+    /// All pending pipeline jobs must have completed
+    void Uninstall();
+
     /// Add a pipeline batch job
     /// \param states all pipeline states
     /// \param diagnostic pipeline diagnostic
@@ -100,6 +105,17 @@ protected:
     /// \return success state
     bool SetShaderModuleObject(VkPipelineShaderStageCreateInfo &createInfo, ShaderModuleState *state, const ShaderModuleInstrumentationKey &key);
 
+    /// Create the pipeline cache, seeded from the previous session if possible
+    /// \return success state
+    bool CreatePipelineCache();
+
+    /// Store the pipeline cache to disk
+    /// \return success state
+    bool StorePipelineCache();
+
+    /// Get the on-disk path of the pipeline cache, keyed by the driver cache UUID
+    std::filesystem::path GetPipelineCachePath() const;
+
 private:
     DeviceDispatchTable* table{nullptr};
 
@@ -112,4 +128,7 @@ private:
 
     /// Async dispatcher
     ComRef<Dispatcher> dispatcher{nullptr};
+
+    /// Pipeline cache shared by all instrumented pipelines, optional
+    VkPipelineCache pipelineCache{VK_NULL_HANDLE};
 };
@@ -32,6 +32,7 @@
 
 // Backend
 #include <Backend/ShaderData/ShaderDataInfo.h>
+#include <Backend/ShaderExportTypeInfo.h>
 
 // Common
 #include <Common/IComponent.h>
@@ -39,6 +40,7 @@
 
 // Std
 #include <mutex>
+#include <list>
 
 class Dispatcher;
 struct DispatcherBucket;
@@ -46,6 +48,7 @@ class IFeature;
 class IShaderFeature;
 class ShaderCompilerDebug;
 class ShaderExportDescriptorAllocator;
+class ShaderExportStreamAllocator;
 
 struct ShaderJob {
     /// State to compile
@@ -75,10 +78,23 @@ public:
     /// \param bucket optional, the dispatcher bucket
     void Add(DeviceDispatchTable* table, const ShaderJob& job, DispatcherBucket *bucket = nullptr);
 
-    /// Ensure a module is initialized
+    /// Ensure a module is initialized, the module is pinned until released
+    ///    ! Always balance with ReleaseModule, regardless of the result
     /// \param state shader state
     bool InitializeModule(ShaderModuleState* state);
 
+    /// Release a module pinned by InitializeModule
+    /// \param state shader state
+    void ReleaseModule(ShaderModuleState* state);
+
+    /// Set the byte budget of all resident modules
+    /// \param budget byte budget
+    void SetModuleBudget(uint64_t budget);
+
+    /// Stop tracking a module, must be called before the state is destroyed
+    /// \param state shader state
+    void UntrackModule(ShaderModuleState* state);
+
 protected:
     struct ShaderJobEntry {
         DeviceDispatchTable *table;
@@ -89,9 +105,25 @@ protected:
     /// \return success state
     bool CompileShader(const ShaderJobEntry &job);
 
+    /// Compile a given job against its pinned module
+    /// \return success state
+    bool CompileModule(const ShaderJobEntry &job);
+
     /// Worker entry
     void Worker(void *userData);
 
+    /// Decompress the originating code of a state
+    /// \param state shader state, lock must be held
+    /// \return success state
+    bool DecompressCode(ShaderModuleState* state);
+
+    /// Mark a module as recently used
+    /// \param state shader state
+    void TouchModule(ShaderModuleState* state);
+
+    /// Evict the least recently used modules until within budget
+    void EvictModules();
+
 private:
     DeviceDispatchTable* table{nullptr};
 
@@ -99,6 +131,7 @@ private:
     ComRef<Dispatcher> dispatcher;
     ComRef<ShaderCompilerDebug> debug;
     ComRef<ShaderExportDescriptorAllocator> shaderExportDescriptorAllocator;
+    ComRef<ShaderExportStreamAllocator> shaderExportStreamAllocator;
 
     /// All features
     std::vector<ComRef<IShaderFeature>> shaderFeatures;
@@ -108,4 +141,48 @@ private:
 
     /// Number of exports
     uint32_t exportCount{0};
+
+    /// Type info of all exports
+    std::vector<ShaderExportTypeInfo> exportTypeInfos;
+
+    /// Shader data of the per-SGUID export limits
+    ShaderDataID exportBudgetDataID{InvalidShaderDataID};
+
+    /// Retention lock
+    std::mutex retentionMutex;
+
+    /// All resident modules, most recently used first
+    ///    ! Does not hold references, states untrack themselves on destruction
+    std::list<ShaderModuleState*> retainedModules;
+
+    /// Estimated bytes of all resident modules
+    uint64_t retainedBytes{0};
+
+    /// Byte budget of all resident modules
+    uint64_t retentionBudget{256ull << 20};
+};
+
+/// Pins a shader module for the lifetime of the scope
+struct ShaderModuleScope {
+    ShaderModuleScope(ShaderCompiler* compiler, ShaderModuleState* state) : compiler(compiler), state(state) {
+        if (compiler && state) {
+            compiler->InitializeModule(state);
+        }
+    }
+
+    ~ShaderModuleScope() {
+        if (compiler && state) {
+            compiler->ReleaseModule(state);
+        }
+    }
+
+    /// No copy
+    ShaderModuleScope(const ShaderModuleScope&) = delete;
+    ShaderModuleScope& operator=(const ShaderModuleScope&) = delete;
+
+    /// Owning compiler
+    ShaderCompiler* compiler;
+
+    /// Pinned state
+    ShaderModuleState* state;
 };
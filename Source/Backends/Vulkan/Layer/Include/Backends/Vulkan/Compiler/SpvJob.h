@@ -33,6 +33,8 @@
 
 // Backend
 #include <Backend/Diagnostic/DiagnosticBucketScope.h>
+#include <Backend/ShaderExportTypeInfo.h>
+#include <Backend/ShaderData/ShaderData.h>
 
 /// Job description
 struct SpvJob {
@@ -45,6 +47,15 @@ struct SpvJob {
     /// Sets up PRMT data for user descriptor mapping
     bool requiresUserDescriptorMapping{true};
 
+    /// Type info of all exports, indexed by export identifier
+    const ShaderExportTypeInfo* exportTypeInfos{nullptr};
+
+    /// Shader data of the per-SGUID export limits, budgets are disabled if invalid
+    ShaderDataID exportBudgetDataID{InvalidShaderDataID};
+
+    /// Dword mask of persistent export rings, zero if streams are not rings
+    uint32_t exportRingMask{0};
+
     /// Diagnostic
     DiagnosticBucketScope<DiagnosticType, uint64_t> messages;
 };
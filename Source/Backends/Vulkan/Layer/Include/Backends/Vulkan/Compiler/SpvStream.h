@@ -93,6 +93,13 @@ struct SpvStream {
         return *reinterpret_cast<SpvInstruction*>(&stream[offset]);
     }
 
+    /// Template a span of source instructions
+    /// \param span the source word span
+    void TemplateSpan(const IL::SourceSpan& span) {
+        ASSERT(span.begin != IL::InvalidOffset && span.end != IL::InvalidOffset, "Cannot template span without source");
+        stream.insert(stream.end(), code + span.begin, code + span.end);
+    }
+
     /// Get an instruction
     /// \param source given source
     /// \return instruction
@@ -33,6 +33,7 @@
 #include <Backend/IL/Source.h>
 #include <Backend/IL/Type.h>
 #include <Backend/IL/Program.h>
+#include <Backend/ShaderExportTypeInfo.h>
 
 // Forward declarations
 struct SpvJob;
@@ -52,11 +53,21 @@ struct SpvUtilShaderExport {
     /// \param value the value to be exported
     void Export(SpvStream& stream, uint32_t exportID, const IL::ID* value, uint32_t count);
 
+    /// Compile the shared budget check, must be invoked after all functions
+    void CompileBudgetFunction();
+
     /// Copy to a new block
     /// \param remote the new block table
     /// \param out the destination shader export
     void CopyTo(SpvPhysicalBlockTable& remote, SpvUtilShaderExport& out);
 
+private:
+    /// Emit the budget check of an export
+    /// \param stream the current spirv stream
+    /// \param sguid the first exported dword, containing the sguid
+    /// \return the boolean identifier, true if within budget
+    uint32_t ExportBudget(SpvStream& stream, uint32_t sguid);
+
 private:
     /// Shared allocators
     Allocators allocators;
@@ -71,6 +82,18 @@ private:
     uint32_t counterId{0};
     uint32_t streamId{0};
 
+    /// Optional export budget, limits are read from the budget data buffer and
+    /// per-sguid report counts are placed past the stream counters
+    const ShaderExportTypeInfo* exportTypeInfos{nullptr};
+    const Backend::IL::Variable* budgetVariable{nullptr};
+    uint32_t budgetCounterOffset{0};
+
+    /// Shared budget check function, invalid if unused
+    uint32_t budgetFunctionId{IL::InvalidID};
+
+    /// Dword mask of persistent rings, zero if disabled
+    uint32_t ringMask{0};
+
     /// Type map
     const Backend::IL::Type *buffer32UIRWArrayPtr{nullptr};
     const Backend::IL::Type *buffer32UIRWPtr{nullptr};
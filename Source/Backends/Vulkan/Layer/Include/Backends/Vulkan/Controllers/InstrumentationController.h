@@ -54,6 +54,9 @@
 // Forward declarations
 class Registry;
 class Dispatcher;
+class IShaderExportAggregator;
+class ShaderExportBudgetHost;
+class ShaderExportStreamAllocator;
 struct DispatcherBucket;
 struct DeviceDispatchTable;
 struct MessageSubStream;
@@ -132,6 +135,9 @@ protected:
     /// \param stream the specialization stream
     void SetInstrumentationInfo(InstrumentationInfo& info, uint64_t bitSet, const MessageSubStream& stream);
 
+    /// Mark all shader modules and pipelines for re-instrumentation
+    void MarkAllDirty();
+
     /// Propagate instrumentation states
     /// \param state destination pipeline
     void PropagateInstrumentationInfo(PipelineState* state);
@@ -175,6 +181,9 @@ private:
     ComRef<ShaderCompiler> shaderCompiler;
     ComRef<PipelineCompiler> pipelineCompiler;
     ComRef<Dispatcher> dispatcher;
+    ComRef<IShaderExportAggregator> aggregator;
+    ComRef<ShaderExportBudgetHost> exportBudgetHost;
+    ComRef<ShaderExportStreamAllocator> streamAllocator;
 
 private:
     /// The global info
@@ -38,6 +38,7 @@
 
 // Common
 #include <Common/ComRef.h>
+#include <Common/Containers/AppendLog.h>
 
 // Schemas
 #include <Schemas/Versioning.h>
@@ -45,6 +46,11 @@
 // Std
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 
 // Forward declarations
 class IBridge;
@@ -94,6 +100,28 @@ public:
     void CollapseOnFork(VersionSegmentationPoint versionSegPoint);
 
 protected:
+    struct LogEntry {
+        /// Physical resource identifier
+        uint32_t puid{0};
+
+        /// Head at the time of the change, UINT32_MAX if destroyed
+        uint32_t version{0};
+
+        /// Interned name, zero if unnamed
+        uint32_t nameID{0};
+
+        /// Dimensions
+        uint32_t width{0};
+        uint32_t height{0};
+        uint32_t depth{0};
+
+        /// Static format string
+        const char* format{nullptr};
+
+        /// Originating object, used for unnamed fallbacks
+        const void* object{nullptr};
+    };
+
     /// Commit an image version
     /// \param view destination view
     /// \param state state to commit
@@ -104,18 +132,72 @@ protected:
     /// \param state state to commit
     void CommitBufferVersion(MessageStreamView<ResourceVersionMessage>& view, BufferState* state);
 
+    /// Commit a logged version
+    /// \param view destination view
+    /// \param entry entry to commit
+    /// \param versionID version to commit with
+    void CommitLogVersion(MessageStreamView<ResourceVersionMessage>& view, const LogEntry& entry, uint32_t versionID);
+
+    /// Append a change to the log
+    /// \param entry change
+    void Append(const LogEntry& entry);
+
+    /// Intern a name
+    /// \param name name to intern, may be null
+    /// \return name identifier
+    uint32_t InternName(const char* name);
+
+    /// Intern a name, name lock must be held
+    /// \param name name to intern
+    /// \return name identifier
+    uint32_t InternNameNoLock(const std::string_view& name);
+
+    /// Intern the name of a logged change, unnamed resources intern their fallback name, name lock must be held
+    /// \param entry logged change
+    /// \return name identifier
+    uint32_t InternEntryNameNoLock(const LogEntry& entry);
+
+    /// Push a full summarization of all resources
+    void Summarize();
+
+    /// Commit all readable log entries to the resource stream
+    void FlushLog();
+
 protected:
     /// Message handlers
     void OnMessage(const struct GetVersionSummarizationMessage& message);
+    void OnMessage(const struct GetVersionDeltaMessage& message);
 
 private:
+    /// Number of committed log entries retained for delta clients that have yet to acknowledge them,
+    /// older entries are released regardless, laggards are resynchronized with a full summary
+    static constexpr uint32_t kLogRetention = 1u << 16;
+
     DeviceDispatchTable* table;
 
     /// Current head
-    uint32_t head{0};
+    std::atomic<uint32_t> head{0};
 
     /// Pending commit and branching?
-    bool pendingCommit{false};
+    std::atomic<bool> pendingCommit{false};
+
+    /// All resource changes, the index serves as the log version
+    AppendLog<LogEntry> log;
+
+    /// Number of log entries committed to the resource stream
+    uint32_t flushedLogCount{0};
+
+    /// Highest log version acknowledged by a delta request
+    uint32_t acknowledgedLogVersion{0};
+
+    /// All interned names, indexed by identifier
+    std::deque<std::string> names;
+
+    /// Name to identifier lookup
+    std::unordered_map<std::string_view, uint32_t> nameLookup;
+
+    /// Interning lock
+    std::mutex nameMutex;
     
     /// Owning bridge, stored as naked pointer for referencing reasons
     IBridge* bridge{nullptr};
@@ -67,6 +67,18 @@ struct ShaderExportSegmentCounterInfo {
 
     /// Counter allocation
     MirrorAllocation allocation;
+
+    /// Number of device counters, the per-SGUID budget counters succeed the stream counters
+    uint64_t deviceCounterCount{0};
+};
+
+/// Host copy of all ring heads, taken at the end of a submission
+struct ShaderExportRingSnapshotInfo {
+    /// Descriptor object
+    VkBuffer buffer{VK_NULL_HANDLE};
+
+    /// Host allocation
+    Allocation allocation;
 };
 
 /// A single allocation, partitioning is up to the allocation modes
@@ -79,4 +91,10 @@ struct ShaderExportSegmentInfo {
 
     /// Does this segment require initialization?
     bool pendingInitialization{true};
+
+    /// Is this a persistent ring? If so, the counters are monotonic heads and never cleared
+    bool persistent{false};
+
+    /// Ring only, host consumed tail for each stream, in dwords
+    std::vector<uint32_t> tails;
 };
@@ -35,4 +35,7 @@ enum class ShaderExportAllocationMode : uint8_t {
 
     /// Allocate stream data for all command buffers, cyclic buffer
     GlobalCyclicBufferNoOverwrite,
+
+    /// Persistent per-queue ring, shaders append at a device head and the host consumes up to it
+    PersistentRing,
 };
@@ -0,0 +1,47 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Std
+#include <cstdint>
+#include <chrono>
+
+/// Maximum number of submissions sharing a single segment, bounds the non ring streams
+static constexpr uint32_t kShaderExportMaxCoalescedSubmissions = 8u;
+
+/// Maximum age of an open segment, bounds the latency of applications that never
+/// wait on the queue or device, e.g. synchronizing through semaphores or earlier fences
+static constexpr std::chrono::milliseconds kShaderExportMaxCoalescedAge{16};
+
+/// Check if an open segment has expired, expired segments cannot take further submissions and must be closed
+/// \param submissionCount number of submissions sharing the segment
+/// \param age time since the segment was opened
+/// \return true if expired
+inline bool IsCoalescedSegmentExpired(uint32_t submissionCount, std::chrono::high_resolution_clock::duration age) {
+    return submissionCount >= kShaderExportMaxCoalescedSubmissions || age >= kShaderExportMaxCoalescedAge;
+}
@@ -0,0 +1,84 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Std
+#include <cstdint>
+#include <algorithm>
+
+/// Consumable window of a single ring stream
+struct ShaderExportRingWindow {
+    /// Dword offset of the first consumed dword within the ring
+    uint32_t offset{0};
+
+    /// Number of consumed dwords
+    uint32_t count{0};
+
+    /// Number of dwords before the ring wraps, at most [count]
+    uint32_t upperCount{0};
+
+    /// Number of leading dwords of the window overwritten by the device, at most [count]
+    uint32_t overwrittenCount{0};
+
+    /// Has the device written past the window? If so, the leading [overwrittenCount] dwords are no longer consistent
+    bool overtaken{false};
+};
+
+/// Get the consumable window of a ring stream
+/// \param tail the host consumed tail, in dwords
+/// \param head the head of the segment being consumed, in dwords
+/// \param latestHead the most recent head allocated by any submission, in dwords
+/// \param capacity number of dwords in the ring, must be a power of two
+/// \return the window
+inline ShaderExportRingWindow GetShaderExportRingWindow(uint32_t tail, uint32_t head, uint32_t latestHead, uint32_t capacity) {
+    ShaderExportRingWindow window;
+
+    // Heads are monotonic and wrap naturally
+    window.count = head - tail;
+    window.offset = tail & (capacity - 1);
+
+    // Stale latest heads never precede the consumed head
+    if (static_cast<int32_t>(latestHead - head) < 0) {
+        latestHead = head;
+    }
+
+    // Any write at or past [tail + capacity] has overwritten the window, front to back
+    window.overtaken = (latestHead - tail) > capacity;
+    if (window.overtaken) {
+        window.overwrittenCount = std::min(latestHead - tail - capacity, window.count);
+    }
+
+    // Split at the wrap
+    window.upperCount = capacity - window.offset;
+    if (window.upperCount > window.count) {
+        window.upperCount = window.count;
+    }
+
+    // OK
+    return window;
+}
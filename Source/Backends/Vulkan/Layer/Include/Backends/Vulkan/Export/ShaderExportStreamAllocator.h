@@ -36,6 +36,7 @@
 #include <Backend/ShaderExportTypeInfo.h>
 
 // Layer
+#include <Backends/Vulkan/Allocation/Residency.h>
 #include <Backends/Vulkan/VMA.h>
 #include "ShaderExportAllocationMode.h"
 #include "ShaderExportStream.h"
@@ -43,6 +44,7 @@
 
 // Std
 #include <vector>
+#include <mutex>
 
 // Forward declarations
 struct CommandBufferObject;
@@ -73,6 +75,33 @@ public:
     /// \param size the byte size of the new stream
     void SetStreamSize(ShaderExportID id, uint64_t size);
 
+    /// Set the persistent ring mode
+    ///   ! Only valid until the allocation mode has been latched
+    /// \param dwordCount number of dwords per ring stream, rounded up to a power of two, zero disables the ring
+    /// \return false if the mode has already been latched
+    bool SetRingMode(uint32_t dwordCount);
+
+    /// Latch the allocation mode, after which it may no longer change
+    /// \return the dword mask of all ring streams, zero if the ring is disabled
+    uint32_t LatchRingMask();
+
+    /// Check if the allocation mode is the persistent ring
+    bool IsPersistentRing() const {
+        return allocationMode == ShaderExportAllocationMode::PersistentRing;
+    }
+
+    /// Allocate a new persistent ring
+    /// \return the ring, lifetime bound to the allocator
+    ShaderExportSegmentInfo* AllocateRing();
+
+    /// Allocate a new ring head snapshot
+    /// \return the snapshot
+    ShaderExportRingSnapshotInfo AllocateRingSnapshot();
+
+    /// Free a ring head snapshot
+    /// \param snapshot the snapshot to be free'd
+    void FreeRingSnapshot(const ShaderExportRingSnapshotInfo& snapshot);
+
 private:
     /// Allocate a new stream
     /// \param id the export id
@@ -80,8 +109,18 @@ private:
     ShaderExportStreamInfo AllocateStreamInfo(const ShaderExportID& id);
 
     /// Allocate a new counter
+    /// \param residency residency of the counters, only device resident counters are pooled
     /// \return counter info
-    ShaderExportSegmentCounterInfo AllocateCounterInfo();
+    ShaderExportSegmentCounterInfo AllocateCounterInfo(AllocationResidency residency = AllocationResidency::Device);
+
+    /// Allocate a new ring stream
+    /// \param id the export id
+    /// \return stream info
+    ShaderExportStreamInfo AllocateRingStreamInfo(const ShaderExportID& id);
+
+    /// Release a segment allocation
+    /// \param segment the segment to release
+    void ReleaseSegment(ShaderExportSegmentInfo* segment);
 
 private:
     struct ExportInfo {
@@ -99,12 +138,28 @@ private:
     ObjectPool<ShaderExportSegmentInfo> segmentPool;
     TrivialObjectPool<ShaderExportSegmentCounterInfo> counterPool;
     TrivialObjectPool<ShaderExportStreamInfo> streamPool;
+    TrivialObjectPool<ShaderExportRingSnapshotInfo> ringSnapshotPool;
+
+    /// All persistent rings
+    std::vector<ShaderExportSegmentInfo*> rings;
+
+    /// All ring snapshots
+    std::vector<ShaderExportRingSnapshotInfo> ringSnapshots;
 
     /// Initial allocation size for all streams
     uint64_t baseDataSize = 10'000;
 
     ShaderExportAllocationMode allocationMode{ShaderExportAllocationMode::GlobalCyclicBufferNoOverwrite};
 
+    /// Number of dwords per ring stream, always a power of two
+    uint32_t ringDWordCount{0};
+
+    /// Has the allocation mode been latched?
+    bool allocationModeLatched{false};
+
+    /// Shared lock
+    std::mutex mutex;
+
 private:
     DeviceDispatchTable* table;
 };
@@ -39,14 +39,21 @@
 #include <Common/Containers/ObjectPool.h>
 #include <Common/Containers/TrivialObjectPool.h>
 #include <Common/Containers/TrivialStackVector.h>
+#include <Common/Containers/LockFreeQueue.h>
 
 // Std
 #include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
 
 // Forward declarations
 class ShaderExportDescriptorAllocator;
 class ShaderExportStreamAllocator;
 class DeviceAllocator;
+class IShaderExportAggregator;
+class IMessageStorage;
+class Dispatcher;
 struct PhysicalResourceMappingTableQueueState;
 struct DeviceDispatchTable;
 struct PipelineState;
@@ -76,8 +83,9 @@ public:
     ShaderExportStreamState* AllocateStreamState();
 
     /// Allocate a new submission segment
+    /// \param queue the queue to be submitted on
     /// \return the segment
-    ShaderExportStreamSegment* AllocateSegment();
+    ShaderExportStreamSegment* AllocateSegment(ShaderExportQueueState* queue);
 
     /// Free a stream state
     /// \param state the state
@@ -94,6 +102,12 @@ public:
     /// \param prmtState prmt state
     VkCommandBuffer RecordPreCommandBuffer(ShaderExportQueueState* queueState, ShaderExportStreamSegment* state, PhysicalResourceMappingTableQueueState* prmtState);
 
+    /// Begin an additional command buffer for a submission coalesced into an existing segment
+    /// \param queueState the queue to record for
+    /// \param state the segment state, owns the command buffer
+    /// \return command buffer to be submitted
+    VkCommandBuffer BeginCoalescedCommandBuffer(ShaderExportQueueState* queueState, ShaderExportStreamSegment* state);
+
     /// Record a patch command buffer for submissions
     /// \param queueState the queue to record for
     /// \param state the segment state
@@ -103,8 +117,9 @@ public:
     /// Enqueue a submitted segment
     /// \param queue the queue state that was submitted on
     /// \param segment the submitted segment
-    /// \param fence shared submission fence, must be valid
-    void Enqueue(ShaderExportQueueState* queue, ShaderExportStreamSegment* segment, FenceState* fence);
+    /// \param fence shared submission fence, must be valid if not timeline tracked
+    /// \param timelineValue queue timeline value signalled on completion, zero if fence tracked
+    void Enqueue(ShaderExportQueueState* queue, ShaderExportStreamSegment* segment, FenceState* fence, uint64_t timelineValue = 0);
 
 public:
     /// Invoked during command buffer recording
@@ -182,13 +197,20 @@ public:
     void BindShaderExport(ShaderExportStreamState* state, const PipelineState* pipeline, VkCommandBuffer commandBuffer);
 
 public:
-    /// Whole device sync point
+    /// Whole device sync point, retires all completed segments
+    ///   Retired segments are processed on the export worker, never on the calling thread
     void Process();
 
-    /// Queue specific sync point
+    /// Queue specific sync point, retires all completed segments of the queue
     /// \param queueState the queue state
     void Process(ShaderExportQueueState* queueState);
 
+    /// Stop the export worker and process all remaining completed segments on the calling thread
+    void Drain();
+
+    /// Flush all pending aggregates, regardless of their window
+    void FlushAggregates();
+
 private:
     /// Migrate the descriptor environment to a new pipeline state
     /// \param state the stream state
@@ -196,12 +218,59 @@ private:
     /// \param commandBuffer the command buffer
     void MigrateDescriptorEnvironment(ShaderExportStreamState* state, const PipelineState* pipeline, VkCommandBuffer commandBuffer);
 
-    /// Process all segments within a queue
+    /// Hand off all completed segments within a queue to the export worker
     /// \param queue the queue state
-    void ProcessSegmentsNoQueueLock(ShaderExportQueueState* queue, TrivialStackVector<CommandContextHandle, 32u>& completedHandles);
-
-    /// Process a segment
-    bool ProcessSegment(ShaderExportStreamSegment* segment, TrivialStackVector<CommandContextHandle, 32u>& completedHandles);
+    void RetireSegmentsNoQueueLock(ShaderExportQueueState* queue);
+
+    /// Check if a segment has completed on the device
+    /// \param segment the segment to check
+    /// \param completedTimelineValue last completed value of the queue timeline
+    /// \return true if completed
+    bool IsSegmentCompleted(ShaderExportStreamSegment* segment, uint64_t completedTimelineValue);
+
+    /// Process and recycle all retired segments
+    /// \return number of processed segments
+    uint32_t ProcessRetiredSegments();
+
+    /// Process a completed segment
+    /// \param segment the segment to process
+    /// \param completedHandles appended context handles of the segment
+    void ProcessSegment(ShaderExportStreamSegment* segment, TrivialStackVector<CommandContextHandle, 32u>& completedHandles);
+
+    /// Export worker entry point
+    void WorkerEntry();
+
+    /// Stop the export worker, if running
+    void StopWorker();
+
+    /// Map the produced data of all streams in a segment
+    /// \param segment the segment to map
+    /// \param views destination views, one per stream
+    void MapStreams(ShaderExportStreamSegment* segment, TrivialStackVector<ShaderExportStreamView, 32u>& views);
+
+    /// Map the produced data of all streams in a persistent ring, advances the ring tails
+    /// \param segment the segment to map
+    /// \param views destination views, one per stream
+    void MapRingStreams(ShaderExportStreamSegment* segment, TrivialStackVector<ShaderExportStreamView, 32u>& views);
+
+    /// Unmap all streams in a segment
+    /// \param segment the segment to unmap
+    /// \param views all mapped views
+    void UnmapStreams(ShaderExportStreamSegment* segment, const TrivialStackVector<ShaderExportStreamView, 32u>& views);
+
+    /// Aggregate all streams of a segment
+    /// \param segment the segment to aggregate
+    /// \param views the mapped stream views
+    /// \param output the storage to flush to
+    void AggregateSegment(ShaderExportStreamSegment* segment, const TrivialStackVector<ShaderExportStreamView, 32u>& views, IMessageStorage* output);
+
+    /// Flush all expired aggregates
+    /// \param force if true, flushes all aggregates regardless of their window
+    void FlushExpiredAggregates(bool force);
+
+    /// Aggregation worker entry point
+    /// \param data the aggregation job
+    void AggregateJob(void* data);
 
     /// Free a segment
     void FreeSegmentNoQueueLock(ShaderExportQueueState* queue, ShaderExportStreamSegment* segment);
@@ -231,6 +300,40 @@ private:
     ComRef<ShaderExportDescriptorAllocator> descriptorAllocator{nullptr};
     ComRef<ShaderExportStreamAllocator> streamAllocator{nullptr};
     ComRef<IBridge> bridge{nullptr};
+    ComRef<IShaderExportAggregator> aggregator{nullptr};
+
+    /// Dedicated aggregation workers, created on first use
+    /// ! Not shared with the instrumentation dispatcher, as it may be paused
+    ComRef<Dispatcher> aggregationDispatcher{nullptr};
+
+    /// Linearized ring data for streams that wrap, one per stream
+    std::vector<std::vector<uint32_t>> ringScratch;
+
+    /// Completed segment pending processing
+    struct ShaderExportRetiredSegment {
+        /// Queue the segment was submitted on
+        ShaderExportQueueState* queue{nullptr};
+
+        /// The completed segment
+        ShaderExportStreamSegment* segment{nullptr};
+    };
+
+    /// Maximum number of retired segments in flight to the worker
+    static constexpr uint32_t kRetiredSegmentCapacity = 1024u;
+
+    /// Completed segments, handed off to the worker
+    LockFreeQueue<ShaderExportRetiredSegment> retiredSegments;
+
+    /// Serializes segment processing and aggregation, never acquired by submission paths
+    std::mutex processMutex;
+
+    /// Dedicated export worker
+    std::thread worker;
+
+    /// Worker wake state
+    std::mutex workerWakeMutex;
+    std::condition_variable workerWake;
+    std::atomic<bool> workerExit{false};
 
     /// Does the device require push state tracking?
     bool requiresPushStateTracking{false};
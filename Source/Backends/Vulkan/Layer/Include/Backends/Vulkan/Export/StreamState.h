@@ -33,6 +33,7 @@
 #include <Backends/Vulkan/Resource/DescriptorDataSegment.h>
 #include <Backends/Vulkan/Controllers/Versioning.h>
 #include <Backends/Vulkan/ShaderData/ConstantShaderDataBuffer.h>
+#include <Backends/Vulkan/Export/SegmentInfo.h>
 
 // Backend
 #include <Backend/CommandContextHandle.h>
@@ -43,9 +44,10 @@
 
 // Std
 #include <vector>
+#include <mutex>
+#include <chrono>
 
 // Forward declarations
-struct ShaderExportSegmentInfo;
 struct PushDescriptorSegment;
 struct FenceState;
 class DescriptorDataAppendAllocator;
@@ -146,9 +148,12 @@ struct ShaderExportStreamSegmentUserContext {
 
 /// Single stream segment, i.e. submission
 struct ShaderExportStreamSegment {
-    /// Allocation for this segment
+    /// Allocation for this segment, shared with the queue if persistent
     ShaderExportSegmentInfo* allocation{nullptr};
 
+    /// Ring heads at the end of this segment, persistent allocations only
+    ShaderExportRingSnapshotInfo ringSnapshot{};
+
     /// Shared fence for this segment
     FenceState* fence{nullptr};
 
@@ -159,6 +164,15 @@ struct ShaderExportStreamSegment {
     /// The next fence commit id to be waited for
     uint64_t fenceNextCommitId{0};
 
+    /// Queue timeline value signalled on completion, zero if tracked by the fence
+    uint64_t timelineValue{0};
+
+    /// Number of submissions sharing this segment
+    uint32_t submissionCount{0};
+
+    /// Additional user command buffers of coalesced submissions
+    std::vector<VkCommandBuffer> coalescedCommandBuffers;
+
     /// Combined context handles
     std::vector<CommandContextHandle> commandContextHandles;
 
@@ -179,4 +193,28 @@ struct ShaderExportQueueState {
 
     /// All submitted segments
     std::vector<ShaderExportStreamSegment*> liveSegments;
+
+    /// Persistent ring of this queue, allocated on first use
+    ShaderExportSegmentInfo* ring{nullptr};
+
+    /// Submitted segment still open for coalescing, not yet enqueued
+    ShaderExportStreamSegment* openSegment{nullptr};
+
+    /// Time at which the open segment was opened
+    std::chrono::high_resolution_clock::time_point openSegmentTimeStamp;
+
+    /// Guards the open segment, held for the entire submission as stale segments may be closed from any thread
+    std::mutex openSegmentMutex;
+};
+
+/// Produced data of a single stream
+struct ShaderExportStreamView {
+    /// Produced data, valid until the segment is released
+    const void* data{nullptr};
+
+    /// Byte size of the produced data
+    size_t size{0};
+
+    /// Was the stream mapped?
+    bool mapped{false};
 };
@@ -60,31 +60,31 @@ struct FeatureHook_vkCmdDrawMeshTasksEXT : TFeatureHook<Hooks::DispatchMesh> {
     }
 };
 
-struct FeatureHook_vkCmdCopyBuffer : TFeatureHook<Hooks::CopyResource> {
+struct FeatureHook_vkCmdCopyBuffer : TFeatureSpanHook<Hooks::CopyResource, Hooks::CopyResources> {
     void operator()(CommandBufferObject* object, CommandContext* context, VkBuffer srcBuffer, VkBuffer dstBuffer, uint32_t regionCount, const VkBufferCopy* pRegions) const;
 };
 
-struct FeatureHook_vkCmdCopyImage : TFeatureHook<Hooks::CopyResource> {
+struct FeatureHook_vkCmdCopyImage : TFeatureSpanHook<Hooks::CopyResource, Hooks::CopyResources> {
     void operator()(CommandBufferObject *object, CommandContext *context, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageCopy* pRegions) const;
 };
 
-struct FeatureHook_vkCmdBlitImage : TFeatureHook<Hooks::CopyResource> {
+struct FeatureHook_vkCmdBlitImage : TFeatureSpanHook<Hooks::CopyResource, Hooks::CopyResources> {
     void operator()(CommandBufferObject *object, CommandContext *context, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageBlit* pRegions, VkFilter filter) const;
 };
 
-struct FeatureHook_vkCmdCopyBufferToImage : TFeatureHook<Hooks::CopyResource> {
+struct FeatureHook_vkCmdCopyBufferToImage : TFeatureSpanHook<Hooks::CopyResource, Hooks::CopyResources> {
     void operator()(CommandBufferObject *object, CommandContext *context, VkBuffer srcBuffer, VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount, const VkBufferImageCopy* pRegions) const;
 };
 
-struct FeatureHook_vkCmdCopyBufferToImage2 : TFeatureHook<Hooks::CopyResource> {
+struct FeatureHook_vkCmdCopyBufferToImage2 : TFeatureSpanHook<Hooks::CopyResource, Hooks::CopyResources> {
     void operator()(CommandBufferObject *object, CommandContext *context, const VkCopyBufferToImageInfo2* pCopyBufferToImageInfo) const;
 };
 
-struct FeatureHook_vkCmdCopyImageToBuffer : TFeatureHook<Hooks::CopyResource> {
+struct FeatureHook_vkCmdCopyImageToBuffer : TFeatureSpanHook<Hooks::CopyResource, Hooks::CopyResources> {
     void operator()(CommandBufferObject *object, CommandContext *context, VkImage srcImage, VkImageLayout srcImageLayout, VkBuffer dstBuffer, uint32_t regionCount, const VkBufferImageCopy* pRegions) const;
 };
 
-struct FeatureHook_vkCmdCopyImageToBuffer2 : TFeatureHook<Hooks::CopyResource> {
+struct FeatureHook_vkCmdCopyImageToBuffer2 : TFeatureSpanHook<Hooks::CopyResource, Hooks::CopyResources> {
     void operator()(CommandBufferObject *object, CommandContext *context, const VkCopyImageToBufferInfo2* pCopyImageToBufferInfo) const;
 };
 
@@ -96,19 +96,19 @@ struct FeatureHook_vkCmdFillBuffer : TFeatureHook<Hooks::WriteResource> {
     void operator()(CommandBufferObject *object, CommandContext *context, VkBuffer dstBuffer, VkDeviceSize dstOffset, VkDeviceSize size, uint32_t data) const;
 };
 
-struct FeatureHook_vkCmdClearColorImage : TFeatureHook<Hooks::ClearResource> {
+struct FeatureHook_vkCmdClearColorImage : TFeatureSpanHook<Hooks::ClearResource, Hooks::ClearResources> {
     void operator()(CommandBufferObject *object, CommandContext *context, VkImage image, VkImageLayout imageLayout, const VkClearColorValue* pColor, uint32_t rangeCount, const VkImageSubresourceRange* pRanges) const;
 };
 
-struct FeatureHook_vkCmdClearDepthStencilImage : TFeatureHook<Hooks::ClearResource> {
+struct FeatureHook_vkCmdClearDepthStencilImage : TFeatureSpanHook<Hooks::ClearResource, Hooks::ClearResources> {
     void operator()(CommandBufferObject *object, CommandContext *context, VkImage image, VkImageLayout imageLayout, const VkClearDepthStencilValue* pDepthStencil, uint32_t rangeCount, const VkImageSubresourceRange* pRanges) const;
 };
 
-struct FeatureHook_vkCmdClearAttachments : TFeatureHook<Hooks::ClearResource> {
+struct FeatureHook_vkCmdClearAttachments : TFeatureSpanHook<Hooks::ClearResource, Hooks::ClearResources> {
     void operator()(CommandBufferObject *object, CommandContext *context, uint32_t attachmentCount, const VkClearAttachment* pAttachments, uint32_t rectCount, const VkClearRect* pRects) const;
 };
 
-struct FeatureHook_vkCmdResolveImage : TFeatureHook<Hooks::ResolveResource> {
+struct FeatureHook_vkCmdResolveImage : TFeatureSpanHook<Hooks::ResolveResource, Hooks::ResolveResources> {
     void operator()(CommandBufferObject *object, CommandContext *context, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageResolve* pRegions) const;
 };
 
@@ -31,6 +31,7 @@
 
 // Forward declarations
 struct DeviceDispatchTable;
+struct QueueState;
 
 // Create a queue state
 void CreateQueueState(DeviceDispatchTable* table, VkQueue queue, uint32_t familyIndex);
@@ -41,11 +42,27 @@ bool IsFamilyEmulated(DeviceDispatchTable* table, uint32_t familyIndex);
 /// Redirect a queue family if it's emulated
 uint32_t RedirectQueueFamily(DeviceDispatchTable* table, uint32_t familyIndex);
 
+/// Submit the post patching of a queue's open segment, if any
+/// \param table device table
+/// \param queueState queue to close
+/// \return result of the submission
+VkResult CloseOpenSegment(DeviceDispatchTable* table, QueueState* queueState);
+
+/// Submit the post patching of all open segments
+/// \param table device table
+void CloseOpenSegments(DeviceDispatchTable* table);
+
+/// Submit the post patching of all expired open segments
+/// \param table device table
+void CloseExpiredSegments(DeviceDispatchTable* table);
+
 // Hooks
 VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueuePresentKHR(VkQueue queue, const VkPresentInfoKHR* pPresentInfo);
 VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo *pSubmits, VkFence fence);
 VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit2(VkQueue queue, uint32_t submitCount, const VkSubmitInfo2 *pSubmits, VkFence fence);
 VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueWaitIdle(VkQueue queue);
 VKAPI_ATTR VkResult VKAPI_CALL Hook_vkDeviceWaitIdle(VkDevice device);
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkWaitSemaphores(VkDevice device, const VkSemaphoreWaitInfo* pWaitInfo, uint64_t timeout);
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkWaitSemaphoresKHR(VkDevice device, const VkSemaphoreWaitInfo* pWaitInfo, uint64_t timeout);
 VKAPI_ATTR void     VKAPI_CALL Hook_vkGetDeviceQueue(VkDevice device, uint32_t queueFamilyIndex, uint32_t queueIndex, VkQueue* pQueue);
 VKAPI_ATTR void     VKAPI_CALL Hook_vkGetDeviceQueue2(VkDevice device, const VkDeviceQueueInfo2* pQueueInfo, VkQueue* pQueue);
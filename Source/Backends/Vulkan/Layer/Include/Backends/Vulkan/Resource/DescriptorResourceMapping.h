@@ -36,11 +36,39 @@
 // Backend
 #include <Backend/IL/ResourceTokenType.h>
 
-/// Get the virtual resource mapping
+// Std
+#include <mutex>
+
+/// Acquire the state lock guarding all handles of a descriptor type
+/// \param table parent table
+/// \param type descriptor type
+/// \return lock, empty if the type does not reference tracked states
+static std::unique_lock<std::mutex> LockVirtualResourceStates(DeviceDispatchTable* table, VkDescriptorType type) {
+    switch (type) {
+        default:
+            return {};
+        case VK_DESCRIPTOR_TYPE_SAMPLER:
+            return std::unique_lock(table->states_sampler.GetLock());
+        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            return std::unique_lock(table->states_imageView.GetLock());
+        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+            return std::unique_lock(table->states_bufferView.GetLock());
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+            return std::unique_lock(table->states_buffer.GetLock());
+    }
+}
+
+/// Get the virtual resource mapping, the type state lock must be held
 /// \param table parent table
 /// \param type descriptor type
 /// \param info descriptor type
-static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* table, VkDescriptorType type, const VkDescriptorImageInfo& info) {
+static VirtualResourceMapping GetVirtualResourceMappingNoLock(DeviceDispatchTable* table, VkDescriptorType type, const VkDescriptorImageInfo& info) {
     VirtualResourceMapping mapping{};
 
     // Handle type
@@ -51,7 +79,7 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
         }
         case VK_DESCRIPTOR_TYPE_SAMPLER: {
             if (info.sampler) {
-                mapping = table->states_sampler.Get(info.sampler)->virtualMapping;
+                mapping = table->states_sampler.GetNoLock(info.sampler)->virtualMapping;
             } else if (table->physicalDeviceRobustness2Features.nullDescriptor) {
                 mapping.token.puid = IL::kResourceTokenPUIDReservedNullSampler;
                 mapping.token.type = static_cast<uint32_t>(Backend::IL::ResourceTokenType::Sampler);
@@ -60,7 +88,7 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
         }
         case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER: {
             if (info.imageView) {
-                mapping = table->states_imageView.Get(info.imageView)->virtualMapping;
+                mapping = table->states_imageView.GetNoLock(info.imageView)->virtualMapping;
             } else if (table->physicalDeviceRobustness2Features.nullDescriptor) {
                 mapping.token.puid = IL::kResourceTokenPUIDReservedNullTexture;
                 mapping.token.type = static_cast<uint32_t>(Backend::IL::ResourceTokenType::Texture);
@@ -70,7 +98,7 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
         case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
         case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE: {
             if (info.imageView) {
-                mapping = table->states_imageView.Get(info.imageView)->virtualMapping;
+                mapping = table->states_imageView.GetNoLock(info.imageView)->virtualMapping;
             } else if (table->physicalDeviceRobustness2Features.nullDescriptor) {
                 mapping.token.puid = IL::kResourceTokenPUIDReservedNullTexture;
                 mapping.token.type = static_cast<uint32_t>(Backend::IL::ResourceTokenType::Texture);
@@ -83,11 +111,11 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
     return mapping;
 }
 
-/// Get the virtual resource mapping
+/// Get the virtual resource mapping, the type state lock must be held
 /// \param table parent table
 /// \param type descriptor type
 /// \param info descriptor type
-static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* table, VkDescriptorType type, VkBufferView info) {
+static VirtualResourceMapping GetVirtualResourceMappingNoLock(DeviceDispatchTable* table, VkDescriptorType type, VkBufferView info) {
     VirtualResourceMapping mapping{};
     
     // Handle type
@@ -99,7 +127,7 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
         case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
         case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER: {
             if (info) {
-                mapping = table->states_bufferView.Get(info)->virtualMapping;
+                mapping = table->states_bufferView.GetNoLock(info)->virtualMapping;
             } else if (table->physicalDeviceRobustness2Features.nullDescriptor) {
                 mapping.token.puid = IL::kResourceTokenPUIDReservedNullBuffer;
                 mapping.token.type = static_cast<uint32_t>(Backend::IL::ResourceTokenType::Buffer);
@@ -112,11 +140,11 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
     return mapping;
 }
 
-/// Get the virtual resource mapping
+/// Get the virtual resource mapping, the type state lock must be held
 /// \param table parent table
 /// \param type descriptor type
 /// \param info descriptor type
-static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* table, VkDescriptorType type, VkDescriptorBufferInfo info) {
+static VirtualResourceMapping GetVirtualResourceMappingNoLock(DeviceDispatchTable* table, VkDescriptorType type, VkDescriptorBufferInfo info) {
     VirtualResourceMapping mapping{};
     
     // Handle type
@@ -130,7 +158,7 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
         case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
         case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC: {
             if (info.buffer) {
-                mapping = table->states_buffer.Get(info.buffer)->virtualMapping;
+                mapping = table->states_buffer.GetNoLock(info.buffer)->virtualMapping;
             } else if (table->physicalDeviceRobustness2Features.nullDescriptor) {
                 mapping.token.puid = IL::kResourceTokenPUIDReservedNullCBuffer;
                 mapping.token.type = static_cast<uint32_t>(Backend::IL::ResourceTokenType::CBuffer);
@@ -143,11 +171,11 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
     return mapping;
 }
 
-/// Get the virtual resource mapping
+/// Get the virtual resource mapping, the type state lock must be held
 /// \param table parent table
 /// \param write the write information
 /// \param descriptorIndex the current index to fill
-static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* table, const VkWriteDescriptorSet& write, uint32_t descriptorIndex) {
+static VirtualResourceMapping GetVirtualResourceMappingNoLock(DeviceDispatchTable* table, const VkWriteDescriptorSet& write, uint32_t descriptorIndex) {
     // Default invalid mapping
     VirtualResourceMapping mapping{};
     mapping.token.puid = IL::kResourceTokenPUIDMask;
@@ -162,13 +190,13 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
         case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
         case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
         case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:  {
-            mapping = GetVirtualResourceMapping(table, write.descriptorType, write.pImageInfo[descriptorIndex]);
+            mapping = GetVirtualResourceMappingNoLock(table, write.descriptorType, write.pImageInfo[descriptorIndex]);
             break;
         }
         case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
         case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER: {
             if (write.pTexelBufferView[descriptorIndex]) {
-                mapping = table->states_bufferView.Get(write.pTexelBufferView[descriptorIndex])->virtualMapping;
+                mapping = table->states_bufferView.GetNoLock(write.pTexelBufferView[descriptorIndex])->virtualMapping;
             } else if (table->physicalDeviceRobustness2Features.nullDescriptor) {
                 mapping.token.puid = IL::kResourceTokenPUIDReservedNullBuffer;
                 mapping.token.type = static_cast<uint32_t>(Backend::IL::ResourceTokenType::Buffer);
@@ -180,7 +208,7 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
         case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
         case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC: {
             if (write.pBufferInfo[descriptorIndex].buffer) {
-                mapping = table->states_buffer.Get(write.pBufferInfo[descriptorIndex].buffer)->virtualMapping;
+                mapping = table->states_buffer.GetNoLock(write.pBufferInfo[descriptorIndex].buffer)->virtualMapping;
             } else if (table->physicalDeviceRobustness2Features.nullDescriptor) {
                 mapping.token.puid = IL::kResourceTokenPUIDReservedNullCBuffer;
                 mapping.token.type = static_cast<uint32_t>(Backend::IL::ResourceTokenType::CBuffer);
@@ -193,11 +221,11 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
     return mapping;
 }
 
-/// Get the virtual resource mapping
+/// Get the virtual resource mapping, the type state lock must be held
 /// \param table parent table
 /// \param descriptorType the descriptor type
 /// \param descriptorData opaque data, must be for the type
-static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* table, VkDescriptorType descriptorType, const void* descriptorData) {
+static VirtualResourceMapping GetVirtualResourceMappingNoLock(DeviceDispatchTable* table, VkDescriptorType descriptorType, const void* descriptorData) {
     // Default invalid mapping
     VirtualResourceMapping mapping{};
     mapping.token.puid = IL::kResourceTokenPUIDMask;
@@ -213,13 +241,13 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
         case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
         case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE: {
             auto&& typeData = *static_cast<const VkDescriptorImageInfo*>(descriptorData);
-            mapping = GetVirtualResourceMapping(table, descriptorType, typeData);
+            mapping = GetVirtualResourceMappingNoLock(table, descriptorType, typeData);
             break;
         }
         case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
         case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER: {
             auto&& typeData = *static_cast<const VkBufferView*>(descriptorData);
-            mapping = GetVirtualResourceMapping(table, descriptorType, typeData);
+            mapping = GetVirtualResourceMappingNoLock(table, descriptorType, typeData);
             break;
         }
         case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
@@ -227,7 +255,7 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
         case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
         case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC: {
             auto&& typeData = *static_cast<const VkDescriptorBufferInfo*>(descriptorData);
-            mapping = GetVirtualResourceMapping(table, descriptorType, typeData);
+            mapping = GetVirtualResourceMappingNoLock(table, descriptorType, typeData);
             break;
         }
     }
@@ -236,3 +264,16 @@ static VirtualResourceMapping GetVirtualResourceMapping(DeviceDispatchTable* tab
     return mapping;
 }
 
+/// Get the virtual resource mappings of all descriptors in a write
+/// \param table parent table
+/// \param write the write information
+/// \param mappings destination mappings, length of descriptorCount
+static void GetVirtualResourceMappings(DeviceDispatchTable* table, const VkWriteDescriptorSet& write, VirtualResourceMapping* mappings) {
+    // All descriptors of a write share the same type, resolve under a single lock
+    std::unique_lock lock = LockVirtualResourceStates(table, write.descriptorType);
+
+    // Resolve all descriptors
+    for (uint32_t descriptorIndex = 0; descriptorIndex < write.descriptorCount; descriptorIndex++) {
+        mappings[descriptorIndex] = GetVirtualResourceMappingNoLock(table, write, descriptorIndex);
+    }
+}
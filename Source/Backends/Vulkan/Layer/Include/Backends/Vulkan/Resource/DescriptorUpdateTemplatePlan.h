@@ -0,0 +1,101 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Layer
+#include <Backends/Vulkan/Vulkan.h>
+#include <Backends/Vulkan/Resource/VirtualResourceMapping.h>
+#include <Backends/Vulkan/Resource/PhysicalResourceSegment.h>
+
+// Std
+#include <vector>
+
+// Forward declarations
+struct DeviceDispatchTable;
+struct DescriptorLayoutPhysicalMapping;
+
+/// Decodes a strided run of update data into mappings
+/// \param table parent table
+/// \param type descriptor type of the run
+/// \param data first descriptor data
+/// \param stride byte stride between descriptors
+/// \param count number of descriptors
+/// \param mappings destination mappings, length of count
+using DescriptorUpdateTemplateDecodeFn = void(*)(DeviceDispatchTable* table, VkDescriptorType type, const uint8_t* data, size_t stride, uint32_t count, VirtualResourceMapping* mappings);
+
+struct DescriptorUpdateTemplateRun {
+    /// Decoder for the run type
+    DescriptorUpdateTemplateDecodeFn decode{nullptr};
+
+    /// Descriptor type of all descriptors in the run
+    VkDescriptorType type{};
+
+    /// Offset into the update data
+    size_t sourceOffset{0};
+
+    /// Byte stride between descriptors
+    size_t sourceStride{0};
+
+    /// Destination slot within the set segment
+    uint32_t prmtOffset{0};
+
+    /// Number of descriptors
+    uint32_t count{0};
+};
+
+struct DescriptorUpdateTemplateWrite {
+    /// Destination slot within the set segment
+    uint32_t prmtOffset{0};
+
+    /// Offset into the decoded mappings
+    uint32_t mappingOffset{0};
+
+    /// Number of mappings
+    uint32_t count{0};
+};
+
+struct DescriptorUpdateTemplatePlan {
+    /// Compile the plan from a template against its set layout
+    /// \param createInfo template creation info
+    /// \param physicalMapping physical mapping of the updated set layout
+    void Compile(const VkDescriptorUpdateTemplateCreateInfo& createInfo, const DescriptorLayoutPhysicalMapping& physicalMapping);
+
+    /// Execute the plan against a set segment
+    /// \param table parent table
+    /// \param id segment of the updated set
+    /// \param pData opaque update data
+    void Execute(DeviceDispatchTable* table, PhysicalResourceSegmentID id, const void* pData) const;
+
+    /// All decode runs, ordered by destination slot
+    std::vector<DescriptorUpdateTemplateRun> runs;
+
+    /// All table writes, contiguous slot ranges of the decoded mappings
+    std::vector<DescriptorUpdateTemplateWrite> writes;
+
+    /// Total number of decoded mappings
+    uint32_t mappingCount{0};
+};
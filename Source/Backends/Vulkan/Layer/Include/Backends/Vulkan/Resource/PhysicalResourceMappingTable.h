@@ -29,6 +29,7 @@
 // Backend
 #include "VirtualResourceMapping.h"
 #include "PhysicalResourceMappingTableSegment.h"
+#include "PhysicalResourceMappingTableWrite.h"
 #include "PhysicalResourceSegment.h"
 #include "PhysicalResourceMappingTableQueueState.h"
 #include <Backends/Vulkan/Allocation/MirrorAllocation.h>
@@ -65,6 +66,12 @@ public:
     /// \return persistent version, must be manually released
     PhysicalResourceMappingTablePersistentVersion* GetPersistentVersion(VkCommandBuffer commandBuffer, PhysicalResourceMappingTableQueueState* queueState);
 
+    /// Check if a persistent version is still current for a queue, i.e. no updates are pending
+    /// \param version the persistent version to check
+    /// \param queueState queue state
+    /// \return true if up to date
+    bool IsUpToDate(const PhysicalResourceMappingTablePersistentVersion* version, const PhysicalResourceMappingTableQueueState* queueState);
+
     /// Allocate a new segment
     /// \param count number of descriptors
     /// \return segment identifier
@@ -84,6 +91,18 @@ public:
     /// \param mapping mapping to write
     void WriteMapping(PhysicalResourceSegmentID id, uint32_t offset, const VirtualResourceMapping& mapping);
 
+    /// Write a contiguous range of mappings at a given offset
+    /// \param id segment identifier
+    /// \param offset offset to be written
+    /// \param mappings mappings to write
+    /// \param count number of mappings
+    void WriteMappings(PhysicalResourceSegmentID id, uint32_t offset, const VirtualResourceMapping* mappings, uint32_t count);
+
+    /// Write a batch of mapping ranges, committed as a single update
+    /// \param writes all writes
+    /// \param count number of writes
+    void WriteMappings(const PhysicalResourceMappingTableWrite* writes, uint32_t count);
+
     /// Get an existing mapping within a segment
     /// \param id segment identifier
     /// \param offset offset within the segment
@@ -101,6 +120,22 @@ public:
     /// \param dest destination segment
     void CopyMappings(PhysicalResourceSegmentID source, PhysicalResourceSegmentID dest);
 
+    /// Copy a range of mappings between segments
+    /// \param source source segment
+    /// \param sourceOffset offset within the source segment
+    /// \param dest destination segment
+    /// \param destOffset offset within the destination segment
+    /// \param count number of mappings
+    void CopyMappings(PhysicalResourceSegmentID source, uint32_t sourceOffset, PhysicalResourceSegmentID dest, uint32_t destOffset, uint32_t count);
+
+private:
+    /// Write a contiguous range of mappings, lock must be held
+    /// \param id segment identifier
+    /// \param offset offset to be written
+    /// \param mappings mappings to write
+    /// \param count number of mappings
+    void WriteMappingsNoLock(PhysicalResourceSegmentID id, uint32_t offset, const VirtualResourceMapping* mappings, uint32_t count);
+
 private:
     /// Allocate a new table with a given size
     /// \param count number of descriptors
@@ -37,6 +37,7 @@
 
 // Common
 #include <Common/ComRef.h>
+#include <Common/Containers/TrivialStackVector.h>
 
 // Std
 #include <vector>
@@ -68,18 +69,43 @@ public:
         // Get the set entry
         SetEntry& setEntry = GetEntryFor(layoutState, set, commandBuffer);
 
+        // Total number of written descriptors
+        uint32_t mappingCount = 0;
+        for (uint32_t i = 0; i < descriptorWriteCount; i++) {
+            mappingCount += pDescriptorWrites[i].descriptorCount;
+        }
+
+        // Resolved mappings and their table writes
+        TrivialStackVector<VirtualResourceMapping, 64u> mappings(table->allocators);
+        TrivialStackVector<PhysicalResourceMappingTableWrite, 16u> prmtWrites(table->allocators);
+        mappings.Resize(mappingCount);
+
         // Handle all writes
+        uint32_t mappingOffset = 0;
         for (uint32_t i = 0; i < descriptorWriteCount; i++) {
             const VkWriteDescriptorSet& write = pDescriptorWrites[i];
 
             // Map current binding to an offset
             const uint32_t prmtOffset = physicalMapping.bindings.at(write.dstBinding).prmtOffset;
 
-            // Create mappings for all descriptors written
-            for (uint32_t descriptorIndex = 0; descriptorIndex < write.descriptorCount; descriptorIndex++) {
-                // Write mapping
-                table->prmTable->WriteMapping(setEntry.segmentId, prmtOffset + write.dstArrayElement, GetVirtualResourceMapping(table, write, descriptorIndex));
-            }
+            // Resolve mappings for all descriptors written
+            VirtualResourceMapping* writeMappings = mappings.Data() + mappingOffset;
+            GetVirtualResourceMappings(table, write, writeMappings);
+
+            // Create PRM association
+            PhysicalResourceMappingTableWrite& prmtWrite = prmtWrites.Add();
+            prmtWrite.id = setEntry.segmentId;
+            prmtWrite.offset = prmtOffset + write.dstArrayElement;
+            prmtWrite.count = write.descriptorCount;
+            prmtWrite.mappings = writeMappings;
+
+            // Next!
+            mappingOffset += write.descriptorCount;
+        }
+
+        // Commit all writes as a single update
+        if (prmtWrites.Size()) {
+            table->prmTable->WriteMappings(prmtWrites.Data(), static_cast<uint32_t>(prmtWrites.Size()));
         }
 
         // Mark as pending writes
@@ -95,27 +121,11 @@ public:
     void PushDescriptorSetWithTemplateKHR(VkCommandBuffer commandBuffer, DescriptorUpdateTemplateState* descriptorUpdateTemplate, VkPipelineLayout layout, uint32_t set, const void* pData) {
         PipelineLayoutState* layoutState = table->states_pipelineLayout.Get(layout);
 
-        // Get the descriptor set layout
-        const DescriptorLayoutPhysicalMapping& physicalMapping = layoutState->physicalMapping.descriptorSets.at(set);
-
         // Get the set entry
         SetEntry& setEntry = GetEntryFor(layoutState, set, commandBuffer);
         
-        // Handle each entry
-        for (uint32_t i = 0; i < descriptorUpdateTemplate->createInfo->descriptorUpdateEntryCount; i++) {
-            const VkDescriptorUpdateTemplateEntry& entry = descriptorUpdateTemplate->createInfo->pDescriptorUpdateEntries[i];
-
-            // Map current binding to an offset
-            const uint32_t prmtOffset = physicalMapping.bindings.at(entry.dstBinding).prmtOffset;
-
-            // Handle each binding write
-            for (uint32_t descriptorIndex = 0; descriptorIndex < entry.descriptorCount; descriptorIndex++) {
-                const void *descriptorData = static_cast<const uint8_t*>(pData) + entry.offset + descriptorIndex * entry.stride;
-                
-                // Write mapping
-                table->prmTable->WriteMapping(setEntry.segmentId, prmtOffset + entry.dstArrayElement, GetVirtualResourceMapping(table, entry.descriptorType, descriptorData));
-            }
-        }
+        // Execute the precompiled plan
+        descriptorUpdateTemplate->plan.Execute(table, setEntry.segmentId, pData);
 
         // Mark as pending writes
         setEntry.pendingWrite = true;
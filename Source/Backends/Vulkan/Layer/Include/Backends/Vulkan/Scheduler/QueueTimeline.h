@@ -0,0 +1,101 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Layer
+#include <Backends/Vulkan/Vulkan.h>
+
+// Std
+#include <cstdint>
+#include <atomic>
+
+// Forward declarations
+struct DeviceDispatchTable;
+
+/// Monotonic completion timeline of a single queue
+///   A single counter read retires every submission signalled before it
+class QueueTimeline {
+public:
+    /// Destructor
+    ~QueueTimeline();
+
+    /// Install this timeline
+    /// \param table parent table
+    /// \return false if timeline semaphores are unavailable, callers must fall back to fences
+    bool Install(DeviceDispatchTable* table);
+
+    /// Is this timeline usable?
+    bool IsSupported() const {
+        return semaphore != VK_NULL_HANDLE;
+    }
+
+    /// Allocate the next signal value
+    ///   Must be invoked under the queue lock, in the order of submission
+    /// \return signal value
+    uint64_t Next() {
+        return ++submittedValue;
+    }
+
+    /// Query the latest completed value from the device
+    /// \return completed value
+    uint64_t Poll();
+
+    /// Check if a value has completed, only queries the device if not already known
+    /// \param value the value to check for
+    /// \return true if completed
+    bool IsCompleted(uint64_t value) {
+        return completedValue.load() >= value || Poll() >= value;
+    }
+
+    /// Wait for a value to complete
+    /// \param value the value to wait for
+    void Wait(uint64_t value);
+
+    /// Wait for all submitted values
+    void WaitForPending() {
+        Wait(submittedValue.load());
+    }
+
+    /// Get the underlying semaphore
+    VkSemaphore GetSemaphore() const {
+        return semaphore;
+    }
+
+private:
+    /// Parent table
+    DeviceDispatchTable* table{nullptr};
+
+    /// Underlying timeline semaphore
+    VkSemaphore semaphore{VK_NULL_HANDLE};
+
+    /// Last allocated signal value
+    std::atomic<uint64_t> submittedValue{0};
+
+    /// Last known completed value
+    std::atomic<uint64_t> completedValue{0};
+};
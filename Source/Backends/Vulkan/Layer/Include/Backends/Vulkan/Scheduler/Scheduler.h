@@ -89,8 +89,11 @@ private:
         /// The streaming state
         ShaderExportStreamState* streamState{nullptr};
 
-        /// The submission fence
+        /// The submission fence, only used if the queue has no timeline
         VkFence fence{VK_NULL_HANDLE};
+
+        /// Queue timeline value signalled on completion, zero if fence tracked
+        uint64_t timelineValue{0};
     };
 
     struct QueueBucket {
@@ -120,6 +123,12 @@ private:
     /// \return submission object
     Submission PopSubmission(Queue queue);
 
+    /// Check if a submission has completed
+    /// \param submission submission to check
+    /// \param completedTimelineValue last completed value of the queue timeline
+    /// \return true if completed
+    bool IsCompleted(const Submission& submission, uint64_t completedTimelineValue);
+
 private:
     struct PrimitiveEntry {
         /// Underlying semaphore
@@ -29,6 +29,7 @@
 // Layer
 #include <Backends/Vulkan/Vulkan.h>
 #include <Backends/Vulkan/DeepCopyObjects.Gen.h>
+#include <Backends/Vulkan/Resource/DescriptorUpdateTemplatePlan.h>
 
 // Forward declarations
 struct DeviceDispatchTable;
@@ -43,6 +44,9 @@ struct DescriptorUpdateTemplateState {
     // Creation info
     VkDescriptorUpdateTemplateCreateInfoDeepCopy createInfo;
 
+    /// Precompiled update plan against the template set layout
+    DescriptorUpdateTemplatePlan plan;
+
     /// Unique identifier, unique for the type
     uint64_t uid;
 };
@@ -29,6 +29,7 @@
 // Layer
 #include <Backends/Vulkan/Vulkan.h>
 #include <Backends/Vulkan/States/FenceState.h>
+#include <Backends/Vulkan/Scheduler/QueueTimeline.h>
 #include <Backends/Vulkan/Resource/PhysicalResourceMappingTableQueueState.h>
 
 // Common
@@ -68,6 +69,9 @@ struct QueueState {
     /// Object pools
     ObjectPool<FenceState> pools_fences;
 
+    /// Completion timeline, fences are used if unsupported
+    QueueTimeline timeline;
+
     /// Current export state
     ShaderExportQueueState* exportState{nullptr};
 
@@ -60,6 +60,9 @@ struct ShaderModuleInstrumentationKey {
     /// Physical mapping
     PipelineLayoutPhysicalMapping* physicalMapping{nullptr};
 
+    /// Instrument export budget checks
+    bool exportBudgets{false};
+
     /// Final hash
     uint64_t combinedHash{0};
 
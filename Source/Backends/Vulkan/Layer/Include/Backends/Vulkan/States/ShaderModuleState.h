@@ -41,6 +41,8 @@
 #include <mutex>
 #include <atomic>
 #include <map>
+#include <vector>
+#include <list>
 
 // Forward declarations
 struct DeviceDispatchTable;
@@ -54,6 +56,11 @@ struct ShaderModuleState : public ReferenceObject {
     /// Release all host resources
     void ReleaseHost() override;
 
+    /// Deep copy the creation info, the originating SPIR-V is retained compressed
+    /// \param allocators deep copy allocators
+    /// \param createInfo user creation info
+    void CopyCreateInfo(const Allocators& allocators, const VkShaderModuleCreateInfo& createInfo);
+
     /// Add an instrument to this module
     /// \param featureBitSet the enabled feature set
     /// \param module the module in question
@@ -133,12 +140,32 @@ struct ShaderModuleState : public ReferenceObject {
     DeviceDispatchTable* table;
 
     /// Recreation info
+    ///    ! Does not hold the code, see compressedCode
     VkShaderModuleCreateInfoDeepCopy createInfoDeepCopy;
 
+    /// Compressed SPIR-V of the originating shader
+    std::vector<uint8_t> compressedCode;
+
+    /// Byte size of the originating shader
+    size_t codeSize{0};
+
+    /// Decompressed SPIR-V of the originating shader, resident alongside the module
+    ///    ! On demand, may be empty
+    std::vector<uint32_t> code;
+
     /// SPIRV module of the originating shader
     ///    ! On demand, may be nullptr
     SpvModule* spirvModule{nullptr};
 
+    /// Number of active users of the module, never evicted while pinned
+    uint32_t spirvModulePinCount{0};
+
+    /// Is this state tracked for module retention?
+    bool spirvModuleRetained{false};
+
+    /// Retention iterator, valid if retained
+    std::list<ShaderModuleState*>::iterator spirvModuleRetentionIt;
+
     /// Instrumentation info
     InstrumentationInfo instrumentationInfo;
 
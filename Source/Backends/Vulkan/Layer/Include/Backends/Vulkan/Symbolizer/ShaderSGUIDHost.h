@@ -61,6 +61,7 @@ private:
     };
 
     /// Get the source map from a guid
+    ///    ! The shader module must be pinned for the lifetime of the map
     /// \param shaderGUID the shader guid
     /// \return source map, nullptr if not found
     const SpvSourceMap* GetSourceMap(uint64_t shaderGUID);
@@ -237,8 +237,13 @@ struct DeviceDispatchTable {
     PFN_vkCreateComputePipelines          next_vkCreateComputePipelines;
     PFN_vkCreateRayTracingPipelinesKHR    next_vkCreateRayTracingPipelinesKHR;
     PFN_vkDestroyPipeline                 next_vkDestroyPipeline;
+    PFN_vkCreatePipelineCache             next_vkCreatePipelineCache;
+    PFN_vkDestroyPipelineCache            next_vkDestroyPipelineCache;
+    PFN_vkGetPipelineCacheData            next_vkGetPipelineCacheData;
     PFN_vkGetFenceStatus                  next_vkGetFenceStatus;
     PFN_vkWaitForFences                   next_vkWaitForFences;
+    PFN_vkWaitSemaphores                  next_vkWaitSemaphores;
+    PFN_vkWaitSemaphoresKHR               next_vkWaitSemaphoresKHR;
     PFN_vkCreateBuffer                    next_vkCreateBuffer;
     PFN_vkDestroyBuffer                   next_vkDestroyBuffer;
     PFN_vkCreateBufferView                next_vkCreateBufferView;
@@ -297,6 +302,8 @@ struct DeviceDispatchTable {
     PFN_vkQueueBindSparse                 next_vkQueueBindSparse;
     PFN_vkCreateSemaphore                 next_vkCreateSemaphore;
     PFN_vkDestroySemaphore                next_vkDestroySemaphore;
+    PFN_vkGetSemaphoreCounterValue        next_vkGetSemaphoreCounterValue;
+    PFN_vkWaitSemaphores                  next_vkWaitSemaphores;
 
     /// Properties
     VkPhysicalDeviceProperties                 physicalDeviceProperties{};
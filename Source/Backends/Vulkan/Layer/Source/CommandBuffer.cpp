@@ -74,14 +74,14 @@ void CreateDeviceCommandProxies(DeviceDispatchTable *table) {
             table->commandBufferDispatchTable.featureBitSetMask_vkCmdDrawMeshTasksEXT |= (1ull << i);
         }
 
-        if (hookTable.copyResource.IsValid()) {
-            table->commandBufferDispatchTable.featureHooks_vkCmdCopyBuffer[i] = hookTable.copyResource;
-            table->commandBufferDispatchTable.featureHooks_vkCmdCopyImage[i] = hookTable.copyResource;
-            table->commandBufferDispatchTable.featureHooks_vkCmdCopyImageToBuffer[i] = hookTable.copyResource;
-            table->commandBufferDispatchTable.featureHooks_vkCmdCopyImageToBuffer2[i] = hookTable.copyResource;
-            table->commandBufferDispatchTable.featureHooks_vkCmdCopyBufferToImage[i] = hookTable.copyResource;
-            table->commandBufferDispatchTable.featureHooks_vkCmdCopyBufferToImage2[i] = hookTable.copyResource;
-            table->commandBufferDispatchTable.featureHooks_vkCmdBlitImage[i] = hookTable.copyResource;
+        if (hookTable.copyResource.IsValid() || hookTable.copyResources.IsValid()) {
+            table->commandBufferDispatchTable.featureHooks_vkCmdCopyBuffer[i] = {hookTable.copyResource, hookTable.copyResources};
+            table->commandBufferDispatchTable.featureHooks_vkCmdCopyImage[i] = {hookTable.copyResource, hookTable.copyResources};
+            table->commandBufferDispatchTable.featureHooks_vkCmdCopyImageToBuffer[i] = {hookTable.copyResource, hookTable.copyResources};
+            table->commandBufferDispatchTable.featureHooks_vkCmdCopyImageToBuffer2[i] = {hookTable.copyResource, hookTable.copyResources};
+            table->commandBufferDispatchTable.featureHooks_vkCmdCopyBufferToImage[i] = {hookTable.copyResource, hookTable.copyResources};
+            table->commandBufferDispatchTable.featureHooks_vkCmdCopyBufferToImage2[i] = {hookTable.copyResource, hookTable.copyResources};
+            table->commandBufferDispatchTable.featureHooks_vkCmdBlitImage[i] = {hookTable.copyResource, hookTable.copyResources};
             table->commandBufferDispatchTable.featureBitSetMask_vkCmdCopyBuffer |= (1ull << i);
             table->commandBufferDispatchTable.featureBitSetMask_vkCmdCopyImage |= (1ull << i);
             table->commandBufferDispatchTable.featureBitSetMask_vkCmdCopyImageToBuffer |= (1ull << i);
@@ -91,15 +91,15 @@ void CreateDeviceCommandProxies(DeviceDispatchTable *table) {
             table->commandBufferDispatchTable.featureBitSetMask_vkCmdBlitImage |= (1ull << i);
         }
         
-        if (hookTable.resolveResource.IsValid()) {
-            table->commandBufferDispatchTable.featureHooks_vkCmdResolveImage[i] = hookTable.resolveResource;
+        if (hookTable.resolveResource.IsValid() || hookTable.resolveResources.IsValid()) {
+            table->commandBufferDispatchTable.featureHooks_vkCmdResolveImage[i] = {hookTable.resolveResource, hookTable.resolveResources};
             table->commandBufferDispatchTable.featureBitSetMask_vkCmdResolveImage |= (1ull << i);
         }
         
-        if (hookTable.clearResource.IsValid()) {
-            table->commandBufferDispatchTable.featureHooks_vkCmdClearAttachments[i] = hookTable.clearResource;
-            table->commandBufferDispatchTable.featureHooks_vkCmdClearColorImage[i] = hookTable.clearResource;
-            table->commandBufferDispatchTable.featureHooks_vkCmdClearDepthStencilImage[i] = hookTable.clearResource;
+        if (hookTable.clearResource.IsValid() || hookTable.clearResources.IsValid()) {
+            table->commandBufferDispatchTable.featureHooks_vkCmdClearAttachments[i] = {hookTable.clearResource, hookTable.clearResources};
+            table->commandBufferDispatchTable.featureHooks_vkCmdClearColorImage[i] = {hookTable.clearResource, hookTable.clearResources};
+            table->commandBufferDispatchTable.featureHooks_vkCmdClearDepthStencilImage[i] = {hookTable.clearResource, hookTable.clearResources};
             table->commandBufferDispatchTable.featureBitSetMask_vkCmdClearAttachments |= (1ull << i);
             table->commandBufferDispatchTable.featureBitSetMask_vkCmdClearColorImage |= (1ull << i);
             table->commandBufferDispatchTable.featureBitSetMask_vkCmdClearDepthStencilImage |= (1ull << i);
@@ -157,6 +157,33 @@ void SetDeviceCommandFeatureSetAndCommit(DeviceDispatchTable *table, uint64_t fe
     table->commandBufferDispatchTable.featureBitSet_vkCmdEndRendering = table->commandBufferDispatchTable.featureBitSetMask_vkCmdEndRendering & featureSet;
     table->commandBufferDispatchTable.featureBitSet_vkCmdEndRenderingKHR = table->commandBufferDispatchTable.featureBitSetMask_vkCmdEndRenderingKHR & featureSet;
     table->commandBufferDispatchTable.featureBitSet_vkCmdDrawMeshTasksEXT = table->commandBufferDispatchTable.featureBitSetMask_vkCmdDrawMeshTasksEXT & featureSet;
+
+    // Compile the dense dispatch of all enabled features
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdDraw, table->commandBufferDispatchTable.featureBitSet_vkCmdDraw);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdDrawIndexed, table->commandBufferDispatchTable.featureBitSet_vkCmdDrawIndexed);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdDispatch, table->commandBufferDispatchTable.featureBitSet_vkCmdDispatch);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdCopyBuffer, table->commandBufferDispatchTable.featureBitSet_vkCmdCopyBuffer);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdCopyImage, table->commandBufferDispatchTable.featureBitSet_vkCmdCopyImage);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdCopyBufferToImage, table->commandBufferDispatchTable.featureBitSet_vkCmdCopyBufferToImage);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdCopyBufferToImage2, table->commandBufferDispatchTable.featureBitSet_vkCmdCopyBufferToImage2);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdCopyImageToBuffer, table->commandBufferDispatchTable.featureBitSet_vkCmdCopyImageToBuffer);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdCopyImageToBuffer2, table->commandBufferDispatchTable.featureBitSet_vkCmdCopyImageToBuffer2);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdBlitImage, table->commandBufferDispatchTable.featureBitSet_vkCmdBlitImage);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdUpdateBuffer, table->commandBufferDispatchTable.featureBitSet_vkCmdUpdateBuffer);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdFillBuffer, table->commandBufferDispatchTable.featureBitSet_vkCmdFillBuffer);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdClearColorImage, table->commandBufferDispatchTable.featureBitSet_vkCmdClearColorImage);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdClearDepthStencilImage, table->commandBufferDispatchTable.featureBitSet_vkCmdClearDepthStencilImage);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdClearAttachments, table->commandBufferDispatchTable.featureBitSet_vkCmdClearAttachments);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdResolveImage, table->commandBufferDispatchTable.featureBitSet_vkCmdResolveImage);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdBeginRenderPass, table->commandBufferDispatchTable.featureBitSet_vkCmdBeginRenderPass);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdBeginRenderPass2, table->commandBufferDispatchTable.featureBitSet_vkCmdBeginRenderPass2);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdBeginRenderPass2KHR, table->commandBufferDispatchTable.featureBitSet_vkCmdBeginRenderPass2KHR);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdEndRenderPass, table->commandBufferDispatchTable.featureBitSet_vkCmdEndRenderPass);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdBeginRendering, table->commandBufferDispatchTable.featureBitSet_vkCmdBeginRendering);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdBeginRenderingKHR, table->commandBufferDispatchTable.featureBitSet_vkCmdBeginRenderingKHR);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdEndRendering, table->commandBufferDispatchTable.featureBitSet_vkCmdEndRendering);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdEndRenderingKHR, table->commandBufferDispatchTable.featureBitSet_vkCmdEndRenderingKHR);
+    CompileFeatureHookDispatch(table->commandBufferDispatchTable.featureDispatch_vkCmdDrawMeshTasksEXT, table->commandBufferDispatchTable.featureBitSet_vkCmdDrawMeshTasksEXT);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreateCommandPool(VkDevice device, const VkCommandPoolCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkCommandPool *pCommandPool) {
@@ -48,6 +48,10 @@ void SpvPhysicalBlockFunction::Parse() {
     // All metadata
     identifierMetadata.resize(table.scan.header.bound);
 
+    // Determine the functions that need lifting
+    std::set<IL::ID> liftedFunctions;
+    CollectLiftedFunctions(liftedFunctions);
+
     // Parse instructions
     SpvParseContext ctx(block->source);
     while (ctx) {
@@ -60,6 +64,12 @@ void SpvPhysicalBlockFunction::Parse() {
         // Must be opening
         ASSERT(ctx->GetOp() == SpvOpFunction, "Unexpected instruction");
 
+        // Start of the function source
+        const uint32_t functionBegin = ctx.Source().codeOffset;
+
+        // Should this function be lifted?
+        const bool isLifted = liftedFunctions.contains(ctx.GetResult());
+
         // Attempt to get existing function in case it's prototyped
         IL::Function *function = program.GetFunctionList().GetFunction(ctx.GetResult());
 
@@ -89,7 +99,8 @@ void SpvPhysicalBlockFunction::Parse() {
             }
 
             // If there's any control md, preallocate the id
-            if (requiresControlMetadata) {
+            //   ? Verbatim functions are never recompiled, and keep their signature
+            if (requiresControlMetadata && isLifted) {
                 md.function.optionalControlStructure = program.GetIdentifierMap().AllocID();
             }
 
@@ -100,6 +111,19 @@ void SpvPhysicalBlockFunction::Parse() {
         // Next instruction
         ctx.Next();
 
+        // Not lifted? Skip the contents and keep it verbatim
+        if (!isLifted) {
+            while (ctx->GetOp() != SpvOpFunctionEnd) {
+                ctx.Next();
+            }
+
+            // Never instrumented, span is inclusive of the end
+            function->AddFlag(FunctionFlag::NoInstrumentation);
+            function->Immortalize(IL::SourceSpan { functionBegin, ctx.Source().codeOffset + 1u });
+            ctx.Next();
+            continue;
+        }
+
         // Parse header
         ParseFunctionHeader(function, ctx);
 
@@ -108,6 +132,17 @@ void SpvPhysicalBlockFunction::Parse() {
             // Parse the body
             ParseFunctionBody(function, ctx);
 
+            // If nothing requires recompilation, immortalize the function
+            // Any modification during instrumentation marks the blocks as dirty
+            if (IsVerbatimCandidate(function)) {
+                for (IL::BasicBlock *basicBlock : function->GetBasicBlocks()) {
+                    basicBlock->Immortalize(basicBlock->GetSourceSpan());
+                }
+
+                // Span is inclusive of the end
+                function->Immortalize(IL::SourceSpan { functionBegin, ctx.Source().codeOffset + 1u });
+            }
+
             // Perform post patching
             PostPatchLoops(function);
         }
@@ -118,6 +153,127 @@ void SpvPhysicalBlockFunction::Parse() {
     }
 }
 
+void SpvPhysicalBlockFunction::CollectLiftedFunctions(std::set<IL::ID> &out) {
+    // Function to callee lookup
+    std::unordered_map<IL::ID, std::vector<IL::ID>> callees;
+
+    // Current function
+    IL::ID function = IL::InvalidID;
+
+    // Pre-scan all calls
+    SpvParseContext ctx(block->source);
+    while (ctx) {
+        switch (ctx->GetOp()) {
+            default: {
+                break;
+            }
+            case SpvOpFunction: {
+                function = ctx.GetResult();
+                callees[function];
+                break;
+            }
+            case SpvOpFunctionCall: {
+                callees[function].push_back(ctx++);
+                break;
+            }
+        }
+
+        // Next instruction
+        ctx.Next();
+    }
+
+    // Without any entry points there's no notion of reachability, lift everything
+    if (!table.entryPoint.GetEntryPointCount()) {
+        for (auto &&kv : callees) {
+            out.insert(kv.first);
+        }
+        return;
+    }
+
+    // Lift everything reachable from the entry points
+    std::vector<IL::ID> stack;
+    for (uint32_t i = 0; i < table.entryPoint.GetEntryPointCount(); i++) {
+        stack.push_back(table.entryPoint.GetEntryPointFunction(i));
+    }
+
+    // Walk the call graph
+    while (!stack.empty()) {
+        IL::ID id = stack.back();
+        stack.pop_back();
+
+        // Already visited?
+        if (!out.insert(id).second) {
+            continue;
+        }
+
+        // Visit all callees
+        if (auto it = callees.find(id); it != callees.end()) {
+            stack.insert(stack.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    // Lifted functions may change signature, so any unreachable caller must be lifted too
+    for (bool changed = true; changed;) {
+        changed = false;
+
+        for (auto &&kv : callees) {
+            if (out.contains(kv.first)) {
+                continue;
+            }
+
+            // Calls into any lifted function?
+            for (IL::ID callee : kv.second) {
+                if (out.contains(callee)) {
+                    out.insert(kv.first);
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool SpvPhysicalBlockFunction::IsVerbatimCandidate(IL::Function *function) {
+    // Control structures change the signature
+    if (identifierMetadata.at(function->GetID()).function.optionalControlStructure != IL::InvalidID) {
+        return false;
+    }
+
+    // Loops are always patched
+    if (!loopBlocks.empty()) {
+        return false;
+    }
+
+    // Check for recompiled calls
+    for (const IL::BasicBlock *basicBlock : function->GetBasicBlocks()) {
+        for (const IL::Instruction *instr : *basicBlock) {
+            if (instr->Is<IL::CallInstruction>() && instr->source.modified) {
+                return false;
+            }
+        }
+    }
+
+    // OK
+    return true;
+}
+
+bool SpvPhysicalBlockFunction::IsVerbatimFunction(const IL::Function &fn) const {
+    // Must have a source span
+    if (fn.GetSourceSpan().begin == IL::InvalidOffset) {
+        return false;
+    }
+
+    // Check all blocks
+    for (const IL::BasicBlock *basicBlock : fn.GetBasicBlocks()) {
+        if (basicBlock->IsModified()) {
+            return false;
+        }
+    }
+
+    // OK
+    return true;
+}
+
 void SpvPhysicalBlockFunction::ParseFunctionHeader(IL::Function *function, SpvParseContext &ctx) {
     while (ctx) {
         // Create type association
@@ -1320,6 +1476,12 @@ bool SpvPhysicalBlockFunction::Compile(const SpvJob& job, SpvIdMap &idMap) {
     
     // Compile all function declarations
     for (IL::Function* fn : program.GetFunctionList()) {
+        // Untouched functions are copied as is
+        if (IsVerbatimFunction(*fn)) {
+            block->stream.TemplateSpan(fn->GetSourceSpan());
+            continue;
+        }
+        
         if (!CompileFunction(job, idMap, *fn, true)) {
             return false;
         }
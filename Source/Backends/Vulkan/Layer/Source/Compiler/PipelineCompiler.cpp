@@ -35,12 +35,38 @@
 // Common
 #include <Common/Dispatcher/Dispatcher.h>
 #include <Common/Registry.h>
+#include <Common/FileSystem.h>
+#include <Common/GlobalUID.h>
+
+// Std
+#include <fstream>
 
 // The maximum number per batch
 //  Each compilation job is of varying time, so split up the batches across workers to ensure that they're spread out
 //  to whatever workers first take them
 constexpr uint32_t kMaxBatchSize = 64;
 
+/// Magic header of the serialized pipeline cache
+static constexpr uint32_t kPipelineCacheMagic = 0x43505247;
+
+/// Version of the instrumented pipelines, bump on layer changes to discard all previous caches
+static constexpr uint32_t kPipelineCacheLayerVersion = 1;
+
+/// Serialized pipeline cache header
+struct PipelineCacheHeader {
+    /// Expected magic
+    uint32_t magic{kPipelineCacheMagic};
+
+    /// Layer version at serialization
+    uint32_t layerVersion{kPipelineCacheLayerVersion};
+
+    /// Driver cache UUID at serialization
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE]{};
+
+    /// Byte size of the driver data following the header
+    uint64_t dataSize{0};
+};
+
 PipelineCompiler::PipelineCompiler(DeviceDispatchTable *table) : table(table) {
 
 }
@@ -51,10 +77,151 @@ bool PipelineCompiler::Install() {
         return false;
     }
 
+    // Create the pipeline cache, optional, pipelines are compiled without one on failure
+    CreatePipelineCache();
+
+    // OK
+    return true;
+}
+
+void PipelineCompiler::Uninstall() {
+    if (!pipelineCache) {
+        return;
+    }
+
+    // Keep the driver compilations for the next session
+    StorePipelineCache();
+
+    // Release the cache
+    table->next_vkDestroyPipelineCache(table->object, pipelineCache, nullptr);
+    pipelineCache = VK_NULL_HANDLE;
+}
+
+bool PipelineCompiler::CreatePipelineCache() {
+    std::filesystem::path path = GetPipelineCachePath();
+
+    // Initial driver data
+    std::vector<uint8_t> data;
+
+    // Try to load the previous session
+    if (std::ifstream stream(path, std::ios::binary); stream.good()) {
+        PipelineCacheHeader header;
+
+        // Get the file size for validation
+        std::error_code error;
+        uintmax_t fileSize = std::filesystem::file_size(path, error);
+
+        // Only accept complete caches from the same layer and driver
+        if (!error &&
+            stream.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+            header.magic == kPipelineCacheMagic &&
+            header.layerVersion == kPipelineCacheLayerVersion &&
+            header.dataSize <= fileSize - sizeof(header) &&
+            !std::memcmp(header.pipelineCacheUUID, table->physicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE)) {
+            data.resize(header.dataSize);
+
+            // Discard partial reads
+            if (!stream.read(reinterpret_cast<char*>(data.data()), data.size())) {
+                data.clear();
+            }
+        }
+    }
+
+    // Cache creation info
+    VkPipelineCacheCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.initialDataSize = data.size();
+    createInfo.pInitialData = data.data();
+
+    // Try to create the cache
+    VkResult result = table->next_vkCreatePipelineCache(table->object, &createInfo, nullptr, &pipelineCache);
+
+    // Drivers may reject the initial data, start from scratch
+    if (result != VK_SUCCESS && !data.empty()) {
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = nullptr;
+        result = table->next_vkCreatePipelineCache(table->object, &createInfo, nullptr, &pipelineCache);
+    }
+
+    // Failed?
+    if (result != VK_SUCCESS) {
+        pipelineCache = VK_NULL_HANDLE;
+        return false;
+    }
+
+    // OK
+    return true;
+}
+
+bool PipelineCompiler::StorePipelineCache() {
+    // Query the size
+    size_t size = 0;
+    if (table->next_vkGetPipelineCacheData(table->object, pipelineCache, &size, nullptr) != VK_SUCCESS || !size) {
+        return false;
+    }
+
+    // Get the driver data
+    std::vector<uint8_t> data(size);
+    if (table->next_vkGetPipelineCacheData(table->object, pipelineCache, &size, data.data()) != VK_SUCCESS) {
+        return false;
+    }
+
+    // Create header
+    PipelineCacheHeader header;
+    header.dataSize = size;
+    std::memcpy(header.pipelineCacheUUID, table->physicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+
+    // Write to a unique intermediate file first, other processes may be reading or storing the cache
+    std::filesystem::path path = GetPipelineCachePath();
+    std::filesystem::path intermediatePath = path;
+    intermediatePath += "." + GlobalUID::New().ToString();
+
+    // Serialize
+    {
+        std::ofstream stream(intermediatePath, std::ios::binary);
+        if (!stream.good()) {
+            return false;
+        }
+
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(data.data()), size);
+
+        // Failed to write?
+        if (!stream.good()) {
+            stream.close();
+
+            std::error_code error;
+            std::filesystem::remove(intermediatePath, error);
+            return false;
+        }
+    }
+
+    // Replace the previous cache
+    std::error_code error;
+    std::filesystem::rename(intermediatePath, path, error);
+    if (error) {
+        std::filesystem::remove(intermediatePath, error);
+        return false;
+    }
+
     // OK
     return true;
 }
 
+std::filesystem::path PipelineCompiler::GetPipelineCachePath() const {
+    static constexpr const char* kHex = "0123456789abcdef";
+
+    // Format the driver UUID
+    std::string uuid;
+    for (uint8_t byte : table->physicalDeviceProperties.pipelineCacheUUID) {
+        uuid.push_back(kHex[byte >> 4]);
+        uuid.push_back(kHex[byte & 0xF]);
+    }
+
+    // Keyed by driver and layer version
+    return GetIntermediateCachePath() / ("Vulkan." + uuid + ".v" + std::to_string(kPipelineCacheLayerVersion) + ".pipelinecache");
+}
+
 void PipelineCompiler::AddBatch(DeviceDispatchTable *table, PipelineCompilerDiagnostic* diagnostic, PipelineJob *jobs, uint32_t count, DispatcherBucket *bucket) {
     std::lock_guard guard(mutex);
 
@@ -285,7 +452,7 @@ void PipelineCompiler::CompileGraphics(const PipelineJobBatch &batch) {
     // Batched?
 #if PIPELINE_COMPILER_NO_BATCH
     for (uint32_t i = 0; i <  static_cast<uint32_t>(createInfos.Size()); i++) {
-        VkResult result = batch.table->next_vkCreateGraphicsPipelines(batch.table->object, nullptr, 1u, &createInfos[i], nullptr, &pipelines[i]);
+        VkResult result = batch.table->next_vkCreateGraphicsPipelines(batch.table->object, pipelineCache, 1u, &createInfos[i], nullptr, &pipelines[i]);
         if (result != VK_SUCCESS) {
             ++batch.diagnostic->failedJobs;
             return;
@@ -295,8 +462,7 @@ void PipelineCompiler::CompileGraphics(const PipelineJobBatch &batch) {
         ++batch.diagnostic->passedJobs;
     }
 #else
-    // TODO: Pipeline cache?
-    VkResult result = batch.table->next_vkCreateGraphicsPipelines(batch.table->object, nullptr, static_cast<uint32_t>(createInfos.Size()), createInfos.Data(), nullptr, pipelines);
+    VkResult result = batch.table->next_vkCreateGraphicsPipelines(batch.table->object, pipelineCache, static_cast<uint32_t>(createInfos.Size()), createInfos.Data(), nullptr, pipelines);
     if (result != VK_SUCCESS) {
         // Add diagnostics for all failed pipelines
         for (uint32_t i = 0; i < batch.count; i++) {
@@ -441,8 +607,7 @@ void PipelineCompiler::CompileCompute(const PipelineJobBatch &batch) {
     // Created pipelines
     auto pipelines = ALLOCA_ARRAY(VkPipeline, batch.count);
 
-    // TODO: Pipeline cache?
-    VkResult result = batch.table->next_vkCreateComputePipelines(batch.table->object, nullptr, static_cast<uint32_t>(createInfos.Size()), createInfos.Data(), nullptr, pipelines);
+    VkResult result = batch.table->next_vkCreateComputePipelines(batch.table->object, pipelineCache, static_cast<uint32_t>(createInfos.Size()), createInfos.Data(), nullptr, pipelines);
     if (result != VK_SUCCESS) {
         // Add diagnostics for all failed pipelines
         for (uint32_t i = 0; i < batch.count; i++) {
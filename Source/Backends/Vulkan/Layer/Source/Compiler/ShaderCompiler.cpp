@@ -29,6 +29,7 @@
 #include <Backends/Vulkan/Compiler/SpvModule.h>
 #include <Backends/Vulkan/Tables/DeviceDispatchTable.h>
 #include <Backends/Vulkan/Export/ShaderExportDescriptorAllocator.h>
+#include <Backends/Vulkan/Export/ShaderExportStreamAllocator.h>
 #include <Backends/Vulkan/ShaderData/ShaderDataHost.h>
 #include <Backends/Vulkan/Compiler/Diagnostic/DiagnosticType.h>
 
@@ -37,6 +38,8 @@
 #include <Backend/IFeature.h>
 #include <Backend/IShaderFeature.h>
 #include <Backend/IShaderExportHost.h>
+#include <Backend/IL/GuardPlan.h>
+#include <Backend/ShaderExportBudgetHost.h>
 #include <Backend/IL/PrettyPrint.h>
 #include <Backend/Diagnostic/DiagnosticBucketScope.h>
 
@@ -44,6 +47,9 @@
 #include "Common/Dispatcher/Dispatcher.h"
 #include <Common/Registry.h>
 
+// ZLIB
+#include <zlib.h>
+
 // Std
 #include <fstream>
 
@@ -58,6 +64,7 @@ bool ShaderCompiler::Install() {
     }
 
     shaderExportDescriptorAllocator = registry->Get<ShaderExportDescriptorAllocator>();
+    shaderExportStreamAllocator = registry->Get<ShaderExportStreamAllocator>();
 
     // Optional debug
     debug = registry->Get<ShaderCompilerDebug>();
@@ -74,6 +81,17 @@ bool ShaderCompiler::Install() {
     auto exportHost = registry->Get<IShaderExportHost>();
     exportHost->Enumerate(&exportCount, nullptr);
 
+    // Get the type info of all exports
+    exportTypeInfos.resize(exportHost->GetBound());
+    for (uint32_t i = 0; i < exportTypeInfos.size(); i++) {
+        exportTypeInfos[i] = exportHost->GetTypeInfo(i);
+    }
+
+    // Optional, per-SGUID export budgets
+    if (auto budgetHost = registry->Get<ShaderExportBudgetHost>()) {
+        exportBudgetDataID = budgetHost->GetDataID();
+    }
+
     // Get the export host
     auto shaderDataHost = registry->Get<ShaderDataHost>();
 
@@ -100,30 +118,141 @@ void ShaderCompiler::Add(DeviceDispatchTable *table, const ShaderJob& job, Dispa
     dispatcher->Add(BindDelegate(this, ShaderCompiler::Worker), data, bucket);
 }
 
+/// Approximate residency of a parsed module relative to its code
+static constexpr uint64_t kModuleResidencyFactor = 8;
+
 bool ShaderCompiler::InitializeModule(ShaderModuleState *state) {
-    // Initial state parsing is *always* serial
-    std::lock_guard guard(state->mutex);
-    
-    // Create the module on demand
-    if (!state->spirvModule) {
-        state->spirvModule = new(registry->GetAllocators()) SpvModule(allocators, state->uid);
-
-        // Parse the module
-        bool result = state->spirvModule->ParseModule(
-            state->createInfoDeepCopy.createInfo.pCode,
-            static_cast<uint32_t>(state->createInfoDeepCopy.createInfo.codeSize / 4u)
-        );
-
-        // Failed?
-        if (!result) {
-            return false;
+    {
+        // Initial state parsing is *always* serial
+        std::lock_guard guard(state->mutex);
+
+        // Pin regardless of the outcome
+        state->spirvModulePinCount++;
+
+        // Create the module on demand
+        if (!state->spirvModule) {
+            // Originating code may have been evicted
+            if (state->code.empty() && !DecompressCode(state)) {
+                return false;
+            }
+            
+            state->spirvModule = new(registry->GetAllocators()) SpvModule(allocators, state->uid);
+
+            // Parse the module
+            bool result = state->spirvModule->ParseModule(
+                state->code.data(),
+                static_cast<uint32_t>(state->code.size())
+            );
+
+            // Failed?
+            if (!result) {
+                destroy(state->spirvModule, allocators);
+                state->spirvModule = nullptr;
+                return false;
+            }
         }
     }
 
+    // Keep the module resident
+    TouchModule(state);
+
+    // Reclaim any cold modules
+    EvictModules();
+
     // OK
     return true;
 }
 
+void ShaderCompiler::ReleaseModule(ShaderModuleState *state) {
+    std::lock_guard guard(state->mutex);
+    ASSERT(state->spirvModulePinCount, "Unbalanced module release");
+    state->spirvModulePinCount--;
+}
+
+void ShaderCompiler::SetModuleBudget(uint64_t budget) {
+    {
+        std::lock_guard guard(retentionMutex);
+        retentionBudget = budget;
+    }
+
+    // Budget may have shrunk
+    EvictModules();
+}
+
+bool ShaderCompiler::DecompressCode(ShaderModuleState *state) {
+    // Allocate code
+    state->code.resize(state->codeSize / sizeof(uint32_t));
+
+    // Decompress the originating code
+    uLongf size = static_cast<uLongf>(state->codeSize);
+    if (uncompress(reinterpret_cast<Bytef*>(state->code.data()), &size, state->compressedCode.data(), static_cast<uLong>(state->compressedCode.size())) != Z_OK || size != state->codeSize) {
+        state->code.clear();
+        return false;
+    }
+
+    // OK
+    return true;
+}
+
+void ShaderCompiler::TouchModule(ShaderModuleState *state) {
+    std::lock_guard guard(retentionMutex);
+
+    // Already tracked? Move to the front
+    if (state->spirvModuleRetained) {
+        retainedModules.splice(retainedModules.begin(), retainedModules, state->spirvModuleRetentionIt);
+        return;
+    }
+
+    // Track the module
+    state->spirvModuleRetentionIt = retainedModules.insert(retainedModules.begin(), state);
+    state->spirvModuleRetained = true;
+    retainedBytes += state->codeSize * kModuleResidencyFactor;
+}
+
+void ShaderCompiler::UntrackModule(ShaderModuleState *state) {
+    std::lock_guard guard(retentionMutex);
+
+    // May have been evicted
+    if (!state->spirvModuleRetained) {
+        return;
+    }
+
+    // No longer tracked
+    retainedBytes -= state->codeSize * kModuleResidencyFactor;
+    state->spirvModuleRetained = false;
+    retainedModules.erase(state->spirvModuleRetentionIt);
+}
+
+void ShaderCompiler::EvictModules() {
+    std::lock_guard guard(retentionMutex);
+
+    // Walk from the least recently used
+    for (auto it = retainedModules.end(); retainedBytes > retentionBudget && it != retainedModules.begin();) {
+        ShaderModuleState* state = *--it;
+
+        // Lock order is always retention then state
+        std::lock_guard stateGuard(state->mutex);
+
+        // Pinned modules are in use
+        if (state->spirvModulePinCount) {
+            continue;
+        }
+
+        // Release the parsed module and the originating code, the compressed code remains
+        if (state->spirvModule) {
+            destroy(state->spirvModule, allocators);
+            state->spirvModule = nullptr;
+        }
+        state->code.clear();
+        state->code.shrink_to_fit();
+
+        // No longer tracked
+        retainedBytes -= state->codeSize * kModuleResidencyFactor;
+        state->spirvModuleRetained = false;
+        it = retainedModules.erase(it);
+    }
+}
+
 void ShaderCompiler::Worker(void *data) {
     auto *job = static_cast<ShaderJobEntry *>(data);
     
@@ -150,20 +279,38 @@ bool ShaderCompiler::CompileShader(const ShaderJobEntry &job) {
     std::vector<uint8_t> debugBinary((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
 
     // Hack the code
-    job.info.state->createInfoDeepCopy.createInfo.pCode = reinterpret_cast<const uint32_t*>(debugBinary.data());
-    job.info.state->createInfoDeepCopy.createInfo.codeSize = debugBinary.size();
+    {
+        std::lock_guard guard(job.info.state->mutex);
+        job.info.state->code.assign(reinterpret_cast<const uint32_t*>(debugBinary.data()), reinterpret_cast<const uint32_t*>(debugBinary.data() + debugBinary.size()));
+        job.info.state->codeSize = debugBinary.size();
+    }
 #endif
 
-    // Diagnostic scope
-    DiagnosticBucketScope scope(job.info.diagnostic->messages, job.info.state->uid);
+    // Ensure state is initialized, pinned for the duration of the compilation
+    bool initialized = InitializeModule(job.info.state);
+
+    // Compile against the pinned module
+    bool result = initialized && CompileModule(job);
 
-    // Ensure state is initialized
-    if (!InitializeModule(job.info.state)) {
+    // Module may now be evicted
+    ReleaseModule(job.info.state);
+
+    // Failed to parse?
+    if (!initialized) {
+        DiagnosticBucketScope scope(job.info.diagnostic->messages, job.info.state->uid);
         scope.Add(DiagnosticType::ShaderParsingFailed);
         ++job.info.diagnostic->failedJobs;
         return false;
     }
 
+    // OK
+    return result;
+}
+
+bool ShaderCompiler::CompileModule(const ShaderJobEntry &job) {
+    // Diagnostic scope
+    DiagnosticBucketScope scope(job.info.diagnostic->messages, job.info.state->uid);
+
     // Passed initial check?
     bool validSource{true};
 
@@ -174,10 +321,10 @@ bool ShaderCompiler::CompileShader(const ShaderJobEntry &job) {
         debugPath = debug->AllocatePath(job.info.state->spirvModule);
 
         // Dump source
-        debug->Add(debugPath, "source", job.info.state->spirvModule, job.info.state->createInfoDeepCopy.createInfo.pCode, job.info.state->createInfoDeepCopy.createInfo.codeSize);
+        debug->Add(debugPath, "source", job.info.state->spirvModule, job.info.state->code.data(), job.info.state->codeSize);
 
         // Validate the source module
-        validSource = debug->Validate(job.info.state->createInfoDeepCopy.createInfo.pCode, job.info.state->createInfoDeepCopy.createInfo.codeSize / sizeof(uint32_t));
+        validSource = debug->Validate(job.info.state->code.data(), job.info.state->code.size());
     }
 
     // Create a copy of the module, don't modify the source
@@ -188,6 +335,9 @@ bool ShaderCompiler::CompileShader(const ShaderJobEntry &job) {
     spvJob.instrumentationKey = job.info.instrumentationKey;
     spvJob.bindingInfo = shaderExportDescriptorAllocator->GetBindingInfo();
     spvJob.messages = scope;
+    spvJob.exportTypeInfos = exportTypeInfos.data();
+    spvJob.exportBudgetDataID = job.instrumentationKey.exportBudgets ? exportBudgetDataID : InvalidShaderDataID;
+    spvJob.exportRingMask = shaderExportStreamAllocator->LatchRingMask();
 
     // Specialize the module
     module->Specialize(spvJob);
@@ -210,6 +360,19 @@ bool ShaderCompiler::CompileShader(const ShaderJobEntry &job) {
         shaderFeatures[i]->PreInject(*module->GetProgram(), *job.info.dependentSpecialization);
     }
 
+    // Shared guard plan, checks across features are fused per instruction
+    IL::GuardPlan guardPlan;
+
+    // Plan all guards
+    for (size_t i = 0; i < shaderFeatures.size(); i++) {
+        if (!(job.info.instrumentationKey.featureBitSet & (1ull << i))) {
+            continue;
+        }
+
+        // Plan marked shader feature
+        shaderFeatures[i]->PlanGuards(guardPlan, *module->GetProgram(), *job.info.dependentSpecialization);
+    }
+
     // Pass through all features
     for (size_t i = 0; i < shaderFeatures.size(); i++) {
         if (!(job.info.instrumentationKey.featureBitSet & (1ull << i))) {
@@ -220,10 +383,13 @@ bool ShaderCompiler::CompileShader(const ShaderJobEntry &job) {
         shaderFeatures[i]->Inject(*module->GetProgram(), *job.info.dependentSpecialization);
     }
 
+    // Emit all fused guards
+    guardPlan.Apply(*module->GetProgram());
+
     // Recompile the program
     if (!module->Recompile(
-        job.info.state->createInfoDeepCopy.createInfo.pCode,
-        static_cast<uint32_t>(job.info.state->createInfoDeepCopy.createInfo.codeSize / 4u),
+        job.info.state->code.data(),
+        static_cast<uint32_t>(job.info.state->code.size()),
         spvJob
     )) {
         scope.Add(DiagnosticType::ShaderInternalCompilerError);
@@ -93,6 +93,11 @@ bool SpvModule::Specialize(const SpvJob &job) {
 
 bool SpvModule::Recompile(const uint32_t *code, uint32_t wordCount, const SpvJob& job) {
     for (IL::Function* fn : program->GetFunctionList()) {
+        // Verbatim functions keep their source layout
+        if (physicalBlockTable->function.IsVerbatimFunction(*fn)) {
+            continue;
+        }
+        
         if (!fn->ReorderByDominantBlocks(true)) {
             return false;
         }
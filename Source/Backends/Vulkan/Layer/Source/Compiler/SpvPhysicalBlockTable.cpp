@@ -104,6 +104,9 @@ bool SpvPhysicalBlockTable::Compile(const SpvJob &job) {
         return false;
     }
 
+    // Compile the shared export functions
+    shaderExport.CompileBudgetFunction();
+
     // Compile dynamic constant data
     typeConstantVariable.CompileConstants();
 
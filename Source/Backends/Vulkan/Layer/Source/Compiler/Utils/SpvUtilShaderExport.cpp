@@ -28,6 +28,9 @@
 #include <Backends/Vulkan/Compiler/SpvPhysicalBlockTable.h>
 #include <Backends/Vulkan/Compiler/SpvJob.h>
 
+// Backend
+#include <Backend/ShaderExport.h>
+
 SpvUtilShaderExport::SpvUtilShaderExport(const Allocators &allocators, IL::Program &program, SpvPhysicalBlockTable &table) :
     allocators(allocators),
     program(program),
@@ -122,6 +125,18 @@ void SpvUtilShaderExport::CompileRecords(const SpvJob &job) {
     // Add to all entry points
     table.entryPoint.AddInterface(SpvStorageClassUniform, counterId);
     table.entryPoint.AddInterface(SpvStorageClassUniform, streamId);
+
+    // Budgets are only lowered if the budget data has been installed
+    if (job.exportTypeInfos && job.exportBudgetDataID != InvalidShaderDataID) {
+        budgetVariable = program.GetShaderDataMap().Get(job.exportBudgetDataID);
+        exportTypeInfos = job.exportTypeInfos;
+
+        // Budget counters succeed all stream counters
+        budgetCounterOffset = job.bindingInfo.streamDescriptorCount;
+    }
+
+    // Persistent rings?
+    ringMask = job.exportRingMask;
 }
 
 void SpvUtilShaderExport::Export(SpvStream &stream, uint32_t exportID, const IL::ID* values, uint32_t valueCount) {
@@ -191,6 +206,22 @@ void SpvUtilShaderExport::Export(SpvStream &stream, uint32_t exportID, const IL:
     texelPtr[4] = streamOffsetId;
     texelPtr[5] = zeroUintId;
 
+    // Budgeted exports only allocate while the sguid is within its limit
+    uint32_t withinBudgetId = IL::InvalidID;
+    if (budgetVariable && exportTypeInfos[exportID].budgeted) {
+        withinBudgetId = ExportBudget(stream, values[0]);
+
+        // Mask the allocation size
+        uint32_t addition = table.scan.header.bound++;
+        SpvInstruction &select = stream.Allocate(SpvOpSelect, 6);
+        select[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(uintType);
+        select[2] = addition;
+        select[3] = withinBudgetId;
+        select[4] = offsetAdditionId;
+        select[5] = zeroUintId;
+        offsetAdditionId = addition;
+    }
+
     uint32_t atomicPositionId = table.scan.header.bound++;
 
     // Atomically increment the texel
@@ -202,6 +233,44 @@ void SpvUtilShaderExport::Export(SpvStream &stream, uint32_t exportID, const IL:
     atom[5] = memSemanticId;
     atom[6] = offsetAdditionId;
 
+    // Out of budget writes are redirected past the end of the stream, which are discarded
+    uint32_t discardOffsetId = IL::InvalidID;
+    if (withinBudgetId != IL::InvalidID) {
+        discardOffsetId = table.scan.header.bound++;
+
+        // Discard offset
+        SpvInstruction &spvDiscard = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+        spvDiscard[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(uintType);
+        spvDiscard[2] = discardOffsetId;
+        spvDiscard[3] = kShaderExportBudgetDiscardOffset;
+
+        // Rings wrap every dword, so the redirection happens per write instead
+        if (!ringMask) {
+            uint32_t positionId = table.scan.header.bound++;
+
+            // Select the final position
+            SpvInstruction &select = stream.Allocate(SpvOpSelect, 6);
+            select[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(uintType);
+            select[2] = positionId;
+            select[3] = withinBudgetId;
+            select[4] = atomicPositionId;
+            select[5] = discardOffsetId;
+            atomicPositionId = positionId;
+        }
+    }
+
+    // Persistent rings mask the monotonic head
+    uint32_t ringMaskId = IL::InvalidID;
+    if (ringMask) {
+        ringMaskId = table.scan.header.bound++;
+
+        // Ring mask
+        SpvInstruction &spvMask = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+        spvMask[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(uintType);
+        spvMask[2] = ringMaskId;
+        spvMask[3] = ringMask;
+    }
+
     uint32_t accessId = table.scan.header.bound++;
 
     // Get the destination stream
@@ -219,44 +288,332 @@ void SpvUtilShaderExport::Export(SpvStream &stream, uint32_t exportID, const IL:
     load[2] = accessLoadId;
     load[3] = accessId;
 
-    // Write to the stream
-    SpvInstruction &write = stream.Allocate(SpvOpImageWrite, 5);
-    write[1] = accessLoadId;
-    write[2] = atomicPositionId;
-    write[3] = values[0];
-    write[4] = SpvImageOperandsMaskNone;
-
-    // Write successive values
-    for (uint32_t i = 1; i < valueCount; i++) {
-        uint32_t offsetId = table.scan.header.bound++;
-        uint32_t addId = table.scan.header.bound++;
-        
-        // Constant offset
-        // TODO: Finish the constant map for spirv, the amount of bloat is excessive
-        SpvInstruction &offset = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
-        offset[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(uintType);
-        offset[2] = offsetId;
-        offset[3] = i;
-
-        // AtomicOffset + i
-        SpvInstruction& add = stream.Allocate(SpvOpIAdd, 5);
-        add[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(uintType);
-        add[2] = addId;
-        add[3] = atomicPositionId;
-        add[4] = offsetId;
+    // Write all values
+    for (uint32_t i = 0; i < valueCount; i++) {
+        uint32_t writeOffsetId = atomicPositionId;
+
+        // Successive value?
+        if (i) {
+            uint32_t offsetId = table.scan.header.bound++;
+            uint32_t addId = table.scan.header.bound++;
+
+            // Constant offset
+            // TODO: Finish the constant map for spirv, the amount of bloat is excessive
+            SpvInstruction &offset = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+            offset[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(uintType);
+            offset[2] = offsetId;
+            offset[3] = i;
+
+            // AtomicOffset + i
+            SpvInstruction& add = stream.Allocate(SpvOpIAdd, 5);
+            add[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(uintType);
+            add[2] = addId;
+            add[3] = atomicPositionId;
+            add[4] = offsetId;
+            writeOffsetId = addId;
+        }
+
+        // Wrap around the ring
+        if (ringMaskId != IL::InvalidID) {
+            uint32_t wrapId = table.scan.header.bound++;
+
+            // Offset & Mask
+            SpvInstruction& wrap = stream.Allocate(SpvOpBitwiseAnd, 5);
+            wrap[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(uintType);
+            wrap[2] = wrapId;
+            wrap[3] = writeOffsetId;
+            wrap[4] = ringMaskId;
+            writeOffsetId = wrapId;
+
+            // Redirect out of budget writes
+            if (discardOffsetId != IL::InvalidID) {
+                uint32_t positionId = table.scan.header.bound++;
+
+                // Select the final position
+                SpvInstruction &select = stream.Allocate(SpvOpSelect, 6);
+                select[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(uintType);
+                select[2] = positionId;
+                select[3] = withinBudgetId;
+                select[4] = writeOffsetId;
+                select[5] = discardOffsetId;
+                writeOffsetId = positionId;
+            }
+        }
 
         // Write to the stream
-        SpvInstruction &postWrite = stream.Allocate(SpvOpImageWrite, 5);
-        postWrite[1] = accessLoadId;
-        postWrite[2] = addId;
-        postWrite[3] = values[i];
-        postWrite[4] = SpvImageOperandsMaskNone;
+        SpvInstruction &write = stream.Allocate(SpvOpImageWrite, 5);
+        write[1] = accessLoadId;
+        write[2] = writeOffsetId;
+        write[3] = values[i];
+        write[4] = SpvImageOperandsMaskNone;
+    }
+}
+
+uint32_t SpvUtilShaderExport::ExportBudget(SpvStream &stream, uint32_t sguid) {
+    Backend::IL::TypeMap &ilTypeMap = program.GetTypeMap();
+
+    // The check is shared by all exports of the module
+    if (budgetFunctionId == IL::InvalidID) {
+        budgetFunctionId = table.scan.header.bound++;
+    }
+
+    // Call the check, control flow cannot be introduced within the current block
+    uint32_t withinBudgetId = table.scan.header.bound++;
+    SpvInstruction &call = stream.Allocate(SpvOpFunctionCall, 5);
+    call[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(ilTypeMap.FindTypeOrAdd(Backend::IL::BoolType{}));
+    call[2] = withinBudgetId;
+    call[3] = budgetFunctionId;
+    call[4] = sguid;
+
+    // OK
+    return withinBudgetId;
+}
+
+void SpvUtilShaderExport::CompileBudgetFunction() {
+    Backend::IL::TypeMap &ilTypeMap = program.GetTypeMap();
+
+    // Not used by any export?
+    if (budgetFunctionId == IL::InvalidID) {
+        return;
     }
+
+    // Functions are appended after all program functions
+    SpvStream& stream = table.function.block->stream;
+
+    // Bool
+    const Backend::IL::Type *boolType = ilTypeMap.FindTypeOrAdd(Backend::IL::BoolType{});
+
+    // UInt32
+    const Backend::IL::Type *uintType = ilTypeMap.FindTypeOrAdd(Backend::IL::IntType{
+        .bitWidth = 32,
+        .signedness = false
+    });
+
+    // Uint32*
+    const Backend::IL::Type *uintImagePtrType = ilTypeMap.FindTypeOrAdd(Backend::IL::PointerType{
+        .pointee = uintType,
+        .addressSpace = Backend::IL::AddressSpace::Texture
+    });
+
+    // UInt32x4
+    const Backend::IL::Type *uint4Type = ilTypeMap.FindTypeOrAdd(Backend::IL::VectorType{
+        .containedType = uintType,
+        .dimension = 4
+    });
+
+    // bool(uint32)
+    Backend::IL::FunctionType typeFunction;
+    typeFunction.returnType = boolType;
+    typeFunction.parameterTypes.push_back(uintType);
+    const Backend::IL::Type *functionType = ilTypeMap.FindTypeOrAdd(typeFunction);
+
+    // Spv types
+    SpvId boolTypeId = table.typeConstantVariable.typeMap.GetSpvTypeId(boolType);
+    SpvId uintTypeId = table.typeConstantVariable.typeMap.GetSpvTypeId(uintType);
+
+    // Constant identifiers
+    uint32_t slotMaskId = table.scan.header.bound++;
+    uint32_t counterOffsetId = table.scan.header.bound++;
+    uint32_t oneId = table.scan.header.bound++;
+    uint32_t zeroId = table.scan.header.bound++;
+    uint32_t falseId = table.scan.header.bound++;
+    uint32_t scopeId = table.scan.header.bound++;
+    uint32_t memSemanticId = table.scan.header.bound++;
+
+    // Slot mask
+    SpvInstruction &spvMask = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+    spvMask[1] = uintTypeId;
+    spvMask[2] = slotMaskId;
+    spvMask[3] = kShaderExportBudgetSlotCount - 1;
+
+    // Offset of the budget counters
+    SpvInstruction &spvOffset = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+    spvOffset[1] = uintTypeId;
+    spvOffset[2] = counterOffsetId;
+    spvOffset[3] = budgetCounterOffset;
+
+    // 1
+    SpvInstruction &spvOne = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+    spvOne[1] = uintTypeId;
+    spvOne[2] = oneId;
+    spvOne[3] = 1;
+
+    // 0
+    SpvInstruction &spvZero = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+    spvZero[1] = uintTypeId;
+    spvZero[2] = zeroId;
+    spvZero[3] = 0;
+
+    // False
+    SpvInstruction &spvFalse = table.typeConstantVariable.block->stream.Allocate(SpvOpConstantFalse, 3);
+    spvFalse[1] = boolTypeId;
+    spvFalse[2] = falseId;
+
+    // Device scope
+    SpvInstruction &spvScope = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+    spvScope[1] = uintTypeId;
+    spvScope[2] = scopeId;
+    spvScope[3] = SpvScopeDevice;
+
+    // No memory mask
+    SpvInstruction &spvMemSem = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+    spvMemSem[1] = uintTypeId;
+    spvMemSem[2] = memSemanticId;
+    spvMemSem[3] = SpvMemorySemanticsMaskNone;
+
+    // Block identifiers
+    uint32_t sguidId = table.scan.header.bound++;
+    uint32_t entryLabelId = table.scan.header.bound++;
+    uint32_t reportLabelId = table.scan.header.bound++;
+    uint32_t mergeLabelId = table.scan.header.bound++;
+
+    // Emit function open
+    SpvInstruction& spvFn = stream.Allocate(SpvOpFunction, 5);
+    spvFn[1] = boolTypeId;
+    spvFn[2] = budgetFunctionId;
+    spvFn[3] = SpvFunctionControlMaskNone;
+    spvFn[4] = table.typeConstantVariable.typeMap.GetSpvTypeId(functionType);
+
+    // The first exported dword, containing the sguid
+    SpvInstruction& spvParam = stream.Allocate(SpvOpFunctionParameter, 3);
+    spvParam[1] = uintTypeId;
+    spvParam[2] = sguidId;
+
+    // Entry block
+    SpvInstruction& spvEntry = stream.Allocate(SpvOpLabel, 2);
+    spvEntry[1] = entryLabelId;
+
+    // The sguid always occupies the lower bits of the first dword
+    uint32_t slotId = table.scan.header.bound++;
+    SpvInstruction &spvSlot = stream.Allocate(SpvOpBitwiseAnd, 5);
+    spvSlot[1] = uintTypeId;
+    spvSlot[2] = slotId;
+    spvSlot[3] = sguidId;
+    spvSlot[4] = slotMaskId;
+
+    // Counter index of the slot
+    uint32_t counterIndexId = table.scan.header.bound++;
+    SpvInstruction &spvIndex = stream.Allocate(SpvOpIAdd, 5);
+    spvIndex[1] = uintTypeId;
+    spvIndex[2] = counterIndexId;
+    spvIndex[3] = slotId;
+    spvIndex[4] = counterOffsetId;
+
+    // Get the address of the report counter
+    uint32_t texelPtrId = table.scan.header.bound++;
+    SpvInstruction &texelPtr = stream.Allocate(SpvOpImageTexelPointer, 6);
+    texelPtr[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(uintImagePtrType);
+    texelPtr[2] = texelPtrId;
+    texelPtr[3] = counterId;
+    texelPtr[4] = counterIndexId;
+    texelPtr[5] = zeroId;
+
+    // Load the limit buffer
+    uint32_t limitBufferId = table.scan.header.bound++;
+    SpvInstruction &load = stream.Allocate(SpvOpLoad, 4);
+    load[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(budgetVariable->type->As<Backend::IL::PointerType>()->pointee);
+    load[2] = limitBufferId;
+    load[3] = budgetVariable->id;
+
+    // Read the limit
+    uint32_t limitTexelId = table.scan.header.bound++;
+    SpvInstruction &read = stream.Allocate(SpvOpImageRead, 5);
+    read[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(uint4Type);
+    read[2] = limitTexelId;
+    read[3] = limitBufferId;
+    read[4] = slotId;
+
+    // Limit is stored in the first component
+    uint32_t limitId = table.scan.header.bound++;
+    SpvInstruction &extract = stream.Allocate(SpvOpCompositeExtract, 5);
+    extract[1] = uintTypeId;
+    extract[2] = limitId;
+    extract[3] = limitTexelId;
+    extract[4] = 0;
+
+    // Read the current number of reports, exhausted sites never touch the counter atomically
+    uint32_t currentId = table.scan.header.bound++;
+    SpvInstruction &current = stream.Allocate(SpvOpAtomicLoad, 6);
+    current[1] = uintTypeId;
+    current[2] = currentId;
+    current[3] = texelPtrId;
+    current[4] = scopeId;
+    current[5] = memSemanticId;
+
+    // Possibly within budget?
+    uint32_t candidateId = table.scan.header.bound++;
+    SpvInstruction &candidate = stream.Allocate(SpvOpULessThan, 5);
+    candidate[1] = boolTypeId;
+    candidate[2] = candidateId;
+    candidate[3] = currentId;
+    candidate[4] = limitId;
+
+    // Selection construct
+    SpvInstruction &selection = stream.Allocate(SpvOpSelectionMerge, 3);
+    selection[1] = mergeLabelId;
+    selection[2] = SpvSelectionControlMaskNone;
+
+    // Only report if possibly within budget
+    SpvInstruction &branch = stream.Allocate(SpvOpBranchConditional, 4);
+    branch[1] = candidateId;
+    branch[2] = reportLabelId;
+    branch[3] = mergeLabelId;
+
+    // Report block
+    SpvInstruction& spvReport = stream.Allocate(SpvOpLabel, 2);
+    spvReport[1] = reportLabelId;
+
+    // Atomically increment the number of reports
+    uint32_t reportedId = table.scan.header.bound++;
+    SpvInstruction &atom = stream.Allocate(SpvOpAtomicIAdd, 7);
+    atom[1] = uintTypeId;
+    atom[2] = reportedId;
+    atom[3] = texelPtrId;
+    atom[4] = scopeId;
+    atom[5] = memSemanticId;
+    atom[6] = oneId;
+
+    // Other invocations may have exhausted the budget since
+    uint32_t reportedWithinBudgetId = table.scan.header.bound++;
+    SpvInstruction &cmp = stream.Allocate(SpvOpULessThan, 5);
+    cmp[1] = boolTypeId;
+    cmp[2] = reportedWithinBudgetId;
+    cmp[3] = reportedId;
+    cmp[4] = limitId;
+
+    // Join
+    SpvInstruction &join = stream.Allocate(SpvOpBranch, 2);
+    join[1] = mergeLabelId;
+
+    // Merge block
+    SpvInstruction& spvMerge = stream.Allocate(SpvOpLabel, 2);
+    spvMerge[1] = mergeLabelId;
+
+    // Exhausted sites are never within budget
+    uint32_t withinBudgetId = table.scan.header.bound++;
+    SpvInstruction &phi = stream.Allocate(SpvOpPhi, 7);
+    phi[1] = boolTypeId;
+    phi[2] = withinBudgetId;
+    phi[3] = reportedWithinBudgetId;
+    phi[4] = reportLabelId;
+    phi[5] = falseId;
+    phi[6] = entryLabelId;
+
+    // Return the budget state
+    SpvInstruction &ret = stream.Allocate(SpvOpReturnValue, 2);
+    ret[1] = withinBudgetId;
+
+    // Emit function close
+    stream.Allocate(SpvOpFunctionEnd, 1);
 }
 
 void SpvUtilShaderExport::CopyTo(SpvPhysicalBlockTable &remote, SpvUtilShaderExport &out) {
     out.counterId = counterId;
     out.streamId = streamId;
+    out.exportTypeInfos = exportTypeInfos;
+    out.budgetVariable = budgetVariable;
+    out.budgetCounterOffset = budgetCounterOffset;
+    out.ringMask = ringMask;
     out.buffer32UIRWArrayPtr = buffer32UIRWArrayPtr;
     out.buffer32UIRWPtr = buffer32UIRWPtr;
     out.buffer32UIRW = buffer32UIRW;
@@ -34,10 +34,13 @@
 #include <Backends/Vulkan/States/PipelineState.h>
 #include <Backends/Vulkan/CommandBuffer.h>
 #include <Backends/Vulkan/Symbolizer/ShaderSGUIDHost.h>
+#include <Backends/Vulkan/Export/ShaderExportStreamAllocator.h>
 #include <Backends/Vulkan/Compiler/Diagnostic/DiagnosticPrettyPrint.h>
 
 // Backend
 #include <Backend/IFeature.h>
+#include <Backend/IShaderExportAggregator.h>
+#include <Backend/ShaderExportBudgetHost.h>
 
 // Bridge
 #include <Bridge/IBridge.h>
@@ -70,6 +73,9 @@ bool InstrumentationController::Install() {
     shaderCompiler = registry->Get<ShaderCompiler>();
     pipelineCompiler = registry->Get<PipelineCompiler>();
     dispatcher = registry->Get<Dispatcher>();
+    aggregator = registry->Get<IShaderExportAggregator>();
+    exportBudgetHost = registry->Get<ShaderExportBudgetHost>();
+    streamAllocator = registry->Get<ShaderExportStreamAllocator>();
 
     auto bridge = registry->Get<IBridge>();
     bridge->Register(this);
@@ -329,6 +335,46 @@ void InstrumentationController::OnMessage(const ConstMessageStreamView<>::ConstI
             synchronousRecording = message->synchronousRecording;
             break;
         }
+        case SetApplicationExportAggregationMessage::kID: {
+            auto *message = it.Get<SetApplicationExportAggregationMessage>();
+            if (aggregator) {
+                aggregator->SetWindow(static_cast<uint64_t>(message->windowMS) * 1'000'000ull);
+            }
+            break;
+        }
+        case SetApplicationExportRingMessage::kID: {
+            auto *message = it.Get<SetApplicationExportRingMessage>();
+            if (!streamAllocator->SetRingMode(message->dwordCount)) {
+                table->parent->logBuffer.Add("Vulkan", LogSeverity::Warning, "Export ring mode must be set before the first instrumentation or submission");
+            }
+            break;
+        }
+        case SetShaderExportBudgetMessage::kID: {
+            auto *message = it.Get<SetShaderExportBudgetMessage>();
+            if (exportBudgetHost) {
+                bool configured = exportBudgetHost->IsConfigured();
+                exportBudgetHost->SetBudget(message->sguid, message->limit);
+
+                // Budget checks are instrumented, re-instrument everything on changes
+                if (configured != exportBudgetHost->IsConfigured()) {
+                    MarkAllDirty();
+                }
+            }
+            break;
+        }
+        case ResetShaderExportBudgetsMessage::kID: {
+            auto *message = it.Get<ResetShaderExportBudgetsMessage>();
+            if (exportBudgetHost) {
+                bool configured = exportBudgetHost->IsConfigured();
+                exportBudgetHost->ResetBudgets(message->limit);
+
+                // Budget checks are instrumented, re-instrument everything on changes
+                if (configured != exportBudgetHost->IsConfigured()) {
+                    MarkAllDirty();
+                }
+            }
+            break;
+        }
         case InstrumentationVersionMessage::kID: {
             versionID = it.Get<InstrumentationVersionMessage>()->version;
             break;
@@ -367,36 +413,8 @@ void InstrumentationController::OnMessage(const ConstMessageStreamView<>::ConstI
             // Apply instrumentation
             SetInstrumentationInfo(globalInstrumentationInfo, message->featureBitSet, message->specialization);
 
-            // Add all shader modules
-            for (ShaderModuleState *state: table->states_shaderModule.GetLinear()) {
-                if (immediateBatch.dirtyObjects.count(state)) {
-                    continue;
-                }
-
-                // Own lifetime
-                state->AddUser();
-
-                immediateBatch.dirtyObjects.insert(state);
-                immediateBatch.dirtyShaderModules.push_back(state);
-            }
-
-            // Add all pipelines modules
-            for (PipelineState *state: table->states_pipeline.GetLinear()) {
-                if (immediateBatch.dirtyObjects.count(state)) {
-                    continue;
-                }
-
-                // Own lifetime
-                state->AddUser();
-
-                immediateBatch.dirtyObjects.insert(state);
-
-                if (state->isLibrary) {
-                    immediateBatch.dirtyPipelineLibraries.push_back(state);
-                } else {
-                    immediateBatch.dirtyPipelines.push_back(state);
-                }
-            }
+            // Add all objects
+            MarkAllDirty();
             break;
         }
 
@@ -704,6 +722,39 @@ void InstrumentationController::SetInstrumentationInfo(InstrumentationInfo &info
     stream.Transfer(info.specialization);
 }
 
+void InstrumentationController::MarkAllDirty() {
+    // Add all shader modules
+    for (ShaderModuleState *state: table->states_shaderModule.GetLinear()) {
+        if (immediateBatch.dirtyObjects.count(state)) {
+            continue;
+        }
+
+        // Own lifetime
+        state->AddUser();
+
+        immediateBatch.dirtyObjects.insert(state);
+        immediateBatch.dirtyShaderModules.push_back(state);
+    }
+
+    // Add all pipelines modules
+    for (PipelineState *state: table->states_pipeline.GetLinear()) {
+        if (immediateBatch.dirtyObjects.count(state)) {
+            continue;
+        }
+
+        // Own lifetime
+        state->AddUser();
+
+        immediateBatch.dirtyObjects.insert(state);
+
+        if (state->isLibrary) {
+            immediateBatch.dirtyPipelineLibraries.push_back(state);
+        } else {
+            immediateBatch.dirtyPipelines.push_back(state);
+        }
+    }
+}
+
 void InstrumentationController::CommitInstrumentation() {
     uint64_t featureBitSet = 0;
     
@@ -878,6 +929,9 @@ void InstrumentationController::CommitShaders(DispatcherBucket* bucket, void *da
     // Reset counters
     std::fill_n(batch->stageCounters, static_cast<uint32_t>(PipelineType::Count), 0u);
 
+    // Budget checks are only instrumented while any site is limited
+    const bool exportBudgets = exportBudgetHost && exportBudgetHost->IsConfigured();
+
     // Submit compiler jobs
     for (ShaderModuleState* state : batch->dirtyShaderModules) {
         uint64_t shaderFeatureBitSet = state->instrumentationInfo.featureBitSet;
@@ -920,6 +974,7 @@ void InstrumentationController::CommitShaders(DispatcherBucket* bucket, void *da
             instrumentationKey.pipelineLayoutPRMTPCOffset = pipelineLayoutPRMTPCOffset;
 #endif // PRMT_METHOD == PRMT_METHOD_UB_PC
             instrumentationKey.physicalMapping = &dependentObject->layout->physicalMapping;
+            instrumentationKey.exportBudgets = exportBudgets;
 
             // Combine hashes
             instrumentationKey.combinedHash = dependentObject->instrumentationInfo.specializationHash;
@@ -930,6 +985,7 @@ void InstrumentationController::CommitShaders(DispatcherBucket* bucket, void *da
             CombineHash(instrumentationKey.combinedHash, instrumentationKey.pipelineLayoutPRMTPCOffset);
 #endif // PRMT_METHOD == PRMT_METHOD_UB_PC
             CombineHash(instrumentationKey.combinedHash, instrumentationKey.physicalMapping->layoutHash);
+            CombineHash(instrumentationKey.combinedHash, instrumentationKey.exportBudgets);
 
             // Determine the shader module index within the dependent object
             uint64_t dependentIndex = dependentObject->GetDependentIndex(state);
@@ -181,10 +181,8 @@ void MetadataController::OnMessage(const GetShaderCodeMessage& message) {
     // Attempt to find shader with given UID
     ShaderModuleState* shader = table->states_shaderModule.GetFromUID(message.shaderUID);
 
-    // Create module if not present
-    if (shaderCompiler && shader && !shader->spirvModule) {
-        shaderCompiler->InitializeModule(shader);
-    }
+    // Create module if not present, pinned for the duration of the request
+    ShaderModuleScope moduleScope(shaderCompiler.GetUnsafe(), shader);
 
     // Failed?
     if (!shader || !shader->spirvModule) {
@@ -251,10 +249,8 @@ void MetadataController::OnMessage(const GetShaderILMessage& message) {
     // Attempt to find shader with given UID
     ShaderModuleState* shader = table->states_shaderModule.GetFromUID(message.shaderUID);
 
-    // Create module if not present
-    if (shaderCompiler && shader && !shader->spirvModule) {
-        shaderCompiler->InitializeModule(shader);
-    }
+    // Create module if not present, pinned for the duration of the request
+    ShaderModuleScope moduleScope(shaderCompiler.GetUnsafe(), shader);
 
     // Failed?
     if (!shader || !shader->spirvModule) {
@@ -281,10 +277,8 @@ void MetadataController::OnMessage(const GetShaderBlockGraphMessage& message) {
     // Attempt to find shader with given UID
     ShaderModuleState* shader = table->states_shaderModule.GetFromUID(message.shaderUID);
 
-    // Create module if not present
-    if (shaderCompiler && shader && !shader->spirvModule) {
-        shaderCompiler->InitializeModule(shader);
-    }
+    // Create module if not present, pinned for the duration of the request
+    ShaderModuleScope moduleScope(shaderCompiler.GetUnsafe(), shader);
 
     // Failed?
     if (!shader || !shader->spirvModule) {
@@ -392,6 +386,9 @@ void MetadataController::OnMessage(const struct GetShaderSourceMappingMessage& m
     // Get mapping
     ShaderSourceMapping mapping = table->sguidHost->GetMapping(static_cast<uint32_t>(message.sguid));
 
+    // Ensure the module is resident while the contents are read
+    ShaderModuleScope moduleScope(shaderCompiler.GetUnsafe(), table->states_shaderModule.GetFromUID(mapping.shaderGUID));
+
     // Get contents
     std::string_view sourceContents = table->sguidHost->GetSource(static_cast<uint32_t>(message.sguid));
 
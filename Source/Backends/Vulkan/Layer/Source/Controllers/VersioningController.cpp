@@ -42,8 +42,13 @@
 // Common
 #include <Common/Format.h>
 
-VersioningController::VersioningController(DeviceDispatchTable *table) : table(table) {
+// Std
+#include <algorithm>
+#include <thread>
 
+VersioningController::VersioningController(DeviceDispatchTable *table) : table(table) {
+    // Reserve the unnamed identifier
+    names.emplace_back();
 }
 
 bool VersioningController::Install() {
@@ -78,12 +83,20 @@ void VersioningController::Handle(const MessageStream *streams, uint32_t count)
                     OnMessage(*it.Get<GetVersionSummarizationMessage>());
                     break;
                 }
+                case GetVersionDeltaMessage::kID: {
+                    OnMessage(*it.Get<GetVersionDeltaMessage>());
+                    break;
+                }
             }
         }
     }
 }
 
 void VersioningController::OnMessage(const GetVersionSummarizationMessage& message) {
+    Summarize();
+}
+
+void VersioningController::Summarize() {
     // Ordered stream
     MessageStreamView view(stream);
 
@@ -109,55 +122,210 @@ void VersioningController::OnMessage(const GetVersionSummarizationMessage& messa
     }
 }
 
-void VersioningController::CreateOrRecommitImage(ImageState *state) {
-    std::lock_guard guard(mutex);
-    pendingCommit = true;
+void VersioningController::OnMessage(const GetVersionDeltaMessage& message) {
+    // Ordered stream
+    MessageStreamView view(stream);
 
-    // Immediately commit
-    MessageStreamView<ResourceVersionMessage> resourceView(resourceStream);
-    CommitImageVersion(resourceView, state);
+    // Get the current log version, everything prior to the flushed count is readable
+    const uint32_t logVersion = log.GetReadableCount(flushedLogCount);
+
+    // Clamp the requested range
+    uint32_t sinceVersion = std::min(message.sinceVersion, logVersion);
+
+    // Entries below the base have been released, resynchronize the client with a full summary
+    if (sinceVersion < log.GetBase()) {
+        Summarize();
+        sinceVersion = logVersion;
+    }
+
+    // Everything prior is known to the client, and may be released
+    acknowledgedLogVersion = std::max(acknowledgedLogVersion, sinceVersion);
+
+    // Names are shared with appenders
+    std::lock_guard nameGuard(nameMutex);
+
+    // Intern all formats and fallback names first, the names must precede the changes
+    for (uint32_t i = sinceVersion; i < logVersion; i++) {
+        const LogEntry& entry = log.Get(i);
+
+        if (entry.format) {
+            InternNameNoLock(entry.format);
+        }
+
+        InternEntryNameNoLock(entry);
+    }
+
+    // Get name range
+    const uint32_t nameCount = static_cast<uint32_t>(names.size());
+    const uint32_t knownNameCount = std::min(message.knownNameCount, nameCount);
+
+    // Push header
+    auto&& delta = view.Add<VersionDeltaMessage>();
+    delta->head = head.load(std::memory_order_relaxed);
+    delta->sinceVersion = sinceVersion;
+    delta->logVersion = logVersion;
+    delta->nameCount = nameCount;
+
+    // Push all names unknown to the client
+    for (uint32_t i = knownNameCount; i < nameCount; i++) {
+        auto&& name = view.Add<ResourceNameMessage>(ResourceNameMessage::AllocationInfo {
+            .nameLength = names[i].length()
+        });
+        name->nameID = i;
+        name->name.Set(names[i]);
+    }
+
+    // Push all changes
+    for (uint32_t i = sinceVersion; i < logVersion; i++) {
+        const LogEntry& entry = log.Get(i);
+
+        auto&& version = view.Add<ResourceVersionDeltaMessage>();
+        version->puid = entry.puid;
+        version->version = entry.version;
+        version->nameID = InternEntryNameNoLock(entry);
+        version->formatID = entry.format ? InternNameNoLock(entry.format) : 0u;
+        version->width = entry.width;
+        version->height = entry.height;
+        version->depth = entry.depth;
+    }
+}
+
+void VersioningController::CreateOrRecommitImage(ImageState *state) {
+    Append(LogEntry {
+        .puid = state->virtualMappingTemplate.token.puid,
+        .version = head.load(std::memory_order_relaxed),
+        .nameID = InternName(state->debugName),
+        .width = state->createInfo.extent.width,
+        .height = state->createInfo.extent.height,
+        .depth = state->createInfo.extent.depth,
+        .format = GetFormatString(state->createInfo.format),
+        .object = reinterpret_cast<const void *>(state->object)
+    });
 }
 
 void VersioningController::CreateOrRecommitBuffer(BufferState *state) {
-    std::lock_guard guard(mutex);
-    pendingCommit = true;
-    
-    // Immediately commit
-    MessageStreamView<ResourceVersionMessage> resourceView(resourceStream);
-    CommitBufferVersion(resourceView, state);
+    Append(LogEntry {
+        .puid = state->virtualMapping.token.puid,
+        .version = head.load(std::memory_order_relaxed),
+        .nameID = InternName(state->debugName),
+        .width = static_cast<uint32_t>(state->createInfo.size),
+        .height = 1u,
+        .depth = 1u,
+        .format = "BUFFER",
+        .object = reinterpret_cast<const void *>(state->object)
+    });
 }
 
 void VersioningController::DestroyImage(ImageState *state) {
-    std::lock_guard guard(mutex);
-    pendingCommit = true;
-
-    // Mark as deleted
-    auto&& version = MessageStreamView<ResourceVersionMessage>(resourceStream).Add();
-    version->puid = state->virtualMappingTemplate.token.puid;
-    version->version = UINT32_MAX;
+    Append(LogEntry {
+        .puid = state->virtualMappingTemplate.token.puid,
+        .version = UINT32_MAX
+    });
 }
 
 void VersioningController::DestroyBuffer(BufferState *state) {
-    std::lock_guard guard(mutex);
-    pendingCommit = true;
+    Append(LogEntry {
+        .puid = state->virtualMapping.token.puid,
+        .version = UINT32_MAX
+    });
+}
 
-    // Mark as deleted
-    auto&& version = MessageStreamView<ResourceVersionMessage>(resourceStream).Add();
-    version->puid = state->virtualMapping.token.puid;
-    version->version = UINT32_MAX;
+void VersioningController::Append(const LogEntry &entry) {
+    uint32_t index;
+    
+    // Log is full? Release everything committed to the resource stream
+    //   ? Delta requests below the new base are answered with a full summary
+    while (!log.TryAppend(entry, index)) {
+        {
+            std::lock_guard guard(mutex);
+            FlushLog();
+            log.Truncate(flushedLogCount);
+        }
+
+        // In flight appends may hold back the release
+        std::this_thread::yield();
+    }
+
+    // Mark for branching after the entry is readable
+    pendingCommit.store(true, std::memory_order_release);
+}
+
+uint32_t VersioningController::InternName(const char *name) {
+    // Unnamed resources never touch the lookup
+    if (!name) {
+        return 0;
+    }
+
+    std::lock_guard guard(nameMutex);
+    return InternNameNoLock(name);
+}
+
+uint32_t VersioningController::InternEntryNameNoLock(const LogEntry &entry) {
+    // Named or destroyed resources need no fallback
+    if (entry.nameID || entry.version == UINT32_MAX) {
+        return entry.nameID;
+    }
+
+    // Same fallback as the full summarization
+    char debugNameBuffer[64];
+    FormatArrayTerminated(debugNameBuffer, "{}", entry.object);
+    return InternNameNoLock(debugNameBuffer);
+}
+
+uint32_t VersioningController::InternNameNoLock(const std::string_view &name) {
+    // Already interned?
+    if (auto it = nameLookup.find(name); it != nameLookup.end()) {
+        return it->second;
+    }
+
+    // Allocate identifier, deque storage is stable
+    auto id = static_cast<uint32_t>(names.size());
+    nameLookup[names.emplace_back(name)] = id;
+    return id;
+}
+
+void VersioningController::FlushLog() {
+    MessageStreamView<ResourceVersionMessage> resourceView(resourceStream);
+
+    // Get all readable entries, in flight appends are picked up on the next flush
+    const uint32_t readableCount = log.GetReadableCount(flushedLogCount);
+
+    // Names are shared with appenders
+    std::lock_guard nameGuard(nameMutex);
+
+    // Commit all entries, they belong to the current head
+    for (uint32_t i = flushedLogCount; i < readableCount; i++) {
+        const LogEntry& entry = log.Get(i);
+
+        // Deletion?
+        if (entry.version == UINT32_MAX) {
+            auto&& version = resourceView.Add();
+            version->puid = entry.puid;
+            version->version = UINT32_MAX;
+            continue;
+        }
+
+        CommitLogVersion(resourceView, entry, head.load(std::memory_order_relaxed));
+    }
+
+    // Mark as flushed
+    flushedLogCount = readableCount;
 }
 
 VersionSegmentationPoint VersioningController::BranchOnSegmentationPoint() {
     std::lock_guard guard(mutex);
 
     // If no new resource states have been added / removed, no need to branch
-    if (!pendingCommit) {
+    if (!pendingCommit.exchange(false, std::memory_order_acquire)) {
         return VersionSegmentationPoint {
             .id = head,
             .segmented = false
         };
     }
     
+    // Commit all pending changes
+    FlushLog();
+
     // Export general to bridge
     // Ordering is guaranteed between streams, so we need to ensure the next ordered messages appear *after* this
     bridge->GetOutput()->AddStreamAndSwap(stream);
@@ -173,9 +341,6 @@ VersionSegmentationPoint VersioningController::BranchOnSegmentationPoint() {
     auto&& branch = view.Add<VersionBranchMessage>();
     branch->head = head;
 
-    // Cleanup
-    pendingCommit = false;
-
     // Current segmentation point represents the last branch
     return VersionSegmentationPoint {
         .id = head - 1u,
@@ -253,9 +418,49 @@ void VersioningController::CommitBufferVersion(MessageStreamView<ResourceVersion
     version->format.Set(formatStr);
 }
 
+void VersioningController::CommitLogVersion(MessageStreamView<ResourceVersionMessage> &view, const LogEntry &entry, uint32_t versionID) {
+    const char* debugName = names[entry.nameID].c_str();
+
+    // Fallback name
+    char debugNameBuffer[64];
+    if (!entry.nameID) {
+        FormatArrayTerminated(debugNameBuffer, "{}", entry.object);
+        debugName = debugNameBuffer;
+    }
+
+    // Allocate version
+    auto&& version = view.Add(ResourceVersionMessage::AllocationInfo {
+        .nameLength = std::strlen(debugName),
+        .formatLength =  std::strlen(entry.format)
+    });
+
+    // Fill info
+    version->puid = entry.puid;
+    version->version = versionID;
+    version->name.Set(debugName);
+    version->width = entry.width;
+    version->height = entry.height;
+    version->depth = entry.depth;
+    version->format.Set(entry.format);
+}
+
 void VersioningController::Commit() {
     std::lock_guard guard(mutex);
 
+    // Commit all pending changes
+    FlushLog();
+
+    // Release all entries committed and acknowledged by delta clients
+    uint32_t releaseCount = std::min(flushedLogCount, acknowledgedLogVersion);
+
+    // Delta clients may never acknowledge, never retain more than the window
+    if (flushedLogCount > kLogRetention) {
+        releaseCount = std::max(releaseCount, flushedLogCount - kLogRetention);
+    }
+
+    // Release
+    log.Truncate(releaseCount);
+
     // Export general to bridge
     bridge->GetOutput()->AddStreamAndSwap(stream);
     bridge->GetOutput()->AddStreamAndSwap(resourceStream);
@@ -47,6 +47,7 @@
 
 // Common
 #include <Common/Hash.h>
+#include <Common/Containers/TrivialStackVector.h>
 
 VKAPI_ATTR VkResult VKAPI_PTR Hook_vkCreateDescriptorSetLayout(VkDevice device, const VkDescriptorSetLayoutCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkDescriptorSetLayout* pSetLayout) {
     DeviceDispatchTable *table = DeviceDispatchTable::Get(GetInternalTable(device));
@@ -351,27 +352,49 @@ VKAPI_ATTR void VKAPI_CALL Hook_vkDestroyDescriptorPool(VkDevice device, VkDescr
 VKAPI_ATTR void VKAPI_CALL Hook_vkUpdateDescriptorSets(VkDevice device, uint32_t descriptorWriteCount, const VkWriteDescriptorSet* pDescriptorWrites, uint32_t descriptorCopyCount, const VkCopyDescriptorSet* pDescriptorCopies) {
     DeviceDispatchTable *table = DeviceDispatchTable::Get(GetInternalTable(device));
 
-    // Create PRM associations from writes
+    // Total number of written descriptors
+    uint32_t mappingCount = 0;
+    for (uint32_t i = 0; i < descriptorWriteCount; i++) {
+        mappingCount += pDescriptorWrites[i].descriptorCount;
+    }
+
+    // Resolved mappings and their table writes
+    TrivialStackVector<VirtualResourceMapping, 64u> mappings(table->allocators);
+    TrivialStackVector<PhysicalResourceMappingTableWrite, 16u> prmtWrites(table->allocators);
+    mappings.Resize(mappingCount);
+
+    // Resolve all writes before touching the table
+    uint32_t mappingOffset = 0;
     for (uint32_t i = 0; i < descriptorWriteCount; i++) {
         const VkWriteDescriptorSet& write = pDescriptorWrites[i];
 
         // Get the originating set
         const DescriptorSetState* state = table->states_descriptorSet.Get(write.dstSet);
 
-        // Create mappings for all descriptors written
-        for (uint32_t descriptorIndex = 0; descriptorIndex < write.descriptorCount; descriptorIndex++) {
-            // Default invalid mapping
-            VirtualResourceMapping mapping = GetVirtualResourceMapping(table, write, descriptorIndex);
-            
-            // Map current binding to an offset
-            const uint32_t prmtOffset = state->prmtOffsets.at(write.dstBinding);
+        // Map current binding to an offset
+        const uint32_t prmtOffset = state->prmtOffsets.at(write.dstBinding);
 
-            // Update the table
-            table->prmTable->WriteMapping(state->segmentID, prmtOffset + write.dstArrayElement + descriptorIndex, mapping);
-        }
+        // Resolve mappings for all descriptors written
+        VirtualResourceMapping* writeMappings = mappings.Data() + mappingOffset;
+        GetVirtualResourceMappings(table, write, writeMappings);
+
+        // Create PRM association
+        PhysicalResourceMappingTableWrite& prmtWrite = prmtWrites.Add();
+        prmtWrite.id = state->segmentID;
+        prmtWrite.offset = prmtOffset + write.dstArrayElement;
+        prmtWrite.count = write.descriptorCount;
+        prmtWrite.mappings = writeMappings;
+
+        // Next!
+        mappingOffset += write.descriptorCount;
     }
 
-    // Create PRM associations from copies
+    // Commit all writes as a single update
+    if (prmtWrites.Size()) {
+        table->prmTable->WriteMappings(prmtWrites.Data(), static_cast<uint32_t>(prmtWrites.Size()));
+    }
+
+    // Create PRM associations from copies, applied after all writes
     for (uint32_t i = 0; i < descriptorCopyCount; i++) {
         const VkCopyDescriptorSet& copy = pDescriptorCopies[i];
 
@@ -383,14 +406,12 @@ VKAPI_ATTR void VKAPI_CALL Hook_vkUpdateDescriptorSets(VkDevice device, uint32_t
         const uint32_t srcPrmtOffset = stateSrc->prmtOffsets.at(copy.srcBinding);
         const uint32_t dstPrmtOffset = stateDst->prmtOffsets.at(copy.dstBinding);
 
-        // Create mappings for all descriptors copied
-        for (uint32_t descriptorIndex = 0; descriptorIndex < copy.descriptorCount; descriptorIndex++) {
-            // Get the original mapping
-            VirtualResourceMapping srcMapping = table->prmTable->GetMapping(stateSrc->segmentID, srcPrmtOffset + copy.srcArrayElement + descriptorIndex);
-
-            // Write as new mapping
-            table->prmTable->WriteMapping(stateDst->segmentID, dstPrmtOffset + copy.dstArrayElement + descriptorIndex, srcMapping);
-        }
+        // Copy the mapping range
+        table->prmTable->CopyMappings(
+            stateSrc->segmentID, srcPrmtOffset + copy.srcArrayElement,
+            stateDst->segmentID, dstPrmtOffset + copy.dstArrayElement,
+            copy.descriptorCount
+        );
     }
 
     // Pass down callchain
@@ -413,6 +434,23 @@ VKAPI_ATTR VkResult VKAPI_PTR Hook_vkCreateDescriptorUpdateTemplate(VkDevice dev
     // Perform deep copy
     state->createInfo.DeepCopy(table->allocators, *pCreateInfo);
 
+    // Compile the update plan against the set layout
+    switch (pCreateInfo->templateType) {
+        default:
+            ASSERT(false, "Invalid template type");
+            break;
+        case VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET: {
+            const DescriptorSetLayoutState* layoutState = table->states_descriptorSetLayout.Get(pCreateInfo->descriptorSetLayout);
+            state->plan.Compile(*pCreateInfo, layoutState->physicalMapping);
+            break;
+        }
+        case VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR: {
+            const PipelineLayoutState* layoutState = table->states_pipelineLayout.Get(pCreateInfo->pipelineLayout);
+            state->plan.Compile(*pCreateInfo, layoutState->physicalMapping.descriptorSets.at(pCreateInfo->set));
+            break;
+        }
+    }
+
     // Store lookup
     table->states_descriptorUpdateTemplateState.Add(*pDescriptorUpdateTemplate, state);
 
@@ -451,24 +489,8 @@ VKAPI_ATTR void VKAPI_PTR Hook_vkUpdateDescriptorSetWithTemplate(VkDevice device
     const DescriptorUpdateTemplateState* templateState = table->states_descriptorUpdateTemplateState.Get(descriptorUpdateTemplate);
     const DescriptorSetState*            setState      = table->states_descriptorSet.Get(descriptorSet);
 
-    // Handle each entry
-    for (uint32_t i = 0; i < templateState->createInfo->descriptorUpdateEntryCount; i++) {
-        const VkDescriptorUpdateTemplateEntry& entry = templateState->createInfo->pDescriptorUpdateEntries[i];
-
-        // Handle each binding write
-        for (uint32_t descriptorIndex = 0; descriptorIndex < entry.descriptorCount; descriptorIndex++) {
-            const void *descriptorData = static_cast<const uint8_t*>(pData) + entry.offset + descriptorIndex * entry.stride;
-
-            // Get mapping
-            VirtualResourceMapping mapping = GetVirtualResourceMapping(table, entry.descriptorType, descriptorData);
-
-            // Map current binding to an offset
-            const uint32_t prmtOffset = setState->prmtOffsets.at(entry.dstBinding);
-
-            // Update the table
-            table->prmTable->WriteMapping(setState->segmentID, prmtOffset + entry.dstArrayElement + descriptorIndex, mapping);
-        }
-    }
+    // Execute the precompiled plan
+    templateState->plan.Execute(table, setState->segmentID, pData);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreatePipelineLayout(VkDevice device, const VkPipelineLayoutCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator, VkPipelineLayout *pPipelineLayout) {
@@ -62,6 +62,8 @@
 #include <Backend/IFeature.h>
 #include <Backend/IL/Format.h>
 #include <Backend/IL/TextureDimension.h>
+#include <Backend/ShaderExportKeyAggregator.h>
+#include <Backend/ShaderExportBudgetHost.h>
 
 // Message
 #include <Message/OrderedMessageStorage.h>
@@ -406,6 +408,9 @@ VkResult VKAPI_PTR Hook_vkCreateDevice(VkPhysicalDevice physicalDevice, const Vk
     // Install the shader export host
     table->registry.AddNew<ShaderExportHost>();
 
+    // Install the shader export aggregator, disabled until configured
+    table->registry.AddNew<ShaderExportKeyAggregator>();
+
     // Install the shader sguid host
     table->sguidHost = table->registry.AddNew<ShaderSGUIDHost>(table);
     ENSURE(table->sguidHost->Install(), "Failed to install shader sguid host");
@@ -414,6 +419,10 @@ VkResult VKAPI_PTR Hook_vkCreateDevice(VkPhysicalDevice physicalDevice, const Vk
     table->dataHost = table->registry.AddNew<ShaderDataHost>(table);
     ENSURE(table->dataHost->Install(), "Failed to install data host");
 
+    // Install the per-SGUID export budgets
+    auto exportBudgetHost = table->registry.AddNew<ShaderExportBudgetHost>();
+    ENSURE(exportBudgetHost->Install(), "Failed to install export budget host");
+
     // Create the program host
     table->shaderProgramHost = table->registry.AddNew<ShaderProgramHost>(table);
     ENSURE(table->shaderProgramHost->Install(), "Failed to install shader program host");
@@ -514,6 +523,9 @@ void VKAPI_PTR Hook_vkDestroyDevice(VkDevice device, const VkAllocationCallbacks
     // Wait for all pending instrumentation
     table->instrumentationController->WaitForCompletion();
 
+    // Submit all deferred post patching
+    CloseOpenSegments(table);
+
     // Ensure all work is done
     table->next_vkDeviceWaitIdle(device);
 
@@ -521,7 +533,10 @@ void VKAPI_PTR Hook_vkDestroyDevice(VkDevice device, const VkAllocationCallbacks
     table->syncPointActionThread.Stop();
 
     // Process all remaining work
-    table->exportStreamer->Process();
+    table->exportStreamer->Drain();
+
+    // Flush all pending aggregates
+    table->exportStreamer->FlushAggregates();
 
     // Wait for all pending submissions
     table->scheduler->WaitForPending();
@@ -532,6 +547,11 @@ void VKAPI_PTR Hook_vkDestroyDevice(VkDevice device, const VkAllocationCallbacks
     table->instrumentationController->Uninstall();
     table->featureController->Uninstall();
 
+    // Serialize the instrumented pipeline cache, all instrumentation has completed
+    if (ComRef pipelineCompiler = table->registry.Get<PipelineCompiler>()) {
+        pipelineCompiler->Uninstall();
+    }
+
     // Release all features
     table->features.clear();
 
@@ -71,8 +71,12 @@ void DeviceDispatchTable::Populate(PFN_vkGetInstanceProcAddr getInstanceProcAddr
     next_vkCreateComputePipelines = reinterpret_cast<PFN_vkCreateComputePipelines>(getDeviceProcAddr(object, "vkCreateComputePipelines"));
     next_vkCreateRayTracingPipelinesKHR = reinterpret_cast<PFN_vkCreateRayTracingPipelinesKHR>(getDeviceProcAddr(object, "vkCreateRayTracingPipelinesKHR"));
     next_vkDestroyPipeline = reinterpret_cast<PFN_vkDestroyPipeline>(getDeviceProcAddr(object, "vkDestroyPipeline"));
+    next_vkCreatePipelineCache = reinterpret_cast<PFN_vkCreatePipelineCache>(getDeviceProcAddr(object, "vkCreatePipelineCache"));
+    next_vkDestroyPipelineCache = reinterpret_cast<PFN_vkDestroyPipelineCache>(getDeviceProcAddr(object, "vkDestroyPipelineCache"));
+    next_vkGetPipelineCacheData = reinterpret_cast<PFN_vkGetPipelineCacheData>(getDeviceProcAddr(object, "vkGetPipelineCacheData"));
     next_vkGetFenceStatus = reinterpret_cast<PFN_vkGetFenceStatus>(getDeviceProcAddr(object, "vkGetFenceStatus"));
     next_vkWaitForFences = reinterpret_cast<PFN_vkWaitForFences>(getDeviceProcAddr(object, "vkWaitForFences"));
+    next_vkWaitSemaphoresKHR = reinterpret_cast<PFN_vkWaitSemaphoresKHR>(getDeviceProcAddr(object, "vkWaitSemaphoresKHR"));
     next_vkCreateBuffer = reinterpret_cast<PFN_vkCreateBuffer>(getDeviceProcAddr(object, "vkCreateBuffer"));
     next_vkDestroyBuffer = reinterpret_cast<PFN_vkDestroyBuffer>(getDeviceProcAddr(object, "vkDestroyBuffer"));
     next_vkCreateBufferView = reinterpret_cast<PFN_vkCreateBufferView>(getDeviceProcAddr(object, "vkCreateBufferView"));
@@ -131,6 +135,16 @@ void DeviceDispatchTable::Populate(PFN_vkGetInstanceProcAddr getInstanceProcAddr
     next_vkQueueBindSparse = reinterpret_cast<PFN_vkQueueBindSparse>(getDeviceProcAddr(object, "vkQueueBindSparse"));
     next_vkCreateSemaphore = reinterpret_cast<PFN_vkCreateSemaphore>(getDeviceProcAddr(object, "vkCreateSemaphore"));
     next_vkDestroySemaphore = reinterpret_cast<PFN_vkDestroySemaphore>(getDeviceProcAddr(object, "vkDestroySemaphore"));
+    next_vkGetSemaphoreCounterValue = reinterpret_cast<PFN_vkGetSemaphoreCounterValue>(getDeviceProcAddr(object, "vkGetSemaphoreCounterValue"));
+    next_vkWaitSemaphores = reinterpret_cast<PFN_vkWaitSemaphores>(getDeviceProcAddr(object, "vkWaitSemaphores"));
+
+    // Timeline queries may only be exposed through the extension
+    if (!next_vkGetSemaphoreCounterValue) {
+        next_vkGetSemaphoreCounterValue = reinterpret_cast<PFN_vkGetSemaphoreCounterValue>(getDeviceProcAddr(object, "vkGetSemaphoreCounterValueKHR"));
+    }
+    if (!next_vkWaitSemaphores) {
+        next_vkWaitSemaphores = reinterpret_cast<PFN_vkWaitSemaphores>(getDeviceProcAddr(object, "vkWaitSemaphoresKHR"));
+    }
 
     // Populate all generated commands
     commandBufferDispatchTable.Populate(object, getDeviceProcAddr);
@@ -233,6 +247,12 @@ PFN_vkVoidFunction DeviceDispatchTable::GetHookAddress(DeviceDispatchTable* tabl
     if (!std::strcmp(name, "vkWaitForFences"))
         return reinterpret_cast<PFN_vkVoidFunction>(&Hook_vkWaitForFences);
 
+    if (!std::strcmp(name, "vkWaitSemaphores"))
+        return reinterpret_cast<PFN_vkVoidFunction>(&Hook_vkWaitSemaphores);
+
+    if (!std::strcmp(name, "vkWaitSemaphoresKHR"))
+        return reinterpret_cast<PFN_vkVoidFunction>(&Hook_vkWaitSemaphoresKHR);
+
     if (!std::strcmp(name, "vkResetFences"))
         return reinterpret_cast<PFN_vkVoidFunction>(&Hook_vkResetFences);
 
@@ -75,22 +75,150 @@ bool ShaderExportStreamAllocator::Install() {
 
 ShaderExportStreamAllocator::~ShaderExportStreamAllocator() {
     for (ShaderExportSegmentInfo* segment : segmentPool) {
-        // Release streams
-        for (const ShaderExportStreamInfo& stream : segment->streams) {
-            table->next_vkDestroyBufferView(table->object, stream.view, nullptr);
-            table->next_vkDestroyBuffer(table->object, stream.buffer, nullptr);
-            deviceAllocator->Free(stream.allocation);
-        }
-
-        // Release counter
-        table->next_vkDestroyBufferView(table->object, segment->counter.view, nullptr);
-        table->next_vkDestroyBuffer(table->object, segment->counter.buffer, nullptr);
-        table->next_vkDestroyBuffer(table->object, segment->counter.bufferHost, nullptr);
-        deviceAllocator->Free(segment->counter.allocation);
+        ReleaseSegment(segment);
     }
+
+    // Release all rings
+    for (ShaderExportSegmentInfo* ring : rings) {
+        ReleaseSegment(ring);
+    }
+
+    // Release all ring snapshots
+    for (const ShaderExportRingSnapshotInfo& snapshot : ringSnapshots) {
+        table->next_vkDestroyBuffer(table->object, snapshot.buffer, nullptr);
+        deviceAllocator->Free(snapshot.allocation);
+    }
+}
+
+void ShaderExportStreamAllocator::ReleaseSegment(ShaderExportSegmentInfo *segment) {
+    // Release streams
+    for (const ShaderExportStreamInfo& stream : segment->streams) {
+        table->next_vkDestroyBufferView(table->object, stream.view, nullptr);
+        table->next_vkDestroyBuffer(table->object, stream.buffer, nullptr);
+        deviceAllocator->Free(stream.allocation);
+    }
+
+    // Release counter
+    table->next_vkDestroyBufferView(table->object, segment->counter.view, nullptr);
+    table->next_vkDestroyBuffer(table->object, segment->counter.buffer, nullptr);
+    table->next_vkDestroyBuffer(table->object, segment->counter.bufferHost, nullptr);
+    deviceAllocator->Free(segment->counter.allocation);
+}
+
+bool ShaderExportStreamAllocator::SetRingMode(uint32_t dwordCount) {
+    std::lock_guard guard(mutex);
+
+    // Already in use by shaders or segments?
+    if (allocationModeLatched) {
+        return false;
+    }
+
+    // Disabled?
+    if (!dwordCount) {
+        allocationMode = ShaderExportAllocationMode::GlobalCyclicBufferNoOverwrite;
+        ringDWordCount = 0;
+        return true;
+    }
+
+    // Shaders mask the head, round up to the next power of two
+    ringDWordCount = 1u;
+    while (ringDWordCount < dwordCount && ringDWordCount < (1u << 31)) {
+        ringDWordCount <<= 1u;
+    }
+
+    // OK
+    allocationMode = ShaderExportAllocationMode::PersistentRing;
+    return true;
+}
+
+uint32_t ShaderExportStreamAllocator::LatchRingMask() {
+    std::lock_guard guard(mutex);
+    allocationModeLatched = true;
+
+    // Non-ring allocations are never masked
+    if (allocationMode != ShaderExportAllocationMode::PersistentRing) {
+        return 0;
+    }
+
+    return ringDWordCount - 1;
+}
+
+ShaderExportSegmentInfo *ShaderExportStreamAllocator::AllocateRing() {
+    ASSERT(IsPersistentRing(), "Ring allocation outside of ring mode");
+    LatchRingMask();
+
+    // Allocate new allocation
+    auto segment = new (allocators) ShaderExportSegmentInfo();
+    segment->persistent = true;
+
+    // Heads are read live by the host to detect laps, the budget counters live alongside
+    segment->counter = AllocateCounterInfo(AllocationResidency::Host);
+
+    // Set number of streams
+    segment->streams.resize(exportInfos.size());
+    segment->tails.resize(exportInfos.size(), 0u);
+
+    // Allocate all streams
+    for (const ExportInfo& exportInfo : exportInfos) {
+        segment->streams[exportInfo.id] = AllocateRingStreamInfo(exportInfo.id);
+    }
+
+#if LOG_ALLOCATION
+    table->parent->logBuffer.Add("Vulkan", LogSeverity::Info, Format("Allocated ring with {} streams", segment->streams.size()));
+#endif
+
+    // Keep track of it
+    rings.push_back(segment);
+
+    // OK
+    return segment;
+}
+
+ShaderExportRingSnapshotInfo ShaderExportStreamAllocator::AllocateRingSnapshot() {
+    ShaderExportRingSnapshotInfo info{};
+
+    // Attempt to re-use an existing allocation
+    if (ringSnapshotPool.TryPop(info)) {
+        return info;
+    }
+
+    // Buffer info
+    VkBufferCreateInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    // One head per stream
+    bufferInfo.size = sizeof(ShaderExportCounter) * std::max(1ull, exportInfos.size());
+
+    // Attempt to create the buffer
+    if (table->next_vkCreateBuffer(table->object, &bufferInfo, nullptr, &info.buffer) != VK_SUCCESS) {
+        return {};
+    }
+
+    // Get the requirements
+    VkMemoryRequirements requirements;
+    table->next_vkGetBufferMemoryRequirements(table->object, info.buffer, &requirements);
+
+    // Create the allocation
+    info.allocation = deviceAllocator->Allocate(requirements, AllocationResidency::Host);
+
+    // Bind against the allocation
+    deviceAllocator->BindBuffer(info.allocation, info.buffer);
+
+    // Keep track of it
+    ringSnapshots.push_back(info);
+
+    // OK
+    return info;
+}
+
+void ShaderExportStreamAllocator::FreeRingSnapshot(const ShaderExportRingSnapshotInfo &snapshot) {
+    ringSnapshotPool.Push(snapshot);
 }
 
 ShaderExportSegmentInfo *ShaderExportStreamAllocator::AllocateSegment() {
+    LatchRingMask();
+
     // Try existing allocation
     if (ShaderExportSegmentInfo* segment = segmentPool.TryPop()) {
         return segment;
@@ -126,11 +254,11 @@ void ShaderExportStreamAllocator::SetStreamSize(ShaderExportID id, uint64_t size
 
 }
 
-ShaderExportSegmentCounterInfo ShaderExportStreamAllocator::AllocateCounterInfo() {
+ShaderExportSegmentCounterInfo ShaderExportStreamAllocator::AllocateCounterInfo(AllocationResidency residency) {
     ShaderExportSegmentCounterInfo info{};
 
-    // Attempt to re-use an existing allocation
-    if (counterPool.TryPop(info)) {
+    // Attempt to re-use an existing allocation, pooled counters are device resident
+    if (residency == AllocationResidency::Device && counterPool.TryPop(info)) {
         return info;
     }
 
@@ -139,8 +267,9 @@ ShaderExportSegmentCounterInfo ShaderExportStreamAllocator::AllocateCounterInfo(
     bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
     bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
-    // One counter per feature
-    bufferInfo.size = sizeof(ShaderExportCounter) * std::max(1ull, exportInfos.size());
+    // One counter per feature, followed by the per-SGUID budget counters
+    info.deviceCounterCount = std::max(1ull, exportInfos.size()) + kShaderExportBudgetSlotCount;
+    bufferInfo.size = sizeof(ShaderExportCounter) * info.deviceCounterCount;
 
     // Attempt to create the buffer
     if (table->next_vkCreateBuffer(table->object, &bufferInfo, nullptr, &info.buffer) != VK_SUCCESS) {
@@ -157,7 +286,7 @@ ShaderExportSegmentCounterInfo ShaderExportStreamAllocator::AllocateCounterInfo(
     table->next_vkGetBufferMemoryRequirements(table->object, info.buffer, &requirements);
 
     // Create the allocation
-    info.allocation = deviceAllocator->AllocateMirror(requirements);
+    info.allocation = deviceAllocator->AllocateMirror(requirements, residency);
 
     // Bind against the allocations
     deviceAllocator->BindBuffer(info.allocation.device, info.buffer);
@@ -231,3 +360,50 @@ ShaderExportStreamInfo ShaderExportStreamAllocator::AllocateStreamInfo(const Sha
     // OK
     return info;
 }
+
+ShaderExportStreamInfo ShaderExportStreamAllocator::AllocateRingStreamInfo(const ShaderExportID& id) {
+    ShaderExportStreamInfo info{};
+
+    // Inherit type info
+    info.typeInfo = exportInfos[id].typeInfo;
+
+    // Buffer info
+    VkBufferCreateInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT;
+
+    // Rings are sized by the mode, not the export
+    bufferInfo.size = sizeof(uint32_t) * static_cast<uint64_t>(ringDWordCount);
+
+    // Attempt to create the buffer
+    if (table->next_vkCreateBuffer(table->object, &bufferInfo, nullptr, &info.buffer) != VK_SUCCESS) {
+        return {};
+    }
+
+    // Get the requirements
+    VkMemoryRequirements requirements;
+    table->next_vkGetBufferMemoryRequirements(table->object, info.buffer, &requirements);
+
+    // Size for safe guarding
+    info.byteSize = bufferInfo.size;
+
+    // Create the allocation, consumed directly by the host
+    info.allocation = deviceAllocator->AllocateMirror(requirements, AllocationResidency::Host);
+
+    // Bind against the device allocation
+    deviceAllocator->BindBuffer(info.allocation.device, info.buffer);
+
+    // View creation info
+    VkBufferViewCreateInfo viewInfo{VK_STRUCTURE_TYPE_BUFFER_VIEW_CREATE_INFO};
+    viewInfo.buffer = info.buffer;
+    viewInfo.format = VK_FORMAT_R32_UINT;
+    viewInfo.range = VK_WHOLE_SIZE;
+
+    // Create the view
+    if (table->next_vkCreateBufferView(table->object, &viewInfo, nullptr, &info.view) != VK_SUCCESS) {
+        return {};
+    }
+
+    // OK
+    return info;
+}
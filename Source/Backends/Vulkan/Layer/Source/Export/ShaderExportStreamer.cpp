@@ -44,6 +44,10 @@
 #include <Backends/Vulkan/ShaderData/ShaderDataHost.h>
 #include <Backends/Vulkan/Resource/PushDescriptorAppendAllocator.h>
 #include <Backends/Vulkan/Resource/PhysicalResourceMappingTablePersistentVersion.h>
+#include <Backends/Vulkan/Export/ShaderExportRingWindow.h>
+
+// Backend
+#include <Backend/IShaderExportAggregator.h>
 
 // Bridge
 #include <Bridge/IBridge.h>
@@ -54,9 +58,50 @@
 
 // Common
 #include <Common/Registry.h>
+#include <Common/Dispatcher/Dispatcher.h>
+#include <Common/Dispatcher/DispatcherBucket.h>
+#include <Common/Dispatcher/Event.h>
 #include <Backends/Vulkan/Translation.h>
 
-ShaderExportStreamer::ShaderExportStreamer(DeviceDispatchTable *table) : table(table), dynamicOffsetAllocator(table->allocators) {
+// Std
+#include <chrono>
+#include <cstring>
+
+/// Number of dedicated aggregation workers
+static constexpr uint32_t kAggregationWorkerCount = 2u;
+
+/// Wake interval of the export worker, bounds the latency of missed wakes
+static constexpr uint32_t kWorkerIntervalMS = 16u;
+
+/// Single export aggregation job
+struct ShaderExportAggregationJob {
+    /// Export being aggregated
+    ShaderExportID id{InvalidShaderExportID};
+
+    /// Type info of the export
+    const ShaderExportTypeInfo* typeInfo{nullptr};
+
+    /// Mapped stream and the written byte size
+    const void* data{nullptr};
+    size_t size{0};
+
+    /// Resource version of all records
+    uint32_t versionID{0};
+
+    /// Host timestamp of all records, in nanoseconds
+    uint64_t timestamp{0};
+
+    /// Storage to flush expired aggregates to
+    IMessageStorage* output{nullptr};
+};
+
+/// Get the current host timestamp
+/// \return timestamp in nanoseconds
+static uint64_t GetAggregationTimestamp() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+ShaderExportStreamer::ShaderExportStreamer(DeviceDispatchTable *table) : table(table), dynamicOffsetAllocator(table->allocators), retiredSegments(kRetiredSegmentCapacity) {
 
 }
 
@@ -66,6 +111,9 @@ bool ShaderExportStreamer::Install() {
     descriptorAllocator = registry->Get<ShaderExportDescriptorAllocator>();
     streamAllocator = registry->Get<ShaderExportStreamAllocator>();
 
+    // Optional, host side aggregation
+    aggregator = registry->Get<IShaderExportAggregator>();
+
     // Check if push descriptor tracking is required
     for (const char* extension : table->enabledExtensions) {
         if (!std::strcmp(extension, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME)) {
@@ -74,11 +122,23 @@ bool ShaderExportStreamer::Install() {
         }
     }
 
+    // Start the export worker
+    worker = std::thread(&ShaderExportStreamer::WorkerEntry, this);
+
     // OK
     return true;
 }
 
 ShaderExportStreamer::~ShaderExportStreamer() {
+    // Stop the worker, if not already drained
+    StopWorker();
+
+    // Free all retired, but unprocessed, segments
+    ShaderExportRetiredSegment retired;
+    while (retiredSegments.TryPop(retired)) {
+        FreeSegmentNoQueueLock(retired.queue, retired.segment);
+    }
+
     // Free all live segments
     for (ShaderExportQueueState* queue : queuePool) {
         for (ShaderExportStreamSegment* segment : queue->liveSegments) {
@@ -86,9 +146,11 @@ ShaderExportStreamer::~ShaderExportStreamer() {
         }
     }
 
-    // Free all segments
+    // Free all segments, persistent rings are owned by the allocator
     for (ShaderExportStreamSegment* segment : segmentPool) {
-        streamAllocator->FreeSegment(segment->allocation);
+        if (!segment->allocation->persistent) {
+            streamAllocator->FreeSegment(segment->allocation);
+        }
     }
 
     // Free all stream states
@@ -161,9 +223,29 @@ void ShaderExportStreamer::Free(ShaderExportQueueState *state) {
     queuePool.Push(state);
 }
 
-ShaderExportStreamSegment *ShaderExportStreamer::AllocateSegment() {
+ShaderExportStreamSegment *ShaderExportStreamer::AllocateSegment(ShaderExportQueueState* queue) {
     std::lock_guard guard(mutex);
 
+    // Persistent rings are shared by all segments of a queue
+    if (streamAllocator->IsPersistentRing()) {
+        if (!queue->ring) {
+            queue->ring = streamAllocator->AllocateRing();
+        }
+
+        // Try existing allocation
+        ShaderExportStreamSegment* segment = segmentPool.TryPop();
+        if (!segment) {
+            segment = new (allocators) ShaderExportStreamSegment();
+        }
+
+        // Assign ring and head snapshot
+        segment->allocation = queue->ring;
+        segment->ringSnapshot = streamAllocator->AllocateRingSnapshot();
+
+        // OK
+        return segment;
+    }
+
     // Try existing allocation
     if (ShaderExportStreamSegment* segment = segmentPool.TryPop()) {
         return segment;
@@ -177,15 +259,21 @@ ShaderExportStreamSegment *ShaderExportStreamer::AllocateSegment() {
     return segment;
 }
 
-void ShaderExportStreamer::Enqueue(ShaderExportQueueState* queue, ShaderExportStreamSegment *segment, FenceState* fence) {
-    ASSERT(!segment->fence, "Segment double submission");
-    
-    // Keep the fence alive
-    fence->AddUser();
+void ShaderExportStreamer::Enqueue(ShaderExportQueueState* queue, ShaderExportStreamSegment *segment, FenceState* fence, uint64_t timelineValue) {
+    ASSERT(!segment->fence && !segment->timelineValue, "Segment double submission");
+    ASSERT(fence || timelineValue, "Segment without completion tracking");
+
+    // Timeline tracked?
+    if (timelineValue) {
+        segment->timelineValue = timelineValue;
+    } else {
+        // Keep the fence alive
+        fence->AddUser();
 
-    // Assign fence and expected future state
-    segment->fence = fence;
-    segment->fenceNextCommitId = fence->GetNextCommitID();
+        // Assign fence and expected future state
+        segment->fence = fence;
+        segment->fenceNextCommitId = fence->GetNextCommitID();
+    }
 
     // OK
     std::lock_guard queueGuard(table->states_queue.GetLock());
@@ -377,41 +465,107 @@ void ShaderExportStreamer::BindPipeline(ShaderExportStreamState *state, const Pi
 }
 
 void ShaderExportStreamer::Process() {
-    // Released handles
-    TrivialStackVector<CommandContextHandle, 32u> completedHandles;
-
-    // Handle segments
+    // Retire segments
     {
         // Maintain lock hierarchy, streamer -> queue
         std::lock_guard guard(mutex);
         
-        // Process queues
+        // Retire all queues
         // ! Linear view locks
         for (QueueState* queueState : table->states_queue.GetLinear()) {
-            ProcessSegmentsNoQueueLock(queueState->exportState, completedHandles);
+            RetireSegmentsNoQueueLock(queueState->exportState);
         }
     }
-    
-    // Invoke proxies for all handles
-    for (CommandContextHandle handle : completedHandles) {
-        for (const FeatureHookTable &proxyTable: table->featureHookTables) {
-            proxyTable.join.TryInvoke(handle);
+
+    // Wake the worker, processing is deferred
+    workerWake.notify_one();
+}
+
+void ShaderExportStreamer::Process(ShaderExportQueueState* queueState) {
+    // Retire segments
+    {
+        // Maintain lock hierarchy, streamer -> queue
+        std::lock_guard guard(mutex);
+        
+        // Retire queue
+        std::lock_guard queueGuard(table->states_queue.GetLock());
+        RetireSegmentsNoQueueLock(queueState);
+    }
+
+    // Wake the worker, processing is deferred
+    workerWake.notify_one();
+}
+
+void ShaderExportStreamer::Drain() {
+    // Stop the worker, remaining segments are processed on this thread
+    StopWorker();
+
+    // Retire and process until nothing is left, retirement stops if the hand-off queue is full
+    do {
+        Process();
+    } while (ProcessRetiredSegments());
+}
+
+void ShaderExportStreamer::StopWorker() {
+    // Signal exit
+    {
+        std::lock_guard guard(workerWakeMutex);
+        workerExit = true;
+    }
+
+    // Wake the worker
+    workerWake.notify_one();
+
+    // Wait for it
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void ShaderExportStreamer::WorkerEntry() {
+    while (!workerExit.load()) {
+        // Wait for retired segments, the interval bounds the latency of missed wakes
+        {
+            std::unique_lock lock(workerWakeMutex);
+            workerWake.wait_for(lock, std::chrono::milliseconds(kWorkerIntervalMS), [this] {
+                return workerExit.load() || !retiredSegments.IsEmpty();
+            });
         }
+
+        // Process all retired segments
+        ProcessRetiredSegments();
     }
 }
 
-void ShaderExportStreamer::Process(ShaderExportQueueState* queueState) {
+uint32_t ShaderExportStreamer::ProcessRetiredSegments() {
     // Released handles
     TrivialStackVector<CommandContextHandle, 32u> completedHandles;
 
+    // Number of processed segments
+    uint32_t count = 0;
+
     // Handle segments
     {
-        // Maintain lock hierarchy, streamer -> queue
-        std::lock_guard guard(mutex);
-        
-        // Process queue
-        std::lock_guard queueGuard(table->states_queue.GetLock());
-        ProcessSegmentsNoQueueLock(queueState, completedHandles);
+        // Serialize processing, the rings must be consumed in order
+        std::lock_guard processGuard(processMutex);
+
+        // Process all retired segments
+        ShaderExportRetiredSegment retired;
+        while (retiredSegments.TryPop(retired)) {
+            ProcessSegment(retired.segment, completedHandles);
+
+            // Add back to pool, maintain lock hierarchy, streamer -> queue
+            {
+                std::lock_guard guard(mutex);
+                std::lock_guard queueGuard(table->states_queue.GetLock());
+                FreeSegmentNoQueueLock(retired.queue, retired.segment);
+            }
+
+            count++;
+        }
+
+        // Flush aggregates that have outlived their window
+        FlushExpiredAggregates(false);
     }
     
     // Invoke proxies for all handles
@@ -420,6 +574,9 @@ void ShaderExportStreamer::Process(ShaderExportQueueState* queueState) {
             proxyTable.join.TryInvoke(handle);
         }
     }
+
+    // OK
+    return count;
 }
 
 void ShaderExportStreamer::Commit(ShaderExportStreamState *state, VkPipelineBindPoint bindPoint, VkCommandBuffer commandBuffer) {
@@ -653,69 +810,94 @@ void ShaderExportStreamer::MapSegment(ShaderExportStreamState *state, ShaderExpo
     segment->commandContextHandles.push_back(state->commandContextHandle);
 }
 
-void ShaderExportStreamer::ProcessSegmentsNoQueueLock(ShaderExportQueueState* queue, TrivialStackVector<CommandContextHandle, 32u>& completedHandles) {
+void ShaderExportStreamer::RetireSegmentsNoQueueLock(ShaderExportQueueState* queue) {
+    // Nothing to do?
+    if (queue->liveSegments.empty()) {
+        return;
+    }
+
+    // Get queue
+    QueueState* queueState = table->states_queue.GetNoLock(queue->queue);
+
+    // Read the timeline once, retires all segments signalled before it
+    uint64_t completedTimelineValue = 0;
+    if (queueState->timeline.IsSupported()) {
+        completedTimelineValue = queueState->timeline.Poll();
+    }
+
     // TODO: Does not hold true for all queues
     auto it = queue->liveSegments.begin();
 
     // Segments are enqueued in order of completion
     for (; it != queue->liveSegments.end(); it++) {
-        // If failed to process, none of the succeeding are ready
-        if (!ProcessSegment(*it, completedHandles)) {
+        // If not completed, none of the succeeding are either
+        if (!IsSegmentCompleted(*it, completedTimelineValue)) {
             break;
         }
 
-        // Add back to pool
-        FreeSegmentNoQueueLock(queue, *it);
+        // Hand off to the worker, if full, retry on the next sync point
+        if (!retiredSegments.TryPush(ShaderExportRetiredSegment { .queue = queue, .segment = *it })) {
+            break;
+        }
     }
 
-    // Remove dead segments
+    // Remove retired segments
     queue->liveSegments.erase(queue->liveSegments.begin(), it);
 }
 
-bool ShaderExportStreamer::ProcessSegment(ShaderExportStreamSegment *segment, TrivialStackVector<CommandContextHandle, 32u>& completedHandles) {
-    // Ready?
-    if (!segment->fence->IsCommitted(segment->fenceNextCommitId)) {
-        return false;
+bool ShaderExportStreamer::IsSegmentCompleted(ShaderExportStreamSegment *segment, uint64_t completedTimelineValue) {
+    // Timeline tracked?
+    if (segment->timelineValue) {
+        return completedTimelineValue >= segment->timelineValue;
     }
 
+    // Fallback, query the fence
+    return segment->fence->IsCommitted(segment->fenceNextCommitId);
+}
+
+void ShaderExportStreamer::ProcessSegment(ShaderExportStreamSegment *segment, TrivialStackVector<CommandContextHandle, 32u>& completedHandles) {
     // Output for messages
     IMessageStorage* output = bridge->GetOutput();
 
-    // Map the counters
-    const MirrorAllocation& counterMirror = segment->allocation->counter.allocation;
-    auto* counters = static_cast<uint32_t*>(deviceAllocator->Map(counterMirror.host));
+    // Map the produced data of all streams
+    TrivialStackVector<ShaderExportStreamView, 32u> views;
+    if (segment->allocation->persistent) {
+        MapRingStreams(segment, views);
+    } else {
+        MapStreams(segment, views);
+    }
+
+    // Coalesce all aggregatable streams on the host if requested
+    const bool aggregate = aggregator && aggregator->IsEnabled();
+    if (aggregate) {
+        AggregateSegment(segment, views, output);
+    }
 
     // Process all streams
     for (size_t i = 0; i < segment->allocation->streams.size(); i++) {
         const ShaderExportStreamInfo& streamInfo = segment->allocation->streams[i];
+        const ShaderExportStreamView& view = views[i];
 
-        // Get the written counter
-        uint32_t elementCount = counters[i];
-
-        // Limit the counter by the physical size of the buffer (may exceed)
-        elementCount = std::min(elementCount, static_cast<uint32_t>(streamInfo.byteSize / streamInfo.typeInfo.typeSize));
-
-        // Map the stream
-        auto* stream = static_cast<uint8_t*>(deviceAllocator->Map(streamInfo.allocation.host));
-
-        // Size of the stream
-        size_t size = elementCount * sizeof(uint32_t);
+        // Already coalesced, or nothing consumed from the ring?
+        if ((aggregate && aggregator->IsAggregatable(streamInfo.typeInfo)) || !view.data) {
+            continue;
+        }
 
         // Copy into stream
         MessageStream messageStream;
         messageStream.SetSchema(streamInfo.typeInfo.messageSchema);
         messageStream.SetVersionID(segment->versionSegPoint.id);
-        messageStream.SetData(stream, size, static_cast<uint32_t>(size / streamInfo.typeInfo.typeSize));
+
+        // Bulk export data, may be dropped under transport overload
+        messageStream.SetLossy(true);
+        messageStream.SetData(view.data, view.size, static_cast<uint32_t>(view.size / streamInfo.typeInfo.typeSize));
 
         // Add output
         output->AddStream(messageStream);
-
-        // Unmap
-        deviceAllocator->Unmap(streamInfo.allocation.host);
     }
 
-    // Unmap host
-    deviceAllocator->Unmap(counterMirror.host);
+    // Unmap all streams
+    UnmapStreams(segment, views);
 
     // Inform the versioning controller of a collapse
     ASSERT(segment->versionSegPoint.id != UINT32_MAX, "Untracked versioning");
@@ -725,9 +907,206 @@ bool ShaderExportStreamer::ProcessSegment(ShaderExportStreamSegment *segment, Tr
     for (CommandContextHandle handle : segment->commandContextHandles) {
         completedHandles.Add(handle);
     }
+}
 
-    // Done!
-    return true;
+void ShaderExportStreamer::MapStreams(ShaderExportStreamSegment *segment, TrivialStackVector<ShaderExportStreamView, 32u> &views) {
+    // Map the counters
+    const MirrorAllocation& counterMirror = segment->allocation->counter.allocation;
+    auto* counters = static_cast<uint32_t*>(deviceAllocator->Map(counterMirror.host));
+
+    // Map all streams
+    for (size_t i = 0; i < segment->allocation->streams.size(); i++) {
+        const ShaderExportStreamInfo& streamInfo = segment->allocation->streams[i];
+
+        // Get the written counter
+        uint32_t elementCount = counters[i];
+
+        // Limit the counter by the physical size of the buffer (may exceed)
+        elementCount = std::min(elementCount, static_cast<uint32_t>(streamInfo.byteSize / streamInfo.typeInfo.typeSize));
+
+        // Map the stream
+        views.Add(ShaderExportStreamView {
+            .data = deviceAllocator->Map(streamInfo.allocation.host),
+            .size = elementCount * sizeof(uint32_t),
+            .mapped = true
+        });
+    }
+
+    // Unmap host
+    deviceAllocator->Unmap(counterMirror.host);
+}
+
+void ShaderExportStreamer::MapRingStreams(ShaderExportStreamSegment *segment, TrivialStackVector<ShaderExportStreamView, 32u> &views) {
+    ShaderExportSegmentInfo* ring = segment->allocation;
+
+    // Map the head snapshot of this segment
+    auto* heads = static_cast<uint32_t*>(deviceAllocator->Map(segment->ringSnapshot.allocation));
+
+    // Map the live heads, host resident, still allocated against by in flight submissions
+    auto* liveHeads = static_cast<const volatile uint32_t*>(deviceAllocator->Map(ring->counter.allocation.host));
+
+    // Ensure there's enough scratch space
+    if (ringScratch.size() < ring->streams.size()) {
+        ringScratch.resize(ring->streams.size());
+    }
+
+    // Map all streams
+    for (size_t i = 0; i < ring->streams.size(); i++) {
+        const ShaderExportStreamInfo& streamInfo = ring->streams[i];
+
+        // Consume everything up to the head
+        const uint32_t capacity = static_cast<uint32_t>(streamInfo.byteSize / sizeof(uint32_t));
+        const uint32_t tail = ring->tails[i];
+        ring->tails[i] = heads[i];
+
+        // Get the window against all allocations so far, succeeding submissions may have lapped it
+        ShaderExportRingWindow window = GetShaderExportRingWindow(tail, heads[i], liveHeads[i], capacity);
+
+        // Nothing produced, or are the contents no longer consistent?
+        if (!window.count || window.overwrittenCount == window.count) {
+            views.Add(ShaderExportStreamView { });
+            continue;
+        }
+
+        // Linearize into scratch memory, the ring may be written while the segment is processed
+        std::vector<uint32_t>& scratch = ringScratch[i];
+        scratch.resize(window.count);
+
+        // Copy both sides of the wrap
+        auto* stream = static_cast<const uint32_t*>(deviceAllocator->Map(streamInfo.allocation.host));
+        std::memcpy(scratch.data(), stream + window.offset, window.upperCount * sizeof(uint32_t));
+        std::memcpy(scratch.data() + window.upperCount, stream, (window.count - window.upperCount) * sizeof(uint32_t));
+        deviceAllocator->Unmap(streamInfo.allocation.host);
+
+        // Re-read the live head, allocations during the copy may have lapped the window front to back
+        window = GetShaderExportRingWindow(tail, heads[i], liveHeads[i], capacity);
+
+        // Discard all overwritten records
+        uint32_t discardCount = window.overwrittenCount;
+        if (discardCount) {
+            if (streamInfo.typeInfo.messageSize) {
+                // Variably sized records, boundaries are unknown
+                discardCount = window.count;
+            } else {
+                // Fixed size records, round up to the next whole record
+                const auto recordCount = static_cast<uint32_t>(streamInfo.typeInfo.typeSize / sizeof(uint32_t));
+                discardCount = std::min(window.count, (discardCount + recordCount - 1) / recordCount * recordCount);
+            }
+        }
+
+        // Entirely overwritten?
+        if (discardCount == window.count) {
+            views.Add(ShaderExportStreamView { });
+            continue;
+        }
+
+        // Linearized
+        views.Add(ShaderExportStreamView {
+            .data = scratch.data() + discardCount,
+            .size = (window.count - discardCount) * sizeof(uint32_t)
+        });
+    }
+
+    // Unmap heads
+    deviceAllocator->Unmap(ring->counter.allocation.host);
+    deviceAllocator->Unmap(segment->ringSnapshot.allocation);
+}
+
+void ShaderExportStreamer::UnmapStreams(ShaderExportStreamSegment *segment, const TrivialStackVector<ShaderExportStreamView, 32u> &views) {
+    for (size_t i = 0; i < views.Size(); i++) {
+        if (views[i].mapped) {
+            deviceAllocator->Unmap(segment->allocation->streams[i].allocation.host);
+        }
+    }
+}
+
+void ShaderExportStreamer::AggregateSegment(ShaderExportStreamSegment *segment, const TrivialStackVector<ShaderExportStreamView, 32u> &views, IMessageStorage *output) {
+    // All records of a segment share the same timestamp
+    const uint64_t timestamp = GetAggregationTimestamp();
+
+    // Aggregation jobs, one per non-empty export
+    TrivialStackVector<ShaderExportAggregationJob, 32u> jobs;
+
+    // Collect all aggregatable streams
+    for (size_t i = 0; i < segment->allocation->streams.size(); i++) {
+        const ShaderExportStreamInfo& streamInfo = segment->allocation->streams[i];
+
+        // Forwarded as is?
+        if (!aggregator->IsAggregatable(streamInfo.typeInfo) || !views[i].size) {
+            continue;
+        }
+
+        // Create job
+        jobs.Add(ShaderExportAggregationJob {
+            .id = static_cast<ShaderExportID>(i),
+            .typeInfo = &streamInfo.typeInfo,
+            .data = views[i].data,
+            .size = views[i].size,
+            .versionID = segment->versionSegPoint.id,
+            .timestamp = timestamp,
+            .output = output
+        });
+    }
+
+    // Exports are aggregated independently, run all but the first on the workers
+    if (jobs.Size() > 1) {
+        if (!aggregationDispatcher) {
+            aggregationDispatcher = registry->New<Dispatcher>(kAggregationWorkerCount);
+        }
+
+        // Signalled once all workers have completed
+        Event event;
+
+        // Completion bucket
+        DispatcherBucket bucket;
+        bucket.userData = &event;
+        bucket.completionFunctor = Delegate<void(void*)>(nullptr, [](void*, void* userData) {
+            static_cast<Event*>(userData)->Signal();
+        });
+
+        // Set the counter ahead of submission, early completions must not signal
+        bucket.SetCounter(static_cast<uint32_t>(jobs.Size() - 1));
+
+        // Submit all worker jobs
+        TrivialStackVector<DispatcherJob, 32u> dispatcherJobs;
+        for (size_t i = 1; i < jobs.Size(); i++) {
+            dispatcherJobs.Add(DispatcherJob {
+                .userData = &jobs[i],
+                .delegate = BindDelegate(this, ShaderExportStreamer::AggregateJob),
+                .bucket = &bucket
+            });
+        }
+
+        // Submit!
+        aggregationDispatcher->AddBatch(dispatcherJobs.Data(), static_cast<uint32_t>(dispatcherJobs.Size()));
+
+        // Aggregate the first on this thread
+        AggregateJob(&jobs[0]);
+
+        // Streams are mapped, wait for all workers
+        event.Wait();
+    } else if (jobs.Size() == 1) {
+        AggregateJob(&jobs[0]);
+    }
+}
+
+void ShaderExportStreamer::AggregateJob(void *data) {
+    auto* job = static_cast<ShaderExportAggregationJob*>(data);
+    aggregator->Aggregate(job->id, *job->typeInfo, job->versionID, job->data, job->size, job->timestamp, job->output);
+}
+
+void ShaderExportStreamer::FlushExpiredAggregates(bool force) {
+    if (!aggregator) {
+        return;
+    }
+
+    // Flush all expired, or every, aggregate
+    aggregator->Flush(force ? UINT64_MAX : GetAggregationTimestamp(), bridge->GetOutput());
+}
+
+void ShaderExportStreamer::FlushAggregates() {
+    std::lock_guard guard(processMutex);
+    FlushExpiredAggregates(true);
 }
 
 void ShaderExportStreamer::FreeSegmentNoQueueLock(ShaderExportQueueState* queue, ShaderExportStreamSegment *segment) {
@@ -735,16 +1114,23 @@ void ShaderExportStreamer::FreeSegmentNoQueueLock(ShaderExportQueueState* queue,
     QueueState* queueState = table->states_queue.GetNoLock(queue->queue);
 
     // Move ownership to queue (don't release the reference count, queue owns it now)
-    if (segment->fence->isImmediate) {
+    if (segment->fence && segment->fence->isImmediate) {
         queueState->pools_fences.Push(segment->fence);
     }
 
+    // Release the ring snapshot, the ring itself is owned by the queue
+    if (segment->allocation->persistent) {
+        streamAllocator->FreeRingSnapshot(segment->ringSnapshot);
+        segment->ringSnapshot = {};
+    }
+
     // Cleanup
     segment->commandContextHandles.clear();
 
     // Remove fence reference
     segment->fence = nullptr;
     segment->fenceNextCommitId = 0;
+    segment->timelineValue = 0;
 
     // Reset versioning
     segment->versionSegPoint = {};
@@ -753,6 +1139,15 @@ void ShaderExportStreamer::FreeSegmentNoQueueLock(ShaderExportQueueState* queue,
     queueState->PushCommandBuffer(segment->prePatchCommandBuffer);
     queueState->PushCommandBuffer(segment->postPatchCommandBuffer);
 
+    // Release all coalesced command buffers
+    for (VkCommandBuffer commandBuffer : segment->coalescedCommandBuffers) {
+        queueState->PushCommandBuffer(commandBuffer);
+    }
+
+    // Cleanup coalescing
+    segment->coalescedCommandBuffers.clear();
+    segment->submissionCount = 0;
+
     // Release persistent version
     destroyRef(segment->prmtPersistentVersion, allocators);
 
@@ -796,9 +1191,9 @@ VkCommandBuffer ShaderExportStreamer::RecordPreCommandBuffer(ShaderExportQueueSt
     //   Only required once per segment allocation, as the segments are recycled this usually
     //   only occurs during application startup.
     if (segment->allocation->pendingInitialization) {
-        // Clear device counters
+        // Clear device counters, including all budget counters
         VkBufferCopy copy{};
-        copy.size = sizeof(ShaderExportCounter) * segment->allocation->streams.size();
+        copy.size = sizeof(ShaderExportCounter) * segment->allocation->counter.deviceCounterCount;
         table->commandBufferDispatchTable.next_vkCmdFillBuffer(segment->prePatchCommandBuffer, segment->allocation->counter.buffer, 0u, copy.size, 0x0);
 
         // Flush barrier
@@ -831,6 +1226,29 @@ VkCommandBuffer ShaderExportStreamer::RecordPreCommandBuffer(ShaderExportQueueSt
     return segment->prePatchCommandBuffer;
 }
 
+VkCommandBuffer ShaderExportStreamer::BeginCoalescedCommandBuffer(ShaderExportQueueState* state, ShaderExportStreamSegment* segment) {
+    std::lock_guard guard(mutex);
+
+    // Get queue
+    QueueState* queueState = table->states_queue.Get(state->queue);
+
+    // Pop a new command buffer, released with the segment
+    VkCommandBuffer commandBuffer = queueState->PopCommandBuffer();
+    segment->coalescedCommandBuffers.push_back(commandBuffer);
+
+    // Begin info
+    VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    // Attempt to begin
+    if (table->next_vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+        return nullptr;
+    }
+
+    // OK
+    return commandBuffer;
+}
+
 VkCommandBuffer ShaderExportStreamer::RecordPostCommandBuffer(ShaderExportQueueState* state, ShaderExportStreamSegment* segment) {
     std::lock_guard guard(mutex);
 
@@ -867,6 +1285,29 @@ VkCommandBuffer ShaderExportStreamer::RecordPostCommandBuffer(ShaderExportQueueS
     // Copy the counter from device to host
     VkBufferCopy copy{};
     copy.size = sizeof(ShaderExportCounter) * segment->allocation->streams.size();
+
+    // Persistent rings only snapshot the heads, the counters are never cleared
+    if (segment->allocation->persistent) {
+        if (copy.size) {
+            table->commandBufferDispatchTable.next_vkCmdCopyBuffer(segment->postPatchCommandBuffer, counter.buffer, segment->ringSnapshot.buffer, 1u, &copy);
+        }
+
+        // Flush snapshot to host
+        //   Succeeding submissions on this queue wait on the snapshot, so it never includes their records
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        table->commandBufferDispatchTable.next_vkCmdPipelineBarrier(
+            segment->postPatchCommandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_HOST_BIT, 0x0,
+            1, &barrier,
+            0, nullptr,
+            0, nullptr
+        );
+
+        // OK
+        return segment->postPatchCommandBuffer;
+    }
+
     table->commandBufferDispatchTable.next_vkCmdCopyBuffer(segment->postPatchCommandBuffer, counter.buffer, counter.bufferHost, 1u, &copy);
 
     // Flush all queue work
@@ -880,8 +1321,8 @@ VkCommandBuffer ShaderExportStreamer::RecordPostCommandBuffer(ShaderExportQueueS
             0, nullptr
     );
 
-    // Clear device counters
-    table->commandBufferDispatchTable.next_vkCmdFillBuffer(segment->postPatchCommandBuffer, counter.buffer, 0u, copy.size, 0x0);
+    // Clear device counters, budgets are per segment
+    table->commandBufferDispatchTable.next_vkCmdFillBuffer(segment->postPatchCommandBuffer, counter.buffer, 0u, sizeof(ShaderExportCounter) * counter.deviceCounterCount, 0x0);
 
     // Flush all queue work
     barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
@@ -39,6 +39,9 @@
 #include <Backends/Vulkan/Resource/ResourceInfo.h>
 #include <Backend/Resource/ResourceInfo.h>
 
+// Common
+#include <Common/Containers/TrivialStackVector.h>
+
 /// Check if a state is volumetric
 static bool IsVolumetric(ImageState* state) {
     return state->createInfo.extent.depth > 1u;
@@ -54,7 +57,11 @@ void FeatureHook_vkCmdCopyBuffer::operator()(CommandBufferObject *object, Comman
     BufferState* srcBufferState = object->table->states_buffer.Get(srcBuffer);
     BufferState* dstBufferState = object->table->states_buffer.Get(dstBuffer);
 
-    // Invoke hook per region
+    // All region infos
+    TrivialStackVector<ResourceInfo, 16u> sources(object->table->allocators);
+    TrivialStackVector<ResourceInfo, 16u> dests(object->table->allocators);
+
+    // Collect all regions
     for (uint32_t i = 0; i < regionCount; i++) {
         // Setup source descriptor
         BufferDescriptor srcDescriptor{
@@ -70,13 +77,13 @@ void FeatureHook_vkCmdCopyBuffer::operator()(CommandBufferObject *object, Comman
             .uid = dstBufferState->uid
         };
 
-        // Invoke hook
-        hook.Invoke(
-            context,
-            ResourceInfo::Buffer(srcBufferState->virtualMapping.token, srcDescriptor),
-            ResourceInfo::Buffer(dstBufferState->virtualMapping.token, dstDescriptor)
-        );
+        // Add region
+        sources.Add(ResourceInfo::Buffer(srcBufferState->virtualMapping.token, srcDescriptor));
+        dests.Add(ResourceInfo::Buffer(dstBufferState->virtualMapping.token, dstDescriptor));
     }
+
+    // Invoke all features once for all regions
+    InvokeSpan(context, static_cast<uint32_t>(dests.Size()), sources.Data(), dests.Data());
 }
 
 void FeatureHook_vkCmdCopyImage::operator()(CommandBufferObject *object, CommandContext *context, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageCopy *pRegions) const {
@@ -84,7 +91,11 @@ void FeatureHook_vkCmdCopyImage::operator()(CommandBufferObject *object, Command
     ImageState* srcImageState = object->table->states_image.Get(srcImage);
     ImageState* dstImageState = object->table->states_image.Get(dstImage);
 
-    // Invoke hook per region
+    // All region infos
+    TrivialStackVector<ResourceInfo, 16u> sources(object->table->allocators);
+    TrivialStackVector<ResourceInfo, 16u> dests(object->table->allocators);
+
+    // Collect all regions
     for (uint32_t i = 0; i < regionCount; i++) {
         const VkImageCopy& region = pRegions[i];
 
@@ -122,13 +133,13 @@ void FeatureHook_vkCmdCopyImage::operator()(CommandBufferObject *object, Command
             .uid = dstImageState->uid
         };
 
-        // Invoke hook
-        hook.Invoke(
-            context,
-            ResourceInfo::Texture(srcImageState->virtualMappingTemplate.token, IsVolumetric(srcImageState), srcDescriptor),
-            ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor)
-        );
+        // Add region
+        sources.Add(ResourceInfo::Texture(srcImageState->virtualMappingTemplate.token, IsVolumetric(srcImageState), srcDescriptor));
+        dests.Add(ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor));
     }
+
+    // Invoke all features once for all regions
+    InvokeSpan(context, static_cast<uint32_t>(dests.Size()), sources.Data(), dests.Data());
 }
 
 void FeatureHook_vkCmdBlitImage::operator()(CommandBufferObject *object, CommandContext *context, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageBlit *pRegions, VkFilter filter) const {
@@ -136,7 +147,11 @@ void FeatureHook_vkCmdBlitImage::operator()(CommandBufferObject *object, Command
     ImageState* srcImageState = object->table->states_image.Get(srcImage);
     ImageState* dstImageState = object->table->states_image.Get(dstImage);
 
-    // Invoke hook per region
+    // All region infos
+    TrivialStackVector<ResourceInfo, 16u> sources(object->table->allocators);
+    TrivialStackVector<ResourceInfo, 16u> dests(object->table->allocators);
+
+    // Collect all regions
     for (uint32_t i = 0; i < regionCount; i++) {
         const VkImageBlit& region = pRegions[i];
 
@@ -174,13 +189,13 @@ void FeatureHook_vkCmdBlitImage::operator()(CommandBufferObject *object, Command
             .uid = dstImageState->uid
         };
 
-        // Invoke hook
-        hook.Invoke(
-            context,
-            ResourceInfo::Texture(srcImageState->virtualMappingTemplate.token, IsVolumetric(srcImageState), srcDescriptor),
-            ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor)
-        );
+        // Add region
+        sources.Add(ResourceInfo::Texture(srcImageState->virtualMappingTemplate.token, IsVolumetric(srcImageState), srcDescriptor));
+        dests.Add(ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor));
     }
+
+    // Invoke all features once for all regions
+    InvokeSpan(context, static_cast<uint32_t>(dests.Size()), sources.Data(), dests.Data());
 }
 
 void FeatureHook_vkCmdCopyBufferToImage::operator()(CommandBufferObject *object, CommandContext *context, VkBuffer srcBuffer, VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount, const VkBufferImageCopy *pRegions) const {
@@ -188,7 +203,11 @@ void FeatureHook_vkCmdCopyBufferToImage::operator()(CommandBufferObject *object,
     BufferState* srcBufferState = object->table->states_buffer.Get(srcBuffer);
     ImageState*  dstImageState  = object->table->states_image.Get(dstImage);
 
-    // Invoke hook per region
+    // All region infos
+    TrivialStackVector<ResourceInfo, 16u> sources(object->table->allocators);
+    TrivialStackVector<ResourceInfo, 16u> dests(object->table->allocators);
+
+    // Collect all regions
     for (uint32_t i = 0; i < regionCount; i++) {
         const VkBufferImageCopy& region = pRegions[i];
 
@@ -218,13 +237,13 @@ void FeatureHook_vkCmdCopyBufferToImage::operator()(CommandBufferObject *object,
             .uid = dstImageState->uid
         };
 
-        // Invoke hook
-        hook.Invoke(
-            context,
-            ResourceInfo::Buffer(srcBufferState->virtualMapping.token, srcDescriptor),
-            ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor)
-        );
+        // Add region
+        sources.Add(ResourceInfo::Buffer(srcBufferState->virtualMapping.token, srcDescriptor));
+        dests.Add(ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor));
     }
+
+    // Invoke all features once for all regions
+    InvokeSpan(context, static_cast<uint32_t>(dests.Size()), sources.Data(), dests.Data());
 }
 
 void FeatureHook_vkCmdCopyBufferToImage2::operator()(CommandBufferObject *object, CommandContext *context, const VkCopyBufferToImageInfo2* pCopyBufferToImageInfo) const {
@@ -232,7 +251,11 @@ void FeatureHook_vkCmdCopyBufferToImage2::operator()(CommandBufferObject *object
     BufferState* srcBufferState = object->table->states_buffer.Get(pCopyBufferToImageInfo->srcBuffer);
     ImageState*  dstImageState  = object->table->states_image.Get(pCopyBufferToImageInfo->dstImage);
 
-    // Invoke hook per region
+    // All region infos
+    TrivialStackVector<ResourceInfo, 16u> sources(object->table->allocators);
+    TrivialStackVector<ResourceInfo, 16u> dests(object->table->allocators);
+
+    // Collect all regions
     for (uint32_t i = 0; i < pCopyBufferToImageInfo->regionCount; i++) {
         const VkBufferImageCopy2& region = pCopyBufferToImageInfo->pRegions[i];
 
@@ -262,13 +285,13 @@ void FeatureHook_vkCmdCopyBufferToImage2::operator()(CommandBufferObject *object
             .uid = dstImageState->uid
         };
 
-        // Invoke hook
-        hook.Invoke(
-            context,
-            ResourceInfo::Buffer(srcBufferState->virtualMapping.token, srcDescriptor),
-            ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor)
-        );
+        // Add region
+        sources.Add(ResourceInfo::Buffer(srcBufferState->virtualMapping.token, srcDescriptor));
+        dests.Add(ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor));
     }
+
+    // Invoke all features once for all regions
+    InvokeSpan(context, static_cast<uint32_t>(dests.Size()), sources.Data(), dests.Data());
 }
 
 void FeatureHook_vkCmdCopyImageToBuffer::operator()(CommandBufferObject *object, CommandContext *context, VkImage srcImage, VkImageLayout srcImageLayout, VkBuffer dstBuffer, uint32_t regionCount, const VkBufferImageCopy *pRegions) const {
@@ -276,7 +299,11 @@ void FeatureHook_vkCmdCopyImageToBuffer::operator()(CommandBufferObject *object,
     ImageState*  srcImageState  = object->table->states_image.Get(srcImage);
     BufferState* dstBufferState = object->table->states_buffer.Get(dstBuffer);
 
-    // Invoke hook per region
+    // All region infos
+    TrivialStackVector<ResourceInfo, 16u> sources(object->table->allocators);
+    TrivialStackVector<ResourceInfo, 16u> dests(object->table->allocators);
+
+    // Collect all regions
     for (uint32_t i = 0; i < regionCount; i++) {
         const VkBufferImageCopy& region = pRegions[i];
 
@@ -306,13 +333,13 @@ void FeatureHook_vkCmdCopyImageToBuffer::operator()(CommandBufferObject *object,
             .uid = dstBufferState->uid
         };
 
-        // Invoke hook
-        hook.Invoke(
-            context,
-            ResourceInfo::Texture(srcImageState->virtualMappingTemplate.token, IsVolumetric(srcImageState), srcDescriptor),
-            ResourceInfo::Buffer(dstBufferState->virtualMapping.token, dstDescriptor)
-        );
+        // Add region
+        sources.Add(ResourceInfo::Texture(srcImageState->virtualMappingTemplate.token, IsVolumetric(srcImageState), srcDescriptor));
+        dests.Add(ResourceInfo::Buffer(dstBufferState->virtualMapping.token, dstDescriptor));
     }
+
+    // Invoke all features once for all regions
+    InvokeSpan(context, static_cast<uint32_t>(dests.Size()), sources.Data(), dests.Data());
 }
 
 void FeatureHook_vkCmdCopyImageToBuffer2::operator()(CommandBufferObject *object, CommandContext *context, const VkCopyImageToBufferInfo2* pCopyImageToBufferInfo) const {
@@ -320,7 +347,11 @@ void FeatureHook_vkCmdCopyImageToBuffer2::operator()(CommandBufferObject *object
     ImageState*  srcImageState  = object->table->states_image.Get(pCopyImageToBufferInfo->srcImage);
     BufferState* dstBufferState = object->table->states_buffer.Get(pCopyImageToBufferInfo->dstBuffer);
 
-    // Invoke hook per region
+    // All region infos
+    TrivialStackVector<ResourceInfo, 16u> sources(object->table->allocators);
+    TrivialStackVector<ResourceInfo, 16u> dests(object->table->allocators);
+
+    // Collect all regions
     for (uint32_t i = 0; i < pCopyImageToBufferInfo->regionCount; i++) {
         const VkBufferImageCopy2& region = pCopyImageToBufferInfo->pRegions[i];
 
@@ -350,13 +381,13 @@ void FeatureHook_vkCmdCopyImageToBuffer2::operator()(CommandBufferObject *object
             .uid = dstBufferState->uid
         };
 
-        // Invoke hook
-        hook.Invoke(
-            context,
-            ResourceInfo::Texture(srcImageState->virtualMappingTemplate.token, IsVolumetric(srcImageState), srcDescriptor),
-            ResourceInfo::Buffer(dstBufferState->virtualMapping.token, dstDescriptor)
-        );
+        // Add region
+        sources.Add(ResourceInfo::Texture(srcImageState->virtualMappingTemplate.token, IsVolumetric(srcImageState), srcDescriptor));
+        dests.Add(ResourceInfo::Buffer(dstBufferState->virtualMapping.token, dstDescriptor));
     }
+
+    // Invoke all features once for all regions
+    InvokeSpan(context, static_cast<uint32_t>(dests.Size()), sources.Data(), dests.Data());
 }
 
 void FeatureHook_vkCmdUpdateBuffer::operator()(CommandBufferObject *object, CommandContext *context, VkBuffer dstBuffer, VkDeviceSize dstOffset, VkDeviceSize dataSize, const void *pData) const {
@@ -399,7 +430,10 @@ void FeatureHook_vkCmdClearColorImage::operator()(CommandBufferObject *object, C
     // Get states
     ImageState* dstImageState = object->table->states_image.Get(image);
 
-    // Invoke hook per region
+    // All region infos
+    TrivialStackVector<ResourceInfo, 16u> resources(object->table->allocators);
+
+    // Collect all regions
     for (uint32_t i = 0; i < rangeCount; i++) {
         VkImageSubresourceRange region = ExpandImageSubresourceRange(dstImageState, pRanges[i]);
         
@@ -416,19 +450,22 @@ void FeatureHook_vkCmdClearColorImage::operator()(CommandBufferObject *object, C
             .uid = dstImageState->uid
         };
 
-        // Invoke hook
-        hook.Invoke(
-            context,
-            ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor)
-        );
+        // Add region
+        resources.Add(ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor));
     }
+
+    // Invoke all features once for all regions
+    InvokeSpan(context, static_cast<uint32_t>(resources.Size()), resources.Data());
 }
 
 void FeatureHook_vkCmdClearDepthStencilImage::operator()(CommandBufferObject *object, CommandContext *context, VkImage image, VkImageLayout imageLayout, const VkClearDepthStencilValue *pDepthStencil, uint32_t rangeCount, const VkImageSubresourceRange *pRanges) const {
     // Get states
     ImageState* dstImageState = object->table->states_image.Get(image);
 
-    // Invoke hook per region
+    // All region infos
+    TrivialStackVector<ResourceInfo, 16u> resources(object->table->allocators);
+
+    // Collect all regions
     for (uint32_t i = 0; i < rangeCount; i++) {
         VkImageSubresourceRange region = ExpandImageSubresourceRange(dstImageState, pRanges[i]);
         
@@ -445,12 +482,12 @@ void FeatureHook_vkCmdClearDepthStencilImage::operator()(CommandBufferObject *ob
             .uid = dstImageState->uid
         };
 
-        // Invoke hook
-        hook.Invoke(
-            context,
-            ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor)
-        );
+        // Add region
+        resources.Add(ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor));
     }
+
+    // Invoke all features once for all regions
+    InvokeSpan(context, static_cast<uint32_t>(resources.Size()), resources.Data());
 }
 
 void FeatureHook_vkCmdClearAttachments::operator()(CommandBufferObject *object, CommandContext *context, uint32_t attachmentCount, const VkClearAttachment *pAttachments, uint32_t rectCount, const VkClearRect *pRects) const {
@@ -459,6 +496,9 @@ void FeatureHook_vkCmdClearAttachments::operator()(CommandBufferObject *object,
     // Get states
     FrameBufferState* frameBufferState = object->table->states_frameBuffers.Get(object->streamState->renderPass.deepCopy->framebuffer);
 
+    // All region infos
+    TrivialStackVector<ResourceInfo, 16u> resources(object->table->allocators);
+
     // Clear each attachment
     for (uint32_t attachmentIndex = 0; attachmentIndex < attachmentCount; attachmentIndex++) {
         ImageViewState* imageViewState = frameBufferState->imageViews[attachmentIndex];
@@ -478,13 +518,13 @@ void FeatureHook_vkCmdClearAttachments::operator()(CommandBufferObject *object,
                 .uid = imageViewState->uid
             };
 
-            // Invoke hook
-            hook.Invoke(
-                context,
-                ResourceInfo::Texture(imageViewState->virtualMapping.token, IsVolumetric(imageViewState), dstDescriptor)
-            );
+            // Add region
+            resources.Add(ResourceInfo::Texture(imageViewState->virtualMapping.token, IsVolumetric(imageViewState), dstDescriptor));
         }
     }
+
+    // Invoke all features once for all regions
+    InvokeSpan(context, static_cast<uint32_t>(resources.Size()), resources.Data());
 }
 
 void FeatureHook_vkCmdResolveImage::operator()(CommandBufferObject *object, CommandContext *context, VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage, VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageResolve *pRegions) const {
@@ -492,7 +532,11 @@ void FeatureHook_vkCmdResolveImage::operator()(CommandBufferObject *object, Comm
     ImageState* srcImageState = object->table->states_image.Get(srcImage);
     ImageState* dstImageState = object->table->states_image.Get(dstImage);
 
-    // Invoke hook per region
+    // All region infos
+    TrivialStackVector<ResourceInfo, 16u> sources(object->table->allocators);
+    TrivialStackVector<ResourceInfo, 16u> dests(object->table->allocators);
+
+    // Collect all regions
     for (uint32_t i = 0; i < regionCount; i++) {
         const VkImageResolve& region = pRegions[i];
 
@@ -530,13 +574,13 @@ void FeatureHook_vkCmdResolveImage::operator()(CommandBufferObject *object, Comm
             .uid = dstImageState->uid
         };
 
-        // Invoke hook
-        hook.Invoke(
-            context,
-            ResourceInfo::Texture(srcImageState->virtualMappingTemplate.token, IsVolumetric(srcImageState), srcDescriptor),
-            ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor)
-        );
+        // Add region
+        sources.Add(ResourceInfo::Texture(srcImageState->virtualMappingTemplate.token, IsVolumetric(srcImageState), srcDescriptor));
+        dests.Add(ResourceInfo::Texture(dstImageState->virtualMappingTemplate.token, IsVolumetric(dstImageState), dstDescriptor));
     }
+
+    // Invoke all features once for all regions
+    InvokeSpan(context, static_cast<uint32_t>(dests.Size()), sources.Data(), dests.Data());
 }
 
 void FeatureHook_vkCmdBeginRenderPass::operator()(CommandBufferObject *object, CommandContext *context, const VkRenderPassBeginInfo *info, VkSubpassContents contents) const {    
@@ -25,6 +25,7 @@
 // 
 
 #include <Backends/Vulkan/Fence.h>
+#include <Backends/Vulkan/Queue.h>
 #include <Backends/Vulkan/States/FenceState.h>
 #include "Backends/Vulkan/Tables/DeviceDispatchTable.h"
 
@@ -64,6 +65,9 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreateFence(VkDevice device, const VkFence
 VKAPI_ATTR VkResult VKAPI_PTR Hook_vkGetFenceStatus(VkDevice device, VkFence fence) {
     DeviceDispatchTable* table = DeviceDispatchTable::Get(GetInternalTable(device));
 
+    // Applications synchronizing through earlier fences may never wait on the queue
+    CloseExpiredSegments(table);
+
     // Get the state
     FenceState* state = table->states_fence.Get(fence);
 
@@ -83,6 +87,9 @@ VKAPI_ATTR VkResult VKAPI_PTR Hook_vkGetFenceStatus(VkDevice device, VkFence fen
 VKAPI_ATTR VkResult VKAPI_CALL Hook_vkWaitForFences(VkDevice device, uint32_t fenceCount, const VkFence* pFences, VkBool32 waitAll, uint64_t timeout) {
     DeviceDispatchTable* table = DeviceDispatchTable::Get(GetInternalTable(device));
 
+    // Applications synchronizing through earlier fences may never wait on the queue
+    CloseExpiredSegments(table);
+
     // Pass down callchain
     VkResult result = table->next_vkWaitForFences(device, fenceCount, pFences, waitAll, timeout);
 
@@ -44,7 +44,7 @@ static ShaderModuleState* GetPipelineStageShaderModule(DeviceDispatchTable* tabl
         auto state = new (table->allocators) ShaderModuleState;
         state->table = table;
         state->object = nullptr;
-        state->createInfoDeepCopy.DeepCopy(table->allocators, *moduleCreateInfo);
+        state->CopyCreateInfo(table->allocators, *moduleCreateInfo);
 
         // Keep track of it
         table->states_shaderModule.Add(nullptr, state);
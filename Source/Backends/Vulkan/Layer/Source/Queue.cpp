@@ -33,6 +33,7 @@
 #include <Backends/Vulkan/States/SwapchainState.h>
 #include <Backends/Vulkan/Objects/CommandBufferObject.h>
 #include <Backends/Vulkan/Export/ShaderExportStreamer.h>
+#include <Backends/Vulkan/Export/ShaderExportCoalescing.h>
 #include <Backends/Vulkan/Controllers/VersioningController.h>
 #include <Backends/Vulkan/ShaderData/ShaderDataHost.h>
 #include <Backends/Vulkan/Command/UserCommandBuffer.h>
@@ -67,6 +68,9 @@ void CreateQueueState(DeviceDispatchTable *table, VkQueue queue, uint32_t family
         return;
     }
 
+    // Try to create the completion timeline, fences are used otherwise
+    state->timeline.Install(table);
+
     // Allocate the streaming state
     state->exportState = table->exportStreamer->AllocateQueueState(state);
 
@@ -189,94 +193,253 @@ static void InvokePreSubmitBatchHook(DeviceDispatchTable* device, QueueState* qu
     }
 }
 
-static VkCommandBuffer RecordExecutePreCommandBuffer(DeviceDispatchTable* device, QueueState* queueState, ShaderExportStreamSegment* segment) {
-    ShaderExportStreamSegmentUserContext& context = segment->userPreContext;
+static void CommitUserContext(DeviceDispatchTable* device, VkCommandBuffer patchBuffer, ShaderExportStreamSegmentUserContext& context) {
+    // Any commands?
+    if (!context.commandContext.buffer.Count()) {
+        return;
+    }
+
+    // Lazy allocate streaming state
+    if (!context.streamState) {
+        context.streamState = device->exportStreamer->AllocateStreamState();
+    }
+
+    // Open the streamer state
+    device->exportStreamer->BeginCommandBuffer(context.streamState, patchBuffer);
+    {
+        // Commit all commands
+        CommitCommands(
+            device,
+            patchBuffer,
+            context.commandContext.buffer,
+            context.streamState
+        );
+
+        // Close the streamer state
+        device->exportStreamer->EndCommandBuffer(context.streamState, patchBuffer);
+    }
 
+    // Clear all commands
+    context.commandContext.buffer.Clear();
+}
+
+static VkCommandBuffer RecordExecutePreCommandBuffer(DeviceDispatchTable* device, QueueState* queueState, ShaderExportStreamSegment* segment) {
     // Record the streaming pre patching
     VkCommandBuffer patchBuffer = device->exportStreamer->RecordPreCommandBuffer(queueState->exportState, segment, &queueState->prmtState);
 
-    // Any commands?
-    if (context.commandContext.buffer.Count()) {
-        // Lazy allocate streaming state
-        if (!context.streamState) {
-            context.streamState = device->exportStreamer->AllocateStreamState();
-        }
-        
-        // Open the streamer state
-        device->exportStreamer->BeginCommandBuffer(context.streamState, patchBuffer);
-        {
-            // Commit all commands
-            CommitCommands(
-                device,
-                patchBuffer,
-                context.commandContext.buffer,
-                context.streamState
-            );
-        
-            // Close the streamer state
-            device->exportStreamer->EndCommandBuffer(context.streamState, patchBuffer);
-        }
-        
-        // Clear all commands
-        context.commandContext.buffer.Clear();
+    // Commit all user commands
+    CommitUserContext(device, patchBuffer, segment->userPreContext);
+
+    // Done
+    device->next_vkEndCommandBuffer(patchBuffer);
+    return patchBuffer;
+}
+
+static VkCommandBuffer RecordExecuteCoalescedPreCommandBuffer(DeviceDispatchTable* device, QueueState* queueState, ShaderExportStreamSegment* segment) {
+    // The streaming pre patching is shared with the first submission, only user commands remain
+    if (!segment->userPreContext.commandContext.buffer.Count()) {
+        return VK_NULL_HANDLE;
     }
 
+    // Begin a new command buffer, released with the segment
+    VkCommandBuffer patchBuffer = device->exportStreamer->BeginCoalescedCommandBuffer(queueState->exportState, segment);
+    if (!patchBuffer) {
+        return VK_NULL_HANDLE;
+    }
+
+    // Commit all user commands
+    CommitUserContext(device, patchBuffer, segment->userPreContext);
+
     // Done
     device->next_vkEndCommandBuffer(patchBuffer);
     return patchBuffer;
 }
 
 static VkCommandBuffer RecordExecutePostCommandBuffer(DeviceDispatchTable* device, QueueState* queueState, ShaderExportStreamSegment* segment) {
-    ShaderExportStreamSegmentUserContext& context = segment->userPostContext;
-
-    // Record the streaming pre patching
+    // Record the streaming post patching
     VkCommandBuffer patchBuffer = device->exportStreamer->RecordPostCommandBuffer(queueState->exportState, segment);
 
-    // Any commands?
-    if (context.commandContext.buffer.Count()) {
-        // Lazy allocate streaming state
-        if (!context.streamState) {
-            context.streamState = device->exportStreamer->AllocateStreamState();
-        }
-        
-        // Open the streamer state
-        device->exportStreamer->BeginCommandBuffer(context.streamState, patchBuffer);
-        {
-            // Commit all commands
-            CommitCommands(
-                device,
-                patchBuffer,
-                context.commandContext.buffer,
-                context.streamState
-            );
-        
-            // Close the streamer state
-            device->exportStreamer->EndCommandBuffer(context.streamState, patchBuffer);
-        }
-        
-        // Clear all commands
-        context.commandContext.buffer.Clear();
-    }
+    // Commit all user commands
+    CommitUserContext(device, patchBuffer, segment->userPostContext);
 
     // Done
     device->next_vkEndCommandBuffer(patchBuffer);
     return patchBuffer;
 }
 
+static std::chrono::high_resolution_clock::duration GetOpenSegmentAge(QueueState* queueState) {
+    return std::chrono::high_resolution_clock::now() - queueState->exportState->openSegmentTimeStamp;
+}
+
+static VkResult CloseOpenSegmentNoLock(DeviceDispatchTable* table, QueueState* queueState);
+
+static ShaderExportStreamSegment* AcquireCoalescedSegment(DeviceDispatchTable* table, QueueState* queueState) {
+    ShaderExportStreamSegment* segment = queueState->exportState->openSegment;
+    if (!segment) {
+        return nullptr;
+    }
+
+    // Only shareable if the segment can take another submission, and the mappings haven't changed since
+    if (!IsCoalescedSegmentExpired(segment->submissionCount, GetOpenSegmentAge(queueState)) && table->prmTable->IsUpToDate(segment->prmtPersistentVersion, &queueState->prmtState)) {
+        return segment;
+    }
+
+    // Not shareable, close it
+    CloseOpenSegmentNoLock(table, queueState);
+    return nullptr;
+}
+
+VkResult CloseOpenSegment(DeviceDispatchTable* table, QueueState* queueState) {
+    std::lock_guard guard(queueState->exportState->openSegmentMutex);
+    return CloseOpenSegmentNoLock(table, queueState);
+}
+
+static VkResult CloseOpenSegmentNoLock(DeviceDispatchTable* table, QueueState* queueState) {
+    ShaderExportStreamSegment* segment = queueState->exportState->openSegment;
+    if (!segment) {
+        return VK_SUCCESS;
+    }
+
+    // No longer open
+    queueState->exportState->openSegment = nullptr;
+
+    // Acquire internal fence if the queue has no timeline
+    FenceState* fenceState = nullptr;
+    if (!queueState->timeline.IsSupported()) {
+        fenceState = AcquireOrCreateFence(table, queueState, VK_NULL_HANDLE);
+    }
+
+    // Record the streaming post patching
+    //   Submissions with user post commands always close their segment, so there's none left
+    VkCommandBuffer postPatchCommandBuffer = RecordExecutePostCommandBuffer(table, queueState, segment);
+
+    // Timeline completion value, assigned on submission
+    VkSemaphore timelineSemaphore = queueState->timeline.GetSemaphore();
+    uint64_t    timelineValue     = 0;
+
+    // Fill timeline semaphore values
+    VkTimelineSemaphoreSubmitInfo postPatchSemaphoreSubmitInfo{VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+    postPatchSemaphoreSubmitInfo.pSignalSemaphoreValues = &timelineValue;
+    postPatchSemaphoreSubmitInfo.signalSemaphoreValueCount = fenceState ? 0u : 1u;
+
+    // Fill the post-patch submission info
+    VkSubmitInfo postPatchInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    postPatchInfo.pNext                = &postPatchSemaphoreSubmitInfo;
+    postPatchInfo.commandBufferCount   = 1;
+    postPatchInfo.pCommandBuffers      = &postPatchCommandBuffer;
+    postPatchInfo.signalSemaphoreCount = fenceState ? 0u : 1u;
+    postPatchInfo.pSignalSemaphores    = &timelineSemaphore;
+
+    // Serialize queue access
+    {
+        std::lock_guard guard(queueState->mutex);
+
+        // Timeline values must be signalled in submission order
+        if (!fenceState) {
+            timelineValue = queueState->timeline.Next();
+        }
+
+        // Pass down callchain
+        VkResult result = table->next_vkQueueSubmit(queueState->object, 1u, &postPatchInfo, fenceState ? fenceState->object : VK_NULL_HANDLE);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    // Notify streamer of submission, enqueue increments reference count
+    table->exportStreamer->Enqueue(queueState->exportState, segment, fenceState, timelineValue);
+
+    // OK
+    return VK_SUCCESS;
+}
+
+/// Collect all queues of a device
+/// \param table device table
+/// \param out destination queues
+static void CollectQueues(DeviceDispatchTable* table, TrivialStackVector<QueueState*, 16u>& out) {
+    // Closing a segment enqueues it, which acquires the queue lock, so collect under the (linear view) lock first
+    for (QueueState* queueState : table->states_queue.GetLinear()) {
+        out.Add(queueState);
+    }
+}
+
+void CloseOpenSegments(DeviceDispatchTable* table) {
+    TrivialStackVector<QueueState*, 16u> queues;
+    CollectQueues(table, queues);
+
+    // Close all queues
+    for (QueueState* queueState : queues) {
+        CloseOpenSegment(table, queueState);
+    }
+}
+
+void CloseExpiredSegments(DeviceDispatchTable* table) {
+    TrivialStackVector<QueueState*, 16u> queues;
+    CollectQueues(table, queues);
+
+    // Close all queues with expired segments
+    for (QueueState* queueState : queues) {
+        // Queues mid-submission are skipped, their segments are checked on submission
+        std::unique_lock guard(queueState->exportState->openSegmentMutex, std::try_to_lock);
+        if (!guard.owns_lock()) {
+            continue;
+        }
+
+        // Nothing open, or still young?
+        ShaderExportStreamSegment* segment = queueState->exportState->openSegment;
+        if (!segment || !IsCoalescedSegmentExpired(segment->submissionCount, GetOpenSegmentAge(queueState))) {
+            continue;
+        }
+
+        // Expired, close it
+        CloseOpenSegmentNoLock(table, queueState);
+    }
+}
+
+static bool ShouldCloseSegment(QueueState* queueState, ShaderExportStreamSegment* segment, const SubmissionContext& submitContext, VkFence userFence) {
+    // User fences must observe all prior work, scheduler signals must observe the post patching
+    if (userFence || submitContext.signalPrimitives.Size()) {
+        return true;
+    }
+
+    // User post commands are recorded in the post patching, and must not be deferred
+    if (segment->userPostContext.commandContext.buffer.Count()) {
+        return true;
+    }
+
+    // Limit the number and age of deferred submissions
+    return IsCoalescedSegmentExpired(segment->submissionCount, GetOpenSegmentAge(queueState));
+}
+
 VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo *pSubmits, VkFence userFence) {
     DeviceDispatchTable* table = DeviceDispatchTable::Get(GetInternalTable(queue));
 
     // Get the state
     QueueState* queueState = table->states_queue.Get(queue);
 
-    // Acquire fence
-    FenceState* fenceState = AcquireOrCreateFence(table, queueState, userFence);
+    // Close the expired segments of all queues, including this one
+    CloseExpiredSegments(table);
+
+    // Hold the open segment until the submission is done
+    std::lock_guard segmentGuard(queueState->exportState->openSegmentMutex);
+
+    // Try to join the open segment
+    ShaderExportStreamSegment* segment = AcquireCoalescedSegment(table, queueState);
+
+    // Shares the pre patching of a previous submission?
+    const bool isCoalesced = segment != nullptr;
+
+    // None to share, create a new streamer allocation
+    if (!isCoalesced) {
+        segment = table->exportStreamer->AllocateSegment(queueState->exportState);
+        queueState->exportState->openSegmentTimeStamp = std::chrono::high_resolution_clock::now();
 
-    // Create streamer allocation
-    ShaderExportStreamSegment* segment = table->exportStreamer->AllocateSegment();
+        // Inform the controller of the segmentation point
+        segment->versionSegPoint = table->versioningController->BranchOnSegmentationPoint();
+    }
 
-    // Inform the controller of the segmentation point
-    segment->versionSegPoint = table->versioningController->BranchOnSegmentationPoint();
+    // Account for this submission
+    segment->submissionCount++;
     
     // Number of command buffers
     uint32_t commandBufferCount = 0;
@@ -311,8 +474,10 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit(VkQueue queue, uint32_t submit
     // Unwrapped submits
     TrivialStackVector<VkSubmitInfo, 32u> vkSubmits;
     
-    // Record the streaming pre patching
-    VkCommandBuffer prePatchCommandBuffer = RecordExecutePreCommandBuffer(table, queueState, segment);
+    // Record the streaming pre patching, coalesced submissions only record the user commands
+    VkCommandBuffer prePatchCommandBuffer = isCoalesced ?
+        RecordExecuteCoalescedPreCommandBuffer(table, queueState, segment) :
+        RecordExecutePreCommandBuffer(table, queueState, segment);
 
     // All semaphores
     TrivialStackVector<VkSemaphore, 4u>          waitSemaphores;
@@ -331,14 +496,16 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit(VkQueue queue, uint32_t submit
     prePatchSemaphoreSubmitInfo.pWaitSemaphoreValues = waitSemaphoreValues.Data();
     prePatchSemaphoreSubmitInfo.waitSemaphoreValueCount = static_cast<uint32_t>(waitSemaphoreValues.Size());
 
-    // Fill pre-patch submission info
-    VkSubmitInfo& prePatchInfo = vkSubmits.Add({VK_STRUCTURE_TYPE_SUBMIT_INFO});
-    prePatchInfo.pNext              = &prePatchSemaphoreSubmitInfo;
-    prePatchInfo.commandBufferCount = 1;
-    prePatchInfo.pCommandBuffers    = &prePatchCommandBuffer;
-    prePatchInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.Size());
-    prePatchInfo.pWaitSemaphores    = waitSemaphores.Data();
-    prePatchInfo.pWaitDstStageMask  = waitSemaphoreStageFlags.Data();
+    // Fill pre-patch submission info, omitted entirely if there's nothing to wait on or execute
+    if (prePatchCommandBuffer || waitSemaphores.Size()) {
+        VkSubmitInfo& prePatchInfo = vkSubmits.Add({VK_STRUCTURE_TYPE_SUBMIT_INFO});
+        prePatchInfo.pNext              = &prePatchSemaphoreSubmitInfo;
+        prePatchInfo.commandBufferCount = prePatchCommandBuffer ? 1u : 0u;
+        prePatchInfo.pCommandBuffers    = &prePatchCommandBuffer;
+        prePatchInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.Size());
+        prePatchInfo.pWaitSemaphores    = waitSemaphores.Data();
+        prePatchInfo.pWaitDstStageMask  = waitSemaphoreStageFlags.Data();
+    }
 
     // Unwrap all internal states
     for (uint32_t i = 0; i < submitCount; i++) {
@@ -373,8 +540,11 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit(VkQueue queue, uint32_t submit
         vkCommandBuffersIt += submit.commandBufferCount;
     }
     
-    // Record the streaming patching
-    VkCommandBuffer postPatchCommandBuffer = RecordExecutePostCommandBuffer(table, queueState, segment);
+    // Does this submission complete the segment?
+    const bool closeSegment = ShouldCloseSegment(queueState, segment, submitContext, userFence);
+
+    // Streaming post patching, only recorded on completion
+    VkCommandBuffer postPatchCommandBuffer = VK_NULL_HANDLE;
 
     // All signal semaphores
     TrivialStackVector<VkSemaphore, 4u> signalSemaphores;
@@ -386,25 +556,60 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit(VkQueue queue, uint32_t submit
         signalSemaphoreValues.Add(primitive.value);
     } 
 
-    // Fill timeline semaphore values
+    // Timeline semaphore values
     VkTimelineSemaphoreSubmitInfo postPatchSemaphoreSubmitInfo{VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
-    postPatchSemaphoreSubmitInfo.pSignalSemaphoreValues = signalSemaphoreValues.Data();
-    postPatchSemaphoreSubmitInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signalSemaphoreValues.Size());
-    
-    // Fill the post-patch submission info
-    VkSubmitInfo& postPatchInfo = vkSubmits.Add({VK_STRUCTURE_TYPE_SUBMIT_INFO});
-    postPatchInfo.pNext                = &postPatchSemaphoreSubmitInfo;
-    postPatchInfo.commandBufferCount   = 1;
-    postPatchInfo.pCommandBuffers      = &postPatchCommandBuffer;
-    postPatchInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.Size());
-    postPatchInfo.pSignalSemaphores    = signalSemaphores.Data();
+
+    // Completion fence, if closing without a timeline
+    FenceState* fenceState = nullptr;
+
+    // Completion timeline signal, if closing with a timeline
+    size_t timelineSignalIndex = SIZE_MAX;
+
+    // Completing submissions record the post patching and signal completion, otherwise the segment remains open
+    if (closeSegment) {
+        postPatchCommandBuffer = RecordExecutePostCommandBuffer(table, queueState, segment);
+
+        // Prefer the queue timeline, fall back to fences
+        if (queueState->timeline.IsSupported()) {
+            timelineSignalIndex = signalSemaphores.Size();
+            signalSemaphores.Add(queueState->timeline.GetSemaphore());
+            signalSemaphoreValues.Add(0u);
+        } else {
+            fenceState = AcquireOrCreateFence(table, queueState, userFence);
+        }
+
+        // Fill timeline semaphore values
+        postPatchSemaphoreSubmitInfo.pSignalSemaphoreValues = signalSemaphoreValues.Data();
+        postPatchSemaphoreSubmitInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signalSemaphoreValues.Size());
+
+        // Fill the post-patch submission info
+        VkSubmitInfo& postPatchInfo = vkSubmits.Add({VK_STRUCTURE_TYPE_SUBMIT_INFO});
+        postPatchInfo.pNext                = &postPatchSemaphoreSubmitInfo;
+        postPatchInfo.commandBufferCount   = 1;
+        postPatchInfo.pCommandBuffers      = &postPatchCommandBuffer;
+        postPatchInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.Size());
+        postPatchInfo.pSignalSemaphores    = signalSemaphores.Data();
+
+        // No longer open
+        queueState->exportState->openSegment = nullptr;
+    } else {
+        queueState->exportState->openSegment = segment;
+    }
+
+    // Timeline completion value, assigned on submission
+    uint64_t timelineValue = 0;
 
     // Serialize queue access
     {
         std::lock_guard guard(queueState->mutex);
 
+        // Timeline values must be signalled in submission order
+        if (timelineSignalIndex != SIZE_MAX) {
+            timelineValue = signalSemaphoreValues[timelineSignalIndex] = queueState->timeline.Next();
+        }
+
         // Pass down callchain
-        VkResult result = table->next_vkQueueSubmit(queue, static_cast<uint32_t>(vkSubmits.Size()), vkSubmits.Data(), fenceState->object);
+        VkResult result = table->next_vkQueueSubmit(queue, static_cast<uint32_t>(vkSubmits.Size()), vkSubmits.Data(), fenceState ? fenceState->object : userFence);
         if (result != VK_SUCCESS) {
             return result;
         }
@@ -421,7 +626,9 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit(VkQueue queue, uint32_t submit
     }
 
     // Notify streamer of submission, enqueue increments reference count
-    table->exportStreamer->Enqueue(queueState->exportState, segment, fenceState);
+    if (closeSegment) {
+        table->exportStreamer->Enqueue(queueState->exportState, segment, fenceState, timelineValue);
+    }
 
     // OK
     return VK_SUCCESS;
@@ -433,14 +640,29 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit2(VkQueue queue, uint32_t submi
     // Get the state
     QueueState* queueState = table->states_queue.Get(queue);
 
-    // Acquire fence
-    FenceState* fenceState = AcquireOrCreateFence(table, queueState, userFence);
+    // Close the expired segments of all queues, including this one
+    CloseExpiredSegments(table);
+
+    // Hold the open segment until the submission is done
+    std::lock_guard segmentGuard(queueState->exportState->openSegmentMutex);
+
+    // Try to join the open segment
+    ShaderExportStreamSegment* segment = AcquireCoalescedSegment(table, queueState);
 
-    // Create streamer allocation
-    ShaderExportStreamSegment* segment = table->exportStreamer->AllocateSegment();
+    // Shares the pre patching of a previous submission?
+    const bool isCoalesced = segment != nullptr;
 
-    // Inform the controller of the segmentation point
-    segment->versionSegPoint = table->versioningController->BranchOnSegmentationPoint();
+    // None to share, create a new streamer allocation
+    if (!isCoalesced) {
+        segment = table->exportStreamer->AllocateSegment(queueState->exportState);
+        queueState->exportState->openSegmentTimeStamp = std::chrono::high_resolution_clock::now();
+
+        // Inform the controller of the segmentation point
+        segment->versionSegPoint = table->versioningController->BranchOnSegmentationPoint();
+    }
+
+    // Account for this submission
+    segment->submissionCount++;
 
     // Number of command buffers
     uint32_t commandBufferCount = 0;
@@ -473,8 +695,10 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit2(VkQueue queue, uint32_t submi
     // Unwrapped submits
     TrivialStackVector<VkSubmitInfo2, 32u> vkSubmits;
     
-    // Record the streaming pre patching
-    VkCommandBuffer prePatchCommandBuffer = RecordExecutePreCommandBuffer(table, queueState, segment);
+    // Record the streaming pre patching, coalesced submissions only record the user commands
+    VkCommandBuffer prePatchCommandBuffer = isCoalesced ?
+        RecordExecuteCoalescedPreCommandBuffer(table, queueState, segment) :
+        RecordExecutePreCommandBuffer(table, queueState, segment);
 
     // Fill pre-patch streaming submit info
     VkCommandBufferSubmitInfo prePatchCommandSubmit{VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
@@ -492,12 +716,14 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit2(VkQueue queue, uint32_t submi
         waitSemaphores.Add(info);
     }
     
-    // Fill patch submission info
-    VkSubmitInfo2& prePatchInfo = vkSubmits.Add({VK_STRUCTURE_TYPE_SUBMIT_INFO_2});
-    prePatchInfo.commandBufferInfoCount = 1;
-    prePatchInfo.pCommandBufferInfos    = &prePatchCommandSubmit;
-    prePatchInfo.waitSemaphoreInfoCount = static_cast<uint32_t>(waitSemaphores.Size());
-    prePatchInfo.pWaitSemaphoreInfos    = waitSemaphores.Data();
+    // Fill patch submission info, omitted entirely if there's nothing to wait on or execute
+    if (prePatchCommandBuffer || waitSemaphores.Size()) {
+        VkSubmitInfo2& prePatchInfo = vkSubmits.Add({VK_STRUCTURE_TYPE_SUBMIT_INFO_2});
+        prePatchInfo.commandBufferInfoCount = prePatchCommandBuffer ? 1u : 0u;
+        prePatchInfo.pCommandBufferInfos    = &prePatchCommandSubmit;
+        prePatchInfo.waitSemaphoreInfoCount = static_cast<uint32_t>(waitSemaphores.Size());
+        prePatchInfo.pWaitSemaphoreInfos    = waitSemaphores.Data();
+    }
     
     // Unwrapped command buffers
     auto* vkCommandSubmitInfos = ALLOCA_ARRAY(VkCommandBufferSubmitInfo, commandBufferCount);
@@ -539,8 +765,8 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit2(VkQueue queue, uint32_t submi
         vkCommandBuffersIt += submit.commandBufferInfoCount;
     }
     
-    // Record the streaming patching
-    VkCommandBuffer postPatchCommandBuffer = RecordExecutePostCommandBuffer(table, queueState, segment);
+    // Does this submission complete the segment?
+    const bool closeSegment = ShouldCloseSegment(queueState, segment, submitContext, userFence);
 
     // All signal semaphores
     TrivialStackVector<VkSemaphoreSubmitInfo, 4u> signalSemaphores;
@@ -554,26 +780,60 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit2(VkQueue queue, uint32_t submi
         signalSemaphores.Add(info);
     }
 
-    // Fill the post-patch streaming submit info
+    // Post-patch streaming submit info
     VkCommandBufferSubmitInfo postPatchCommandSubmit{VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
-    postPatchCommandSubmit.commandBuffer = postPatchCommandBuffer;
 
-    // Fill patch submission info
-    VkSubmitInfo2& postPatchInfo = vkSubmits.Add({VK_STRUCTURE_TYPE_SUBMIT_INFO_2});
-    postPatchInfo.commandBufferInfoCount   = 1;
-    postPatchInfo.pCommandBufferInfos      = &postPatchCommandSubmit;
-    postPatchInfo.signalSemaphoreInfoCount = static_cast<uint32_t>(signalSemaphores.Size());
-    postPatchInfo.pSignalSemaphoreInfos    = signalSemaphores.Data();
+    // Completion fence, if closing without a timeline
+    FenceState* fenceState = nullptr;
+
+    // Completion timeline signal, if closing with a timeline
+    size_t timelineSignalIndex = SIZE_MAX;
+
+    // Completing submissions record the post patching and signal completion, otherwise the segment remains open
+    if (closeSegment) {
+        postPatchCommandSubmit.commandBuffer = RecordExecutePostCommandBuffer(table, queueState, segment);
+
+        // Prefer the queue timeline, fall back to fences
+        if (queueState->timeline.IsSupported()) {
+            VkSemaphoreSubmitInfo info{VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+            info.semaphore = queueState->timeline.GetSemaphore();
+            info.stageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            timelineSignalIndex = signalSemaphores.Size();
+            signalSemaphores.Add(info);
+        } else {
+            fenceState = AcquireOrCreateFence(table, queueState, userFence);
+        }
+
+        // Fill patch submission info
+        VkSubmitInfo2& postPatchInfo = vkSubmits.Add({VK_STRUCTURE_TYPE_SUBMIT_INFO_2});
+        postPatchInfo.commandBufferInfoCount   = 1;
+        postPatchInfo.pCommandBufferInfos      = &postPatchCommandSubmit;
+        postPatchInfo.signalSemaphoreInfoCount = static_cast<uint32_t>(signalSemaphores.Size());
+        postPatchInfo.pSignalSemaphoreInfos    = signalSemaphores.Data();
+
+        // No longer open
+        queueState->exportState->openSegment = nullptr;
+    } else {
+        queueState->exportState->openSegment = segment;
+    }
+
+    // Timeline completion value, assigned on submission
+    uint64_t timelineValue = 0;
 
     // Serialize queue access
     {
         std::lock_guard guard(queueState->mutex);
 
+        // Timeline values must be signalled in submission order
+        if (timelineSignalIndex != SIZE_MAX) {
+            timelineValue = signalSemaphores[timelineSignalIndex].value = queueState->timeline.Next();
+        }
+
         // Select next
         PFN_vkQueueSubmit2 next = table->next_vkQueueSubmit2 ? table->next_vkQueueSubmit2 : table->next_vkQueueSubmit2KHR;
 
         // Pass down callchain
-        VkResult result = next(queue, static_cast<uint32_t>(vkSubmits.Size()), vkSubmits.Data(), fenceState->object);
+        VkResult result = next(queue, static_cast<uint32_t>(vkSubmits.Size()), vkSubmits.Data(), fenceState ? fenceState->object : userFence);
         if (result != VK_SUCCESS) {
             return result;
         }
@@ -590,7 +850,9 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit2(VkQueue queue, uint32_t submi
     }
 
     // Notify streamer of submission, enqueue increments reference count
-    table->exportStreamer->Enqueue(queueState->exportState, segment, fenceState);
+    if (closeSegment) {
+        table->exportStreamer->Enqueue(queueState->exportState, segment, fenceState, timelineValue);
+    }
 
     // OK
     return VK_SUCCESS;
@@ -602,6 +864,9 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueWaitIdle(VkQueue queue) {
     // Get the state
     QueueState* queueState = table->states_queue.Get(queue);
 
+    // Deferred submissions must be visible after the wait
+    CloseOpenSegment(table, queueState);
+
     // Pass down callchain
     VkResult result = table->next_vkQueueWaitIdle(queue);
     if (result != VK_SUCCESS) {
@@ -618,6 +883,9 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueWaitIdle(VkQueue queue) {
 VKAPI_ATTR VkResult VKAPI_CALL Hook_vkDeviceWaitIdle(VkDevice device) {
     DeviceDispatchTable* table = DeviceDispatchTable::Get(GetInternalTable(device));
 
+    // Deferred submissions must be visible after the wait
+    CloseOpenSegments(table);
+
     // Pass down callchain
     VkResult result = table->next_vkDeviceWaitIdle(device);
     if (result != VK_SUCCESS) {
@@ -631,6 +899,26 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkDeviceWaitIdle(VkDevice device) {
     return VK_SUCCESS;
 }
 
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkWaitSemaphores(VkDevice device, const VkSemaphoreWaitInfo* pWaitInfo, uint64_t timeout) {
+    DeviceDispatchTable* table = DeviceDispatchTable::Get(GetInternalTable(device));
+
+    // Applications synchronizing through semaphores may never wait on the queue
+    CloseExpiredSegments(table);
+
+    // Pass down callchain
+    return table->next_vkWaitSemaphores(device, pWaitInfo, timeout);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL Hook_vkWaitSemaphoresKHR(VkDevice device, const VkSemaphoreWaitInfo* pWaitInfo, uint64_t timeout) {
+    DeviceDispatchTable* table = DeviceDispatchTable::Get(GetInternalTable(device));
+
+    // Applications synchronizing through semaphores may never wait on the queue
+    CloseExpiredSegments(table);
+
+    // Pass down callchain
+    return table->next_vkWaitSemaphoresKHR(device, pWaitInfo, timeout);
+}
+
 VKAPI_ATTR void VKAPI_CALL Hook_vkGetDeviceQueue(VkDevice device, uint32_t queueFamilyIndex, uint32_t queueIndex, VkQueue* pQueue) {
     DeviceDispatchTable* table = DeviceDispatchTable::Get(GetInternalTable(device));
 
@@ -663,6 +951,9 @@ VKAPI_ATTR void VKAPI_CALL Hook_vkGetDeviceQueue2(VkDevice device, const VkDevic
 VkResult Hook_vkQueuePresentKHR(VkQueue queue, const VkPresentInfoKHR *pPresentInfo) {
     DeviceDispatchTable* table = DeviceDispatchTable::Get(GetInternalTable(queue));
 
+    // Frame boundary, complete any deferred submissions
+    CloseOpenSegment(table, table->states_queue.Get(queue));
+
     // Pass down callchain
     VkResult result = table->next_vkQueuePresentKHR(queue, pPresentInfo);
     if (result != VK_SUCCESS) {
@@ -0,0 +1,191 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <Backends/Vulkan/Resource/DescriptorUpdateTemplatePlan.h>
+#include <Backends/Vulkan/Resource/DescriptorResourceMapping.h>
+#include <Backends/Vulkan/Resource/PhysicalResourceMappingTable.h>
+#include <Backends/Vulkan/States/DescriptorLayoutPhysicalMapping.h>
+#include <Backends/Vulkan/Tables/DeviceDispatchTable.h>
+
+// Common
+#include <Common/Containers/TrivialStackVector.h>
+
+// Std
+#include <algorithm>
+
+/// Decode a run of image and sampler descriptors
+static void DecodeImageRun(DeviceDispatchTable* table, VkDescriptorType type, const uint8_t* data, size_t stride, uint32_t count, VirtualResourceMapping* mappings) {
+    std::unique_lock lock = LockVirtualResourceStates(table, type);
+
+    for (uint32_t i = 0; i < count; i++) {
+        mappings[i] = GetVirtualResourceMappingNoLock(table, type, *reinterpret_cast<const VkDescriptorImageInfo*>(data + i * stride));
+    }
+}
+
+/// Decode a run of texel buffer descriptors
+static void DecodeTexelBufferRun(DeviceDispatchTable* table, VkDescriptorType type, const uint8_t* data, size_t stride, uint32_t count, VirtualResourceMapping* mappings) {
+    std::unique_lock lock = LockVirtualResourceStates(table, type);
+
+    for (uint32_t i = 0; i < count; i++) {
+        mappings[i] = GetVirtualResourceMappingNoLock(table, type, *reinterpret_cast<const VkBufferView*>(data + i * stride));
+    }
+}
+
+/// Decode a run of buffer descriptors
+static void DecodeBufferRun(DeviceDispatchTable* table, VkDescriptorType type, const uint8_t* data, size_t stride, uint32_t count, VirtualResourceMapping* mappings) {
+    std::unique_lock lock = LockVirtualResourceStates(table, type);
+
+    for (uint32_t i = 0; i < count; i++) {
+        mappings[i] = GetVirtualResourceMappingNoLock(table, type, *reinterpret_cast<const VkDescriptorBufferInfo*>(data + i * stride));
+    }
+}
+
+/// Decode a run of descriptors not tracked by the table
+static void DecodeUntrackedRun(DeviceDispatchTable* table, VkDescriptorType type, const uint8_t* data, size_t stride, uint32_t count, VirtualResourceMapping* mappings) {
+    for (uint32_t i = 0; i < count; i++) {
+        mappings[i] = GetVirtualResourceMappingNoLock(table, type, static_cast<const void*>(data + i * stride));
+    }
+}
+
+/// Get the decoder for a descriptor type
+static DescriptorUpdateTemplateDecodeFn GetDecoder(VkDescriptorType type) {
+    switch (type) {
+        default:
+            return DecodeUntrackedRun;
+        case VK_DESCRIPTOR_TYPE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            return DecodeImageRun;
+        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+            return DecodeTexelBufferRun;
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+            return DecodeBufferRun;
+    }
+}
+
+void DescriptorUpdateTemplatePlan::Compile(const VkDescriptorUpdateTemplateCreateInfo &createInfo, const DescriptorLayoutPhysicalMapping &physicalMapping) {
+    runs.clear();
+    writes.clear();
+    mappingCount = 0;
+
+    // Create a run per entry
+    for (uint32_t i = 0; i < createInfo.descriptorUpdateEntryCount; i++) {
+        const VkDescriptorUpdateTemplateEntry& entry = createInfo.pDescriptorUpdateEntries[i];
+
+        // Empty entries are allowed
+        if (!entry.descriptorCount) {
+            continue;
+        }
+
+        // Resolve the decoder and destination slot once
+        DescriptorUpdateTemplateRun& run = runs.emplace_back();
+        run.decode = GetDecoder(entry.descriptorType);
+        run.type = entry.descriptorType;
+        run.sourceOffset = entry.offset;
+        run.sourceStride = entry.stride;
+        run.prmtOffset = physicalMapping.bindings.at(entry.dstBinding).prmtOffset + entry.dstArrayElement;
+        run.count = entry.descriptorCount;
+    }
+
+    // Order by destination slot, entries may be specified in any order
+    std::stable_sort(runs.begin(), runs.end(), [](const DescriptorUpdateTemplateRun& lhs, const DescriptorUpdateTemplateRun& rhs) {
+        return lhs.prmtOffset < rhs.prmtOffset;
+    });
+
+    // Merge runs contiguous in both the update data and the set segment
+    size_t mergedCount = 0;
+    for (const DescriptorUpdateTemplateRun& run : runs) {
+        if (mergedCount) {
+            DescriptorUpdateTemplateRun& last = runs[mergedCount - 1];
+
+            // Same decoding and adjacent?
+            if (last.type == run.type &&
+                last.sourceStride == run.sourceStride &&
+                last.sourceOffset + last.count * last.sourceStride == run.sourceOffset &&
+                last.prmtOffset + last.count == run.prmtOffset) {
+                last.count += run.count;
+                continue;
+            }
+        }
+
+        runs[mergedCount++] = run;
+    }
+
+    // Trim merged runs
+    runs.resize(mergedCount);
+
+    // Create the table writes, runs adjacent in the segment share a write regardless of type
+    for (const DescriptorUpdateTemplateRun& run : runs) {
+        if (!writes.empty() && writes.back().prmtOffset + writes.back().count == run.prmtOffset) {
+            writes.back().count += run.count;
+        } else {
+            writes.push_back(DescriptorUpdateTemplateWrite {
+                .prmtOffset = run.prmtOffset,
+                .mappingOffset = mappingCount,
+                .count = run.count
+            });
+        }
+
+        // Runs are decoded linearly
+        mappingCount += run.count;
+    }
+}
+
+void DescriptorUpdateTemplatePlan::Execute(DeviceDispatchTable *table, PhysicalResourceSegmentID id, const void *pData) const {
+    // Nothing to write?
+    if (!mappingCount) {
+        return;
+    }
+
+    // Decode all runs
+    TrivialStackVector<VirtualResourceMapping, 64u> mappings(table->allocators);
+    mappings.Resize(mappingCount);
+
+    // Runs are decoded linearly
+    VirtualResourceMapping* cursor = mappings.Data();
+    for (const DescriptorUpdateTemplateRun& run : runs) {
+        run.decode(table, run.type, static_cast<const uint8_t*>(pData) + run.sourceOffset, run.sourceStride, run.count, cursor);
+        cursor += run.count;
+    }
+
+    // Translate to table writes
+    TrivialStackVector<PhysicalResourceMappingTableWrite, 16u> prmtWrites(table->allocators);
+    for (const DescriptorUpdateTemplateWrite& write : writes) {
+        PhysicalResourceMappingTableWrite& prmtWrite = prmtWrites.Add();
+        prmtWrite.id = id;
+        prmtWrite.offset = write.prmtOffset;
+        prmtWrite.count = write.count;
+        prmtWrite.mappings = mappings.Data() + write.mappingOffset;
+    }
+
+    // Commit all writes as a single update
+    table->prmTable->WriteMappings(prmtWrites.Data(), static_cast<uint32_t>(prmtWrites.Size()));
+}
@@ -197,6 +197,18 @@ PhysicalResourceMappingTablePersistentVersion* PhysicalResourceMappingTable::Get
     return persistentVersion;
 }
 
+bool PhysicalResourceMappingTable::IsUpToDate(const PhysicalResourceMappingTablePersistentVersion *version, const PhysicalResourceMappingTableQueueState *queueState) {
+    std::lock_guard guard(mutex);
+
+    // Re-allocated since?
+    if (version != persistentVersion) {
+        return false;
+    }
+
+    // Same condition as skipped updates
+    return commitHead == queueState->commitHead || !liveSegmentCount;
+}
+
 void PhysicalResourceMappingTable::WriteMapping(PhysicalResourceSegmentID id, uint32_t offset, const VirtualResourceMapping &mapping) {
     std::lock_guard guard(mutex);
 
@@ -211,6 +223,41 @@ void PhysicalResourceMappingTable::WriteMapping(PhysicalResourceSegmentID id, ui
     commitHead++;
 }
 
+void PhysicalResourceMappingTable::WriteMappings(PhysicalResourceSegmentID id, uint32_t offset, const VirtualResourceMapping *mappings, uint32_t count) {
+    std::lock_guard guard(mutex);
+
+    // Write range
+    WriteMappingsNoLock(id, offset, mappings, count);
+
+    // Advance head
+    commitHead++;
+}
+
+void PhysicalResourceMappingTable::WriteMappings(const PhysicalResourceMappingTableWrite *writes, uint32_t count) {
+    std::lock_guard guard(mutex);
+
+    // Write all ranges
+    for (uint32_t i = 0; i < count; i++) {
+        WriteMappingsNoLock(writes[i].id, writes[i].offset, writes[i].mappings, writes[i].count);
+    }
+
+    // Advance head, once for the whole batch
+    commitHead++;
+}
+
+void PhysicalResourceMappingTable::WriteMappingsNoLock(PhysicalResourceSegmentID id, uint32_t offset, const VirtualResourceMapping *mappings, uint32_t count) {
+    // Get the underlying segment
+    PhysicalResourceMappingTableSegment& segment = segments.at(indices.at(id));
+
+    // Write range
+    ASSERT(offset + count <= segment.length, "Physical segment range out of bounds");
+    std::memcpy(
+        persistentVersion->virtualMappings + segment.offset + offset,
+        mappings,
+        sizeof(VirtualResourceMapping) * count
+    );
+}
+
 size_t PhysicalResourceMappingTable::GetMappingOffset(PhysicalResourceSegmentID id, uint32_t offset) {
     std::lock_guard guard(mutex);
     
@@ -243,6 +290,28 @@ void PhysicalResourceMappingTable::CopyMappings(PhysicalResourceSegmentID source
     commitHead++;
 }
 
+void PhysicalResourceMappingTable::CopyMappings(PhysicalResourceSegmentID source, uint32_t sourceOffset, PhysicalResourceSegmentID dest, uint32_t destOffset, uint32_t count) {
+    std::lock_guard guard(mutex);
+    
+    // Get the underlying segment
+    const PhysicalResourceMappingTableSegment& sourceSegment = segments.at(indices.at(source));
+    const PhysicalResourceMappingTableSegment& destSegment   = segments.at(indices.at(dest));
+
+    // Validation
+    ASSERT(sourceOffset + count <= sourceSegment.length, "Physical segment range out of bounds");
+    ASSERT(destOffset + count <= destSegment.length, "Physical segment range out of bounds");
+
+    // Copy range, source and destination may be the same segment
+    std::memmove(
+        persistentVersion->virtualMappings + destSegment.offset + destOffset,
+        persistentVersion->virtualMappings + sourceSegment.offset + sourceOffset,
+        sizeof(VirtualResourceMapping) * count
+    );
+    
+    // Advance head
+    commitHead++;
+}
+
 PhysicalResourceMappingTableSegment PhysicalResourceMappingTable::GetSegmentShader(PhysicalResourceSegmentID id) {
     std::lock_guard guard(mutex);
     return segments.at(indices.at(id));
@@ -0,0 +1,99 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <Backends/Vulkan/Scheduler/QueueTimeline.h>
+#include <Backends/Vulkan/Tables/DeviceDispatchTable.h>
+
+QueueTimeline::~QueueTimeline() {
+    if (semaphore) {
+        table->next_vkDestroySemaphore(table->object, semaphore, nullptr);
+    }
+}
+
+bool QueueTimeline::Install(DeviceDispatchTable* table) {
+    this->table = table;
+
+    // Counter queries are required
+    if (!table->next_vkGetSemaphoreCounterValue || !table->next_vkWaitSemaphores) {
+        return false;
+    }
+
+    // Timeline info, default to 0
+    VkSemaphoreTypeCreateInfo timelineInfo{VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO};
+    timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    timelineInfo.initialValue = 0u;
+
+    // Semaphore info
+    VkSemaphoreCreateInfo info{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+    info.pNext = &timelineInfo;
+
+    // Attempt to create the semaphore
+    if (table->next_vkCreateSemaphore(table->object, &info, nullptr, &semaphore) != VK_SUCCESS) {
+        semaphore = VK_NULL_HANDLE;
+        return false;
+    }
+
+    // OK
+    return true;
+}
+
+uint64_t QueueTimeline::Poll() {
+    uint64_t value = 0;
+
+    // Query the device counter
+    if (table->next_vkGetSemaphoreCounterValue(table->object, semaphore, &value) != VK_SUCCESS) {
+        return completedValue.load();
+    }
+
+    // Keep the latest known value, polls may race
+    uint64_t known = completedValue.load();
+    while (known < value && !completedValue.compare_exchange_weak(known, value));
+
+    // OK
+    return value;
+}
+
+void QueueTimeline::Wait(uint64_t value) {
+    // Already known?
+    if (completedValue.load() >= value) {
+        return;
+    }
+
+    // Wait info
+    VkSemaphoreWaitInfo info{VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+    info.semaphoreCount = 1u;
+    info.pSemaphores = &semaphore;
+    info.pValues = &value;
+
+    // Wait for the value
+    if (table->next_vkWaitSemaphores(table->object, &info, UINT64_MAX) != VK_SUCCESS) {
+        return;
+    }
+
+    // Update the known value
+    Poll();
+}
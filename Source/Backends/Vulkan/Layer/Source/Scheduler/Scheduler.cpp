@@ -86,12 +86,22 @@ void Scheduler::SyncPoint() {
 
     // Synchronize all queues
     for (QueueBucket &bucket: queues) {
+        if (bucket.pendingSubmissions.empty()) {
+            continue;
+        }
+
+        // Read the timeline once, retires all submissions signalled before it
+        uint64_t completedTimelineValue = 0;
+        if (QueueTimeline& timeline = table->states_queue.Get(bucket.queue)->timeline; timeline.IsSupported()) {
+            completedTimelineValue = timeline.Poll();
+        }
+
         auto it = bucket.pendingSubmissions.begin();
 
         // Segments are enqueued in order of completion
         for (; it != bucket.pendingSubmissions.end(); it++) {
             // If failed to process, none of the succeeding are ready
-            if (table->next_vkGetFenceStatus(table->object, it->fence) == VK_SUCCESS) {
+            if (!IsCompleted(*it, completedTimelineValue)) {
                 break;
             }
 
@@ -104,6 +114,16 @@ void Scheduler::SyncPoint() {
     }
 }
 
+bool Scheduler::IsCompleted(const Submission& submission, uint64_t completedTimelineValue) {
+    // Timeline tracked?
+    if (submission.timelineValue) {
+        return completedTimelineValue >= submission.timelineValue;
+    }
+
+    // Fallback, query the fence
+    return table->next_vkGetFenceStatus(table->object, submission.fence) == VK_SUCCESS;
+}
+
 VkSemaphore Scheduler::GetPrimitiveSemaphore(SchedulerPrimitiveID pid) {
     return primitives[pid].semaphore;
 }
@@ -113,6 +133,17 @@ void Scheduler::WaitForPending() {
 
     // Wait for all buckets
     for (QueueBucket &bucket: queues) {
+        if (bucket.pendingSubmissions.empty()) {
+            continue;
+        }
+
+        // Timeline tracked, a single wait on the last submission covers all before it
+        if (QueueTimeline& timeline = table->states_queue.Get(bucket.queue)->timeline; timeline.IsSupported()) {
+            timeline.Wait(bucket.pendingSubmissions.back().timelineValue);
+            continue;
+        }
+
+        // Fallback, wait on each fence
         for (Submission &submission: bucket.pendingSubmissions) {
             // Already done?
             if (table->next_vkGetFenceStatus(table->object, submission.fence) == VK_SUCCESS) {
@@ -134,8 +165,13 @@ void Scheduler::Schedule(Queue queue, const CommandBuffer &buffer, const Schedul
     // Get or create a submission
     Submission submission = PopSubmission(queue);
 
-    // Reset the submission fence
-    table->next_vkResetFences(table->object, 1u, &submission.fence);
+    // Get the queue state
+    QueueState* queueState = table->states_queue.Get(bucket.queue);
+
+    // Reset the submission fence if not timeline tracked
+    if (!queueState->timeline.IsSupported()) {
+        table->next_vkResetFences(table->object, 1u, &submission.fence);
+    }
 
     // Command generation
     {
@@ -168,6 +204,14 @@ void Scheduler::Schedule(Queue queue, const CommandBuffer &buffer, const Schedul
         signalSemaphores.Add(info);
     }
 
+    // Signal the queue timeline on completion
+    if (queueState->timeline.IsSupported()) {
+        VkSemaphoreSubmitInfo info{VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO};
+        info.semaphore = queueState->timeline.GetSemaphore();
+        info.stageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        signalSemaphores.Add(info);
+    }
+
     // Command buffer info
     VkCommandBufferSubmitInfo commandSubmitInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO};
     commandSubmitInfo.commandBuffer = submission.commandBuffer;
@@ -184,8 +228,14 @@ void Scheduler::Schedule(Queue queue, const CommandBuffer &buffer, const Schedul
 
     // Submit
     {
-        std::lock_guard queueGuard(table->states_queue.Get(bucket.queue)->mutex);
-        next(bucket.queue, 1u, &submitInfo, submission.fence);
+        std::lock_guard queueGuard(queueState->mutex);
+
+        // Timeline values must be signalled in submission order
+        if (queueState->timeline.IsSupported()) {
+            submission.timelineValue = signalSemaphores[signalSemaphores.Size() - 1].value = queueState->timeline.Next();
+        }
+
+        next(bucket.queue, 1u, &submitInfo, submission.timelineValue ? VK_NULL_HANDLE : submission.fence);
     }
 
     // Mark as pending
@@ -225,12 +275,15 @@ Scheduler::Submission Scheduler::PopSubmission(Queue queue) {
     // Patch the dispatch table
     PatchInternalTable(submission.commandBuffer, table->object);
 
-    // Fence info
-    VkFenceCreateInfo fenceCreateInfo{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+    // Fences are only needed if the queue has no timeline
+    if (!table->states_queue.Get(bucket.queue)->timeline.IsSupported()) {
+        // Fence info
+        VkFenceCreateInfo fenceCreateInfo{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
 
-    // Attempt to create fence
-    if (table->next_vkCreateFence(table->object, &fenceCreateInfo, nullptr, &submission.fence) != VK_SUCCESS) {
-        return {};
+        // Attempt to create fence
+        if (table->next_vkCreateFence(table->object, &fenceCreateInfo, nullptr, &submission.fence) != VK_SUCCESS) {
+            return {};
+        }
     }
 
     // Create streaming state
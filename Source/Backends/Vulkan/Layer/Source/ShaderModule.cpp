@@ -28,6 +28,10 @@
 #include <Backends/Vulkan/ShaderModule.h>
 #include <Backends/Vulkan/Tables/DeviceDispatchTable.h>
 #include <Backends/Vulkan/Compiler/SpvModule.h>
+#include <Backends/Vulkan/Compiler/ShaderCompiler.h>
+
+// ZLIB
+#include <zlib.h>
 
 VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreateShaderModule(VkDevice device, const VkShaderModuleCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkShaderModule* pShaderModule) {
     DeviceDispatchTable* table = DeviceDispatchTable::Get(GetInternalTable(device));
@@ -47,7 +51,7 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkCreateShaderModule(VkDevice device, const
     state->AddUser();
 
     // Create a deep copy
-    state->createInfoDeepCopy.DeepCopy(table->allocators, *pCreateInfo);
+    state->CopyCreateInfo(table->allocators, *pCreateInfo);
 
     // OK
     return VK_SUCCESS;
@@ -85,6 +89,11 @@ ShaderModuleState::~ShaderModuleState() {
         table->next_vkDestroyShaderModule(table->object, kv.second, nullptr);
     }
 
+    // Stop retention tracking before the module is released
+    if (ComRef<ShaderCompiler> shaderCompiler = table->registry.Get<ShaderCompiler>()) {
+        shaderCompiler->UntrackModule(this);
+    }
+
     // Release spirv module
     if (spirvModule) {
         destroy(spirvModule, table->allocators);
@@ -104,3 +113,27 @@ void ShaderModuleState::ReleaseHost() {
     // Reference host has locked these
     table->states_shaderModule.RemoveStateNoLock(this);
  }
+
+void ShaderModuleState::CopyCreateInfo(const Allocators &allocators, const VkShaderModuleCreateInfo &createInfo) {
+    // Deep copy everything but the code
+    VkShaderModuleCreateInfo strippedInfo = createInfo;
+    strippedInfo.pCode = nullptr;
+    strippedInfo.codeSize = 0;
+    createInfoDeepCopy.DeepCopy(allocators, strippedInfo);
+
+    // Favor speed, this is on the creation path
+    uLongf compressedSize = compressBound(static_cast<uLong>(createInfo.codeSize));
+    compressedCode.resize(compressedSize);
+
+    // Compress the originating code
+    if (compress2(compressedCode.data(), &compressedSize, reinterpret_cast<const Bytef*>(createInfo.pCode), static_cast<uLong>(createInfo.codeSize), Z_BEST_SPEED) != Z_OK) {
+        ASSERT(false, "Failed compression, zlib faulted");
+        compressedCode.clear();
+        return;
+    }
+
+    // Trim to the compressed size
+    compressedCode.resize(compressedSize);
+    compressedCode.shrink_to_fit();
+    codeSize = createInfo.codeSize;
+}
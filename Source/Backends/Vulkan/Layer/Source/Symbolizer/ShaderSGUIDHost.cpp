@@ -28,6 +28,7 @@
 #include <Backends/Vulkan/Tables/DeviceDispatchTable.h>
 #include <Backends/Vulkan/States/ShaderModuleState.h>
 #include <Backends/Vulkan/Compiler/SpvModule.h>
+#include <Backends/Vulkan/Compiler/ShaderCompiler.h>
 #include <Backends/Vulkan/Compiler/SpvSourceMap.h>
 #include <Backends/Vulkan/Compiler/SpvCodeOffsetTraceback.h>
 
@@ -57,6 +58,9 @@ void ShaderSGUIDHost::Commit(IBridge *bridge) {
     MessageStream stream;
     MessageStreamView<ShaderSourceMappingMessage> view(stream);
 
+    // Modules may have been evicted since binding
+    ComRef<ShaderCompiler> shaderCompiler = table->registry.Get<ShaderCompiler>();
+
     // Serial
     std::lock_guard guard(mutex);
     
@@ -64,6 +68,9 @@ void ShaderSGUIDHost::Commit(IBridge *bridge) {
     for (ShaderSGUID sguid : pendingSubmissions) {
         ShaderSourceMapping mapping = sguidLookup.at(sguid);
 
+        // Pin the module until the contents are copied, rehydrated if evicted
+        ShaderModuleScope moduleScope(shaderCompiler.GetUnsafe(), table->states_shaderModule.GetFromUID(mapping.shaderGUID));
+
         // Get source
         std::string_view sourceContents = GetSource(mapping);
 
@@ -101,6 +108,9 @@ ShaderSGUID ShaderSGUIDHost::Bind(const IL::Program &program, const IL::BasicBlo
     // Get the shader
     ShaderModuleState* shader = table->states_shaderModule.GetFromUID(program.GetShaderGUID());
 
+    // Pin the module for the traceback and source lookups
+    ShaderModuleScope moduleScope(table->registry.Get<ShaderCompiler>().GetUnsafe(), shader);
+
     // Validate shader
     if (!shader || !shader->spirvModule) {
         return InvalidShaderSGUID;
@@ -201,8 +211,11 @@ std::string_view ShaderSGUIDHost::GetSource(const ShaderSourceMapping &mapping)
         return {};
     }
 
-    // Get source map
+    // Get source map, may not be resident
     const SpvSourceMap* map = GetSourceMap(mapping.shaderGUID);
+    if (!map) {
+        return {};
+    }
 
     // Get line
     std::string_view view = map->GetLine(mapping.fileUID, mapping.line);
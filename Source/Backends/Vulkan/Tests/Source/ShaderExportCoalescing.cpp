@@ -0,0 +1,47 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <catch2/catch.hpp>
+
+// Layer
+#include <Backends/Vulkan/Export/ShaderExportCoalescing.h>
+
+TEST_CASE("Export.Coalescing.Count", "[Vulkan]") {
+    REQUIRE(!IsCoalescedSegmentExpired(1, std::chrono::milliseconds(0)));
+    REQUIRE(!IsCoalescedSegmentExpired(kShaderExportMaxCoalescedSubmissions - 1, std::chrono::milliseconds(0)));
+
+    // Bounded number of submissions
+    REQUIRE(IsCoalescedSegmentExpired(kShaderExportMaxCoalescedSubmissions, std::chrono::milliseconds(0)));
+}
+
+TEST_CASE("Export.Coalescing.Age", "[Vulkan]") {
+    REQUIRE(!IsCoalescedSegmentExpired(1, kShaderExportMaxCoalescedAge - std::chrono::milliseconds(1)));
+
+    // Bounded age, regardless of the number of submissions
+    REQUIRE(IsCoalescedSegmentExpired(1, kShaderExportMaxCoalescedAge));
+    REQUIRE(IsCoalescedSegmentExpired(1, std::chrono::seconds(1)));
+}
@@ -0,0 +1,88 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <catch2/catch.hpp>
+
+// Layer
+#include <Backends/Vulkan/Export/ShaderExportRingWindow.h>
+
+TEST_CASE("Export.RingWindow.Contiguous", "[Vulkan]") {
+    ShaderExportRingWindow window = GetShaderExportRingWindow(4, 12, 12, 16);
+    REQUIRE(!window.overtaken);
+    REQUIRE(window.offset == 4);
+    REQUIRE(window.count == 8);
+    REQUIRE(window.upperCount == 8);
+
+    // Nothing produced
+    window = GetShaderExportRingWindow(12, 12, 12, 16);
+    REQUIRE(!window.overtaken);
+    REQUIRE(window.count == 0);
+}
+
+TEST_CASE("Export.RingWindow.Wrap", "[Vulkan]") {
+    ShaderExportRingWindow window = GetShaderExportRingWindow(12, 20, 20, 16);
+    REQUIRE(!window.overtaken);
+    REQUIRE(window.offset == 12);
+    REQUIRE(window.count == 8);
+    REQUIRE(window.upperCount == 4);
+
+    // Heads wrap naturally
+    window = GetShaderExportRingWindow(0xFFFFFFFC, 4, 4, 16);
+    REQUIRE(!window.overtaken);
+    REQUIRE(window.offset == 12);
+    REQUIRE(window.count == 8);
+    REQUIRE(window.upperCount == 4);
+}
+
+TEST_CASE("Export.RingWindow.Overtaken", "[Vulkan]") {
+    // The segment itself has lapped the ring
+    REQUIRE(GetShaderExportRingWindow(0, 17, 17, 16).overtaken);
+    REQUIRE(GetShaderExportRingWindow(0, 17, 17, 16).overwrittenCount == 1);
+
+    // Exactly one lap is still consistent
+    REQUIRE(!GetShaderExportRingWindow(0, 16, 16, 16).overtaken);
+
+    // A succeeding submission has written over the window
+    REQUIRE(!GetShaderExportRingWindow(4, 8, 20, 16).overtaken);
+    REQUIRE(GetShaderExportRingWindow(4, 8, 21, 16).overtaken);
+    REQUIRE(GetShaderExportRingWindow(4, 8, 21, 16).overwrittenCount == 1);
+
+    // Written over entirely
+    REQUIRE(GetShaderExportRingWindow(4, 8, 40, 16).overwrittenCount == 4);
+
+    // Across the wrap
+    REQUIRE(GetShaderExportRingWindow(0xFFFFFFFC, 4, 13, 16).overtaken);
+    REQUIRE(GetShaderExportRingWindow(0xFFFFFFFC, 4, 13, 16).overwrittenCount == 1);
+}
+
+TEST_CASE("Export.RingWindow.StaleHead", "[Vulkan]") {
+    // Latest heads preceding the segment are ignored
+    ShaderExportRingWindow window = GetShaderExportRingWindow(4, 8, 0, 16);
+    REQUIRE(!window.overtaken);
+    REQUIRE(window.overwrittenCount == 0);
+    REQUIRE(window.count == 4);
+}
@@ -0,0 +1,134 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+// Catch2
+#include <catch2/catch.hpp>
+
+// Layer
+#include <Backends/Vulkan/Compiler/SpvModule.h>
+
+// Backend
+#include <Backend/IL/Program.h>
+
+// Std
+#include <algorithm>
+#include <vector>
+
+/// Identifiers of the test module
+enum : uint32_t {
+    kVoid = 1,
+    kFunctionType,
+    kMain,
+    kMainLabel,
+    kUnused,
+    kUnusedLabel,
+    kBound
+};
+
+/// Encode an instruction header
+static constexpr uint32_t Op(uint32_t wordCount, uint32_t op) {
+    return (wordCount << 16u) | op;
+}
+
+/// Words of the function unreachable from any entry point
+static const uint32_t kUnusedFunction[] = {
+    Op(5, 54), kVoid, kUnused, 0, kFunctionType, // OpFunction
+    Op(2, 248), kUnusedLabel,                    // OpLabel
+    Op(1, 253),                                  // OpReturn
+    Op(1, 56)                                    // OpFunctionEnd
+};
+
+/// Assemble a compute module with an entry point and an uncalled function
+static std::vector<uint32_t> AssembleModule() {
+    std::vector<uint32_t> words = {
+        // Header
+        0x07230203, 0x00010000, 0, kBound, 0,
+
+        // OpCapability Shader
+        Op(2, 17), 1,
+
+        // OpMemoryModel Logical GLSL450
+        Op(3, 14), 0, 1,
+
+        // OpEntryPoint GLCompute %main "main"
+        Op(5, 15), 5, kMain, 0x6E69616D, 0x0,
+
+        // OpExecutionMode %main LocalSize 1 1 1
+        Op(6, 16), kMain, 17, 1, 1, 1,
+
+        // Types
+        Op(2, 19), kVoid,
+        Op(3, 33), kFunctionType, kVoid,
+
+        // Entry point
+        Op(5, 54), kVoid, kMain, 0, kFunctionType,
+        Op(2, 248), kMainLabel,
+        Op(1, 253),
+        Op(1, 56)
+    };
+
+    // Uncalled function
+    words.insert(words.end(), std::begin(kUnusedFunction), std::end(kUnusedFunction));
+    return words;
+}
+
+TEST_CASE("Spv.PassThrough") {
+    Allocators allocators;
+
+    std::vector<uint32_t> words = AssembleModule();
+
+    // Parse the module
+    SpvModule module(allocators, 0u);
+    REQUIRE(module.ParseModule(words.data(), static_cast<uint32_t>(words.size())));
+
+    IL::Program* program = module.GetProgram();
+
+    // Entry point is lifted, and untouched since parsing
+    IL::Function* main = program->GetFunctionList().GetFunction(kMain);
+    REQUIRE(main);
+    REQUIRE(!main->HasFlag(FunctionFlag::NoInstrumentation));
+    REQUIRE(main->GetBasicBlocks().GetBlockCount() == 1);
+
+    for (IL::BasicBlock* bb : main->GetBasicBlocks()) {
+        REQUIRE(!bb->IsModified());
+    }
+
+    // Uncalled function is never lifted, only its source span is kept
+    IL::Function* unused = program->GetFunctionList().GetFunction(kUnused);
+    REQUIRE(unused);
+    REQUIRE(unused->HasFlag(FunctionFlag::NoInstrumentation));
+    REQUIRE(unused->GetBasicBlocks().GetBlockCount() == 0);
+    REQUIRE(unused->GetSourceSpan().end - unused->GetSourceSpan().begin == std::size(kUnusedFunction));
+
+    // Recompile without any instrumentation
+    SpvJob job;
+    REQUIRE(module.Recompile(words.data(), static_cast<uint32_t>(words.size()), job));
+
+    // Uncalled function must be copied word for word
+    const uint32_t* code = module.GetCode();
+    const uint32_t* codeEnd = code + module.GetSize() / sizeof(uint32_t);
+    REQUIRE(std::search(code, codeEnd, std::begin(kUnusedFunction), std::end(kUnusedFunction)) != codeEnd);
+}
@@ -58,7 +58,7 @@ public:
 
     /// IShaderFeature
     void CollectExports(const MessageStream &exports) override;
-    void Inject(IL::Program &program, const MessageStreamView<> &specialization) override;
+    void PlanGuards(IL::GuardPlan &plan, IL::Program &program, const MessageStreamView<> &specialization) override;
 
     /// Interface querying
     void *QueryInterface(ComponentID id) override {
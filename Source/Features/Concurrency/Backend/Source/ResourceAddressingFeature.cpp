@@ -30,9 +30,9 @@
 // Backend
 #include <Backend/IShaderExportHost.h>
 #include <Backend/IShaderSGUIDHost.h>
-#include <Backend/IL/Visitor.h>
 #include <Backend/IL/TypeCommon.h>
 #include <Backend/IL/Emitters/ResourceTokenEmitter.h>
+#include <Backend/IL/GuardPlan.h>
 #include <Backend/CommandContext.h>
 
 // Generated schema
@@ -95,80 +95,27 @@ void ResourceAddressingConcurrencyFeature::CollectMessages(IMessageStorage *stor
     storage->AddStreamAndSwap(stream);
 }
 
-void ResourceAddressingConcurrencyFeature::Inject(IL::Program &program, const MessageStreamView<> &specialization) {
-    // Options
-    const SetInstrumentationConfigMessage config = CollapseOrDefault<SetInstrumentationConfigMessage>(specialization);
-    
-    // Get the data ids
-    IL::ID lockBufferDataID = program.GetShaderDataMap().Get(lockBufferID)->id;
-    IL::ID eventDataID = program.GetShaderDataMap().Get(eventID)->id;
-
-    // Visit all instructions
-    IL::VisitUserInstructions(program, [&](IL::VisitContext& context, IL::BasicBlock::Iterator it) -> IL::BasicBlock::Iterator {
-        // Is write operation?
-        bool isWrite = false;
-
-        // Instruction of interest?
-        IL::ID resource;
-        switch (it->opCode) {
-            default:
-                return it;
-            case IL::OpCode::LoadBuffer: {
-                resource = it->As<IL::LoadBufferInstruction>()->buffer;
-                break;
-            }
-            case IL::OpCode::StoreBuffer: {
-                resource = it->As<IL::StoreBufferInstruction>()->buffer;
-                isWrite = true;
-                break;
-            }
-            case IL::OpCode::StoreTexture: {
-                resource = it->As<IL::StoreTextureInstruction>()->texture;
-                isWrite = true;
-                break;
-            }
-            case IL::OpCode::LoadTexture: {
-                resource = it->As<IL::LoadTextureInstruction>()->texture;
-
-                // Get type
-                auto type = program.GetTypeMap().GetType(resource)->As<Backend::IL::TextureType>();
-
-                // Sub-pass inputs are not validated
-                if (type->dimension == Backend::IL::TextureDimension::SubPass) {
-                    return it;
-                }
-                break;
-            }
-            case IL::OpCode::SampleTexture: {
-                resource = it->As<IL::SampleTextureInstruction>()->texture;
-                break;
-            }
-        }
+/// Resource addressing concurrency guard check
+class ResourceAddressingConcurrencyGuardCheck final : public IL::IGuardCheck {
+public:
+    ResourceAddressingConcurrencyGuardCheck(ShaderExportID exportID, ShaderSGUID sguid, IL::ID resource, IL::ID lockBufferDataID, IL::ID eventDataID, bool isWrite, bool detail) :
+        exportID(exportID), sguid(sguid), resource(resource), lockBufferDataID(lockBufferDataID), eventDataID(eventDataID), isWrite(isWrite), detail(detail) {
 
-        // Bind the SGUID
-        ShaderSGUID sguid = sguidHost ? sguidHost->Bind(program, it) : InvalidShaderSGUID;
-
-        // Allocate blocks
-        IL::BasicBlock* resumeBlock = context.function.GetBasicBlocks().AllocBlock();
-        IL::BasicBlock* oobBlock    = context.function.GetBasicBlocks().AllocBlock();
-
-        // Split this basic block, move all instructions post and including the instrumented instruction to resume
-        // ! iterator invalidated
-        auto instr = context.basicBlock.Split(resumeBlock, it);
+    }
 
-        // Perform instrumentation check
-        IL::Emitter<> pre(program, context.basicBlock);
+    IL::ID EmitCondition(IL::GuardContext& context) override {
+        IL::Emitter<>& pre = context.pre;
 
-        // Get global id of resource
-        IL::ResourceTokenEmitter token(pre, resource);
-        IL::ID puid = token.GetPUID();
-        IL::ID packedToken = token.GetPackedToken();
+        // Get global id of resource, shared with all other checks
+        IL::ResourceTokenEmitter<IL::Emitter<>>& token = context.GetToken(resource);
+        puid = token.GetPUID();
+        packedToken = token.GetPackedToken();
 
         // Load buffer
-        IL::ID bufferValue = pre.Load(lockBufferDataID);
+        bufferValue = pre.Load(lockBufferDataID);
 
         // Default unlocked value
-        IL::ID unlockedConstant = pre.UInt32(0);
+        unlockedConstant = pre.UInt32(0);
 
         // Get previous lock
         IL::ID previousLock;
@@ -179,58 +126,132 @@ void ResourceAddressingConcurrencyFeature::Inject(IL::Program &program, const Me
         } else {
             // Read the current lock at PUID
             // ! Multiple consumers
-            previousLock = pre.Extract(pre.LoadBuffer(bufferValue, puid), program.GetConstants().UInt(0)->id);
+            previousLock = pre.Extract(pre.LoadBuffer(bufferValue, puid), context.program.GetConstants().UInt(0)->id);
         }
 
         // If either unacquired or by the current event
-        IL::ID cond = pre.And(
+        return pre.And(
             pre.NotEqual(previousLock, pre.UInt32(0)),
             pre.NotEqual(previousLock, eventDataID)
         );
+    }
 
-        // If so, branch to failure, otherwise resume
-        pre.BranchConditional(cond, oobBlock, resumeBlock, IL::ControlFlow::Selection(resumeBlock));
-
-        // Out of bounds block
-        IL::Emitter<> oob(program, *oobBlock);
-        oob.AddBlockFlag(BasicBlockFlag::NoInstrumentation);
-
+    void EmitFailure(IL::GuardContext& context, IL::Emitter<>& oob) override {
         // Export the message
         ResourceRaceConditionMessage::ShaderExport msg;
         msg.sguid = oob.UInt32(sguid);
         msg.LUID = eventDataID;
 
         // Detailed instrumentation?
-        if (config.detail) {
+        if (detail) {
             msg.chunks |= ResourceRaceConditionMessage::Chunk::Detail;
             msg.detail.token = packedToken;
 
             // Texel addressing constants
-            IL::ID zero = program.GetConstants().UInt(0)->id;
+            IL::ID zero = context.program.GetConstants().UInt(0)->id;
             msg.detail.coordinate[0] = zero;
             msg.detail.coordinate[1] = zero;
             msg.detail.coordinate[2] = zero;
             msg.detail.mip = zero;
             msg.detail.byteOffset = zero;
         }
-        
+
         // Export the message
         oob.Export(exportID, msg);
+    }
 
-        // Branch back
-        oob.Branch(resumeBlock);
-
+    void EmitPost(IL::GuardContext& context, IL::Emitter<>& post) override {
         // Reads have no lock
         if (!isWrite) {
-            return instr;
+            return;
         }
 
         // Writes release lock after IOI
-        IL::Emitter<> resumeEmitter(program, *resumeBlock, ++resumeBlock->begin());
-        resumeEmitter.StoreBuffer(bufferValue, puid, unlockedConstant);
+        post.StoreBuffer(bufferValue, puid, unlockedConstant);
+    }
+
+private:
+    /// Export id of the feature
+    ShaderExportID exportID;
+
+    /// Bound sguid
+    ShaderSGUID sguid;
+
+    /// Resource to validate
+    IL::ID resource;
+
+    /// Data ids
+    IL::ID lockBufferDataID;
+    IL::ID eventDataID;
+
+    /// Is write operation?
+    bool isWrite;
+
+    /// Detailed instrumentation?
+    bool detail;
+
+    /// Shared data, emitted with the condition
+    IL::ID puid{IL::InvalidID};
+    IL::ID packedToken{IL::InvalidID};
+    IL::ID bufferValue{IL::InvalidID};
+    IL::ID unlockedConstant{IL::InvalidID};
+};
+
+void ResourceAddressingConcurrencyFeature::PlanGuards(IL::GuardPlan &plan, IL::Program &program, const MessageStreamView<> &specialization) {
+    // Options
+    const SetInstrumentationConfigMessage config = CollapseOrDefault<SetInstrumentationConfigMessage>(specialization);
+    
+    // Get the data ids
+    IL::ID lockBufferDataID = program.GetShaderDataMap().Get(lockBufferID)->id;
+    IL::ID eventDataID = program.GetShaderDataMap().Get(eventID)->id;
+
+    // Register the lock checks, fused with all other guards on the same instruction
+    plan.Add([this, lockBufferDataID, eventDataID, detail = config.detail](IL::Program& program, IL::Function& function, const IL::BasicBlock::Iterator& it, IL::GuardCheckList& checks) {
+        // Is write operation?
+        bool isWrite = false;
+
+        // Instruction of interest?
+        IL::ID resource;
+        switch (it->opCode) {
+            default:
+                return;
+            case IL::OpCode::LoadBuffer: {
+                resource = it->As<IL::LoadBufferInstruction>()->buffer;
+                break;
+            }
+            case IL::OpCode::StoreBuffer: {
+                resource = it->As<IL::StoreBufferInstruction>()->buffer;
+                isWrite = true;
+                break;
+            }
+            case IL::OpCode::StoreTexture: {
+                resource = it->As<IL::StoreTextureInstruction>()->texture;
+                isWrite = true;
+                break;
+            }
+            case IL::OpCode::LoadTexture: {
+                resource = it->As<IL::LoadTextureInstruction>()->texture;
+
+                // Get type
+                auto type = program.GetTypeMap().GetType(resource)->As<Backend::IL::TextureType>();
+
+                // Sub-pass inputs are not validated
+                if (type->dimension == Backend::IL::TextureDimension::SubPass) {
+                    return;
+                }
+                break;
+            }
+            case IL::OpCode::SampleTexture: {
+                resource = it->As<IL::SampleTextureInstruction>()->texture;
+                break;
+            }
+        }
+
+        // Bind the SGUID
+        ShaderSGUID sguid = sguidHost ? sguidHost->Bind(program, it) : InvalidShaderSGUID;
 
-        // Resume after unlock
-        return resumeEmitter.GetIterator();
+        // Add check
+        checks.push_back(std::make_unique<ResourceAddressingConcurrencyGuardCheck>(exportID, sguid, resource, lockBufferDataID, eventDataID, isWrite, detail));
     });
 }
 
@@ -58,6 +58,7 @@ public:
 
     /// IShaderFeature
     void CollectExports(const MessageStream &exports) override;
+    void PlanGuards(IL::GuardPlan &plan, IL::Program &program, const MessageStreamView<> &specialization) override;
     void Inject(IL::Program &program, const MessageStreamView<> &specialization) override;
 
     /// Interface querying
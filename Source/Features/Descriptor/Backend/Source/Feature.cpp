@@ -31,6 +31,7 @@
 #include <Backend/IShaderExportHost.h>
 #include <Backend/IShaderSGUIDHost.h>
 #include <Backend/IL/Visitor.h>
+#include <Backend/IL/GuardPlan.h>
 #include <Backend/IL/TypeCommon.h>
 #include <Backend/IL/Emitters/ResourceTokenEmitter.h>
 #include <Backend/IL/ResourceTokenType.h>
@@ -225,6 +226,11 @@ void DescriptorFeature::Inject(IL::Program &program, const MessageStreamView<> &
     // Options
     const SetInstrumentationConfigMessage config = CollapseOrDefault<SetInstrumentationConfigMessage>(specialization);
 
+    // Non safe-guarded validation is fused with all other guards, see PlanGuards
+    if (!config.safeGuard) {
+        return;
+    }
+
     // Visit all instructions
     IL::VisitUserInstructions(program, [&](IL::VisitContext &context, IL::BasicBlock::Iterator it) -> IL::BasicBlock::Iterator {
         // Instruction of interest?
@@ -281,6 +287,156 @@ void DescriptorFeature::Inject(IL::Program &program, const MessageStreamView<> &
     });
 }
 
+/// Descriptor guard check, non safe-guarded
+class DescriptorGuardCheck final : public IL::IGuardCheck {
+public:
+    DescriptorGuardCheck(ShaderExportID exportID, ShaderSGUID sguid, IL::ID resource, Backend::IL::ResourceTokenType compileTypeLiteral, bool detail) :
+        exportID(exportID), sguid(sguid), resource(resource), compileTypeLiteral(compileTypeLiteral), detail(detail) {
+
+    }
+
+    IL::ID EmitCondition(IL::GuardContext& context) override {
+        IL::Emitter<>& pre = context.pre;
+
+        // Get global id of resource, shared with all other checks
+        IL::ResourceTokenEmitter<IL::Emitter<>>& token = context.GetToken(resource);
+
+        // Keep token
+        packedToken = token.GetPackedToken();
+
+        // Get the ids
+        compileType = pre.UInt32(static_cast<uint32_t>(compileTypeLiteral));
+        runtimeType = token.GetType();
+        runtimePUID = token.GetPUID();
+
+        // Types must match, or out of bounds
+        return pre.Or(
+            pre.NotEqual(compileType, runtimeType),
+            pre.GreaterThanEqual(runtimePUID, pre.UInt32(IL::kResourceTokenPUIDInvalidStart))
+        );
+    }
+
+    void EmitFailure(IL::GuardContext& context, IL::Emitter<>& mismatch) override {
+        // Special PUIDs
+        IL::ID isUndefined     = mismatch.Equal(runtimePUID, mismatch.UInt32(IL::kResourceTokenPUIDInvalidUndefined));
+        IL::ID isOutOfBounds   = mismatch.Equal(runtimePUID, mismatch.UInt32(IL::kResourceTokenPUIDInvalidOutOfBounds));
+        IL::ID isTableNotBound = mismatch.Equal(runtimePUID, mismatch.UInt32(IL::kResourceTokenPUIDInvalidTableNotBound));
+
+        // Setup message
+        DescriptorMismatchMessage::ShaderExport msg;
+        msg.sguid = mismatch.UInt32(sguid);
+        msg.compileType = compileType;
+        msg.runtimeType = runtimeType;
+        msg.isUndefined = mismatch.Select(isUndefined, mismatch.UInt32(1), mismatch.UInt32(0));
+        msg.isOutOfBounds = mismatch.Select(isOutOfBounds, mismatch.UInt32(1), mismatch.UInt32(0));
+        msg.isTableNotBound = mismatch.Select(isTableNotBound, mismatch.UInt32(1), mismatch.UInt32(0));
+
+        // Detailed instrumentation?
+        if (detail) {
+            msg.chunks |= DescriptorMismatchMessage::Chunk::Detail;
+            msg.detail.token = packedToken;
+        }
+
+        // Export the message
+        mismatch.Export(exportID, msg);
+    }
+
+private:
+    /// Export id of the feature
+    ShaderExportID exportID;
+
+    /// Bound sguid
+    ShaderSGUID sguid;
+
+    /// Resource to validate
+    IL::ID resource;
+
+    /// Expected compile type value
+    Backend::IL::ResourceTokenType compileTypeLiteral;
+
+    /// Detailed instrumentation?
+    bool detail;
+
+    /// Shared data, emitted with the condition
+    IL::ID packedToken{IL::InvalidID};
+    IL::ID compileType{IL::InvalidID};
+    IL::ID runtimeType{IL::InvalidID};
+    IL::ID runtimePUID{IL::InvalidID};
+};
+
+void DescriptorFeature::PlanGuards(IL::GuardPlan &plan, IL::Program &program, const MessageStreamView<> &specialization) {
+    // Options
+    const SetInstrumentationConfigMessage config = CollapseOrDefault<SetInstrumentationConfigMessage>(specialization);
+
+    // Safe-guarding moves the offending instruction out of the shared path, injected separately
+    if (config.safeGuard) {
+        return;
+    }
+
+    // Register the descriptor checks, fused with all other guards on the same instruction
+    plan.Add([this, detail = config.detail](IL::Program& program, IL::Function& function, const IL::BasicBlock::Iterator& it, IL::GuardCheckList& checks) {
+        // Bind the SGUID
+        auto bind = [&] {
+            return sguidHost ? sguidHost->Bind(program, it) : InvalidShaderSGUID;
+        };
+
+        // Instruction of interest?
+        switch (it->opCode) {
+            default:
+                return;
+            case IL::OpCode::LoadBuffer: {
+                checks.push_back(std::make_unique<DescriptorGuardCheck>(exportID, bind(), it->As<IL::LoadBufferInstruction>()->buffer, Backend::IL::ResourceTokenType::Buffer, detail));
+                return;
+            }
+            case IL::OpCode::StoreBuffer: {
+                checks.push_back(std::make_unique<DescriptorGuardCheck>(exportID, bind(), it->As<IL::StoreBufferInstruction>()->buffer, Backend::IL::ResourceTokenType::Buffer, detail));
+                return;
+            }
+            case IL::OpCode::LoadBufferRaw: {
+                checks.push_back(std::make_unique<DescriptorGuardCheck>(exportID, bind(), it->As<IL::LoadBufferRawInstruction>()->buffer, Backend::IL::ResourceTokenType::Buffer, detail));
+                return;
+            }
+            case IL::OpCode::StoreBufferRaw: {
+                checks.push_back(std::make_unique<DescriptorGuardCheck>(exportID, bind(), it->As<IL::StoreBufferRawInstruction>()->buffer, Backend::IL::ResourceTokenType::Buffer, detail));
+                return;
+            }
+            case IL::OpCode::StoreTexture: {
+                checks.push_back(std::make_unique<DescriptorGuardCheck>(exportID, bind(), it->As<IL::StoreTextureInstruction>()->texture, Backend::IL::ResourceTokenType::Texture, detail));
+                return;
+            }
+            case IL::OpCode::LoadTexture: {
+                IL::ID resource = it->As<IL::LoadTextureInstruction>()->texture;
+
+                // Get type
+                auto type = program.GetTypeMap().GetType(resource)->As<Backend::IL::TextureType>();
+
+                // Sub-pass inputs are not validated
+                if (type->dimension == Backend::IL::TextureDimension::SubPass) {
+                    return;
+                }
+
+                checks.push_back(std::make_unique<DescriptorGuardCheck>(exportID, bind(), resource, Backend::IL::ResourceTokenType::Texture, detail));
+                return;
+            }
+            case IL::OpCode::SampleTexture: {
+                auto* instr = it->As<IL::SampleTextureInstruction>();
+
+                // Both checks share the sguid
+                ShaderSGUID sguid = bind();
+
+                // Validate texture
+                checks.push_back(std::make_unique<DescriptorGuardCheck>(exportID, sguid, instr->texture, Backend::IL::ResourceTokenType::Texture, detail));
+
+                // Samplers are not guaranteed (can be combined)
+                if (instr->sampler != IL::InvalidID) {
+                    checks.push_back(std::make_unique<DescriptorGuardCheck>(exportID, sguid, instr->sampler, Backend::IL::ResourceTokenType::Sampler, detail));
+                }
+                return;
+            }
+        }
+    });
+}
+
 FeatureInfo DescriptorFeature::GetInfo() {
     FeatureInfo info;
     info.name = "Descriptor";
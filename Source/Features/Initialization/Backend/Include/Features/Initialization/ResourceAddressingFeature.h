@@ -63,6 +63,7 @@ public:
 
     /// IShaderFeature
     void CollectExports(const MessageStream &exports) override;
+    void PlanGuards(IL::GuardPlan &plan, IL::Program &program, const MessageStreamView<> &specialization) override;
     void Inject(IL::Program &program, const MessageStreamView<> &specialization) override;
 
     /// Interface querying
@@ -85,6 +86,9 @@ private:
     void OnCopyResource(CommandContext* context, const ResourceInfo& source, const ResourceInfo& dest);
     void OnResolveResource(CommandContext* context, const ResourceInfo& source, const ResourceInfo& dest);
     void OnClearResource(CommandContext* context, const ResourceInfo& buffer);
+    void OnCopyResources(CommandContext* context, const ResourceInfo* sources, const ResourceInfo* dests, uint32_t count);
+    void OnResolveResources(CommandContext* context, const ResourceInfo* sources, const ResourceInfo* dests, uint32_t count);
+    void OnClearResources(CommandContext* context, const ResourceInfo* resources, uint32_t count);
     void OnWriteResource(CommandContext* context, const ResourceInfo& buffer);
     void OnBeginRenderPass(CommandContext* context, const RenderPassInfo& passInfo);
     void OnSubmitBatchBegin(SubmissionContext& submission, const CommandContextHandle *contexts, uint32_t contextCount);
@@ -97,6 +101,12 @@ private:
     /// \param srb resource mask
     void MaskResourceSRB(CommandContext* context, uint64_t puid, uint32_t srb);
 
+    /// Mark a span of resources as fully initialized
+    /// \param context destination context
+    /// \param resources all resources
+    /// \param count number of resources
+    void MaskResourceSpanSRB(CommandContext* context, const ResourceInfo* resources, uint32_t count);
+
 private:
     /// Hosts
     ComRef<IShaderSGUIDHost> sguidHost{nullptr};
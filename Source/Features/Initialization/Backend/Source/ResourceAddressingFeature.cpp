@@ -35,6 +35,7 @@
 #include <Backend/IL/Visitor.h>
 #include <Backend/IL/TypeCommon.h>
 #include <Backend/IL/Emitters/ResourceTokenEmitter.h>
+#include <Backend/IL/GuardPlan.h>
 #include <Backend/IL/ResourceTokenType.h>
 #include <Backend/CommandContext.h>
 #include <Backend/Resource/BufferDescriptor.h>
@@ -133,6 +134,9 @@ FeatureHookTable ResourceAddressingInitializationFeature::GetHookTable() {
     table.copyResource = BindDelegate(this, ResourceAddressingInitializationFeature::OnCopyResource);
     table.resolveResource = BindDelegate(this, ResourceAddressingInitializationFeature::OnResolveResource);
     table.clearResource = BindDelegate(this, ResourceAddressingInitializationFeature::OnClearResource);
+    table.copyResources = BindDelegate(this, ResourceAddressingInitializationFeature::OnCopyResources);
+    table.resolveResources = BindDelegate(this, ResourceAddressingInitializationFeature::OnResolveResources);
+    table.clearResources = BindDelegate(this, ResourceAddressingInitializationFeature::OnClearResources);
     table.writeResource = BindDelegate(this, ResourceAddressingInitializationFeature::OnWriteResource);
     table.beginRenderPass = BindDelegate(this, ResourceAddressingInitializationFeature::OnBeginRenderPass);
     table.preSubmit = BindDelegate(this, ResourceAddressingInitializationFeature::OnSubmitBatchBegin);
@@ -149,9 +153,6 @@ void ResourceAddressingInitializationFeature::CollectMessages(IMessageStorage *s
 }
 
 void ResourceAddressingInitializationFeature::Inject(IL::Program &program, const MessageStreamView<> &specialization) {
-    // Options
-    const SetInstrumentationConfigMessage config = CollapseOrDefault<SetInstrumentationConfigMessage>(specialization);
-    
     // Get the data ids
     IL::ID initializationMaskBufferDataID = program.GetShaderDataMap().Get(initializationMaskBufferID)->id;
 
@@ -160,120 +161,87 @@ void ResourceAddressingInitializationFeature::Inject(IL::Program &program, const
         // Pooled resource id
         IL::ID resource;
 
-        // Write operation?
-        bool isWrite = false;
-
-        // Instruction of interest?
+        // Write operation of interest? Reads are validated by the fused guards, see PlanGuards
         switch (it->opCode) {
             default:
                 return it;
-            case IL::OpCode::LoadBuffer: {
-                resource = it->As<IL::LoadBufferInstruction>()->buffer;
-                break;
-            }
             case IL::OpCode::StoreBuffer: {
                 resource = it->As<IL::StoreBufferInstruction>()->buffer;
-                isWrite = true;
                 break;
             }
             case IL::OpCode::StoreTexture: {
                 resource = it->As<IL::StoreTextureInstruction>()->texture;
-                isWrite = true;
                 break;
             }
-            case IL::OpCode::LoadTexture: {
-                resource = it->As<IL::LoadTextureInstruction>()->texture;
+        }
 
-                // Get type
-                auto type = program.GetTypeMap().GetType(resource)->As<Backend::IL::TextureType>();
+        // Writes just assign the new mask, insert prior to IOI
+        IL::Emitter<> emitter(program, context.basicBlock, it);
 
-                // Sub-pass inputs are not validated
-                if (type->dimension == Backend::IL::TextureDimension::SubPass) {
-                    return it;
-                }
-                break;
-            }
-            case IL::OpCode::SampleTexture: {
-                resource = it->As<IL::SampleTextureInstruction>()->texture;
-                break;
-            }
-        }
+        // Get global id of resource
+        IL::ResourceTokenEmitter token(emitter, resource);
 
-        // Write operations just assign the new mask
-        if (isWrite) {
-            // Insert prior to IOI
-            IL::Emitter<> emitter(program, context.basicBlock, it);
+        // Note: Superceeded by texel-addressing
+        IL::ID SRB = program.GetConstants().UInt(1u)->id;
+        
+        // Get token details
+        IL::ID PUID = token.GetPUID();
 
-            // Get global id of resource
-            IL::ResourceTokenEmitter token(emitter, resource);
+        // Multiple events may write to the same resource, accumulate the SRB atomically
+        const bool UseAtomics = true;
 
-            // Note: Superceeded by texel-addressing
-            IL::ID SRB = program.GetConstants().UInt(1u)->id;
+        // Atomics?
+        if (UseAtomics) {
+            // Or the destination resource
+            emitter.AtomicOr(emitter.AddressOf(initializationMaskBufferDataID, PUID), SRB);
+        } else {
+            // Load buffer pointer
+            IL::ID bufferID = emitter.Load(initializationMaskBufferDataID);
             
-            // Get token details
-            IL::ID PUID = token.GetPUID();
-
-            // Multiple events may write to the same resource, accumulate the SRB atomically
-            const bool UseAtomics = true;
-
-            // Atomics?
-            if (UseAtomics) {
-                // Or the destination resource
-                emitter.AtomicOr(emitter.AddressOf(initializationMaskBufferDataID, PUID), SRB);
-            } else {
-                // Load buffer pointer
-                IL::ID bufferID = emitter.Load(initializationMaskBufferDataID);
-                
-                // Get current mask
-                IL::ID srbMask = emitter.Extract(emitter.LoadBuffer(bufferID, PUID), program.GetConstants().UInt(0)->id);
-
-                // Bit-Or with resource mask
-                emitter.StoreBuffer(bufferID, PUID, emitter.BitOr(srbMask, SRB));
-            }
-            
-            // Resume on next
-            return emitter.GetIterator();
-        }
+            // Get current mask
+            IL::ID srbMask = emitter.Extract(emitter.LoadBuffer(bufferID, PUID), program.GetConstants().UInt(0)->id);
 
-        // Bind the SGUID
-        ShaderSGUID sguid = sguidHost ? sguidHost->Bind(program, it) : InvalidShaderSGUID;
+            // Bit-Or with resource mask
+            emitter.StoreBuffer(bufferID, PUID, emitter.BitOr(srbMask, SRB));
+        }
+        
+        // Resume on next
+        return emitter.GetIterator();
+    });
+}
 
-        // Allocate resume
-        IL::BasicBlock* resumeBlock = context.function.GetBasicBlocks().AllocBlock();
+/// Resource addressing initialization guard check
+class ResourceAddressingInitializationGuardCheck final : public IL::IGuardCheck {
+public:
+    ResourceAddressingInitializationGuardCheck(ShaderExportID exportID, ShaderSGUID sguid, IL::ID resource, IL::ID initializationMaskBufferDataID, bool detail) :
+        exportID(exportID), sguid(sguid), resource(resource), initializationMaskBufferDataID(initializationMaskBufferDataID), detail(detail) {
 
-        // Split this basic block, move all instructions post and including the instrumented instruction to resume
-        // ! iterator invalidated
-        auto instr = context.basicBlock.Split(resumeBlock, it);
+    }
 
-        // Allocate failure block
-        IL::Emitter<> mismatch(program, *context.function.GetBasicBlocks().AllocBlock());
-        mismatch.AddBlockFlag(BasicBlockFlag::NoInstrumentation);
+    IL::ID EmitCondition(IL::GuardContext& context) override {
+        IL::Emitter<>& pre = context.pre;
 
-        // Perform instrumentation check
-        IL::Emitter<> pre(program, context.basicBlock);
+        // Get global id of resource, shared with all other checks
+        IL::ResourceTokenEmitter<IL::Emitter<>>& token = context.GetToken(resource);
 
-        // Get global id of resource
-        IL::ResourceTokenEmitter token(pre, resource);
-        
         // Note: Superceeded by texel-addressing
-        IL::ID SRB = program.GetConstants().UInt(1u)->id;
-        
+        IL::ID SRB = context.program.GetConstants().UInt(1u)->id;
+
         // Get token details
         IL::ID PUID = token.GetPUID();
-        IL::ID packedToken = token.GetPackedToken();
+        packedToken = token.GetPackedToken();
 
         // Get the current mask
-        IL::ID currentMask = pre.Extract(pre.LoadBuffer(pre.Load(initializationMaskBufferDataID), PUID), program.GetConstants().UInt(0)->id);
+        IL::ID currentMask = pre.Extract(pre.LoadBuffer(pre.Load(initializationMaskBufferDataID), PUID), context.program.GetConstants().UInt(0)->id);
 
         // Compare mask against token SRB
-        IL::ID cond = pre.NotEqual(pre.BitAnd(currentMask, SRB), SRB);
-
-        // If so, branch to failure, otherwise resume
-        pre.BranchConditional(cond, mismatch.GetBasicBlock(), resumeBlock, IL::ControlFlow::Selection(resumeBlock));
+        return pre.NotEqual(pre.BitAnd(currentMask, SRB), SRB);
+    }
 
+    void EmitFailure(IL::GuardContext& context, IL::Emitter<>& mismatch) override {
         // Common constants
-        IL::ID zero = program.GetConstants().UInt(0)->id;
-        
+        IL::ID zero = context.program.GetConstants().UInt(0)->id;
+
         // Setup message
         UninitializedResourceMessage::ShaderExport msg;
         msg.sguid = mismatch.UInt32(sguid);
@@ -282,7 +250,7 @@ void ResourceAddressingInitializationFeature::Inject(IL::Program &program, const
         msg.failureCode = zero;
 
         // Detailed instrumentation?
-        if (config.detail) {
+        if (detail) {
             msg.chunks |= UninitializedResourceMessage::Chunk::Detail;
             msg.detail.token = packedToken;
 
@@ -293,13 +261,73 @@ void ResourceAddressingInitializationFeature::Inject(IL::Program &program, const
             msg.detail.mip = zero;
             msg.detail.byteOffset = zero;
         }
-        
+
         // Export the message
         mismatch.Export(exportID, msg);
+    }
+
+private:
+    /// Export id of the feature
+    ShaderExportID exportID;
 
-        // Branch back
-        mismatch.Branch(resumeBlock);
-        return instr;
+    /// Bound sguid
+    ShaderSGUID sguid;
+
+    /// Resource to validate
+    IL::ID resource;
+
+    /// Mask buffer
+    IL::ID initializationMaskBufferDataID;
+
+    /// Detailed instrumentation?
+    bool detail;
+
+    /// Shared token
+    IL::ID packedToken{IL::InvalidID};
+};
+
+void ResourceAddressingInitializationFeature::PlanGuards(IL::GuardPlan &plan, IL::Program &program, const MessageStreamView<> &specialization) {
+    // Options
+    const SetInstrumentationConfigMessage config = CollapseOrDefault<SetInstrumentationConfigMessage>(specialization);
+
+    // Get the data ids
+    IL::ID initializationMaskBufferDataID = program.GetShaderDataMap().Get(initializationMaskBufferID)->id;
+
+    // Register the read checks, fused with all other guards on the same instruction
+    plan.Add([this, initializationMaskBufferDataID, detail = config.detail](IL::Program& program, IL::Function& function, const IL::BasicBlock::Iterator& it, IL::GuardCheckList& checks) {
+        IL::ID resource;
+
+        // Instruction of interest?
+        switch (it->opCode) {
+            default:
+                return;
+            case IL::OpCode::LoadBuffer: {
+                resource = it->As<IL::LoadBufferInstruction>()->buffer;
+                break;
+            }
+            case IL::OpCode::LoadTexture: {
+                resource = it->As<IL::LoadTextureInstruction>()->texture;
+
+                // Get type
+                auto type = program.GetTypeMap().GetType(resource)->As<Backend::IL::TextureType>();
+
+                // Sub-pass inputs are not validated
+                if (type->dimension == Backend::IL::TextureDimension::SubPass) {
+                    return;
+                }
+                break;
+            }
+            case IL::OpCode::SampleTexture: {
+                resource = it->As<IL::SampleTextureInstruction>()->texture;
+                break;
+            }
+        }
+
+        // Bind the SGUID
+        ShaderSGUID sguid = sguidHost ? sguidHost->Bind(program, it) : InvalidShaderSGUID;
+
+        // Add check
+        checks.push_back(std::make_unique<ResourceAddressingInitializationGuardCheck>(exportID, sguid, resource, initializationMaskBufferDataID, detail));
     });
 }
 
@@ -325,6 +353,29 @@ void ResourceAddressingInitializationFeature::OnClearResource(CommandContext* co
     MaskResourceSRB(context, resource.token.puid, ~0u);
 }
 
+void ResourceAddressingInitializationFeature::OnCopyResources(CommandContext* context, const ResourceInfo* sources, const ResourceInfo* dests, uint32_t count) {
+    MaskResourceSpanSRB(context, dests, count);
+}
+
+void ResourceAddressingInitializationFeature::OnResolveResources(CommandContext* context, const ResourceInfo* sources, const ResourceInfo* dests, uint32_t count) {
+    MaskResourceSpanSRB(context, dests, count);
+}
+
+void ResourceAddressingInitializationFeature::OnClearResources(CommandContext* context, const ResourceInfo* resources, uint32_t count) {
+    MaskResourceSpanSRB(context, resources, count);
+}
+
+void ResourceAddressingInitializationFeature::MaskResourceSpanSRB(CommandContext* context, const ResourceInfo* resources, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        // Regions of the same command typically share the resource, mask each run once
+        if (i > 0 && resources[i].token.puid == resources[i - 1].token.puid) {
+            continue;
+        }
+
+        MaskResourceSRB(context, resources[i].token.puid, ~0u);
+    }
+}
+
 void ResourceAddressingInitializationFeature::OnWriteResource(CommandContext* context, const ResourceInfo& resource) {
     MaskResourceSRB(context, resource.token.puid, ~0u);
 }
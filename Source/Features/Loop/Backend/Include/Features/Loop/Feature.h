@@ -45,10 +45,16 @@
 // Std
 #include <atomic>
 #include <unordered_map>
+#include <unordered_set>
 #include <chrono>
 #include <thread>
 #include <mutex>
 
+// Forward declarations
+namespace IL {
+    class LoopTripCountAnalysis;
+}
+
 // Forward declarations
 class SignalShaderProgram;
 class IShaderSGUIDHost;
@@ -91,6 +97,19 @@ public:
 
 private:
     using LoopCounterMap = std::map<IL::ID, IL::ID>;
+    using BoundedLoopMap = std::map<IL::ID, std::unordered_set<uint32_t>>;
+
+    /// Collect all loops with a bounded trip count
+    /// @param program source program
+    /// @param iterationLimit maximum trip count
+    /// @param map destination map, header terminator sources per function
+    void CollectBoundedLoops(IL::Program &program, uint32_t iterationLimit, BoundedLoopMap& map);
+
+    /// Get the trip count analysis of a function, computed once on the source program
+    /// @param program program to instrument
+    /// @param functionID function to analyze
+    /// @return nullptr if the function does not originate from the source
+    ComRef<IL::LoopTripCountAnalysis> GetSourceTripCountAnalysis(IL::Program &program, IL::ID functionID);
 
     /// Inject all function wide loop counters
     /// @param program source program
@@ -37,6 +37,7 @@
 #include <Backend/CommandContext.h>
 #include <Backend/IL/Analysis/CFG/DominatorAnalysis.h>
 #include <Backend/IL/Analysis/CFG/LoopAnalysis.h>
+#include <Backend/IL/Analysis/CFG/LoopTripCountAnalysis.h>
 #include <Backend/ShaderData/ShaderDataDescriptorInfo.h>
 #include <Backend/Command/CommandBuilder.h>
 #include <Backend/Scheduler/IScheduler.h>
@@ -169,6 +170,10 @@ void LoopFeature::Inject(IL::Program &program, const MessageStreamView<> &specia
 
     // If the program has structured control flow, we can take quite a few liberties in instrumentation
     if (capabilityTable.hasControlFlow) {
+        // Instrumentation splits loop headers, so collect the bounded loops by their header terminators beforehand
+        BoundedLoopMap boundedLoops;
+        CollectBoundedLoops(program, config.iterationLimit, boundedLoops);
+
         // Visit all instructions
         IL::VisitUserInstructions(program, [&](IL::VisitContext &context, IL::BasicBlock::Iterator it) -> IL::BasicBlock::Iterator {
             IL::BranchControlFlow controlFlow;
@@ -178,6 +183,11 @@ void LoopFeature::Inject(IL::Program &program, const MessageStreamView<> &specia
                 return it;
             }
 
+            // Bounded loops never hang, skip them
+            if (auto sources = boundedLoops.find(context.function.GetID()); sources != boundedLoops.end() && it->source.HasNonSymbolicCodeOffset() && sources->second.contains(it->source.codeOffset)) {
+                return it;
+            }
+
             // All basic blocks
             IL::BasicBlockList& basicBlocks = context.function.GetBasicBlocks();
 
@@ -332,9 +342,17 @@ void LoopFeature::Inject(IL::Program &program, const MessageStreamView<> &specia
     } else {
         // The program does not have structured control flow, therefore we need to perform cfg loop analysis, and pray.
         for (IL::Function *fn: program.GetFunctionList()) {
+            // Skip non-instrumented functions
+            if (fn->HasFlag(FunctionFlag::NoInstrumentation)) {
+                continue;
+            }
+            
             // Compute loop analysis
             ComRef loopAnalysis = fn->GetAnalysisMap().FindPassOrCompute<IL::LoopAnalysis>(*fn);
 
+            // Get the trip counts of the uninstrumented function
+            ComRef<IL::LoopTripCountAnalysis> tripCountAnalysis = GetSourceTripCountAnalysis(program, fn->GetID());
+
             // Instrument each loop
             for (const IL::Loop& loop : loopAnalysis->GetView()) {
                 // Ignore flagged blocks
@@ -342,6 +360,11 @@ void LoopFeature::Inject(IL::Program &program, const MessageStreamView<> &specia
                    continue;
                 }
 
+                // Bounded loops never hang, skip them
+                if (std::optional<uint64_t> tripCount = tripCountAnalysis ? tripCountAnalysis->GetMaxTripCount(loop.header) : std::nullopt; tripCount && tripCount.value() <= config.iterationLimit) {
+                    continue;
+                }
+
                 // Allocate blocks
                 IL::BasicBlock* postGuardBlock   = fn->GetBasicBlocks().AllocBlock();
                 IL::BasicBlock *terminationBlock = fn->GetBasicBlocks().AllocBlock();
@@ -416,8 +439,61 @@ void LoopFeature::Inject(IL::Program &program, const MessageStreamView<> &specia
     }
 }
 
+void LoopFeature::CollectBoundedLoops(IL::Program &program, uint32_t iterationLimit, BoundedLoopMap &map) {
+    // Trip counts only depend on the user program, compute them on the source shared by all copies
+    std::lock_guard guard(program.GetSourceAnalysisMutex());
+    IL::Program& source = program.GetSourceProgram();
+    
+    for (IL::Function *function : source.GetFunctionList()) {
+        // Skip non-instrumented functions
+        if (function->HasFlag(FunctionFlag::NoInstrumentation)) {
+            continue;
+        }
+
+        // Compute trip counts
+        ComRef tripCountAnalysis = function->GetAnalysisMap().FindPassOrCompute<IL::LoopTripCountAnalysis>(source, *function);
+        if (!tripCountAnalysis) {
+            continue;
+        }
+
+        // Map all bounded loops within the iteration limit
+        for (const IL::Loop& loop : function->GetAnalysisMap().FindPass<IL::LoopAnalysis>()->GetView()) {
+            const IL::Instruction* terminator = loop.header->GetTerminator();
+
+            // Must be traceable after instrumentation
+            if (!terminator->source.HasNonSymbolicCodeOffset()) {
+                continue;
+            }
+
+            // Bounded?
+            if (std::optional<uint64_t> tripCount = tripCountAnalysis->GetMaxTripCount(loop.header); tripCount && tripCount.value() <= iterationLimit) {
+                map[function->GetID()].insert(terminator->source.codeOffset);
+            }
+        }
+    }
+}
+
+ComRef<IL::LoopTripCountAnalysis> LoopFeature::GetSourceTripCountAnalysis(IL::Program &program, IL::ID functionID) {
+    std::lock_guard guard(program.GetSourceAnalysisMutex());
+    IL::Program& source = program.GetSourceProgram();
+
+    // Function may have been introduced by instrumentation
+    IL::Function* function = source.GetFunctionList().GetFunction(functionID);
+    if (!function) {
+        return nullptr;
+    }
+
+    // Compute trip counts on the source, header identifiers are shared with all copies
+    return function->GetAnalysisMap().FindPassOrCompute<IL::LoopTripCountAnalysis>(source, *function);
+}
+
 void LoopFeature::InjectLoopCounters(IL::Program &program, LoopCounterMap &map) {
     for (IL::Function *function : program.GetFunctionList()) {
+        // Skip non-instrumented functions
+        if (function->HasFlag(FunctionFlag::NoInstrumentation)) {
+            continue;
+        }
+        
         IL::BasicBlock* entryPoint = function->GetBasicBlocks().GetEntryPoint();
 
         // Inject counter allocation at the start of the function
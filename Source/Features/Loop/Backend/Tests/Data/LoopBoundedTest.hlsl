@@ -0,0 +1,69 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+//! KERNEL   Compute "main"
+//! DISPATCH 4, 1, 1
+
+//! SCHEMA "Schemas/Features/Loop.h"
+
+//! RESOURCE RWBuffer<R32Float> size:64
+[[vk::binding(0)]] RWBuffer<float> bufferRW : register(u0, space0);
+
+[numthreads(1, 1, 1)]
+void main(uint dtid : SV_DispatchThreadID) {
+    float sum = 0.0f;
+
+    // Bounded loops are not instrumented, the shared iteration counter
+    // would otherwise exceed the iteration limit across both loops
+    for (uint i = 0; i < 20000; i++) {
+        sum += bufferRW[i % 64];
+    }
+
+    for (int j = 20000; j > 0; j--) {
+        sum += bufferRW[j % 64];
+    }
+
+    // Bounded nested loops
+    for (uint x = 0; x < 16; x++) {
+        for (uint y = 0; y <= 8; y += 2) {
+            sum += bufferRW[(x + y) % 64];
+        }
+    }
+
+    // Bounded by the range of the limit
+    for (uint k = 0; k < (dtid & 15); k++) {
+        sum += bufferRW[k];
+    }
+
+    // Unbounded
+    //! MESSAGE LoopTermination[{true}]
+    for (uint l = 1; sum != -1.0f; l++) {
+        sum += bufferRW[l % 64];
+    }
+
+    // No-opt!
+    bufferRW[dtid] = sum;
+}
@@ -39,9 +39,17 @@
 // Message
 #include <Message/MessageStream.h>
 
+// Std
+#include <unordered_map>
+#include <unordered_set>
+
 // Forward declarations
 class IShaderSGUIDHost;
 
+namespace IL {
+    struct Function;
+}
+
 class ResourceBoundsFeature final : public IFeature, public IShaderFeature {
 public:
     COMPONENT(ResourceBoundsFeature);
@@ -54,7 +62,8 @@ public:
 
     /// IShaderFeature
     void CollectExports(const MessageStream &exports) override;
-    void Inject(IL::Program &program, const MessageStreamView<> &specialization) override;
+    void PreInject(IL::Program &program, const MessageStreamView<> &specialization) override;
+    void PlanGuards(IL::GuardPlan &plan, IL::Program &program, const MessageStreamView<> &specialization) override;
 
     /// Interface querying
     void *QueryInterface(ComponentID id) override {
@@ -70,6 +79,17 @@ public:
         return nullptr;
     }
 
+private:
+    struct ElisionData : public TComponent<ElisionData> {
+        COMPONENT(ResourceBoundsElisionData);
+
+        /// All elided instruction sources, per function
+        std::unordered_map<IL::ID, std::unordered_set<uint32_t>> functionSources;
+    };
+
+    /// Collect all provably redundant checks
+    void CollectElidedChecks(IL::Program& program, IL::Function& function, const ComRef<ElisionData>& data);
+
 private:
     /// Shader SGUID
     ComRef<IShaderSGUIDHost> sguidHost{nullptr};
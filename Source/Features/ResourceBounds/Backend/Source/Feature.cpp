@@ -31,10 +31,12 @@
 // Backend
 #include <Backend/IShaderExportHost.h>
 #include <Backend/IShaderSGUIDHost.h>
-#include <Backend/IL/Visitor.h>
+#include <Backend/IL/GuardPlan.h>
 #include <Backend/IL/TypeCommon.h>
 #include <Backend/IL/Emitters/ResourceTokenEmitter.h>
 #include <Backend/IL/InstructionValueCommon.h>
+#include <Backend/IL/Analysis/ValueRangeAnalysis.h>
+#include <Backend/IL/Analysis/CFG/DominatorAnalysis.h>
 
 // Generated schema
 #include <Schemas/Features/ResourceBounds.h>
@@ -48,6 +50,9 @@
 // Common
 #include <Common/Registry.h>
 
+// Std
+#include <tuple>
+
 bool ResourceBoundsFeature::Install() {
     // Must have the export host
     auto exportHost = registry->Get<IShaderExportHost>();
@@ -77,86 +82,121 @@ void ResourceBoundsFeature::CollectMessages(IMessageStorage *storage) {
     storage->AddStreamAndSwap(stream);
 }
 
-void ResourceBoundsFeature::Inject(IL::Program &program, const MessageStreamView<> &specialization) {
-    // Options
-    const SetInstrumentationConfigMessage config = CollapseOrDefault<SetInstrumentationConfigMessage>(specialization);
+/// Check if an instruction is bounds checked
+/// \param program the owning program
+/// \param instr the instruction to check
+/// \param isTexture output, true if a texture operation
+/// \param isWrite output, true if a write operation
+/// \return false if not bounds checked
+static bool IsBoundsCheckedInstruction(IL::Program& program, const IL::Instruction* instr, bool& isTexture, bool& isWrite) {
+    switch (instr->opCode) {
+        default:
+            return false;
+
+        /* Handled cases */
+        case IL::OpCode::StoreBuffer:
+        case IL::OpCode::StoreBufferRaw: {
+            isWrite = true;
+            isTexture = false;
+            return true;
+        }
+        case IL::OpCode::LoadBuffer:
+        case IL::OpCode::LoadBufferRaw:  {
+            isWrite = false;
+            isTexture = false;
+            return true;
+        }
+        case IL::OpCode::StoreTexture: {
+            isWrite = true;
+            isTexture = true;
+            return true;
+        }
+        case IL::OpCode::LoadTexture: {
+            isWrite = false;
+            isTexture = true;
 
-    // Unsigned target type
-    const Backend::IL::Type* uint32Type = program.GetTypeMap().FindTypeOrAdd(Backend::IL::IntType {.bitWidth = 32, .signedness = false});
+            // Get texture type
+            auto _instr = instr->As<IL::LoadTextureInstruction>();
+            auto type = program.GetTypeMap().GetType(_instr->texture)->As<Backend::IL::TextureType>();
 
-    // Visit all instructions
-    IL::VisitUserInstructions(program, [&](IL::VisitContext& context, IL::BasicBlock::Iterator it) -> IL::BasicBlock::Iterator {
-        bool isTexture;
-        bool isWrite;
+            // Sub-pass inputs are not validated
+            return type->dimension != Backend::IL::TextureDimension::SubPass;
+        }
+    }
+}
 
-        // Instruction of interest?
-        switch (it->opCode) {
-            default:
-                return it;
+/// Resource bounds guard check
+class ResourceBoundsGuardCheck final : public IL::IGuardCheck {
+public:
+    ResourceBoundsGuardCheck(ShaderExportID exportID, ShaderSGUID sguid, bool isTexture, bool isWrite, bool detail) :
+        exportID(exportID), sguid(sguid), isTexture(isTexture), isWrite(isWrite), detail(detail) {
 
-            /* Handled cases */
-            case IL::OpCode::StoreBuffer:
+    }
+
+    IL::ID EmitCondition(IL::GuardContext& context) override {
+        IL::Program& program = context.program;
+        IL::Emitter<>& pre = context.pre;
+
+        // Unsigned target type
+        const Backend::IL::Type* uint32Type = program.GetTypeMap().FindTypeOrAdd(Backend::IL::IntType {.bitWidth = 32, .signedness = false});
+
+        // Detailed exports need the token, fetch it while the token is shared
+        if (detail) {
+            packedToken = context.GetToken(GetResource(context.instr)).GetPackedToken();
+        }
+
+        // Is any of the indices larger than the resource size
+        switch (context.instr->opCode) {
+            default:
+                ASSERT(false, "Unexpected opcode");
+                return IL::InvalidID;
+            case IL::OpCode::StoreBuffer: {
+                auto* storeBuffer = context.instr->As<IL::StoreBufferInstruction>();
+                return pre.Any(pre.GreaterThanEqual(pre.BitCast(storeBuffer->index, SplatToValue(program, uint32Type, storeBuffer->index)), pre.ResourceSize(storeBuffer->buffer)));
+            }
+            case IL::OpCode::LoadBuffer: {
+                auto* loadBuffer = context.instr->As<IL::LoadBufferInstruction>();
+                return pre.Any(pre.GreaterThanEqual(pre.BitCast(loadBuffer->index, SplatToValue(program, uint32Type, loadBuffer->index)), pre.ResourceSize(loadBuffer->buffer)));
+            }
             case IL::OpCode::StoreBufferRaw: {
-                isWrite = true;
-                isTexture = false;
-                break;
+                auto* storeBuffer = context.instr->As<IL::StoreBufferRawInstruction>();
+                return pre.Any(pre.GreaterThanEqual(pre.BitCast(storeBuffer->index, SplatToValue(program, uint32Type, storeBuffer->index)), pre.ResourceSize(storeBuffer->buffer)));
             }
-            case IL::OpCode::LoadBuffer:
-            case IL::OpCode::LoadBufferRaw:  {
-                isWrite = false;
-                isTexture = false;
-                break;
+            case IL::OpCode::LoadBufferRaw: {
+                auto* loadBuffer = context.instr->As<IL::LoadBufferRawInstruction>();
+                return pre.Any(pre.GreaterThanEqual(pre.BitCast(loadBuffer->index, SplatToValue(program, uint32Type, loadBuffer->index)), pre.ResourceSize(loadBuffer->buffer)));
             }
             case IL::OpCode::StoreTexture: {
-                isWrite = true;
-                isTexture = true;
-                break;
-            }
-            case IL::OpCode::LoadTexture: {
-                isWrite = false;
-                isTexture = true;
+                auto* storeTexture = context.instr->As<IL::StoreTextureInstruction>();
 
                 // Get texture type
-                auto instr = it->As<IL::LoadTextureInstruction>();
-                auto type = program.GetTypeMap().GetType(instr->texture)->As<Backend::IL::TextureType>();
+                auto type = program.GetTypeMap().GetType(storeTexture->texture)->As<Backend::IL::TextureType>();
 
-                // Sub-pass inputs are not validated
-                if (type->dimension == Backend::IL::TextureDimension::SubPass) {
-                    return it;
+                // Type of the index
+                const Backend::IL::Type *indexType = SplatToValue(program, uint32Type, storeTexture->index);
+                
+                // Store instructions have special considerations for cube arrays
+                // Size queries only report the width/height, so assume 6 faces (3d)
+                IL::ID size = pre.ResourceSize(storeTexture->texture);
+                if (type->dimension == Backend::IL::TextureDimension::Texture2DCube) {
+                    size = pre.Construct(
+                        indexType,
+                        pre.Extract(size, pre.UInt32(0)).GetID(),
+                        pre.Extract(size, pre.UInt32(1)).GetID(),
+                        pre.UInt32(6)
+                    );
                 }
-                break;
+
+                return pre.Any(pre.GreaterThanEqual(pre.BitCast(storeTexture->index, indexType), size));
+            }
+            case IL::OpCode::LoadTexture: {
+                auto* loadTexture = context.instr->As<IL::LoadTextureInstruction>();
+                return pre.Any(pre.GreaterThanEqual(pre.BitCast(loadTexture->index, SplatToValue(program, uint32Type, loadTexture->index)), pre.ResourceSize(loadTexture->texture)));
             }
         }
+    }
 
-        // Instrumentation Segmentation
-        //
-        //             BEFORE                                 AFTER
-        //
-        //   ┌─────┬─────────────┬───────┐      ┌─────┐                   ┌─────────────┬──────┐
-        //   │     │             │       │      │     │        OK         │             │      │
-        //   │ Pre │ Instruction │ Post  │      │ Pre ├───────────────────┤ Instruction │ Post │
-        //   │     │             │       │      │     │                   │   [RESUME]  │      │
-        //   └─────┴─────────────┴───────┘      └──┬──┘                   └──────┬──────┴──────┘
-        //                                         │    ┌───────────────┐        │
-        //                                     OOB │    │               │        │
-        //                                         └────┤ Out of Bounds ├────────┘
-        //                                              │     [OOB]     │
-        //                                              └───────────────┘
-
-        // Bind the SGUID
-        ShaderSGUID sguid = sguidHost ? sguidHost->Bind(program, it) : InvalidShaderSGUID;
-
-        // Allocate resume
-        IL::BasicBlock* resumeBlock = context.function.GetBasicBlocks().AllocBlock();
-
-        // Split this basic block, move all instructions post and including the instrumented instruction to resume
-        // ! iterator invalidated
-        auto instr = context.basicBlock.Split(resumeBlock, it);
-
-        // Out of bounds block
-        IL::Emitter<> oob(program, *context.function.GetBasicBlocks().AllocBlock());
-        oob.AddBlockFlag(BasicBlockFlag::NoInstrumentation);
-
+    void EmitFailure(IL::GuardContext& context, IL::Emitter<>& oob) override {
         // Setup message
         ResourceIndexOutOfBoundsMessage::ShaderExport msg;
         msg.sguid = oob.UInt32(sguid);
@@ -164,159 +204,274 @@ void ResourceBoundsFeature::Inject(IL::Program &program, const MessageStreamView
         msg.isWrite = oob.UInt32(isWrite);
 
         // Detailed instrumentation?
-        if (config.detail) {
+        if (detail) {
             msg.chunks |= ResourceIndexOutOfBoundsMessage::Chunk::Detail;
+            msg.detail.token = packedToken;
 
             // Convenient zero
             IL::ID zero = oob.UInt32(0);
 
-            // Get detailed information on the op code
-            switch (it->opCode) {
-                default:
-                    ASSERT(false, "Invalid op code");
-                    break;
-
-                    /* Handled cases */
-                case IL::OpCode::StoreBuffer: {
-                    auto _instr = instr->As<IL::StoreBufferInstruction>();
-                    msg.detail.token = IL::ResourceTokenEmitter(oob, _instr->buffer).GetPackedToken();
-                    msg.detail.coordinate[0] = Backend::IL::BitCastToUnsigned(oob, _instr->index);
-                    msg.detail.coordinate[1] = zero;
-                    msg.detail.coordinate[2] = zero;
-                    break;
-                }
-                case IL::OpCode::LoadBuffer: {
-                    auto _instr = instr->As<IL::LoadBufferInstruction>();
-                    msg.detail.token = IL::ResourceTokenEmitter(oob, _instr->buffer).GetPackedToken();
-                    msg.detail.coordinate[0] = Backend::IL::BitCastToUnsigned(oob, _instr->index);
-                    msg.detail.coordinate[1] = zero;
-                    msg.detail.coordinate[2] = zero;
-                    break;
-                }
-                case IL::OpCode::StoreBufferRaw: {
-                    auto _instr = instr->As<IL::StoreBufferRawInstruction>();
-                    msg.detail.token = IL::ResourceTokenEmitter(oob, _instr->buffer).GetPackedToken();
-                    msg.detail.coordinate[0] = Backend::IL::BitCastToUnsigned(oob, _instr->index);
-                    msg.detail.coordinate[1] = zero;
-                    msg.detail.coordinate[2] = zero;
-                    break;
-                }
-                case IL::OpCode::LoadBufferRaw: {
-                    auto _instr = instr->As<IL::LoadBufferRawInstruction>();
-                    msg.detail.token = IL::ResourceTokenEmitter(oob, _instr->buffer).GetPackedToken();
-                    msg.detail.coordinate[0] = Backend::IL::BitCastToUnsigned(oob, _instr->index);
-                    msg.detail.coordinate[1] = zero;
-                    msg.detail.coordinate[2] = zero;
-                    break;
-                }
-                case IL::OpCode::StoreTexture: {
-                    auto _instr = instr->As<IL::StoreTextureInstruction>();
-                    msg.detail.token = IL::ResourceTokenEmitter(oob, _instr->texture).GetPackedToken();
-
-                    // Vectorized index?
-                    if (const Backend::IL::Type* indexType = program.GetTypeMap().GetType(_instr->index); indexType->Is<Backend::IL::VectorType>()) {
-                        const uint32_t dimension = indexType->As<Backend::IL::VectorType>()->dimension;
-
-                        msg.detail.coordinate[0] = Backend::IL::BitCastToUnsigned(oob, oob.Extract(_instr->index, program.GetConstants().UInt(0)->id));
-                        msg.detail.coordinate[1] = dimension > 1 ? Backend::IL::BitCastToUnsigned(oob, oob.Extract(_instr->index, program.GetConstants().UInt(1)->id)) : zero;
-                        msg.detail.coordinate[2] = dimension > 2 ? Backend::IL::BitCastToUnsigned(oob, oob.Extract(_instr->index, program.GetConstants().UInt(2)->id)) : zero;
-                    } else {
-                        msg.detail.coordinate[0] = Backend::IL::BitCastToUnsigned(oob, _instr->index);
-                        msg.detail.coordinate[1] = zero;
-                        msg.detail.coordinate[2] = zero;
-                    }
-                    break;
-                }
-                case IL::OpCode::LoadTexture: {
-                    auto _instr = instr->As<IL::LoadTextureInstruction>();
-                    msg.detail.token = IL::ResourceTokenEmitter(oob, _instr->texture).GetPackedToken();
-
-                    // Vectorized index?
-                    if (const Backend::IL::Type* indexType = program.GetTypeMap().GetType(_instr->index); indexType->Is<Backend::IL::VectorType>()) {
-                        const uint32_t dimension = indexType->As<Backend::IL::VectorType>()->dimension;
-
-                        msg.detail.coordinate[0] = Backend::IL::BitCastToUnsigned(oob, oob.Extract(_instr->index, program.GetConstants().UInt(0)->id));
-                        msg.detail.coordinate[1] = dimension > 1 ? Backend::IL::BitCastToUnsigned(oob, oob.Extract(_instr->index, program.GetConstants().UInt(1)->id)) : zero;
-                        msg.detail.coordinate[2] = dimension > 2 ? Backend::IL::BitCastToUnsigned(oob, oob.Extract(_instr->index, program.GetConstants().UInt(2)->id)) : zero;
-                    } else {
-                        msg.detail.coordinate[0] = Backend::IL::BitCastToUnsigned(oob, _instr->index);
-                        msg.detail.coordinate[1] = zero;
-                        msg.detail.coordinate[2] = zero;
-                    }
-                    break;
-                }
+            // Get the index of the op code
+            IL::ID index = GetIndex(context.instr);
+
+            // Vectorized index?
+            if (const Backend::IL::Type* indexType = context.program.GetTypeMap().GetType(index); indexType->Is<Backend::IL::VectorType>()) {
+                const uint32_t dimension = indexType->As<Backend::IL::VectorType>()->dimension;
+
+                msg.detail.coordinate[0] = Backend::IL::BitCastToUnsigned(oob, oob.Extract(index, context.program.GetConstants().UInt(0)->id));
+                msg.detail.coordinate[1] = dimension > 1 ? Backend::IL::BitCastToUnsigned(oob, oob.Extract(index, context.program.GetConstants().UInt(1)->id)) : zero;
+                msg.detail.coordinate[2] = dimension > 2 ? Backend::IL::BitCastToUnsigned(oob, oob.Extract(index, context.program.GetConstants().UInt(2)->id)) : zero;
+            } else {
+                msg.detail.coordinate[0] = Backend::IL::BitCastToUnsigned(oob, index);
+                msg.detail.coordinate[1] = zero;
+                msg.detail.coordinate[2] = zero;
             }
         }
 
         // Export the message
         oob.Export(exportID, msg);
+    }
 
-        // Branch back
-        oob.Branch(resumeBlock);
-
-        // Perform instrumentation check
-        IL::Emitter<> pre(program, context.basicBlock);
+public:
+    /// Get the resource of an instruction
+    static IL::ID GetResource(const IL::Instruction* instr) {
+        switch (instr->opCode) {
+            default:
+                ASSERT(false, "Unexpected opcode");
+                return IL::InvalidID;
+            case IL::OpCode::StoreBuffer:
+                return instr->As<IL::StoreBufferInstruction>()->buffer;
+            case IL::OpCode::LoadBuffer:
+                return instr->As<IL::LoadBufferInstruction>()->buffer;
+            case IL::OpCode::StoreBufferRaw:
+                return instr->As<IL::StoreBufferRawInstruction>()->buffer;
+            case IL::OpCode::LoadBufferRaw:
+                return instr->As<IL::LoadBufferRawInstruction>()->buffer;
+            case IL::OpCode::StoreTexture:
+                return instr->As<IL::StoreTextureInstruction>()->texture;
+            case IL::OpCode::LoadTexture:
+                return instr->As<IL::LoadTextureInstruction>()->texture;
+        }
+    }
 
-        // Is any of the indices larger than the resource size
-        IL::ID cond{};
+    /// Get the index of an instruction
+    static IL::ID GetIndex(const IL::Instruction* instr) {
         switch (instr->opCode) {
             default:
                 ASSERT(false, "Unexpected opcode");
-                break;
-            case IL::OpCode::StoreBuffer: {
-                auto* storeBuffer = instr->As<IL::StoreBufferInstruction>();
-                cond = pre.Any(pre.GreaterThanEqual(pre.BitCast(storeBuffer->index, SplatToValue(program, uint32Type, storeBuffer->index)), pre.ResourceSize(storeBuffer->buffer)));
-                break;
-            }
-            case IL::OpCode::LoadBuffer: {
-                auto* loadBuffer = instr->As<IL::LoadBufferInstruction>();
-                cond = pre.Any(pre.GreaterThanEqual(pre.BitCast(loadBuffer->index, SplatToValue(program, uint32Type, loadBuffer->index)), pre.ResourceSize(loadBuffer->buffer)));
-                break;
-            }
-            case IL::OpCode::StoreBufferRaw: {
-                auto* storeBuffer = instr->As<IL::StoreBufferRawInstruction>();
-                cond = pre.Any(pre.GreaterThanEqual(pre.BitCast(storeBuffer->index, SplatToValue(program, uint32Type, storeBuffer->index)), pre.ResourceSize(storeBuffer->buffer)));
-                break;
+                return IL::InvalidID;
+            case IL::OpCode::StoreBuffer:
+                return instr->As<IL::StoreBufferInstruction>()->index;
+            case IL::OpCode::LoadBuffer:
+                return instr->As<IL::LoadBufferInstruction>()->index;
+            case IL::OpCode::StoreBufferRaw:
+                return instr->As<IL::StoreBufferRawInstruction>()->index;
+            case IL::OpCode::LoadBufferRaw:
+                return instr->As<IL::LoadBufferRawInstruction>()->index;
+            case IL::OpCode::StoreTexture:
+                return instr->As<IL::StoreTextureInstruction>()->index;
+            case IL::OpCode::LoadTexture:
+                return instr->As<IL::LoadTextureInstruction>()->index;
+        }
+    }
+
+private:
+    /// Export id of the feature
+    ShaderExportID exportID;
+
+    /// Bound sguid
+    ShaderSGUID sguid;
+
+    /// Operation details
+    bool isTexture;
+    bool isWrite;
+
+    /// Detailed instrumentation?
+    bool detail;
+
+    /// Shared token, only fetched for detailed instrumentation
+    IL::ID packedToken{IL::InvalidID};
+};
+
+void ResourceBoundsFeature::PreInject(IL::Program &program, const MessageStreamView<> &specialization) {
+    // Create data
+    ComRef data = program.GetRegistry().AddNew<ElisionData>();
+
+    // Collect all redundant checks before any injection
+    for (IL::Function *function: program.GetFunctionList()) {
+        // Skip non-instrumented functions
+        if (function->HasFlag(FunctionFlag::NoInstrumentation)) {
+            continue;
+        }
+
+        CollectElidedChecks(program, *function, data);
+    }
+}
+
+void ResourceBoundsFeature::CollectElidedChecks(IL::Program &program, IL::Function &function, const ComRef<ElisionData>& data) {
+    // Bounds checks are not statically elided against resource extents, as extents are unknown at compilation.
+    // However, a check is redundant if a dominating check of the same kind, on the same resource, covers the index.
+    // If the dominating check passes, the dominated index is provably in bounds. If it fails, the dominated access
+    // may be out of bounds as well, so this is only valid if both share the same source location, as messages are
+    // reported per source location. Typically inlined or unrolled code.
+
+    // Source locations are needed for elision
+    if (!sguidHost) {
+        return;
+    }
+
+    // Compute value ranges, identifier based and therefore safe to keep past injection
+    ComRef valueRangeAnalysis = function.GetAnalysisMap().FindPassOrCompute<IL::ValueRangeAnalysis>(program, function);
+    if (!valueRangeAnalysis) {
+        return;
+    }
+
+    // Compute dominance analysis
+    // Not added to the function analysis map, as injection invalidates the control flow
+    IL::DominatorAnalysis dominatorAnalysis(function);
+    if (!dominatorAnalysis.Compute()) {
+        return;
+    }
+
+    struct Access {
+        /// Source block
+        const IL::BasicBlock* block{nullptr};
+
+        /// Instruction order within the block
+        uint32_t order{0};
+
+        /// Instruction info
+        IL::BasicBlock::ConstIterator it;
+        const IL::Instruction* instr{nullptr};
+        IL::ID index{IL::InvalidID};
+        bool isTexture{false};
+        bool isWrite{false};
+    };
+
+    // All bounds checked accesses, per resource
+    std::unordered_map<IL::ID, std::vector<Access>> resourceAccesses;
+
+    // Collect all accesses in reachable blocks
+    for (const IL::BasicBlock* block : dominatorAnalysis.GetPostOrderTraversal().GetView()) {
+        if (block->HasFlag(BasicBlockFlag::NoInstrumentation)) {
+            continue;
+        }
+
+        uint32_t order = 0;
+        for (auto it = block->begin(); it != block->end(); ++it) {
+            const IL::Instruction* instr = it.Get();
+            order++;
+
+            // Only consider instructions with a known source
+            if (!instr->source.HasNonSymbolicCodeOffset()) {
+                continue;
             }
-            case IL::OpCode::LoadBufferRaw: {
-                auto* loadBuffer = instr->As<IL::LoadBufferRawInstruction>();
-                cond = pre.Any(pre.GreaterThanEqual(pre.BitCast(loadBuffer->index, SplatToValue(program, uint32Type, loadBuffer->index)), pre.ResourceSize(loadBuffer->buffer)));
-                break;
+
+            // Bounds checked?
+            Access access;
+            if (!IsBoundsCheckedInstruction(program, instr, access.isTexture, access.isWrite)) {
+                continue;
             }
-            case IL::OpCode::StoreTexture: {
-                auto* storeTexture = instr->As<IL::StoreTextureInstruction>();
 
-                // Get texture type
-                auto type = program.GetTypeMap().GetType(storeTexture->texture)->As<Backend::IL::TextureType>();
+            // Fill remaining info
+            access.block = block;
+            access.order = order;
+            access.it = it;
+            access.instr = instr;
+            access.index = ResourceBoundsGuardCheck::GetIndex(instr);
+            resourceAccesses[ResourceBoundsGuardCheck::GetResource(instr)].push_back(access);
+        }
+    }
 
-                // Type of the index
-                const Backend::IL::Type *indexType = SplatToValue(program, uint32Type, storeTexture->index);
-                
-                // Store instructions have special considerations for cube arrays
-                // Size queries only report the width/height, so assume 6 faces (3d)
-                IL::ID size = pre.ResourceSize(storeTexture->texture);
-                if (type->dimension == Backend::IL::TextureDimension::Texture2DCube) {
-                    size = pre.Construct(
-                        indexType,
-                        pre.Extract(size, pre.UInt32(0)).GetID(),
-                        pre.Extract(size, pre.UInt32(1)).GetID(),
-                        pre.UInt32(6)
-                    );
+    // Elided sources of this function
+    std::unordered_set<uint32_t>& sources = data->functionSources[function.GetID()];
+
+    // Source location of an access, (file, line, column)
+    using SourceLocation = std::tuple<uint32_t, uint32_t, uint32_t>;
+
+    // All bound source locations
+    std::unordered_map<const IL::Instruction*, SourceLocation> locations;
+
+    // Get the source location of an access, bound lazily as binding allocates a guid
+    auto getLocation = [&](const Access& access) -> SourceLocation {
+        if (auto it = locations.find(access.instr); it != locations.end()) {
+            return it->second;
+        }
+
+        // Unknown locations are left empty
+        SourceLocation location{};
+        if (ShaderSGUID sguid = sguidHost->Bind(program, access.it); sguid != InvalidShaderSGUID) {
+            ShaderSourceMapping mapping = sguidHost->GetMapping(sguid);
+            location = SourceLocation(static_cast<uint32_t>(mapping.fileUID), static_cast<uint32_t>(mapping.line), static_cast<uint32_t>(mapping.column));
+        }
+
+        locations[access.instr] = location;
+        return location;
+    };
+
+    // Check all accesses against all other accesses on the same resource
+    for (auto&& [resource, accesses] : resourceAccesses) {
+        for (const Access& access : accesses) {
+            for (const Access& dominator : accesses) {
+                // Must be of the same kind, reported messages are distinct
+                if (&access == &dominator || access.isTexture != dominator.isTexture || access.isWrite != dominator.isWrite) {
+                    continue;
+                }
+
+                // Must strictly dominate the access
+                if (access.block == dominator.block ? dominator.order >= access.order : !dominatorAnalysis.Dominates(dominator.block, access.block)) {
+                    continue;
+                }
+
+                // Texture coordinates must match exactly, buffer indices must be provably covered
+                if (access.isTexture ? access.index != dominator.index : !valueRangeAnalysis->IsLessThanEqual(access.index, dominator.index)) {
+                    continue;
                 }
 
-                cond = pre.Any(pre.GreaterThanEqual(pre.BitCast(storeTexture->index, indexType), size));
+                // Must report at the same source location, otherwise the dominated report is lost
+                // Unknown locations are never merged
+                SourceLocation location = getLocation(access);
+                if (location == SourceLocation{} || location != getLocation(dominator)) {
+                    continue;
+                }
+
+                // Redundant, dominating checks are never elided by the same access, so this is acyclic
+                sources.insert(access.instr->source.codeOffset);
                 break;
             }
-            case IL::OpCode::LoadTexture: {
-                auto* loadTexture = instr->As<IL::LoadTextureInstruction>();
-                cond = pre.Any(pre.GreaterThanEqual(pre.BitCast(loadTexture->index, SplatToValue(program, uint32Type, loadTexture->index)), pre.ResourceSize(loadTexture->texture)));
-                break;
+        }
+    }
+}
+
+void ResourceBoundsFeature::PlanGuards(IL::GuardPlan &plan, IL::Program &program, const MessageStreamView<> &specialization) {
+    // Options
+    const SetInstrumentationConfigMessage config = CollapseOrDefault<SetInstrumentationConfigMessage>(specialization);
+
+    // Get data
+    ComRef data = program.GetRegistry().Get<ElisionData>();
+
+    // Register the bounds checks, fused with all other guards on the same instruction
+    plan.Add([this, data, detail = config.detail](IL::Program& program, IL::Function& function, const IL::BasicBlock::Iterator& it, IL::GuardCheckList& checks) {
+        bool isTexture;
+        bool isWrite;
+
+        // Instruction of interest?
+        if (!IsBoundsCheckedInstruction(program, it.Get(), isTexture, isWrite)) {
+            return;
+        }
+
+        // Provably redundant?
+        if (data && it->source.HasNonSymbolicCodeOffset()) {
+            if (auto sources = data->functionSources.find(function.GetID()); sources != data->functionSources.end() && sources->second.contains(it->source.codeOffset)) {
+                return;
             }
         }
 
-        // If so, branch to failure, otherwise resume
-        pre.BranchConditional(cond, oob.GetBasicBlock(), resumeBlock, IL::ControlFlow::Selection(resumeBlock));
-        return instr;
+        // Bind the SGUID
+        ShaderSGUID sguid = sguidHost ? sguidHost->Bind(program, it) : InvalidShaderSGUID;
+
+        // Add check
+        checks.push_back(std::make_unique<ResourceBoundsGuardCheck>(exportID, sguid, isTexture, isWrite, detail));
     });
 }
 
@@ -0,0 +1,92 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+//! KERNEL   Compute "main"
+//! DISPATCH 4, 1, 1
+
+//! SCHEMA "Schemas/Features/ResourceBounds.h"
+
+//! RESOURCE RWBuffer<R32Float> size:64
+[[vk::binding(0)]] RWBuffer<float> bufferRW : register(u0, space0);
+
+/**
+ * Checks are only elided when covered by a dominating check at the same source
+ * location, message counts per line are therefore the number of non-elided checks
+ */
+
+float Read(uint index) {
+    // Two inlined reads, the second is covered by the first and elided
+    //! CHECK   "Read from buffer 'bufferRW' out of bounds"
+    //! MESSAGE ResourceIndexOutOfBounds[4] isTexture:0 isWrite:0
+    return bufferRW[index];
+}
+
+void Write(uint index, float value) {
+    // Two inlined writes, the second is not covered by the first
+    //! CHECK   "Write into buffer 'bufferRW' out of bounds"
+    //! MESSAGE ResourceIndexOutOfBounds[8] isTexture:0 isWrite:1
+    bufferRW[index] = value;
+}
+
+[numthreads(1, 1, 1)]
+void main(uint dtid : SV_DispatchThreadID) {
+	float noOpt = 0.0f;
+
+    // Same source location, covered
+	noOpt += Read(128 + (dtid.x & 1));
+	noOpt += Read(64 + (dtid.x & 3));
+
+    // Same source location, not covered
+	Write(128 + (dtid.x & 1), noOpt);
+	Write(256 + (dtid.x & 1), noOpt);
+
+    //! CHECK   "Read from buffer 'bufferRW' out of bounds"
+    //! MESSAGE ResourceIndexOutOfBounds[4] isTexture:0 isWrite:0
+	noOpt += bufferRW[128 + (dtid.x & 1)];
+
+    // Covered by the dominating read, but reported at a different source location
+    //! CHECK   "Read from buffer 'bufferRW' out of bounds"
+    //! MESSAGE ResourceIndexOutOfBounds[4] isTexture:0 isWrite:0
+	noOpt += bufferRW[64 + (dtid.x & 3)];
+
+    // In bounds
+	noOpt += bufferRW[dtid.x & 31];
+
+    // Writes are not covered by reads
+    //! CHECK   "Write into buffer 'bufferRW' out of bounds"
+    //! MESSAGE ResourceIndexOutOfBounds[4] isTexture:0 isWrite:1
+	bufferRW[128 + (dtid.x & 1)] = noOpt;
+
+    // Not dominated by any write
+    if (dtid.x > 1) {
+        //! CHECK   "Write into buffer 'bufferRW' out of bounds"
+        //! MESSAGE ResourceIndexOutOfBounds[2] isTexture:0 isWrite:1
+        bufferRW[512 + dtid.x] = noOpt;
+    }
+
+    // In bounds
+	bufferRW[dtid.x & 31] = noOpt;
+}
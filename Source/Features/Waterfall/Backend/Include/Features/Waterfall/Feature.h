@@ -44,6 +44,7 @@
 
 namespace IL {
     struct VisitContext;
+    class SimulationAnalysis;
 }
 
 // Forward declarations
@@ -85,6 +86,9 @@ private:
 
         /// The originating blocks of an instruction id
         std::unordered_map<IL::ID, IL::ID> instructionSourceBlocks;
+
+        /// Simulation analysis per function, computed on the source program
+        std::unordered_map<IL::ID, ComRef<IL::SimulationAnalysis>> simulationAnalyses;
     };
     
     /// Inject waterfall checks to address chains
@@ -80,19 +80,37 @@ void WaterfallFeature::CollectMessages(IMessageStorage *storage) {
 }
 
 void WaterfallFeature::PreInject(IL::Program &program, const MessageStreamView<> &specialization) {
-    // Set up function simulators with divergence analysis
-    for (IL::Function *function: program.GetFunctionList()) {
-        if (auto&& analysis = function->GetAnalysisMap().FindPassOrAdd<IL::SimulationAnalysis>(program, *function)) {
-            analysis->AddPropagator<IL::DivergencePropagator>(analysis->GetConstantPropagator(), program, *function);
-        }
-    }
-    
-    // Compute interprocedural analysis
-    program.GetAnalysisMap().FindPassOrCompute<IL::InterproceduralSimulationAnalysis>(program);
-
     // Create data
     ComRef data = program.GetRegistry().AddNew<SharedData>();
 
+    // Simulation only depends on the user program, not the instrumentation key, so
+    // compute it once on the source program and share it across all instrumented copies
+    {
+        std::lock_guard guard(program.GetSourceAnalysisMutex());
+        IL::Program& source = program.GetSourceProgram();
+
+        // Analyses are simulated by the interprocedural pass, keep them local until then
+        std::unordered_map<IL::ID, ComRef<IL::SimulationAnalysis>> analyses;
+        
+        // Set up function simulators with divergence analysis
+        for (IL::Function *function: source.GetFunctionList()) {
+            if (auto&& analysis = function->GetAnalysisMap().FindPassOrAdd<IL::SimulationAnalysis>(source, *function)) {
+                // May already be set up by a previous copy
+                if (!analysis->FindPropagator<IL::DivergencePropagator>()) {
+                    analysis->AddPropagator<IL::DivergencePropagator>(analysis->GetConstantPropagator(), source, *function);
+                }
+
+                analyses[function->GetID()] = analysis;
+            }
+        }
+
+        // Compute interprocedural analysis
+        // Only publish complete analyses, these are never modified again, so injection reads them without the lock
+        if (source.GetAnalysisMap().FindPassOrCompute<IL::InterproceduralSimulationAnalysis>(source)) {
+            data->simulationAnalyses = std::move(analyses);
+        }
+    }
+
     // Map all instructions of interest to their source blocks
     IL::VisitUserInstructions(program, [&](IL::VisitContext& context, IL::BasicBlock::Iterator it) -> IL::BasicBlock::Iterator {
         switch (it->opCode) {
@@ -150,8 +168,14 @@ IL::BasicBlock::Iterator WaterfallFeature::InjectAddressChain(IL::Program& progr
         return it;
     }
 
-    // Get the pre-injection analysis
-    ComRef simulationAnalysis = context.function.GetAnalysisMap().FindPass<IL::SimulationAnalysis>();
+    // Get the pre-injection analysis, functions not originating from the source are never simulated
+    auto simulationIt = data->simulationAnalyses.find(context.function.GetID());
+    if (simulationIt == data->simulationAnalyses.end()) {
+        return it;
+    }
+
+    // Get the simulation
+    const ComRef<IL::SimulationAnalysis>& simulationAnalysis = simulationIt->second;
 
     // Get the constant analysis
     const IL::ConstantPropagator& constantPropagator = simulationAnalysis->GetConstantPropagator();
@@ -333,8 +357,14 @@ IL::ID WaterfallFeature::InjectRuntimeDivergenceVisitor(IL::Program& program, IL
 IL::BasicBlock::Iterator WaterfallFeature::InjectExtract(IL::Program &program, const ComRef<SharedData>& data, IL::VisitContext &context, IL::BasicBlock::Iterator it) {
     auto* instr = it->As<IL::ExtractInstruction>();
 
-    // Get the pre-injection analysis
-    ComRef simulationAnalysis = context.function.GetAnalysisMap().FindPass<IL::SimulationAnalysis>();
+    // Get the pre-injection analysis, functions not originating from the source are never simulated
+    auto simulationIt = data->simulationAnalyses.find(context.function.GetID());
+    if (simulationIt == data->simulationAnalyses.end()) {
+        return it;
+    }
+
+    // Get the simulation
+    const ComRef<IL::SimulationAnalysis>& simulationAnalysis = simulationIt->second;
 
     // Get the constant analysis
     const IL::ConstantPropagator& constantPropagator = simulationAnalysis->GetConstantPropagator();
@@ -29,6 +29,9 @@
 // Backend
 #include <Common/Delegate.h>
 
+// Std
+#include <cstdint>
+
 // Forward declarations
 class CommandContext;
 
@@ -50,6 +53,91 @@ struct TFeatureHook<R(A...)> {
     Hook hook;
 };
 
+/// Compiled feature dispatch, dense list of the active feature bits of a hook
+struct FeatureHookDispatch {
+    /// Active feature bits, in invocation order
+    uint8_t indices[64];
+
+    /// Number of active features
+    uint32_t count{0};
+};
+
+/// Span feature hook, derived type must implement operator() and invoke all dispatched hooks once per command
+/// \tparam E the per element delegate
+/// \tparam S the span delegate
+template<typename E, typename S>
+struct TFeatureSpanHook {
+    /// Marks span hooks
+    static constexpr bool kIsSpan = true;
+
+    /// Per feature hooks
+    struct Hook {
+        /// Per element hook, required if the span hook is not set
+        E element;
+
+        /// Span hook, preferred if set
+        S span;
+
+        /// Does this feature hook anything?
+        bool IsValid() const {
+            return element.IsValid() || span.IsValid();
+        }
+    };
+
+    /// Invoke all dispatched hooks over a set of spans
+    /// \param context the command context
+    /// \param count number of elements in each span
+    /// \param spans all spans, each of length count
+    template<typename... T>
+    void InvokeSpan(CommandContext* context, uint32_t count, const T*... spans) const {
+        for (uint32_t i = 0; i < dispatch->count; i++) {
+            const Hook& featureHook = hooks[dispatch->indices[i]];
+
+            // Span aware feature?
+            if (featureHook.span.IsValid()) {
+                featureHook.span.Invoke(context, spans..., count);
+                continue;
+            }
+
+            // Fall back to per element invocation
+            for (uint32_t elementIndex = 0; elementIndex < count; elementIndex++) {
+                featureHook.element.Invoke(context, spans[elementIndex]...);
+            }
+        }
+    }
+
+    /// All feature hooks, indexed by feature bit
+    const Hook* hooks{nullptr};
+
+    /// Compiled dispatch
+    const FeatureHookDispatch* dispatch{nullptr};
+};
+
+/// Check if a feature hook is a span hook
+template<typename T>
+concept IsFeatureSpanHook = requires {
+    T::kIsSpan;
+};
+
+/// Compile the dispatch of a feature hook
+/// \param dispatch the destination dispatch
+/// \param featureBitSet the active bit set
+inline void CompileFeatureHookDispatch(FeatureHookDispatch& dispatch, uint64_t featureBitSet) {
+    dispatch.count = 0;
+
+    // Current mask
+    uint64_t bitMask = featureBitSet;
+
+    // Scan for all set hooks, same order as the uncompiled application
+    unsigned long index;
+    while (_BitScanReverse64(&index, bitMask)) {
+        dispatch.indices[dispatch.count++] = static_cast<uint8_t>(index);
+
+        // Next!
+        bitMask &= ~(1ull << index);
+    }
+}
+
 /// Apply a given feature hook
 /// \tparam T the feature typename, see the specification above
 /// \param featureBitSet the active bit set
@@ -80,3 +168,31 @@ inline bool ApplyFeatureHook(O* object, CommandContext* context, uint64_t featur
     return true;
 }
 
+/// Apply a given feature hook from a compiled dispatch
+/// \tparam T the feature typename, see the specification above
+/// \param dispatch the compiled dispatch
+/// \param featureHooks the feature hooks registered
+/// \param args all hook arguments
+template<typename T, typename O, typename... A>
+inline bool ApplyFeatureHook(O* object, CommandContext* context, const FeatureHookDispatch& dispatch, typename T::Hook featureHooks[64], A... args) {
+    // Early out if empty
+    if (!dispatch.count)
+        return false;
+
+    // Span hooks are invoked once for all features
+    if constexpr (IsFeatureSpanHook<T>) {
+        T handler;
+        handler.hooks = featureHooks;
+        handler.dispatch = &dispatch;
+        handler(object, context, args...);
+    } else {
+        for (uint32_t i = 0; i < dispatch.count; i++) {
+            T handler;
+            handler.hook = featureHooks[dispatch.indices[i]];
+            handler(object, context, args...);
+        }
+    }
+
+    // OK
+    return true;
+}
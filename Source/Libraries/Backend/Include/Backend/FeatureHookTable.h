@@ -64,6 +64,11 @@ namespace Hooks {
     using WriteResource = Delegate<void(CommandContext* context, const ResourceInfo& resource)>;
     using DiscardResource = Delegate<void(CommandContext* context, const ResourceInfo& resource)>;
 
+    /// Resource spans, all regions of a command in a single invocation
+    using CopyResources = Delegate<void(CommandContext* context, const ResourceInfo* sources, const ResourceInfo* dests, uint32_t count)>;
+    using ResolveResources = Delegate<void(CommandContext* context, const ResourceInfo* sources, const ResourceInfo* dests, uint32_t count)>;
+    using ClearResources = Delegate<void(CommandContext* context, const ResourceInfo* resources, uint32_t count)>;
+
     /// Render pass
     using BeginRenderPass = Delegate<void(CommandContext* context, const RenderPassInfo& passInfo)>;
     using EndRenderPass = Delegate<void(CommandContext* context)>;
@@ -96,6 +101,11 @@ public:
     Hooks::WriteResource writeResource;
     Hooks::DiscardResource discardResource;
 
+    /// Resource spans, optional, backends supporting spans prefer these over the per region hooks
+    Hooks::CopyResources copyResources;
+    Hooks::ResolveResources resolveResources;
+    Hooks::ClearResources clearResources;
+
     /// Render pass
     Hooks::BeginRenderPass beginRenderPass;
     Hooks::EndRenderPass endRenderPass;
@@ -0,0 +1,703 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Backend
+#include <Backend/IL/Program.h>
+#include <Backend/IL/InstructionCommon.h>
+#include <Backend/IL/Analysis/CFG/DominatorAnalysis.h>
+#include <Backend/IL/Analysis/CFG/LoopAnalysis.h>
+#include <Backend/IL/Analysis/ValueRangeAnalysis.h>
+
+// Std
+#include <unordered_map>
+#include <unordered_set>
+#include <optional>
+#include <vector>
+
+namespace IL {
+    /// Loop trip count analysis
+    ///   Recognizes induction variables, either as header phis or as function variables with a single
+    ///   per-iteration increment, and bounds the number of iterations from the exit conditions.
+    ///   Integral comparisons in the IL do not carry signedness (DXIL erases it), so a loop is only considered
+    ///   bounded if its induction variable provably stays non-negative, where both interpretations agree.
+    class LoopTripCountAnalysis : public IFunctionAnalysis {
+    public:
+        COMPONENT(LoopTripCountAnalysis);
+
+        /// Constructor
+        /// \param program the owning program
+        /// \param function the function to compute the trip counts for
+        LoopTripCountAnalysis(Program& program, Function& function) : program(program), function(function) {
+
+        }
+
+        /// Compute all trip counts
+        bool Compute() override {
+            // Compute loop analysis
+            if (loopAnalysis = function.GetAnalysisMap().FindPassOrCompute<LoopAnalysis>(function); !loopAnalysis) {
+                return false;
+            }
+
+            // Compute dominance analysis
+            if (dominatorAnalysis = function.GetAnalysisMap().FindPassOrCompute<DominatorAnalysis>(function); !dominatorAnalysis) {
+                return false;
+            }
+
+            // Compute value ranges
+            if (valueRangeAnalysis = function.GetAnalysisMap().FindPassOrCompute<ValueRangeAnalysis>(program, function); !valueRangeAnalysis) {
+                return false;
+            }
+
+            // Nothing to bound?
+            if (loopAnalysis->GetView().empty()) {
+                return true;
+            }
+
+            // Map all definitions and variable accesses
+            MapDefinitions();
+
+            // Bound all loops
+            for (const Loop& loop : loopAnalysis->GetView()) {
+                if (std::optional<uint64_t> tripCount = ComputeTripCount(loop)) {
+                    tripCounts[loop.header->GetID()] = tripCount.value();
+                }
+            }
+
+            // Definitions are only valid during computation
+            definitions.clear();
+            variables.clear();
+
+            // OK
+            return true;
+        }
+
+        /// Get the maximum trip count of a loop
+        /// \param header the loop header
+        /// \return empty if unbounded
+        std::optional<uint64_t> GetMaxTripCount(const BasicBlock* header) const {
+            if (auto it = tripCounts.find(header->GetID()); it != tripCounts.end()) {
+                return it->second;
+            }
+
+            // Unbounded
+            return {};
+        }
+
+    private:
+        struct Definition {
+            /// Source block
+            const BasicBlock* block{nullptr};
+
+            /// Order within the block
+            uint32_t order{0};
+
+            /// Defining instruction
+            const Instruction* instr{nullptr};
+        };
+
+        struct Variable {
+            /// All stores to this variable
+            std::vector<Definition> stores;
+
+            /// Has the address escaped, i.e. used by anything but loads and stores
+            bool escaped{false};
+        };
+
+        struct Induction {
+            /// Range of the value on entry
+            ValueRange entry;
+
+            /// Signed step per iteration
+            int64_t step{0};
+        };
+
+        /// Comparison relation, the loop continues while the induction value satisfies it
+        enum class Relation {
+            Less,
+            LessEqual,
+            Greater,
+            GreaterEqual
+        };
+
+        /// Map all definitions and variable accesses
+        void MapDefinitions() {
+            for (const BasicBlock* block : function.GetBasicBlocks()) {
+                uint32_t order = 0;
+                for (const Instruction* instr : *block) {
+                    Definition definition{.block = block, .order = order++, .instr = instr};
+
+                    // Track all function variables
+                    switch (instr->opCode) {
+                        default: {
+                            Backend::IL::VisitOperands(instr, [&](ID operand) {
+                                if (auto it = variables.find(operand); it != variables.end()) {
+                                    it->second.escaped = true;
+                                }
+                            });
+                            break;
+                        }
+                        case OpCode::Alloca: {
+                            variables[instr->result] = {};
+                            break;
+                        }
+                        case OpCode::Load: {
+                            break;
+                        }
+                        case OpCode::Store: {
+                            auto _instr = instr->As<StoreInstruction>();
+                            if (auto it = variables.find(_instr->address); it != variables.end()) {
+                                it->second.stores.push_back(definition);
+                            }
+
+                            // Storing the address itself escapes it
+                            if (auto it = variables.find(_instr->value); it != variables.end()) {
+                                it->second.escaped = true;
+                            }
+                            break;
+                        }
+                    }
+
+                    // Map the result
+                    if (instr->result != InvalidID) {
+                        definitions[instr->result] = definition;
+                    }
+                }
+            }
+        }
+
+        /// Check if a block dominates another, or is the same block
+        bool DominatesOrEqual(const BasicBlock* first, const BasicBlock* second) const {
+            return first == second || dominatorAnalysis->Dominates(first, second);
+        }
+
+        /// Check if a block is executed on every iteration of a loop
+        bool IsExecutedPerIteration(const Loop& loop, const BasicBlock* block) const {
+            for (const BasicBlock* backEdge : loop.backEdgeBlocks) {
+                if (!DominatesOrEqual(block, backEdge)) {
+                    return false;
+                }
+            }
+
+            // OK
+            return true;
+        }
+
+        /// Check if a block is part of a loop
+        static bool IsInLoop(const Loop& loop, ID block) {
+            for (const BasicBlock* loopBlock : loop.blocks) {
+                if (loopBlock->GetID() == block) {
+                    return true;
+                }
+            }
+
+            // Not found
+            return false;
+        }
+
+        /// Find the definition of a value
+        const Definition* FindDefinition(ID id) const {
+            if (auto it = definitions.find(id); it != definitions.end()) {
+                return &it->second;
+            }
+
+            return nullptr;
+        }
+
+        /// Get the constant step of an increment
+        /// \param instr the increment instruction
+        /// \param value the value being incremented
+        /// \return empty if not an increment of value
+        std::optional<int64_t> GetStep(const Instruction* instr, ID value) const {
+            ID lhs;
+            ID rhs;
+
+            // Get operands
+            switch (instr->opCode) {
+                default:
+                    return {};
+                case OpCode::Add:
+                    lhs = instr->As<AddInstruction>()->lhs;
+                    rhs = instr->As<AddInstruction>()->rhs;
+                    break;
+                case OpCode::Sub:
+                    lhs = instr->As<SubInstruction>()->lhs;
+                    rhs = instr->As<SubInstruction>()->rhs;
+                    break;
+            }
+
+            // Additions are commutative
+            if (instr->opCode == OpCode::Add && rhs == value) {
+                std::swap(lhs, rhs);
+            }
+
+            // Must be an increment of the value
+            if (lhs != value) {
+                return {};
+            }
+
+            // Step must be constant
+            ValueRange step = valueRangeAnalysis->GetRange(rhs);
+            if (step.lower != step.upper || step.lower == 0) {
+                return {};
+            }
+
+            // Interpret as signed
+            auto signedStep = static_cast<int64_t>(static_cast<int32_t>(static_cast<uint32_t>(step.lower)));
+            return instr->opCode == OpCode::Add ? signedStep : -signedStep;
+        }
+
+        /// Offset an induction by a single step
+        static std::optional<Induction> Advance(const Induction& induction) {
+            Induction advanced = induction;
+
+            // Must not wrap
+            if (induction.step > 0) {
+                advanced.entry.lower += induction.step;
+                advanced.entry.upper += induction.step;
+            } else {
+                if (induction.entry.lower < static_cast<uint64_t>(-induction.step)) {
+                    return {};
+                }
+
+                advanced.entry.lower -= -induction.step;
+                advanced.entry.upper -= -induction.step;
+            }
+
+            // OK
+            return advanced;
+        }
+
+        /// Find the induction of a header phi
+        std::optional<Induction> FindPhiInduction(const Loop& loop, ID phi) const {
+            const Definition* definition = FindDefinition(phi);
+            if (!definition || definition->block != loop.header || definition->instr->opCode != OpCode::Phi) {
+                return {};
+            }
+
+            auto instr = definition->instr->As<PhiInstruction>();
+
+            // Entry ranges and the loop carried value
+            Induction induction;
+            induction.entry = ValueRange{.lower = UINT32_MAX, .upper = 0};
+            ID next = InvalidID;
+
+            // Check all incoming values
+            for (uint32_t i = 0; i < instr->values.count; i++) {
+                const PhiValue& value = instr->values[i];
+
+                // Entry value?
+                if (!IsInLoop(loop, value.branch)) {
+                    ValueRange range = valueRangeAnalysis->GetRange(value.value);
+                    induction.entry = ValueRange{.lower = std::min(induction.entry.lower, range.lower), .upper = std::max(induction.entry.upper, range.upper)};
+                    continue;
+                }
+
+                // All back-edges must carry the same value
+                if (next != InvalidID && next != value.value) {
+                    return {};
+                }
+
+                next = value.value;
+            }
+
+            // Must have both entry and loop carried values
+            if (next == InvalidID || induction.entry.lower > induction.entry.upper) {
+                return {};
+            }
+
+            // Loop carried value must be a constant step
+            const Definition* nextDefinition = FindDefinition(next);
+            if (!nextDefinition) {
+                return {};
+            }
+
+            // Get the step
+            std::optional<int64_t> step = GetStep(nextDefinition->instr, phi);
+            if (!step) {
+                return {};
+            }
+
+            // OK
+            induction.step = step.value();
+            return induction;
+        }
+
+        /// Find the induction of a function variable load
+        std::optional<Induction> FindVariableInduction(const Loop& loop, const Definition& load) const {
+            auto instr = load.instr->As<LoadInstruction>();
+
+            // Must be a non-escaping variable
+            auto variableIt = variables.find(instr->address);
+            if (variableIt == variables.end() || variableIt->second.escaped) {
+                return {};
+            }
+
+            // Entry ranges
+            Induction induction;
+            induction.entry = ValueRange{.lower = UINT32_MAX, .upper = 0};
+
+            // Single in-loop store
+            const Definition* increment = nullptr;
+
+            // Must be initialized prior to the loop
+            bool initialized = false;
+
+            // Check all stores
+            for (const Definition& store : variableIt->second.stores) {
+                auto storeInstr = store.instr->As<StoreInstruction>();
+
+                // Outside the loop?
+                if (!IsInLoop(loop, store.block->GetID())) {
+                    ValueRange range = valueRangeAnalysis->GetRange(storeInstr->value);
+                    induction.entry = ValueRange{.lower = std::min(induction.entry.lower, range.lower), .upper = std::max(induction.entry.upper, range.upper)};
+                    initialized |= dominatorAnalysis->Dominates(store.block, loop.header);
+                    continue;
+                }
+
+                // Only a single increment per iteration
+                if (increment) {
+                    return {};
+                }
+
+                increment = &store;
+            }
+
+            // Must be initialized and incremented on every iteration
+            if (!initialized || !increment || !IsExecutedPerIteration(loop, increment->block)) {
+                return {};
+            }
+
+            // Incremented value must be loaded from the variable, prior to the increment
+            const Definition* incrementValue = FindDefinition(increment->instr->As<StoreInstruction>()->value);
+            if (!incrementValue) {
+                return {};
+            }
+
+            // Find the incremented load, must be the variable in the same block
+            std::optional<int64_t> step;
+            Backend::IL::VisitOperands(incrementValue->instr, [&](ID operand) {
+                const Definition* operandDefinition = FindDefinition(operand);
+                if (step || !operandDefinition || operandDefinition->instr->opCode != OpCode::Load) {
+                    return;
+                }
+
+                // Same variable, prior to the increment?
+                if (operandDefinition->instr->As<LoadInstruction>()->address != instr->address ||
+                    operandDefinition->block != increment->block ||
+                    operandDefinition->order > increment->order) {
+                    return;
+                }
+
+                step = GetStep(incrementValue->instr, operand);
+            });
+
+            // Not an increment?
+            if (!step) {
+                return {};
+            }
+
+            induction.step = step.value();
+
+            // If the load happens after the increment, the loaded value is already advanced
+            bool isAdvanced = load.block == increment->block ? load.order > increment->order : dominatorAnalysis->Dominates(increment->block, load.block);
+            if (isAdvanced) {
+                return Advance(induction);
+            }
+
+            // OK
+            return induction;
+        }
+
+        /// Find the induction of a compared value
+        std::optional<Induction> FindInduction(const Loop& loop, ID value) const {
+            const Definition* definition = FindDefinition(value);
+            if (!definition) {
+                return {};
+            }
+
+            switch (definition->instr->opCode) {
+                default: {
+                    return {};
+                }
+                case OpCode::Phi: {
+                    return FindPhiInduction(loop, value);
+                }
+                case OpCode::Load: {
+                    return FindVariableInduction(loop, *definition);
+                }
+                case OpCode::Add:
+                case OpCode::Sub: {
+                    // Compared after the increment, i.e. the next value of a phi
+                    std::optional<Induction> induction;
+                    Backend::IL::VisitOperands(definition->instr, [&](ID operand) {
+                        if (induction) {
+                            return;
+                        }
+
+                        // Must be the same step as the phi induction, otherwise this is an unrelated offset
+                        if (std::optional<Induction> phiInduction = FindPhiInduction(loop, operand)) {
+                            if (std::optional<int64_t> step = GetStep(definition->instr, operand); step && step.value() == phiInduction->step) {
+                                induction = Advance(phiInduction.value());
+                            }
+                        }
+                    });
+
+                    return induction;
+                }
+            }
+        }
+
+        /// Compute the trip count of an induction against a bound
+        /// \param induction the induction value
+        /// \param relation the relation to continue on
+        /// \param bound the bound range
+        /// \return empty if unbounded
+        static std::optional<uint64_t> ComputeTripCount(const Induction& induction, Relation relation, const ValueRange& bound) {
+            // Induction must start non-negative
+            if (!induction.entry.IsNonNegative()) {
+                return {};
+            }
+
+            switch (relation) {
+                case Relation::Less:
+                case Relation::LessEqual: {
+                    // Must be an increasing induction
+                    if (induction.step <= 0) {
+                        return {};
+                    }
+
+                    // Must not exceed the non-negative range while iterating
+                    auto step = static_cast<uint64_t>(induction.step);
+                    if (bound.upper + step > INT32_MAX) {
+                        return {};
+                    }
+
+                    // Already out of range?
+                    if (bound.upper < induction.entry.lower) {
+                        return 0;
+                    }
+
+                    // Number of values in [entry, bound) or [entry, bound]
+                    uint64_t distance = bound.upper - induction.entry.lower;
+                    return relation == Relation::Less ? (distance + step - 1) / step : distance / step + 1;
+                }
+                case Relation::Greater:
+                case Relation::GreaterEqual: {
+                    // Must be a decreasing induction
+                    if (induction.step >= 0 || !bound.IsNonNegative()) {
+                        return {};
+                    }
+
+                    // Must not go negative while iterating
+                    auto step = static_cast<uint64_t>(-induction.step);
+                    if (relation == Relation::Greater ? bound.lower + 1 < step : bound.lower < step) {
+                        return {};
+                    }
+
+                    // Already out of range?
+                    if (induction.entry.upper < bound.lower) {
+                        return 0;
+                    }
+
+                    // Number of values in (bound, entry] or [bound, entry]
+                    uint64_t distance = induction.entry.upper - bound.lower;
+                    return relation == Relation::Greater ? (distance + step - 1) / step : distance / step + 1;
+                }
+            }
+
+            return {};
+        }
+
+        /// Compute the trip count of a loop condition
+        /// \param loop the loop
+        /// \param condition the condition
+        /// \param continueOn the condition value on which the loop continues
+        /// \return empty if unbounded
+        std::optional<uint64_t> ComputeConditionTripCount(const Loop& loop, ID condition, bool continueOn) const {
+            const Definition* definition = FindDefinition(condition);
+            if (!definition) {
+                return {};
+            }
+
+            ID lhs;
+            ID rhs;
+            Relation relation;
+
+            // Get the relation if the condition is true
+            switch (definition->instr->opCode) {
+                default: {
+                    return {};
+                }
+                case OpCode::And:
+                case OpCode::Or: {
+                    // Continuing on (a && b), or exiting on (a || b), requires both operands to hold
+                    auto lhsCondition = definition->instr->opCode == OpCode::And ? definition->instr->As<AndInstruction>()->lhs : definition->instr->As<OrInstruction>()->lhs;
+                    auto rhsCondition = definition->instr->opCode == OpCode::And ? definition->instr->As<AndInstruction>()->rhs : definition->instr->As<OrInstruction>()->rhs;
+                    if (continueOn != (definition->instr->opCode == OpCode::And)) {
+                        return {};
+                    }
+
+                    // Bounded by either
+                    std::optional<uint64_t> lhsCount = ComputeConditionTripCount(loop, lhsCondition, continueOn);
+                    std::optional<uint64_t> rhsCount = ComputeConditionTripCount(loop, rhsCondition, continueOn);
+                    if (lhsCount && rhsCount) {
+                        return std::min(lhsCount.value(), rhsCount.value());
+                    }
+                    return lhsCount ? lhsCount : rhsCount;
+                }
+                case OpCode::Not: {
+                    return ComputeConditionTripCount(loop, definition->instr->As<NotInstruction>()->value, !continueOn);
+                }
+                case OpCode::LessThan: {
+                    lhs = definition->instr->As<LessThanInstruction>()->lhs;
+                    rhs = definition->instr->As<LessThanInstruction>()->rhs;
+                    relation = Relation::Less;
+                    break;
+                }
+                case OpCode::LessThanEqual: {
+                    lhs = definition->instr->As<LessThanEqualInstruction>()->lhs;
+                    rhs = definition->instr->As<LessThanEqualInstruction>()->rhs;
+                    relation = Relation::LessEqual;
+                    break;
+                }
+                case OpCode::GreaterThan: {
+                    lhs = definition->instr->As<GreaterThanInstruction>()->lhs;
+                    rhs = definition->instr->As<GreaterThanInstruction>()->rhs;
+                    relation = Relation::Greater;
+                    break;
+                }
+                case OpCode::GreaterThanEqual: {
+                    lhs = definition->instr->As<GreaterThanEqualInstruction>()->lhs;
+                    rhs = definition->instr->As<GreaterThanEqualInstruction>()->rhs;
+                    relation = Relation::GreaterEqual;
+                    break;
+                }
+            }
+
+            // Continuing on false negates the relation
+            if (!continueOn) {
+                switch (relation) {
+                    case Relation::Less:
+                        relation = Relation::GreaterEqual;
+                        break;
+                    case Relation::LessEqual:
+                        relation = Relation::Greater;
+                        break;
+                    case Relation::Greater:
+                        relation = Relation::LessEqual;
+                        break;
+                    case Relation::GreaterEqual:
+                        relation = Relation::Less;
+                        break;
+                }
+            }
+
+            // Induction on the left hand side?
+            if (std::optional<Induction> induction = FindInduction(loop, lhs)) {
+                return ComputeTripCount(induction.value(), relation, valueRangeAnalysis->GetRange(rhs));
+            }
+
+            // Induction on the right hand side, mirror the relation
+            if (std::optional<Induction> induction = FindInduction(loop, rhs)) {
+                switch (relation) {
+                    case Relation::Less:
+                        relation = Relation::Greater;
+                        break;
+                    case Relation::LessEqual:
+                        relation = Relation::GreaterEqual;
+                        break;
+                    case Relation::Greater:
+                        relation = Relation::Less;
+                        break;
+                    case Relation::GreaterEqual:
+                        relation = Relation::LessEqual;
+                        break;
+                }
+
+                return ComputeTripCount(induction.value(), relation, valueRangeAnalysis->GetRange(lhs));
+            }
+
+            // Not an induction
+            return {};
+        }
+
+        /// Compute the trip count of a loop
+        /// \param loop the loop
+        /// \return empty if unbounded
+        std::optional<uint64_t> ComputeTripCount(const Loop& loop) const {
+            std::optional<uint64_t> tripCount;
+
+            // Any exit executed on every iteration bounds the loop
+            for (const BasicBlock* block : loop.blocks) {
+                if (!IsExecutedPerIteration(loop, block)) {
+                    continue;
+                }
+
+                // Must be a conditional exit
+                auto terminator = block->GetTerminator()->Cast<BranchConditionalInstruction>();
+                if (!terminator) {
+                    continue;
+                }
+
+                // Exactly one target must leave the loop
+                bool passInLoop = IsInLoop(loop, terminator->pass);
+                if (passInLoop == IsInLoop(loop, terminator->fail)) {
+                    continue;
+                }
+
+                // Bound by the condition
+                if (std::optional<uint64_t> count = ComputeConditionTripCount(loop, terminator->cond, passInLoop)) {
+                    tripCount = tripCount ? std::min(tripCount.value(), count.value()) : count.value();
+                }
+            }
+
+            return tripCount;
+        }
+
+    private:
+        /// Owning program
+        Program& program;
+
+        /// Function to analyse
+        Function& function;
+
+        /// Dependent analysis
+        ComRef<LoopAnalysis> loopAnalysis;
+        ComRef<DominatorAnalysis> dominatorAnalysis;
+        ComRef<ValueRangeAnalysis> valueRangeAnalysis;
+
+        /// Bounded trip counts, per loop header
+        std::unordered_map<ID, uint64_t> tripCounts;
+
+        /// All definitions, only valid during computation
+        std::unordered_map<ID, Definition> definitions;
+
+        /// All function variables, only valid during computation
+        std::unordered_map<ID, Variable> variables;
+    };
+}
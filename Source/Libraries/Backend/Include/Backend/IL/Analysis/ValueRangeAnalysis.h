@@ -0,0 +1,399 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Backend
+#include <Backend/IL/Program.h>
+#include <Backend/IL/Analysis/IAnalysis.h>
+#include <Backend/IL/Analysis/CFG/BasicBlockTraversal.h>
+
+// Std
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+
+namespace IL {
+    /// Inclusive unsigned range of a 32 bit integral value
+    struct ValueRange {
+        /// Get the unbounded range
+        static ValueRange Full() {
+            return ValueRange{};
+        }
+
+        /// Get a single value range
+        static ValueRange Single(uint64_t value) {
+            return ValueRange{.lower = value, .upper = value};
+        }
+
+        /// Check if this range is unbounded
+        bool IsFull() const {
+            return lower == 0 && upper == UINT32_MAX;
+        }
+
+        /// Check if this range is identical under signed and unsigned interpretation
+        bool IsNonNegative() const {
+            return upper <= INT32_MAX;
+        }
+
+        /// Lowest possible value
+        uint64_t lower{0};
+
+        /// Highest possible value
+        uint64_t upper{UINT32_MAX};
+    };
+
+    /// Value range analysis
+    ///   Computes conservative unsigned ranges of 32 bit integral values, and the values they are bounded by.
+    ///   Integral operations in the IL do not carry signedness (DXIL erases it), so every rule must hold for
+    ///   both interpretations, signed dependent rules are only applied on non-negative ranges.
+    ///   Ranges are keyed by identifiers and remain valid for all pre-existing values after instrumentation.
+    class ValueRangeAnalysis : public IFunctionAnalysis {
+    public:
+        COMPONENT(ValueRangeAnalysis);
+
+        /// Constructor
+        /// \param program the owning program
+        /// \param function the function to compute the value ranges for
+        ValueRangeAnalysis(Program& program, Function& function) : program(program), function(function) {
+
+        }
+
+        /// Compute all value ranges
+        bool Compute() override {
+            // Definitions are visited before their users in reverse post-order,
+            // loop carried values are naturally unbounded, as the back-edge value is not yet visited.
+            BasicBlockTraversal traversal;
+            traversal.PostOrder(function.GetBasicBlocks());
+
+            // Visit all blocks in reverse post-order
+            const BasicBlockTraversal::BlockView& view = traversal.GetView();
+            for (auto blockIt = view.rbegin(); blockIt != view.rend(); ++blockIt) {
+                for (const Instruction* instr : **blockIt) {
+                    if (instr->result == InvalidID || !IsIntegral32(instr->result)) {
+                        continue;
+                    }
+
+                    // Compute the value info
+                    ValueInfo info = ComputeValue(instr);
+
+                    // Only keep values with useful information
+                    if (!info.range.IsFull() || info.alias != InvalidID || info.bounds[0] != InvalidID) {
+                        values[instr->result] = info;
+                    }
+                }
+            }
+
+            // OK
+            return true;
+        }
+
+        /// Get the range of a value
+        /// \param id the value identifier
+        /// \return the range, unbounded if unknown
+        ValueRange GetRange(ID id) const {
+            // Constant?
+            if (program.GetConstants().HasConstant(id)) {
+                if (auto constant = program.GetConstants().GetConstant<IntConstant>(id); constant && constant->type->As<Backend::IL::IntType>()->bitWidth == 32) {
+                    return ValueRange::Single(static_cast<uint32_t>(constant->value));
+                }
+
+                // Unknown constant
+                return ValueRange::Full();
+            }
+
+            // Computed?
+            if (auto it = values.find(id); it != values.end()) {
+                return it->second.range;
+            }
+
+            // Unknown
+            return ValueRange::Full();
+        }
+
+        /// Check if a value is less than or equal to another value, under unsigned interpretation
+        /// \param lhs the smaller value
+        /// \param rhs the larger value
+        /// \return true if provably less than or equal
+        bool IsLessThanEqual(ID lhs, ID rhs) const {
+            return IsLessThanEqual(lhs, rhs, kMaxRelationDepth);
+        }
+
+    private:
+        /// Maximum number of bounded-by relations to traverse
+        static constexpr uint32_t kMaxRelationDepth = 4;
+
+        struct ValueInfo {
+            /// Range of the value
+            ValueRange range;
+
+            /// Optional, bit-identical source value
+            ID alias{InvalidID};
+
+            /// Optional, values this value is less than or equal to
+            ID bounds[2]{InvalidID, InvalidID};
+        };
+
+        /// Check if a value is less than or equal to another value
+        bool IsLessThanEqual(ID lhs, ID rhs, uint32_t depth) const {
+            lhs = Resolve(lhs);
+            rhs = Resolve(rhs);
+
+            // Trivially the same value?
+            if (lhs == rhs) {
+                return true;
+            }
+
+            // Disjoint ranges?
+            if (GetRange(lhs).upper <= GetRange(rhs).lower) {
+                return true;
+            }
+
+            // Check all bounded-by relations
+            if (auto it = values.find(lhs); it != values.end() && depth > 0) {
+                for (ID bound : it->second.bounds) {
+                    if (bound != InvalidID && IsLessThanEqual(bound, rhs, depth - 1)) {
+                        return true;
+                    }
+                }
+            }
+
+            // Unknown
+            return false;
+        }
+
+        /// Resolve all aliases of a value
+        ID Resolve(ID id) const {
+            for (auto it = values.find(id); it != values.end() && it->second.alias != InvalidID; it = values.find(id)) {
+                id = it->second.alias;
+            }
+
+            return id;
+        }
+
+        /// Check if a value is a 32 bit integral
+        bool IsIntegral32(ID id) const {
+            const Backend::IL::Type* type = program.GetTypeMap().GetType(id);
+            if (!type) {
+                return false;
+            }
+
+            // Check width
+            auto intType = type->Cast<Backend::IL::IntType>();
+            return intType && intType->bitWidth == 32;
+        }
+
+        /// Compute the union of two ranges
+        static ValueRange Union(const ValueRange& lhs, const ValueRange& rhs) {
+            return ValueRange{.lower = std::min(lhs.lower, rhs.lower), .upper = std::max(lhs.upper, rhs.upper)};
+        }
+
+        /// Create a range, unbounded if the upper bound is not representable
+        static ValueRange Bounded(uint64_t lower, uint64_t upper) {
+            if (upper > UINT32_MAX) {
+                return ValueRange::Full();
+            }
+
+            return ValueRange{.lower = lower, .upper = upper};
+        }
+
+        /// Compute the info of a value
+        ValueInfo ComputeValue(const Instruction* instr) const {
+            ValueInfo info;
+
+            switch (instr->opCode) {
+                default: {
+                    break;
+                }
+                case OpCode::BitCast: {
+                    auto _instr = instr->As<BitCastInstruction>();
+                    if (IsIntegral32(_instr->value)) {
+                        info.range = GetRange(_instr->value);
+                        info.alias = _instr->value;
+                    }
+                    break;
+                }
+                case OpCode::BitAnd: {
+                    auto _instr = instr->As<BitAndInstruction>();
+
+                    // Masking never exceeds either operand
+                    info.range = ValueRange{.lower = 0, .upper = std::min(GetRange(_instr->lhs).upper, GetRange(_instr->rhs).upper)};
+                    info.bounds[0] = _instr->lhs;
+                    info.bounds[1] = _instr->rhs;
+                    break;
+                }
+                case OpCode::BitOr: {
+                    auto _instr = instr->As<BitOrInstruction>();
+                    ValueRange lhs = GetRange(_instr->lhs);
+                    ValueRange rhs = GetRange(_instr->rhs);
+
+                    // Fill all bits below the highest set bit
+                    uint64_t upper = std::max(lhs.upper, rhs.upper);
+                    for (uint32_t shift = 1; shift < 32; shift <<= 1) {
+                        upper |= upper >> shift;
+                    }
+
+                    info.range = ValueRange{.lower = std::max(lhs.lower, rhs.lower), .upper = upper};
+                    break;
+                }
+                case OpCode::BitShiftLeft: {
+                    auto _instr = instr->As<BitShiftLeftInstruction>();
+                    ValueRange value = GetRange(_instr->value);
+                    ValueRange shift = GetRange(_instr->shift);
+
+                    // Only constant shifts, must not overflow
+                    if (shift.lower == shift.upper && shift.upper < 32) {
+                        info.range = Bounded(value.lower << shift.upper, value.upper << shift.upper);
+                    }
+                    break;
+                }
+                case OpCode::BitShiftRight: {
+                    auto _instr = instr->As<BitShiftRightInstruction>();
+                    ValueRange value = GetRange(_instr->value);
+                    ValueRange shift = GetRange(_instr->shift);
+
+                    // Arithmetic and logical shifts only agree on non-negative values
+                    if (value.IsNonNegative() && shift.upper < 32) {
+                        info.range = ValueRange{.lower = value.lower >> shift.upper, .upper = value.upper >> shift.lower};
+                        info.bounds[0] = _instr->value;
+                    }
+                    break;
+                }
+                case OpCode::Add: {
+                    auto _instr = instr->As<AddInstruction>();
+                    ValueRange lhs = GetRange(_instr->lhs);
+                    ValueRange rhs = GetRange(_instr->rhs);
+                    info.range = Bounded(lhs.lower + rhs.lower, lhs.upper + rhs.upper);
+                    break;
+                }
+                case OpCode::Sub: {
+                    auto _instr = instr->As<SubInstruction>();
+                    ValueRange lhs = GetRange(_instr->lhs);
+                    ValueRange rhs = GetRange(_instr->rhs);
+
+                    // Must not wrap
+                    if (lhs.lower >= rhs.upper) {
+                        info.range = ValueRange{.lower = lhs.lower - rhs.upper, .upper = lhs.upper - rhs.lower};
+                        info.bounds[0] = _instr->lhs;
+                    }
+                    break;
+                }
+                case OpCode::Mul: {
+                    auto _instr = instr->As<MulInstruction>();
+                    ValueRange lhs = GetRange(_instr->lhs);
+                    ValueRange rhs = GetRange(_instr->rhs);
+                    info.range = Bounded(lhs.lower * rhs.lower, lhs.upper * rhs.upper);
+                    break;
+                }
+                case OpCode::Div: {
+                    auto _instr = instr->As<DivInstruction>();
+                    ValueRange lhs = GetRange(_instr->lhs);
+                    ValueRange rhs = GetRange(_instr->rhs);
+
+                    // Signed and unsigned division only agree on non-negative values, and zero divisors are undefined
+                    if (lhs.IsNonNegative() && rhs.IsNonNegative() && rhs.lower > 0) {
+                        info.range = ValueRange{.lower = lhs.lower / rhs.upper, .upper = lhs.upper / rhs.lower};
+                        info.bounds[0] = _instr->lhs;
+                    }
+                    break;
+                }
+                case OpCode::Rem: {
+                    auto _instr = instr->As<RemInstruction>();
+                    ValueRange lhs = GetRange(_instr->lhs);
+                    ValueRange rhs = GetRange(_instr->rhs);
+
+                    // Signed and unsigned remainders only agree on non-negative values, and zero divisors are undefined
+                    if (lhs.IsNonNegative() && rhs.IsNonNegative() && rhs.lower > 0) {
+                        info.range = ValueRange{.lower = 0, .upper = std::min(lhs.upper, rhs.upper - 1)};
+                        info.bounds[0] = _instr->lhs;
+                    }
+                    break;
+                }
+                case OpCode::Extended: {
+                    auto _instr = instr->As<ExtendedInstruction>();
+                    if (_instr->operands.count != 2) {
+                        break;
+                    }
+
+                    ValueRange lhs = GetRange(_instr->operands[0]);
+                    ValueRange rhs = GetRange(_instr->operands[1]);
+
+                    // Signed and unsigned min / max only agree on non-negative values
+                    if (!lhs.IsNonNegative() || !rhs.IsNonNegative()) {
+                        break;
+                    }
+
+                    switch (_instr->extendedOp) {
+                        default:
+                            break;
+                        case Backend::IL::ExtendedOp::Min:
+                            info.range = ValueRange{.lower = std::min(lhs.lower, rhs.lower), .upper = std::min(lhs.upper, rhs.upper)};
+                            info.bounds[0] = _instr->operands[0];
+                            info.bounds[1] = _instr->operands[1];
+                            break;
+                        case Backend::IL::ExtendedOp::Max:
+                            info.range = ValueRange{.lower = std::max(lhs.lower, rhs.lower), .upper = std::max(lhs.upper, rhs.upper)};
+                            break;
+                    }
+                    break;
+                }
+                case OpCode::Select: {
+                    auto _instr = instr->As<SelectInstruction>();
+                    info.range = Union(GetRange(_instr->pass), GetRange(_instr->fail));
+                    break;
+                }
+                case OpCode::Phi: {
+                    auto _instr = instr->As<PhiInstruction>();
+
+                    // Union of all incoming values, unvisited (loop carried) values are unbounded
+                    info.range = ValueRange{.lower = UINT32_MAX, .upper = 0};
+                    for (uint32_t i = 0; i < _instr->values.count; i++) {
+                        info.range = Union(info.range, GetRange(_instr->values[i].value));
+                    }
+
+                    // No incoming values?
+                    if (info.range.lower > info.range.upper) {
+                        info.range = ValueRange::Full();
+                    }
+                    break;
+                }
+            }
+
+            // OK
+            return info;
+        }
+
+    private:
+        /// Owning program
+        Program& program;
+
+        /// Function to analyse
+        Function& function;
+
+        /// All computed values
+        std::unordered_map<ID, ValueInfo> values;
+    };
+}
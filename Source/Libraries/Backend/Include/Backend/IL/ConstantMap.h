@@ -165,12 +165,13 @@ namespace Backend::IL {
         /// \param id expected id
         /// \return false if not present
         bool HasConstant(ID id) {
-            if (id >= idMap.size()) {
+            auto it = idMap.find(id);
+            if (it == idMap.end()) {
                 return false;
             }
 
             // Check if valid
-            return idMap[id] != nullptr;
+            return it->second != nullptr;
         }
 
         /// Get the constant for a given id
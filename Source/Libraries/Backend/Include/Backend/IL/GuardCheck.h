@@ -0,0 +1,124 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Backend
+#include <Backend/IL/Emitters/Emitter.h>
+#include <Backend/IL/Emitters/ResourceTokenEmitter.h>
+
+// Common
+#include <Common/Assert.h>
+
+// Std
+#include <optional>
+#include <memory>
+#include <vector>
+
+namespace IL {
+    /// Shared state of a single fused guard
+    struct GuardContext {
+        /// Maximum number of distinct resources per guarded instruction
+        static constexpr uint32_t kMaxTokens = 4;
+
+        GuardContext(Program& program, Emitter<>& pre, const Instruction* instr) : program(program), pre(pre), instr(instr) {
+
+        }
+
+        /// Get the shared token of a resource, fetched once for all checks
+        ///   Only valid while emitting conditions, any token value the failure handlers need must be fetched then
+        /// \param resource the resource to fetch the token for
+        /// \return token emitter
+        ResourceTokenEmitter<Emitter<>>& GetToken(ID resource) {
+            ASSERT(!sealed, "Tokens requested after condition emission");
+
+            // Already fetched?
+            for (uint32_t i = 0; i < tokenCount; i++) {
+                if (tokenResources[i] == resource) {
+                    return *tokens[i];
+                }
+            }
+
+            // Fetch the new token
+            ASSERT(tokenCount < kMaxTokens, "Token count exceeded");
+            tokenResources[tokenCount] = resource;
+            return tokens[tokenCount++].emplace(pre, resource);
+        }
+
+        /// Seal the context, no more tokens may be fetched
+        void Seal() {
+            sealed = true;
+        }
+
+        /// Current program
+        Program& program;
+
+        /// Shared guard emitter, the condition block
+        Emitter<>& pre;
+
+        /// The guarded instruction, invalidated before post emission
+        const Instruction* instr;
+
+    private:
+        /// All fetched tokens
+        std::optional<ResourceTokenEmitter<Emitter<>>> tokens[kMaxTokens];
+
+        /// Resources of all fetched tokens
+        ID tokenResources[kMaxTokens];
+
+        /// Number of fetched tokens
+        uint32_t tokenCount{0};
+
+        /// Is the context sealed?
+        bool sealed{false};
+    };
+
+    /// A single guard check registered on an instruction
+    class IGuardCheck {
+    public:
+        virtual ~IGuardCheck() = default;
+
+        /// Emit the failure condition into the shared guard block
+        /// \param context the shared guard context
+        /// \return scalar boolean condition, true if failed
+        virtual ID EmitCondition(GuardContext& context) = 0;
+
+        /// Emit the failure handling, only executed if this check failed
+        /// \param context the shared guard context, sealed
+        /// \param failure the failure emitter
+        virtual void EmitFailure(GuardContext& context, Emitter<>& failure) = 0;
+
+        /// Emit all post instruction operations, executed regardless of failure
+        /// \param context the shared guard context, sealed
+        /// \param post the emitter following the guarded instruction
+        virtual void EmitPost(GuardContext& context, Emitter<>& post) {
+            /* no post operations */
+        }
+    };
+
+    /// All checks of a single instruction
+    using GuardCheckList = std::vector<std::unique_ptr<IGuardCheck>>;
+}
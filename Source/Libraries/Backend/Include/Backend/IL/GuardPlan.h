@@ -0,0 +1,75 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Backend
+#include <Backend/IL/GuardCheck.h>
+#include <Backend/IL/BasicBlock.h>
+
+// Std
+#include <functional>
+#include <vector>
+
+namespace IL {
+    /// Guard provider, appends all checks a feature places on an instruction
+    using GuardProvider = std::function<void(Program& program, Function& function, const BasicBlock::Iterator& it, GuardCheckList& checks)>;
+
+    /// Shared guard plan
+    ///   Checks of all features on the same instruction are fused into a single guard, with a shared token fetch,
+    ///   a single branch, and a shared failure path.
+    class GuardPlan {
+    public:
+        /// Add a new provider
+        /// \param provider the provider, invoked for every user instruction
+        void Add(const GuardProvider& provider) {
+            providers.push_back(provider);
+        }
+
+        /// Check if there are any providers
+        bool IsEmpty() const {
+            return providers.empty();
+        }
+
+        /// Emit all fused guards
+        /// \param program the program to instrument
+        void Apply(Program& program);
+
+    private:
+        /// Fuse all checks on an instruction
+        /// \param program the program to instrument
+        /// \param function the function of the instruction
+        /// \param basicBlock the block of the instruction
+        /// \param it the guarded instruction
+        /// \param checks all checks, must not be empty
+        /// \return the next iterator
+        BasicBlock::Iterator Fuse(Program& program, Function& function, BasicBlock& basicBlock, const BasicBlock::Iterator& it, GuardCheckList& checks);
+
+    private:
+        /// All providers
+        std::vector<GuardProvider> providers;
+    };
+}
@@ -40,6 +40,7 @@
 // Std
 #include <list>
 #include <algorithm>
+#include <mutex>
 
 namespace IL {
     struct Program {
@@ -77,6 +78,9 @@ namespace IL {
             program->capabilityTable = capabilityTable;
             program->entryPoint = entryPoint;
 
+            // Copies share the analyses of the program they originate from, copies of copies share the original source
+            program->sourceProgram = sourceProgram ? sourceProgram : const_cast<Program*>(this);
+
             // Copy all functions and their basic blocks
             functions.CopyTo(program->functions);
 
@@ -100,6 +104,19 @@ namespace IL {
             return functions.GetFunction(entryPoint);
         }
 
+        /// Get the program this program was copied from
+        /// Source programs are never modified and outlive their copies, any analysis that is a pure
+        /// function of the user program may be computed once on the source and shared across copies.
+        /// \return the source program, or this program if not a copy
+        Program& GetSourceProgram() {
+            return sourceProgram ? *sourceProgram : *this;
+        }
+
+        /// Get the lock guarding all analyses on the source program
+        std::mutex& GetSourceAnalysisMutex() {
+            return GetSourceProgram().sourceAnalysisMutex;
+        }
+
         /// Get the shader guid
         uint64_t GetShaderGUID() const {
             return shaderGUID;
@@ -241,6 +258,12 @@ namespace IL {
         /// Shader guid of this program
         uint64_t shaderGUID{~0ull};
 
+        /// Program this was copied from, null if not a copy
+        Program* sourceProgram{nullptr};
+
+        /// Shared lock for analyses computed on this program by its copies
+        std::mutex sourceAnalysisMutex;
+
     private:
         /// Internal registry
         Registry registry;
@@ -0,0 +1,76 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+#include "ShaderExport.h"
+#include "ShaderExportTypeInfo.h"
+
+// Common
+#include <Common/IComponent.h>
+
+// Std
+#include <cstdint>
+
+// Forward declarations
+class IMessageStorage;
+
+/// Host side aggregation of shader export records
+/// Records are coalesced before reaching the bridge, each coalesced record is forwarded once and
+/// accompanied by a ShaderExportAggregate message describing the number of occurrences.
+class IShaderExportAggregator : public TComponent<IShaderExportAggregator> {
+public:
+    COMPONENT(IShaderExportAggregator);
+
+    /// Set the coalescing window
+    /// \param nanoseconds window length, zero disables aggregation
+    virtual void SetWindow(uint64_t nanoseconds) = 0;
+
+    /// Check if aggregation is enabled
+    virtual bool IsEnabled() = 0;
+
+    /// Check if an export may be aggregated
+    /// \param typeInfo the export type info
+    /// \return false if the records must be forwarded as is
+    virtual bool IsAggregatable(const ShaderExportTypeInfo& typeInfo) = 0;
+
+    /// Aggregate a set of raw export records
+    /// ! Thread safe, different exports may be aggregated concurrently
+    /// \param id the export identifier
+    /// \param typeInfo the export type info
+    /// \param versionID the resource version of all records
+    /// \param data the raw records
+    /// \param size the byte size of all records
+    /// \param timestamp the host timestamp of all records, in nanoseconds
+    /// \param storage the storage to flush expired aggregates to
+    virtual void Aggregate(ShaderExportID id, const ShaderExportTypeInfo& typeInfo, uint32_t versionID, const void* data, size_t size, uint64_t timestamp, IMessageStorage* storage) = 0;
+
+    /// Flush all expired aggregates
+    /// \param timestamp the current host timestamp, in nanoseconds, UINT64_MAX flushes all aggregates
+    /// \param storage the storage to flush to
+    virtual void Flush(uint64_t timestamp, IMessageStorage* storage) = 0;
+};
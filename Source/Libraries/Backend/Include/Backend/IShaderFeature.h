@@ -39,6 +39,7 @@ struct MessageStream;
 // IL
 namespace IL {
     struct Program;
+    class GuardPlan;
 }
 
 class IShaderFeature : public IInterface {
@@ -53,6 +54,12 @@ public:
     /// \param program the program to be injected    
     virtual void PreInject(IL::Program &program, const MessageStreamView<> &specialization) { /* no pre-injection */};
 
+    /// Plan all guard checks, invoked before injection
+    ///   Checks registered on the same instruction across features are fused, and emitted after all injection
+    /// \param plan the shared guard plan
+    /// \param program the program to be injected
+    virtual void PlanGuards(IL::GuardPlan &plan, IL::Program &program, const MessageStreamView<> &specialization) { /* no guards */ }
+
     /// Perform injection into a program
     /// \param program the program to be injected to
     virtual void Inject(IL::Program &program, const MessageStreamView<> &specialization) { /* no injection */ }
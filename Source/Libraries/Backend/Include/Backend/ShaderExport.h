@@ -44,3 +44,12 @@ static constexpr ShaderSGUID InvalidShaderSGUID = 0xFFFF;
 
 /// Total amount of bits for the source guid
 static constexpr uint32_t kShaderSGUIDBitCount = 16u;
+
+/// Number of per-SGUID export budget slots, source guids beyond this alias
+static constexpr uint32_t kShaderExportBudgetSlotCount = 4096u;
+
+/// Export budget limit that never throttles
+static constexpr uint32_t kShaderExportUnlimitedBudget = ~0u;
+
+/// Stream offset of out of budget exports, writes beyond the stream extent are discarded
+static constexpr uint32_t kShaderExportBudgetDiscardOffset = 0x80000000u;
@@ -0,0 +1,95 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Backend
+#include <Backend/ShaderExport.h>
+#include <Backend/ShaderData/ShaderData.h>
+
+// Common
+#include <Common/IComponent.h>
+#include <Common/ComRef.h>
+
+// Std
+#include <mutex>
+#include <atomic>
+
+// Forward declarations
+class IShaderDataHost;
+
+/// Per-SGUID export budgets
+/// Budgeted exports stop reporting once a site has exported [limit] times within a segment,
+/// the limits reside in shader data and may be changed at any time without re-instrumentation.
+class ShaderExportBudgetHost : public TComponent<ShaderExportBudgetHost> {
+public:
+    COMPONENT(ShaderExportBudgetHost);
+
+    /// Install this host
+    /// \return success state
+    bool Install();
+
+    /// Set the budget of a single export site
+    /// \param sguid the source guid of the site
+    /// \param limit maximum number of exports per segment, zero is unlimited
+    void SetBudget(ShaderSGUID sguid, uint32_t limit);
+
+    /// Reset the budget of all export sites
+    /// \param limit maximum number of exports per segment, zero is unlimited
+    void ResetBudgets(uint32_t limit);
+
+    /// Get the shader data holding all limits
+    ShaderDataID GetDataID() const {
+        return limitBufferID;
+    }
+
+    /// Check if any export site is limited
+    /// Budget checks are only instrumented while configured
+    /// \return true if configured
+    bool IsConfigured() const {
+        return limitedSlotCount.load(std::memory_order_acquire) != 0;
+    }
+
+private:
+    /// Flush all pending limit writes
+    void FlushNoLock();
+
+private:
+    ComRef<IShaderDataHost> shaderDataHost;
+
+    /// Shared lock
+    std::mutex mutex;
+
+    /// Limit buffer, one limit per budget slot
+    ShaderDataID limitBufferID{InvalidShaderDataID};
+
+    /// Mapped limits
+    uint32_t* limits{nullptr};
+
+    /// Number of slots with a limit
+    std::atomic<uint32_t> limitedSlotCount{0};
+};
@@ -0,0 +1,125 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Backend
+#include "IShaderExportAggregator.h"
+
+// Std
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+struct ShaderExportAggregateMessage;
+
+/// Default aggregator, coalesces non-structured exports by their primary record
+/// The first record of each key is forwarded with its detail chunks, subsequent records within the window only add to the count.
+class ShaderExportKeyAggregator final : public IShaderExportAggregator {
+public:
+    /// Overrides
+    void SetWindow(uint64_t nanoseconds) override;
+    bool IsEnabled() override;
+    bool IsAggregatable(const ShaderExportTypeInfo& typeInfo) override;
+    void Aggregate(ShaderExportID id, const ShaderExportTypeInfo& typeInfo, uint32_t versionID, const void* data, size_t size, uint64_t timestamp, IMessageStorage* storage) override;
+    void Flush(uint64_t timestamp, IMessageStorage* storage) override;
+
+    /// Check if a forwarded record is described by an aggregate
+    /// \param aggregate the aggregate
+    /// \param typeInfo type info of the record
+    /// \param record the forwarded record
+    /// \return true if the record identity matches the aggregate key
+    static bool IsAggregateOf(const ShaderExportAggregateMessage& aggregate, const ShaderExportTypeInfo& typeInfo, const void* record);
+
+private:
+    /// Get the identity of a record
+    /// \param typeInfo type info of the record
+    /// \param record the record
+    /// \param recordSize byte size of the record
+    /// \param out destination identity
+    static void GetIdentity(const ShaderExportTypeInfo& typeInfo, const void* record, size_t recordSize, std::string& out);
+
+    struct Entry {
+        /// Identity of the primary record, see GetIdentity
+        std::string identity;
+
+        /// Number of coalesced records
+        uint32_t count{0};
+
+        /// Host timestamps of the first and last record
+        uint64_t firstTimestamp{0};
+        uint64_t lastTimestamp{0};
+    };
+
+    struct Bucket {
+        /// Shared lock
+        std::mutex mutex;
+
+        /// Schema and version of all retained records
+        MessageSchema schema{};
+        uint32_t versionID{0};
+
+        /// Host timestamp of the first record in the current window
+        uint64_t windowBegin{0};
+
+        /// All entries, in order of first occurrence
+        std::vector<Entry> entries;
+
+        /// Primary record to entry index lookup
+        std::unordered_map<std::string, uint32_t> lookup;
+
+        /// Identity scratch buffer
+        std::string identity;
+
+        /// Forwarded records, one per entry
+        std::vector<uint8_t> records;
+    };
+
+    /// Get or create the bucket of an export
+    /// \param id the export identifier
+    /// \return the bucket
+    Bucket* GetBucket(ShaderExportID id);
+
+    /// Flush all aggregates of a bucket
+    /// \param bucket the bucket to flush
+    /// \param storage the storage to flush to
+    void FlushBucketNoLock(Bucket* bucket, IMessageStorage* storage);
+
+private:
+    /// Coalescing window, in nanoseconds
+    std::atomic<uint64_t> window{0};
+
+    /// Bucket lookup lock
+    std::mutex mutex;
+
+    /// All buckets, indexed by export identifier
+    std::vector<std::unique_ptr<Bucket>> buckets;
+};
@@ -31,6 +31,7 @@
 
 // Std
 #include <cstdint>
+#include <type_traits>
 
 /// Shader export type metadata
 struct ShaderExportTypeInfo {
@@ -44,6 +45,14 @@ struct ShaderExportTypeInfo {
         info.noSGUID = ShaderExport::kNoSGUID;
         info.structured = ShaderExport::kStructured;
         info.typeSize = sizeof(T);
+        info.budgeted = !ShaderExport::kNoSGUID && !ShaderExport::kStructured;
+
+        // Chunked messages are variable in size, and carry the chunk mask in the upper bits of the key
+        if constexpr (std::is_same_v<Schema, ChunkedMessageSchema>) {
+            info.messageSize = [](const void* message) { return T::MessageSize(static_cast<const T*>(message)); };
+            info.keyMask = ~(static_cast<uint32_t>(T::Chunk::Mask) << (32u - static_cast<uint32_t>(T::Chunk::Count)));
+        }
+
         return info;
     }
 
@@ -51,4 +60,13 @@ struct ShaderExportTypeInfo {
     bool noSGUID{false};
     bool structured{false};
     size_t typeSize{0};
+
+    /// Is this export subject to per-SGUID budgets? Requires the source guid in the lower bits of the key
+    bool budgeted{false};
+
+    /// Optional, size of a given message, if null, all messages are of size typeSize
+    uint32_t(*messageSize)(const void* message){nullptr};
+
+    /// Mask of the primary key excluding any non-identity bits
+    uint32_t keyMask{~0u};
 };
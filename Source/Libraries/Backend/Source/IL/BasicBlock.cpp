@@ -254,6 +254,7 @@ IL::BasicBlock::Iterator IL::BasicBlock::Split(IL::BasicBlock *destBlock, const
 
     // Erase moved instruction data
     data.erase(data.begin() + splitPointRelocationOffset, data.end());
+    MarkAsDirty();
 
     // Free relocation indices
     auto relocationIt = relocationTable.begin() + splitIteratorPhi.relocationIndex;
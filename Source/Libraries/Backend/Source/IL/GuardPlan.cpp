@@ -0,0 +1,153 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <Backend/IL/GuardPlan.h>
+#include <Backend/IL/Visitor.h>
+#include <Backend/IL/ControlFlow.h>
+
+// Common
+#include <Common/Containers/TrivialStackVector.h>
+
+void IL::GuardPlan::Apply(Program &program) {
+    // Nothing to fuse?
+    if (providers.empty()) {
+        return;
+    }
+
+    // Shared check list
+    GuardCheckList checks;
+
+    // Visit all instructions
+    VisitUserInstructions(program, [&](VisitContext& context, BasicBlock::Iterator it) -> BasicBlock::Iterator {
+        checks.clear();
+
+        // Collect the checks of all features
+        for (const GuardProvider& provider : providers) {
+            provider(program, context.function, it, checks);
+        }
+
+        // Unguarded?
+        if (checks.empty()) {
+            return it;
+        }
+
+        // Fuse all checks
+        return Fuse(program, context.function, context.basicBlock, it, checks);
+    });
+}
+
+IL::BasicBlock::Iterator IL::GuardPlan::Fuse(Program &program, Function &function, BasicBlock &basicBlock, const BasicBlock::Iterator &it, GuardCheckList &checks) {
+    // Instrumentation Segmentation
+    //
+    //             BEFORE                                 AFTER
+    //
+    //   ┌─────┬─────────────┬───────┐      ┌─────────┐                   ┌─────────────┬──────┬──────┐
+    //   │     │             │       │      │ Tokens  │        OK         │             │      │      │
+    //   │ Pre │ Instruction │ Post  │      │ Checks  ├───────────────────┤ Instruction │ Post │ Post │
+    //   │     │             │       │      │ Any     │                   │   [RESUME]  │ Ops  │      │
+    //   └─────┴─────────────┴───────┘      └────┬────┘                   └──────┬──────┴──────┴──────┘
+    //                                           │    ┌───────────────┐          │
+    //                                    FAILED │    │  Check 0..N   │          │
+    //                                           └────┤   Failures    ├──────────┘
+    //                                                │   [FAILURE]   │
+    //                                                └───────────────┘
+
+    // Allocate resume
+    BasicBlock* resumeBlock = function.GetBasicBlocks().AllocBlock();
+
+    // Split this basic block, move all instructions post and including the instrumented instruction to resume
+    // ! iterator invalidated
+    BasicBlock::Iterator instr = basicBlock.Split(resumeBlock, it);
+
+    // Shared guard emitter
+    Emitter<> pre(program, basicBlock);
+
+    // Shared context
+    GuardContext context(program, pre, instr.Get());
+
+    // Emit all conditions, tokens are shared across all checks
+    TrivialStackVector<ID, 8> conditions;
+    for (const std::unique_ptr<IGuardCheck>& check : checks) {
+        conditions.Add(check->EmitCondition(context));
+    }
+
+    // Any check failed?
+    ID anyFailed = conditions[0];
+    for (size_t i = 1; i < conditions.Size(); i++) {
+        anyFailed = pre.Or(anyFailed, conditions[i]);
+    }
+
+    // No more token fetches past this point
+    context.Seal();
+
+    // Shared failure block
+    Emitter<> failure(program, *function.GetBasicBlocks().AllocBlock());
+    failure.AddBlockFlag(BasicBlockFlag::NoInstrumentation);
+
+    // Single branch to the shared failure path
+    pre.BranchConditional(anyFailed, failure.GetBasicBlock(), resumeBlock, ControlFlow::Selection(resumeBlock));
+
+    // Single check, no need to re-test the condition
+    if (checks.size() == 1) {
+        checks[0]->EmitFailure(context, failure);
+        failure.Branch(resumeBlock);
+    } else {
+        for (size_t i = 0; i < checks.size(); i++) {
+            // Allocate blocks
+            Emitter<> handler(program, *function.GetBasicBlocks().AllocBlock());
+            handler.AddBlockFlag(BasicBlockFlag::NoInstrumentation);
+
+            // Allocate next failure test
+            BasicBlock* nextBlock = function.GetBasicBlocks().AllocBlock();
+            nextBlock->AddFlag(BasicBlockFlag::NoInstrumentation);
+
+            // Handle this check only if it failed
+            failure.BranchConditional(conditions[i], handler.GetBasicBlock(), nextBlock, ControlFlow::Selection(nextBlock));
+
+            // Emit failure handling
+            checks[i]->EmitFailure(context, handler);
+            handler.Branch(nextBlock);
+
+            // Continue in next
+            failure = Emitter<>(program, *nextBlock);
+        }
+
+        // Branch back
+        failure.Branch(resumeBlock);
+    }
+
+    // Post emission may relocate the guarded instruction
+    context.instr = nullptr;
+
+    // Any post operations?
+    Emitter<> post(program, *resumeBlock, ++resumeBlock->begin());
+    for (const std::unique_ptr<IGuardCheck>& check : checks) {
+        check->EmitPost(context, post);
+    }
+
+    // Resume after the guarded instruction, post operations are not user instructions
+    return instr;
+}
@@ -0,0 +1,95 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <Backend/ShaderExportBudgetHost.h>
+#include <Backend/ShaderData/IShaderDataHost.h>
+
+// Common
+#include <Common/Registry.h>
+
+// Std
+#include <algorithm>
+
+/// Translate a user limit to the device limit
+static uint32_t GetDeviceLimit(uint32_t limit) {
+    return limit ? limit : kShaderExportUnlimitedBudget;
+}
+
+bool ShaderExportBudgetHost::Install() {
+    shaderDataHost = registry->Get<IShaderDataHost>();
+    if (!shaderDataHost) {
+        return false;
+    }
+
+    // Allocate the limits, visible to the host as limits are written directly
+    limitBufferID = shaderDataHost->CreateBuffer(ShaderDataBufferInfo {
+        .elementCount = kShaderExportBudgetSlotCount,
+        .format = Backend::IL::Format::R32UInt,
+        .flagSet = ShaderDataBufferFlag::HostVisible
+    });
+
+    // Map the limits
+    limits = static_cast<uint32_t*>(shaderDataHost->Map(limitBufferID));
+    if (!limits) {
+        return false;
+    }
+
+    // Unlimited by default
+    std::lock_guard guard(mutex);
+    std::fill_n(limits, kShaderExportBudgetSlotCount, kShaderExportUnlimitedBudget);
+    FlushNoLock();
+
+    // OK
+    return true;
+}
+
+void ShaderExportBudgetHost::SetBudget(ShaderSGUID sguid, uint32_t limit) {
+    std::lock_guard guard(mutex);
+
+    // Source guids beyond the slot count alias
+    uint32_t& slot = limits[sguid % kShaderExportBudgetSlotCount];
+
+    // Track the number of limited slots
+    uint32_t limitedSlots = limitedSlotCount.load(std::memory_order_relaxed);
+    limitedSlots -= (slot != kShaderExportUnlimitedBudget);
+    slot = GetDeviceLimit(limit);
+    limitedSlots += (slot != kShaderExportUnlimitedBudget);
+    limitedSlotCount.store(limitedSlots, std::memory_order_release);
+
+    FlushNoLock();
+}
+
+void ShaderExportBudgetHost::ResetBudgets(uint32_t limit) {
+    std::lock_guard guard(mutex);
+    std::fill_n(limits, kShaderExportBudgetSlotCount, GetDeviceLimit(limit));
+    limitedSlotCount.store(GetDeviceLimit(limit) != kShaderExportUnlimitedBudget ? kShaderExportBudgetSlotCount : 0u, std::memory_order_release);
+    FlushNoLock();
+}
+
+void ShaderExportBudgetHost::FlushNoLock() {
+    shaderDataHost->FlushMappedRange(limitBufferID, 0, sizeof(uint32_t) * kShaderExportBudgetSlotCount);
+}
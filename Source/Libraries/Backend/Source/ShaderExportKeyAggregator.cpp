@@ -0,0 +1,206 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <Backend/ShaderExportKeyAggregator.h>
+
+// Message
+#include <Message/IMessageStorage.h>
+#include <Message/MessageStream.h>
+
+// Schemas
+#include <Schemas/Instrumentation.h>
+
+// Std
+#include <algorithm>
+#include <cstring>
+
+void ShaderExportKeyAggregator::SetWindow(uint64_t nanoseconds) {
+    window = nanoseconds;
+}
+
+bool ShaderExportKeyAggregator::IsEnabled() {
+    return window != 0;
+}
+
+bool ShaderExportKeyAggregator::IsAggregatable(const ShaderExportTypeInfo &typeInfo) {
+    // Structured exports have no identity key
+    return !typeInfo.structured;
+}
+
+void ShaderExportKeyAggregator::Aggregate(ShaderExportID id, const ShaderExportTypeInfo &typeInfo, uint32_t versionID, const void *data, size_t size, uint64_t timestamp, IMessageStorage *storage) {
+    Bucket* bucket = GetBucket(id);
+
+    // Serial per export
+    std::lock_guard guard(bucket->mutex);
+
+    // Records are only coalesced within the same window and resource version
+    if (!bucket->entries.empty() && (bucket->versionID != versionID || timestamp - bucket->windowBegin >= window)) {
+        FlushBucketNoLock(bucket, storage);
+    }
+
+    // Begin new window?
+    if (bucket->entries.empty()) {
+        bucket->schema = typeInfo.messageSchema;
+        bucket->versionID = versionID;
+        bucket->windowBegin = timestamp;
+    }
+
+    auto* ptr = static_cast<const uint8_t*>(data);
+    auto* end = ptr + size;
+
+    // Visit all records
+    while (ptr + sizeof(uint32_t) <= end) {
+        // Get the record size, variable for chunked exports
+        size_t recordSize = typeInfo.messageSize ? typeInfo.messageSize(ptr) : typeInfo.typeSize;
+
+        // Records may be partially written if the stream overflowed
+        if (ptr + recordSize > end) {
+            break;
+        }
+
+        // Get the identity
+        GetIdentity(typeInfo, ptr, recordSize, bucket->identity);
+
+        // First occurrence?
+        auto it = bucket->lookup.find(bucket->identity);
+        if (it == bucket->lookup.end()) {
+            it = bucket->lookup.emplace(bucket->identity, static_cast<uint32_t>(bucket->entries.size())).first;
+
+            bucket->entries.push_back(Entry {
+                .identity = bucket->identity,
+                .firstTimestamp = timestamp
+            });
+
+            // Forward the record as is
+            bucket->records.insert(bucket->records.end(), ptr, ptr + recordSize);
+        }
+
+        // Accumulate
+        Entry& entry = bucket->entries[it->second];
+        entry.count++;
+        entry.lastTimestamp = timestamp;
+
+        // Next!
+        ptr += recordSize;
+    }
+}
+
+void ShaderExportKeyAggregator::Flush(uint64_t timestamp, IMessageStorage *storage) {
+    std::lock_guard guard(mutex);
+
+    // Flush all expired buckets
+    for (const std::unique_ptr<Bucket>& bucket : buckets) {
+        if (!bucket) {
+            continue;
+        }
+
+        // Expired?
+        std::lock_guard bucketGuard(bucket->mutex);
+        if (!bucket->entries.empty() && (timestamp == UINT64_MAX || timestamp - bucket->windowBegin >= window)) {
+            FlushBucketNoLock(bucket.get(), storage);
+        }
+    }
+}
+
+bool ShaderExportKeyAggregator::IsAggregateOf(const ShaderExportAggregateMessage &aggregate, const ShaderExportTypeInfo &typeInfo, const void *record) {
+    if (aggregate.messageID != typeInfo.messageSchema.id) {
+        return false;
+    }
+
+    // Get the record identity
+    std::string identity;
+    GetIdentity(typeInfo, record, typeInfo.messageSize ? typeInfo.messageSize(record) : typeInfo.typeSize, identity);
+
+    // Must match the key
+    return identity.size() == aggregate.key.count * sizeof(uint32_t) && !std::memcmp(identity.data(), aggregate.key.Get(), identity.size());
+}
+
+void ShaderExportKeyAggregator::GetIdentity(const ShaderExportTypeInfo &typeInfo, const void *record, size_t recordSize, std::string &out) {
+    // Identity is the full primary record, excluding any detail chunks
+    out.assign(static_cast<const char*>(record), std::min(recordSize, typeInfo.typeSize));
+
+    // Only the first dword carries non-identity bits
+    uint32_t key;
+    std::memcpy(&key, out.data(), sizeof(uint32_t));
+    key &= typeInfo.keyMask;
+    std::memcpy(out.data(), &key, sizeof(uint32_t));
+}
+
+ShaderExportKeyAggregator::Bucket *ShaderExportKeyAggregator::GetBucket(ShaderExportID id) {
+    std::lock_guard guard(mutex);
+
+    // Ensure enough space
+    if (id >= buckets.size()) {
+        buckets.resize(id + 1);
+    }
+
+    // Create on first use
+    std::unique_ptr<Bucket>& bucket = buckets[id];
+    if (!bucket) {
+        bucket = std::make_unique<Bucket>();
+    }
+
+    // OK
+    return bucket.get();
+}
+
+void ShaderExportKeyAggregator::FlushBucketNoLock(Bucket *bucket, IMessageStorage *storage) {
+    // Forward all coalesced records, one per key
+    MessageStream recordStream;
+    recordStream.SetSchema(bucket->schema);
+    recordStream.SetVersionID(bucket->versionID);
+    recordStream.SetData(bucket->records.data(), bucket->records.size(), bucket->entries.size());
+    recordStream.SetLossy(true);
+    storage->AddStream(recordStream);
+
+    // Ordered aggregate stream
+    MessageStream aggregateStream;
+    MessageStreamView view(aggregateStream);
+
+    // Describe all occurrences
+    for (const Entry& entry : bucket->entries) {
+        auto&& aggregate = view.Add<ShaderExportAggregateMessage>(ShaderExportAggregateMessage::AllocationInfo {
+            .keyCount = entry.identity.size() / sizeof(uint32_t)
+        });
+
+        // Identity is matched against the forwarded records
+        aggregate->messageID = bucket->schema.id;
+        std::memcpy(aggregate->key.Get(), entry.identity.data(), aggregate->key.count * sizeof(uint32_t));
+        aggregate->count = entry.count;
+        aggregate->firstTimestamp = entry.firstTimestamp;
+        aggregate->lastTimestamp = entry.lastTimestamp;
+    }
+
+    // Add output, bulk export data like the records
+    aggregateStream.SetLossy(true);
+    storage->AddStream(aggregateStream);
+
+    // Cleanup
+    bucket->entries.clear();
+    bucket->lookup.clear();
+    bucket->records.clear();
+}
@@ -0,0 +1,310 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <catch2/catch.hpp>
+
+// Backend
+#include <Backend/IL/Emitters/Emitter.h>
+#include <Backend/IL/Analysis/CFG/LoopTripCountAnalysis.h>
+
+// Std
+#include <optional>
+
+namespace {
+    /// Loop skeleton, entry -> header -> body -> header, header -> exit
+    struct LoopBlocks {
+        IL::Function* fn{nullptr};
+        IL::BasicBlock* entry{nullptr};
+        IL::BasicBlock* header{nullptr};
+        IL::BasicBlock* body{nullptr};
+        IL::BasicBlock* exit{nullptr};
+    };
+
+    /// Allocate a loop skeleton, the exit returns
+    LoopBlocks AllocLoop(IL::Program& program) {
+        IL::IdentifierMap& map = program.GetIdentifierMap();
+
+        LoopBlocks blocks;
+        blocks.fn = program.GetFunctionList().AllocFunction(map.AllocID());
+        blocks.entry = blocks.fn->GetBasicBlocks().AllocBlock(map.AllocID());
+        blocks.header = blocks.fn->GetBasicBlocks().AllocBlock(map.AllocID());
+        blocks.body = blocks.fn->GetBasicBlocks().AllocBlock(map.AllocID());
+        blocks.exit = blocks.fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+        // Exit
+        IL::Emitter<>(program, *blocks.exit).Return();
+        return blocks;
+    }
+
+    /// Emit a canonical phi induction
+    /// \param program the program
+    /// \param blocks the loop skeleton
+    /// \param entryValue the value on entry
+    /// \param stepValue the step
+    /// \param decrement decrement by the step instead
+    /// \return the phi
+    IL::ID EmitPhiInduction(IL::Program& program, const LoopBlocks& blocks, IL::ID entryValue, IL::ID stepValue, bool decrement = false) {
+        IL::ID phi = program.GetIdentifierMap().AllocID();
+
+        // Body, step the induction
+        IL::Emitter<> body(program, *blocks.body);
+        IL::ID next = decrement ? IL::ID(body.Sub(phi, stepValue)) : IL::ID(body.Add(phi, stepValue));
+        body.Branch(blocks.header);
+
+        // Header, select the induction
+        IL::Emitter<> header(program, *blocks.header);
+        header.Phi(phi, blocks.entry, entryValue, blocks.body, next);
+        return phi;
+    }
+
+    /// Terminate the header
+    /// \param program the program
+    /// \param blocks the loop skeleton
+    /// \param cond the condition
+    /// \param continueOn the condition value on which the loop continues
+    void EmitHeaderBranch(IL::Program& program, const LoopBlocks& blocks, IL::ID cond, bool continueOn = true) {
+        IL::Emitter<> header(program, *blocks.header);
+        if (continueOn) {
+            header.BranchConditional(cond, blocks.body, blocks.exit, IL::ControlFlow::Loop(blocks.exit, blocks.body));
+        } else {
+            header.BranchConditional(cond, blocks.exit, blocks.body, IL::ControlFlow::Loop(blocks.exit, blocks.body));
+        }
+    }
+
+    /// Compute the trip count of the skeleton
+    std::optional<uint64_t> GetTripCount(IL::Program& program, const LoopBlocks& blocks) {
+        IL::LoopTripCountAnalysis analysis(program, *blocks.fn);
+        REQUIRE(analysis.Compute());
+        return analysis.GetMaxTripCount(blocks.header);
+    }
+
+    /// Get the unsigned 32 bit type
+    const Backend::IL::Type* GetUIntType(IL::Program& program) {
+        return program.GetTypeMap().FindTypeOrAdd(Backend::IL::IntType { .bitWidth = 32, .signedness = false });
+    }
+}
+
+TEST_CASE("Backend.IL.LoopTripCountAnalysis.ConstantBound") {
+    Allocators allocators;
+    IL::Program program(allocators, 0x0);
+
+    LoopBlocks blocks = AllocLoop(program);
+    IL::Emitter<> entry(program, *blocks.entry);
+    entry.Branch(blocks.header);
+
+    // for (i = 0; i < 16; i++)
+    IL::ID phi = EmitPhiInduction(program, blocks, entry.UInt32(0), entry.UInt32(1));
+    EmitHeaderBranch(program, blocks, IL::Emitter<>(program, *blocks.header).LessThan(phi, entry.UInt32(16)));
+
+    REQUIRE(GetTripCount(program, blocks) == 16u);
+}
+
+TEST_CASE("Backend.IL.LoopTripCountAnalysis.RangedBound") {
+    Allocators allocators;
+    IL::Program program(allocators, 0x0);
+
+    LoopBlocks blocks = AllocLoop(program);
+
+    // bound = x & 15
+    IL::Emitter<> entry(program, *blocks.entry);
+    IL::ID bound = entry.BitAnd(entry.Load(entry.Alloca(GetUIntType(program))), entry.UInt32(15));
+    entry.Branch(blocks.header);
+
+    // for (i = 0; i < bound; i++)
+    IL::ID phi = EmitPhiInduction(program, blocks, entry.UInt32(0), entry.UInt32(1));
+    EmitHeaderBranch(program, blocks, IL::Emitter<>(program, *blocks.header).LessThan(phi, bound));
+
+    // Bounded by the upper range
+    REQUIRE(GetTripCount(program, blocks) == 15u);
+}
+
+TEST_CASE("Backend.IL.LoopTripCountAnalysis.NegativeInduction") {
+    // for (i = -4; i < 16; i++), negative under the signed interpretation
+    {
+        Allocators allocators;
+        IL::Program program(allocators, 0x0);
+
+        LoopBlocks blocks = AllocLoop(program);
+        IL::Emitter<> entry(program, *blocks.entry);
+        entry.Branch(blocks.header);
+
+        IL::ID phi = EmitPhiInduction(program, blocks, entry.UInt32(static_cast<uint32_t>(-4)), entry.UInt32(1));
+        EmitHeaderBranch(program, blocks, IL::Emitter<>(program, *blocks.header).LessThan(phi, entry.UInt32(16)));
+
+        // Signedness is unknown, must stay unbounded
+        REQUIRE(!GetTripCount(program, blocks));
+    }
+
+    // for (i = 0; i < 16; i--), only terminates through the unsigned wrap
+    {
+        Allocators allocators;
+        IL::Program program(allocators, 0x0);
+
+        LoopBlocks blocks = AllocLoop(program);
+        IL::Emitter<> entry(program, *blocks.entry);
+        entry.Branch(blocks.header);
+
+        IL::ID phi = EmitPhiInduction(program, blocks, entry.UInt32(0), entry.UInt32(1), true);
+        EmitHeaderBranch(program, blocks, IL::Emitter<>(program, *blocks.header).LessThan(phi, entry.UInt32(16)));
+
+        REQUIRE(!GetTripCount(program, blocks));
+    }
+}
+
+TEST_CASE("Backend.IL.LoopTripCountAnalysis.DecreasingInduction") {
+    Allocators allocators;
+    IL::Program program(allocators, 0x0);
+
+    LoopBlocks blocks = AllocLoop(program);
+    IL::Emitter<> entry(program, *blocks.entry);
+    entry.Branch(blocks.header);
+
+    // for (i = 16; i > 0; i--)
+    IL::ID phi = EmitPhiInduction(program, blocks, entry.UInt32(16), entry.UInt32(1), true);
+    EmitHeaderBranch(program, blocks, IL::Emitter<>(program, *blocks.header).GreaterThan(phi, entry.UInt32(0)));
+
+    REQUIRE(GetTripCount(program, blocks) == 16u);
+}
+
+TEST_CASE("Backend.IL.LoopTripCountAnalysis.VariableInduction") {
+    // Number of stores to the variable within the body
+    for (uint32_t storeCount : {1u, 2u}) {
+        Allocators allocators;
+        IL::Program program(allocators, 0x0);
+
+        LoopBlocks blocks = AllocLoop(program);
+
+        // i = 0
+        IL::Emitter<> entry(program, *blocks.entry);
+        IL::ID variable = entry.Alloca(GetUIntType(program));
+        entry.Store(variable, entry.UInt32(0));
+        entry.Branch(blocks.header);
+
+        // i < 8
+        IL::Emitter<> header(program, *blocks.header);
+        EmitHeaderBranch(program, blocks, header.LessThan(header.Load(variable), entry.UInt32(8)));
+
+        // i++, possibly more than once
+        IL::Emitter<> body(program, *blocks.body);
+        for (uint32_t i = 0; i < storeCount; i++) {
+            body.Store(variable, body.Add(body.Load(variable), entry.UInt32(1)));
+        }
+        body.Branch(blocks.header);
+
+        // Only a single increment per iteration is recognized
+        if (storeCount == 1) {
+            REQUIRE(GetTripCount(program, blocks) == 8u);
+        } else {
+            REQUIRE(!GetTripCount(program, blocks));
+        }
+    }
+}
+
+TEST_CASE("Backend.IL.LoopTripCountAnalysis.CompoundExit") {
+    // while (i < 16 && i < 8)
+    {
+        Allocators allocators;
+        IL::Program program(allocators, 0x0);
+
+        LoopBlocks blocks = AllocLoop(program);
+        IL::Emitter<> entry(program, *blocks.entry);
+        entry.Branch(blocks.header);
+
+        IL::ID phi = EmitPhiInduction(program, blocks, entry.UInt32(0), entry.UInt32(1));
+
+        IL::Emitter<> header(program, *blocks.header);
+        EmitHeaderBranch(program, blocks, header.And(header.LessThan(phi, entry.UInt32(16)), header.LessThan(phi, entry.UInt32(8))));
+
+        // Bounded by either
+        REQUIRE(GetTripCount(program, blocks) == 8u);
+    }
+
+    // Exit on (i >= 16 || i >= 8)
+    {
+        Allocators allocators;
+        IL::Program program(allocators, 0x0);
+
+        LoopBlocks blocks = AllocLoop(program);
+        IL::Emitter<> entry(program, *blocks.entry);
+        entry.Branch(blocks.header);
+
+        IL::ID phi = EmitPhiInduction(program, blocks, entry.UInt32(0), entry.UInt32(1));
+
+        IL::Emitter<> header(program, *blocks.header);
+        EmitHeaderBranch(program, blocks, header.Or(header.GreaterThanEqual(phi, entry.UInt32(16)), header.GreaterThanEqual(phi, entry.UInt32(8))), false);
+
+        REQUIRE(GetTripCount(program, blocks) == 8u);
+    }
+
+    // while (i < 16 || x), continues while either holds
+    {
+        Allocators allocators;
+        IL::Program program(allocators, 0x0);
+
+        LoopBlocks blocks = AllocLoop(program);
+        IL::Emitter<> entry(program, *blocks.entry);
+        IL::ID opaque = entry.Load(entry.Alloca(program.GetTypeMap().FindTypeOrAdd(Backend::IL::BoolType {})));
+        entry.Branch(blocks.header);
+
+        IL::ID phi = EmitPhiInduction(program, blocks, entry.UInt32(0), entry.UInt32(1));
+
+        IL::Emitter<> header(program, *blocks.header);
+        EmitHeaderBranch(program, blocks, header.Or(header.LessThan(phi, entry.UInt32(16)), opaque));
+
+        REQUIRE(!GetTripCount(program, blocks));
+    }
+}
+
+TEST_CASE("Backend.IL.LoopTripCountAnalysis.ModifiedBound") {
+    Allocators allocators;
+    IL::Program program(allocators, 0x0);
+
+    LoopBlocks blocks = AllocLoop(program);
+
+    // bound = 8
+    IL::Emitter<> entry(program, *blocks.entry);
+    IL::ID boundVariable = entry.Alloca(GetUIntType(program));
+    entry.Store(boundVariable, entry.UInt32(8));
+    entry.Branch(blocks.header);
+
+    // for (i = 0; i < bound; i++)
+    IL::ID phi = program.GetIdentifierMap().AllocID();
+    IL::Emitter<> header(program, *blocks.header);
+
+    // bound++
+    IL::Emitter<> body(program, *blocks.body);
+    IL::ID next = body.Add(phi, entry.UInt32(1));
+    body.Store(boundVariable, body.Add(body.Load(boundVariable), entry.UInt32(1)));
+    body.Branch(blocks.header);
+
+    // Select the induction and compare against the current bound
+    header.Phi(phi, blocks.entry, entry.UInt32(0), blocks.body, next);
+    EmitHeaderBranch(program, blocks, header.LessThan(phi, header.Load(boundVariable)));
+
+    // The bound is not invariant
+    REQUIRE(!GetTripCount(program, blocks));
+}
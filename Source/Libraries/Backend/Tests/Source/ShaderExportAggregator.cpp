@@ -0,0 +1,208 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <catch2/catch.hpp>
+
+// Backend
+#include <Backend/ShaderExportKeyAggregator.h>
+
+// Message
+#include <Message/OrderedMessageStorage.h>
+
+// Messages
+#include <Schemas/Feature.h>
+#include <Schemas/Instrumentation.h>
+
+// Std
+#include <vector>
+
+static ShaderExportTypeInfo GetDrawTypeInfo() {
+    ShaderExportTypeInfo info{};
+    info.messageSchema = EmptyDrawCommandMessage::Schema::GetSchema(EmptyDrawCommandMessage::kID);
+    info.typeSize = sizeof(EmptyDrawCommandMessage);
+    return info;
+}
+
+static std::vector<EmptyDrawCommandMessage> GetDrawRecords(std::initializer_list<uint32_t> keys) {
+    std::vector<EmptyDrawCommandMessage> records;
+    for (uint32_t key : keys) {
+        EmptyDrawCommandMessage& record = records.emplace_back();
+        record.indexCount = key;
+        record.instanceCount = key * 10u;
+    }
+
+    return records;
+}
+
+TEST_CASE("Backend.ShaderExportAggregator.Coalesce") {
+    ShaderExportKeyAggregator aggregator;
+    aggregator.SetWindow(1000);
+
+    ShaderExportTypeInfo typeInfo = GetDrawTypeInfo();
+    OrderedMessageStorage storage;
+
+    // Two segments within the same window
+    std::vector<EmptyDrawCommandMessage> first = GetDrawRecords({1, 2, 1, 1});
+    aggregator.Aggregate(0, typeInfo, 0, first.data(), first.size() * sizeof(EmptyDrawCommandMessage), 100, &storage);
+
+    std::vector<EmptyDrawCommandMessage> second = GetDrawRecords({3, 2});
+    aggregator.Aggregate(0, typeInfo, 0, second.data(), second.size() * sizeof(EmptyDrawCommandMessage), 200, &storage);
+
+    // Window has not expired
+    aggregator.Flush(500, &storage);
+    REQUIRE(storage.StreamCount() == 0);
+
+    // Window expired
+    aggregator.Flush(1100, &storage);
+
+    uint32_t consumeCount;
+    storage.ConsumeStreams(&consumeCount, nullptr);
+    REQUIRE(consumeCount == 2);
+
+    MessageStream streams[2];
+    storage.ConsumeStreams(&consumeCount, streams);
+
+    // One record per key, first occurrence retained
+    REQUIRE(streams[0].Is<EmptyDrawCommandMessage>());
+    REQUIRE(streams[0].GetCount() == 3);
+
+    MessageStreamView<EmptyDrawCommandMessage> records(streams[0]);
+    auto recordIt = records.GetIterator();
+    REQUIRE(recordIt->indexCount == 1);
+    REQUIRE(recordIt->instanceCount == 10);
+    ++recordIt;
+    REQUIRE(recordIt->indexCount == 2);
+    ++recordIt;
+    REQUIRE(recordIt->indexCount == 3);
+
+    // Occurrences per key
+    std::vector<const ShaderExportAggregateMessage*> aggregates;
+    for (auto it = ConstMessageStreamView(streams[1]).GetIterator(); it; ++it) {
+        REQUIRE(it.Is(ShaderExportAggregateMessage::kID));
+        aggregates.push_back(it.Get<ShaderExportAggregateMessage>());
+    }
+
+    REQUIRE(aggregates.size() == 3);
+    REQUIRE(aggregates[0]->messageID == EmptyDrawCommandMessage::kID);
+    REQUIRE(aggregates[0]->key.count == sizeof(EmptyDrawCommandMessage) / sizeof(uint32_t));
+    REQUIRE(aggregates[0]->key[0] == 1);
+    REQUIRE(aggregates[0]->count == 3);
+    REQUIRE(aggregates[0]->firstTimestamp == 100);
+    REQUIRE(aggregates[0]->lastTimestamp == 100);
+    REQUIRE(aggregates[1]->key[0] == 2);
+    REQUIRE(aggregates[1]->count == 2);
+    REQUIRE(aggregates[1]->firstTimestamp == 100);
+    REQUIRE(aggregates[1]->lastTimestamp == 200);
+    REQUIRE(aggregates[2]->key[0] == 3);
+    REQUIRE(aggregates[2]->count == 1);
+
+    // Records are matched by key, not by order
+    recordIt = records.GetIterator();
+    REQUIRE(ShaderExportKeyAggregator::IsAggregateOf(*aggregates[0], typeInfo, recordIt.Get()));
+    REQUIRE(!ShaderExportKeyAggregator::IsAggregateOf(*aggregates[2], typeInfo, recordIt.Get()));
+    ++recordIt;
+    ++recordIt;
+    REQUIRE(ShaderExportKeyAggregator::IsAggregateOf(*aggregates[2], typeInfo, recordIt.Get()));
+}
+
+TEST_CASE("Backend.ShaderExportAggregator.Version") {
+    ShaderExportKeyAggregator aggregator;
+    aggregator.SetWindow(1000);
+
+    ShaderExportTypeInfo typeInfo = GetDrawTypeInfo();
+    OrderedMessageStorage storage;
+
+    // Records of different versions are never coalesced
+    std::vector<EmptyDrawCommandMessage> records = GetDrawRecords({1, 1});
+    aggregator.Aggregate(0, typeInfo, 0, records.data(), records.size() * sizeof(EmptyDrawCommandMessage), 100, &storage);
+    aggregator.Aggregate(0, typeInfo, 1, records.data(), records.size() * sizeof(EmptyDrawCommandMessage), 200, &storage);
+    REQUIRE(storage.StreamCount() == 2);
+
+    // Force the remaining window
+    aggregator.Flush(UINT64_MAX, &storage);
+    REQUIRE(storage.StreamCount() == 4);
+
+    MessageStream streams[4];
+    uint32_t consumeCount = 4;
+    storage.ConsumeStreams(&consumeCount, streams);
+    REQUIRE(streams[0].GetVersionID() == 0);
+    REQUIRE(streams[2].GetVersionID() == 1);
+}
+
+TEST_CASE("Backend.ShaderExportAggregator.PrimaryRecord") {
+    ShaderExportKeyAggregator aggregator;
+    aggregator.SetWindow(1000);
+
+    ShaderExportTypeInfo typeInfo = GetDrawTypeInfo();
+    OrderedMessageStorage storage;
+
+    // Same first dword, different trailing dwords
+    std::vector<EmptyDrawCommandMessage> records = GetDrawRecords({1, 1, 1});
+    records[1].instanceCount = 20;
+    aggregator.Aggregate(0, typeInfo, 0, records.data(), records.size() * sizeof(EmptyDrawCommandMessage), 100, &storage);
+
+    // Masked bits never split identities
+    typeInfo.keyMask = ~0x80000000u;
+    records = GetDrawRecords({1 | 0x80000000u});
+    records[0].instanceCount = 10;
+    aggregator.Aggregate(0, typeInfo, 0, records.data(), records.size() * sizeof(EmptyDrawCommandMessage), 200, &storage);
+
+    aggregator.Flush(UINT64_MAX, &storage);
+
+    MessageStream streams[2];
+    uint32_t consumeCount = 2;
+    storage.ConsumeStreams(&consumeCount, streams);
+    REQUIRE(consumeCount == 2);
+
+    // Distinct primary records are never merged
+    REQUIRE(streams[0].GetCount() == 2);
+
+    MessageStreamView<EmptyDrawCommandMessage> view(streams[0]);
+    auto recordIt = view.GetIterator();
+    REQUIRE(recordIt->instanceCount == 10);
+    ++recordIt;
+    REQUIRE(recordIt->instanceCount == 20);
+
+    // Occurrences per record
+    std::vector<const ShaderExportAggregateMessage*> aggregates;
+    for (auto it = ConstMessageStreamView(streams[1]).GetIterator(); it; ++it) {
+        aggregates.push_back(it.Get<ShaderExportAggregateMessage>());
+    }
+
+    REQUIRE(aggregates.size() == 2);
+    REQUIRE(aggregates[0]->key[0] == 1);
+    REQUIRE(aggregates[0]->count == 3);
+    REQUIRE(aggregates[1]->key[0] == 1);
+    REQUIRE(aggregates[1]->count == 1);
+
+    // Same first dword, the full key tells the records apart
+    recordIt = view.GetIterator();
+    REQUIRE(ShaderExportKeyAggregator::IsAggregateOf(*aggregates[0], typeInfo, recordIt.Get()));
+    REQUIRE(!ShaderExportKeyAggregator::IsAggregateOf(*aggregates[1], typeInfo, recordIt.Get()));
+    ++recordIt;
+    REQUIRE(ShaderExportKeyAggregator::IsAggregateOf(*aggregates[1], typeInfo, recordIt.Get()));
+}
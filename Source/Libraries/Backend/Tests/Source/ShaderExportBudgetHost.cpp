@@ -0,0 +1,153 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <catch2/catch.hpp>
+
+// Backend
+#include <Backend/ShaderExportBudgetHost.h>
+#include <Backend/ShaderData/IShaderDataHost.h>
+
+// Common
+#include <Common/Registry.h>
+
+// Std
+#include <vector>
+
+/// Host visible shader data backed by system memory
+class TestShaderDataHost final : public IShaderDataHost {
+public:
+    /// Overrides
+    ShaderDataID CreateBuffer(const ShaderDataBufferInfo &info) override {
+        buffers.emplace_back(info.elementCount);
+        return static_cast<ShaderDataID>(buffers.size() - 1);
+    }
+
+    ShaderDataID CreateEventData(const ShaderDataEventInfo &info) override {
+        return InvalidShaderDataID;
+    }
+
+    ShaderDataID CreateDescriptorData(const ShaderDataDescriptorInfo &info) override {
+        return InvalidShaderDataID;
+    }
+
+    ShaderDataMappingID CreateMapping(ShaderDataID data, uint64_t tileCount) override {
+        return InvalidShaderDataMappingID;
+    }
+
+    void *Map(ShaderDataID rid) override {
+        return buffers[rid].data();
+    }
+
+    void FlushMappedRange(ShaderDataID rid, size_t offset, size_t length) override {
+        flushCount++;
+    }
+
+    void Destroy(ShaderDataID rid) override {
+
+    }
+
+    void DestroyMapping(ShaderDataMappingID mid) override {
+
+    }
+
+    void Enumerate(uint32_t *count, ShaderDataInfo *out, ShaderDataTypeSet mask) override {
+        *count = 0;
+    }
+
+    ShaderDataCapabilityTable GetCapabilityTable() override {
+        return {};
+    }
+
+    /// All buffers
+    std::vector<std::vector<uint32_t>> buffers;
+
+    /// Number of flushes
+    uint32_t flushCount{0};
+};
+
+TEST_CASE("Backend.ShaderExportBudgetHost.Configured") {
+    Registry registry;
+
+    auto dataHost = registry.AddNew<TestShaderDataHost>();
+    auto budgetHost = registry.AddNew<ShaderExportBudgetHost>();
+    REQUIRE(budgetHost->Install());
+
+    // Unlimited by default, budget checks are not instrumented
+    const std::vector<uint32_t>& limits = dataHost->buffers[budgetHost->GetDataID()];
+    REQUIRE(!budgetHost->IsConfigured());
+    REQUIRE(limits[7] == kShaderExportUnlimitedBudget);
+
+    // Limit a single site
+    budgetHost->SetBudget(7, 16);
+    REQUIRE(budgetHost->IsConfigured());
+    REQUIRE(limits[7] == 16);
+
+    // Aliased sites share the slot
+    budgetHost->SetBudget(7 + kShaderExportBudgetSlotCount, 32);
+    REQUIRE(budgetHost->IsConfigured());
+    REQUIRE(limits[7] == 32);
+
+    // Limit another site
+    budgetHost->SetBudget(8, 4);
+    REQUIRE(budgetHost->IsConfigured());
+
+    // Unlimiting a single site keeps the other
+    budgetHost->SetBudget(7, 0);
+    REQUIRE(budgetHost->IsConfigured());
+    REQUIRE(limits[7] == kShaderExportUnlimitedBudget);
+
+    // Unlimiting the last site
+    budgetHost->SetBudget(8, 0);
+    REQUIRE(!budgetHost->IsConfigured());
+}
+
+TEST_CASE("Backend.ShaderExportBudgetHost.Reset") {
+    Registry registry;
+
+    auto dataHost = registry.AddNew<TestShaderDataHost>();
+    auto budgetHost = registry.AddNew<ShaderExportBudgetHost>();
+    REQUIRE(budgetHost->Install());
+
+    // Limit all sites
+    const std::vector<uint32_t>& limits = dataHost->buffers[budgetHost->GetDataID()];
+    budgetHost->ResetBudgets(2);
+    REQUIRE(budgetHost->IsConfigured());
+    REQUIRE(limits[0] == 2);
+    REQUIRE(limits[kShaderExportBudgetSlotCount - 1] == 2);
+
+    // Unlimiting a single site keeps the others
+    budgetHost->SetBudget(0, 0);
+    REQUIRE(budgetHost->IsConfigured());
+
+    // Unlimit all sites
+    budgetHost->ResetBudgets(0);
+    REQUIRE(!budgetHost->IsConfigured());
+    REQUIRE(limits[0] == kShaderExportUnlimitedBudget);
+
+    // Changes are always flushed
+    REQUIRE(dataHost->flushCount == 4);
+}
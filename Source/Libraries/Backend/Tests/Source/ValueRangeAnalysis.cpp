@@ -0,0 +1,96 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <catch2/catch.hpp>
+
+// Backend
+#include <Backend/IL/Emitters/Emitter.h>
+#include <Backend/IL/Analysis/ValueRangeAnalysis.h>
+
+TEST_CASE("Backend.IL.ValueRangeAnalysis") {
+    Allocators allocators;
+
+    IL::Program program(allocators, 0x0);
+
+    IL::IdentifierMap& map = program.GetIdentifierMap();
+
+    IL::Function* fn = program.GetFunctionList().AllocFunction(map.AllocID());
+
+    IL::BasicBlock* bb = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+    IL::Emitter<> emitter(program, *bb);
+
+    // Opaque value
+    const Backend::IL::Type* uintType = program.GetTypeMap().FindTypeOrAdd(Backend::IL::IntType { .bitWidth = 32, .signedness = false });
+    IL::ID value = emitter.Load(emitter.Alloca(uintType));
+
+    // 128 + (value & 1), dominating index
+    IL::ID covering = emitter.Add(emitter.UInt32(128), emitter.BitAnd(value, emitter.UInt32(1)));
+
+    // 64 + (value & 3), covered
+    IL::ID covered = emitter.Add(emitter.UInt32(64), emitter.BitAnd(value, emitter.UInt32(3)));
+
+    // 256 + (value & 1), not covered
+    IL::ID uncovered = emitter.Add(emitter.UInt32(256), emitter.BitAnd(value, emitter.UInt32(1)));
+
+    // value & 7, covered by the mask
+    IL::ID masked = emitter.BitAnd(value, emitter.UInt32(7));
+
+    // Unbounded
+    IL::ID unbounded = emitter.Add(value, emitter.UInt32(1));
+
+    emitter.Return();
+
+    IL::ValueRangeAnalysis analysis(program, *fn);
+    REQUIRE(analysis.Compute());
+
+    // Ranges
+    REQUIRE(analysis.GetRange(covering).lower == 128);
+    REQUIRE(analysis.GetRange(covering).upper == 129);
+    REQUIRE(analysis.GetRange(covered).lower == 64);
+    REQUIRE(analysis.GetRange(covered).upper == 67);
+    REQUIRE(analysis.GetRange(masked).upper == 7);
+    REQUIRE(analysis.GetRange(unbounded).IsFull());
+
+    // Count all candidates covered by the dominating index
+    IL::ID candidates[] = { covered, uncovered, masked, unbounded, value };
+
+    uint32_t coveredCount = 0;
+    for (IL::ID candidate : candidates) {
+        coveredCount += analysis.IsLessThanEqual(candidate, covering);
+    }
+
+    // Only the bounded candidates are elided
+    REQUIRE(coveredCount == 2);
+    REQUIRE(analysis.IsLessThanEqual(covered, covering));
+    REQUIRE(analysis.IsLessThanEqual(masked, covering));
+
+    // Values are covered by themselves and their masks
+    REQUIRE(analysis.IsLessThanEqual(value, value));
+    REQUIRE(analysis.IsLessThanEqual(masked, value));
+    REQUIRE(!analysis.IsLessThanEqual(value, masked));
+}
@@ -0,0 +1,470 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+// Bridge
+#include <Bridge/HostServerBridge.h>
+#include <Bridge/RemoteClientBridge.h>
+#include <Bridge/IBridgeListener.h>
+#include <Bridge/Asio/AsioHostResolverServer.h>
+
+// Message
+#include <Message/MessageStream.h>
+#include <Message/IMessageStorage.h>
+
+// Common
+#include <Common/Registry.h>
+#include <Common/GlobalUID.h>
+
+// Schemas
+#include <Schemas/HostResolve.h>
+#include <Schemas/PingPong.h>
+
+// Std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/// Benchmark configuration
+struct BenchmarkConfig {
+    /// Shared port of the resolver stand-in, kept away from the default to not collide with a running resolver
+    uint32_t port{kBridgeSharedPort + 1};
+
+    /// Number of connected clients
+    uint32_t clients{1};
+
+    /// Duration of the measurement, in milliseconds
+    uint32_t duration{5'000};
+
+    /// Number of small messages per ordered stream
+    uint32_t orderedMessages{16};
+
+    /// Number of messages per export stream, zero disables export streams
+    uint32_t exportMessages{64'000};
+
+    /// Number of ordered streams per export stream
+    uint32_t exportInterval{16};
+
+    /// Number of streams per commit
+    uint32_t batch{32};
+
+    /// Streams per second, zero produces as fast as possible
+    uint32_t rate{0};
+
+    /// Allow the shared memory transport
+    bool sharedMemory{false};
+};
+
+/// Time after which connection attempts fail
+static constexpr std::chrono::milliseconds kConnectTimeout{10'000};
+
+/// Per client measurements
+class BenchmarkListener : public TComponent<BenchmarkListener>, public IBridgeListener {
+public:
+    COMPONENT(BenchmarkListener);
+
+    /// Overrides
+    void Handle(const MessageStream *streams, uint32_t count) override {
+        const uint64_t now = GetTimeStamp();
+
+        std::lock_guard guard(mutex);
+
+        for (uint32_t i = 0; i < count; i++) {
+            const MessageStream& stream = streams[i];
+
+            // Commit time stamp, only present on stamp streams
+            uint64_t commitStamp = 0;
+            uint64_t messageCount = 0;
+
+            if (stream.GetSchema().type == MessageSchemaType::Ordered) {
+                ConstMessageStreamView view(stream);
+                for (auto it = view.GetIterator(); it; ++it) {
+                    switch (it.GetID()) {
+                        case HostConnectedMessage::kID: {
+                            connected = it.Get<HostConnectedMessage>()->accepted;
+                            responded = true;
+                            break;
+                        }
+                        case PingPongMessage::kID: {
+                            // Payload messages are not stamped
+                            if (uint64_t timeStamp = it.Get<PingPongMessage>()->timeStamp) {
+                                commitStamp = timeStamp;
+                            } else {
+                                messageCount++;
+                            }
+                            break;
+                        }
+                    }
+                }
+            } else {
+                ConstMessageStreamView<PingPongMessage> view(stream);
+                for (auto it = view.GetIterator(); it; ++it) {
+                    messageCount++;
+                }
+            }
+
+            // Only measure within the window
+            if (!measuring) {
+                continue;
+            }
+
+            // Stamp streams trail their commit, so the latency covers the entire commit
+            if (commitStamp) {
+                latencies.push_back(now - commitStamp);
+                continue;
+            }
+
+            // Not a benchmark stream?
+            if (!messageCount) {
+                continue;
+            }
+
+            streamCount++;
+            messages += messageCount;
+            bytes += stream.GetByteSize();
+
+            // Receipts may trail production, the window ends at the last receipt
+            lastReceiptStamp = now;
+        }
+    }
+
+    /// Get the current time stamp, in nanoseconds
+    static uint64_t GetTimeStamp() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// Shared lock
+    std::mutex mutex;
+
+    /// Connection state, connected is valid once responded
+    std::atomic<bool> responded{false};
+    std::atomic<bool> connected{false};
+
+    /// Are streams measured?
+    std::atomic<bool> measuring{false};
+
+    /// Totals
+    uint64_t streamCount{0};
+    uint64_t messages{0};
+    uint64_t bytes{0};
+
+    /// Time stamp of the last measured receipt, in nanoseconds
+    uint64_t lastReceiptStamp{0};
+
+    /// All commit latencies, in nanoseconds
+    std::vector<uint64_t> latencies;
+};
+
+/// Wait for a condition
+/// \param predicate the condition
+/// \param timeout maximum time to wait
+/// \return false if timed out
+template<typename F>
+static bool WaitFor(const F& predicate, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // OK
+    return true;
+}
+
+/// Parse all arguments
+/// \param argc argument count
+/// \param argv argument values
+/// \param config destination configuration
+/// \return false if an argument is invalid
+static bool ParseArguments(int32_t argc, const char* const* argv, BenchmarkConfig& config) {
+    for (int32_t i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+
+        // Expect key=value
+        size_t split = arg.find('=');
+        if (arg.substr(0, 2) != "--" || split == std::string_view::npos) {
+            std::cerr << "Invalid argument '" << arg << "', expected --key=value" << std::endl;
+            return false;
+        }
+
+        // Split argument
+        std::string_view key = arg.substr(2, split - 2);
+        uint32_t value = static_cast<uint32_t>(std::strtoul(arg.data() + split + 1, nullptr, 10));
+
+        if (key == "port") {
+            config.port = value;
+        } else if (key == "clients") {
+            config.clients = std::max(1u, value);
+        } else if (key == "duration") {
+            config.duration = value;
+        } else if (key == "ordered-messages") {
+            config.orderedMessages = value;
+        } else if (key == "export-messages") {
+            config.exportMessages = value;
+        } else if (key == "export-interval") {
+            config.exportInterval = std::max(1u, value);
+        } else if (key == "batch") {
+            config.batch = std::max(1u, value);
+        } else if (key == "rate") {
+            config.rate = value;
+        } else if (key == "shared-memory") {
+            config.sharedMemory = value != 0;
+        } else {
+            std::cerr << "Unknown argument '" << key << "'" << std::endl;
+            return false;
+        }
+    }
+
+    // OK
+    return true;
+}
+
+/// Get a latency percentile
+/// \param sorted sorted latencies
+/// \param percentile percentile in [0, 1]
+/// \return latency in milliseconds
+static double GetPercentile(const std::vector<uint64_t>& sorted, double percentile) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+
+    size_t index = std::min(sorted.size() - 1, static_cast<size_t>(percentile * sorted.size()));
+    return sorted[index] / 1e6;
+}
+
+int main(int32_t argc, const char* const* argv) {
+    BenchmarkConfig config;
+    if (!ParseArguments(argc, argv, config)) {
+        return 1;
+    }
+
+    std::cout << "Bridge Benchmark\n" << std::endl;
+
+    Registry registry;
+
+    // Host resolver stand-in
+    AsioConfig resolverConfig;
+    resolverConfig.hostResolvePort = config.port;
+
+    AsioHostResolverServer resolver(resolverConfig);
+    if (!resolver.IsOpen()) {
+        std::cerr << "Failed to open host resolver at port " << config.port << std::endl;
+        return 1;
+    }
+
+    // Wait for server allocations
+    std::atomic<bool> allocated{false};
+    resolver.onAllocated.Add(0, [&](const AsioHostClientInfo&) {
+        allocated = true;
+    });
+
+    // Server endpoint, reserved token to skip discovery
+    EndpointConfig endpointConfig;
+    endpointConfig.sharedPort = config.port;
+    endpointConfig.reservedToken = GlobalUID::New();
+    endpointConfig.sharedMemory = config.sharedMemory;
+    endpointConfig.device.applicationName = "Bridge Benchmark";
+
+    // Create server
+    std::cout << "Starting server... " << std::flush;
+    auto server = registry.New<HostServerBridge>();
+    if (!server->Install(endpointConfig)) {
+        std::cerr << "Failed to install server bridge" << std::endl;
+        return 1;
+    }
+
+    // Wait for the resolver
+    if (!WaitFor([&] { return allocated.load(); }, kConnectTimeout)) {
+        std::cerr << "Timed out waiting for the server allocation" << std::endl;
+        return 1;
+    }
+
+    std::cout << "OK." << std::endl;
+
+    // Connect all clients
+    std::cout << "Connecting " << config.clients << " client(s)... " << std::flush;
+
+    std::vector<ComRef<RemoteClientBridge>> clients;
+    std::vector<ComRef<BenchmarkListener>> listeners;
+    for (uint32_t i = 0; i < config.clients; i++) {
+        EndpointResolve resolve;
+        resolve.config = endpointConfig;
+        resolve.ipvxAddress = kAsioLocalhost;
+
+        // Create client, dispatch on arrival
+        auto client = registry.New<RemoteClientBridge>();
+        client->SetCommitOnAppend(true);
+
+        // Register listeners
+        auto listener = registry.New<BenchmarkListener>();
+        client->Register(listener);
+        client->Register(PingPongMessage::kID, listener);
+
+        // Connect to the resolver
+        if (!client->Install(resolve)) {
+            std::cerr << "Failed to connect client to the resolver" << std::endl;
+            return 1;
+        }
+
+        // Request the server
+        client->RequestClientAsync(endpointConfig.reservedToken);
+
+        // Wait for connection
+        if (!WaitFor([&] { return listener->responded.load(); }, kConnectTimeout)) {
+            std::cerr << "Timed out waiting for client connection" << std::endl;
+            return 1;
+        }
+
+        // Rejected by the server?
+        if (!listener->connected) {
+            std::cerr << "Client connection rejected" << std::endl;
+            return 1;
+        }
+
+        clients.push_back(client);
+        listeners.push_back(listener);
+    }
+
+    // Allow pending negotiations to finish
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::cout << "OK.\n" << std::endl;
+
+    // Start measuring
+    for (const ComRef<BenchmarkListener>& listener : listeners) {
+        listener->measuring = true;
+    }
+
+    // Production totals
+    uint64_t producedStreams = 0;
+    uint64_t producedBytes = 0;
+
+    // Produce for the given duration
+    const uint64_t startStamp = BenchmarkListener::GetTimeStamp();
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + std::chrono::milliseconds(config.duration);
+    while (std::chrono::steady_clock::now() < end) {
+        for (uint32_t i = 0; i < config.batch; i++) {
+            MessageStream stream;
+
+            // Export stream?
+            if (config.exportMessages && producedStreams % config.exportInterval == config.exportInterval - 1) {
+                MessageStreamView<PingPongMessage> view(stream);
+                for (uint32_t j = 0; j < config.exportMessages; j++) {
+                    view.Add()->timeStamp = 0;
+                }
+            } else {
+                MessageStreamView view(stream);
+                for (uint32_t j = 0; j < config.orderedMessages; j++) {
+                    view.Add<PingPongMessage>()->timeStamp = 0;
+                }
+            }
+
+            producedStreams++;
+            producedBytes += stream.GetByteSize();
+            server->GetOutput()->AddStream(stream);
+        }
+
+        // Stamp the commit last, it arrives after every stream of the batch
+        MessageStream stampStream;
+        MessageStreamView stampView(stampStream);
+        stampView.Add<PingPongMessage>()->timeStamp = BenchmarkListener::GetTimeStamp();
+        server->GetOutput()->AddStream(stampStream);
+
+        // Push to all clients
+        server->Commit();
+
+        // Pace to the requested rate
+        if (config.rate) {
+            std::this_thread::sleep_until(start + std::chrono::nanoseconds(producedStreams * 1'000'000'000ull / config.rate));
+        }
+    }
+
+    // Elapsed production window
+    const uint64_t productionStamp = BenchmarkListener::GetTimeStamp();
+
+    // Allow in flight streams to arrive
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    // Stop measuring
+    for (const ComRef<BenchmarkListener>& listener : listeners) {
+        listener->measuring = false;
+    }
+
+    // Merge all measurements
+    uint64_t streams = 0;
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+    std::vector<uint64_t> latencies;
+
+    // Measured window, covers everything received, including streams that arrived after production
+    uint64_t endStamp = productionStamp;
+
+    for (const ComRef<BenchmarkListener>& listener : listeners) {
+        std::lock_guard guard(listener->mutex);
+        endStamp = std::max(endStamp, listener->lastReceiptStamp);
+        streams += listener->streamCount;
+        messages += listener->messages;
+        bytes += listener->bytes;
+        latencies.insert(latencies.end(), listener->latencies.begin(), listener->latencies.end());
+    }
+
+    // Elapsed measured window
+    const double seconds = (endStamp - startStamp) / 1e9;
+
+    // Sort for percentiles
+    std::sort(latencies.begin(), latencies.end());
+
+    // Server side statistics
+    BridgeInfo info = server->GetInfo();
+
+    // Report
+    std::cout << "Produced    : " << producedStreams << " streams, " << producedBytes / 1e6 << " MB\n";
+    std::cout << "Received    : " << streams << " streams, " << messages << " messages, " << bytes / 1e6 << " MB (all clients)\n";
+    std::cout << "Dropped     : " << info.streamsDropped << " streams, " << info.bytesDropped / 1e6 << " MB\n";
+    std::cout << "Throughput  : " << messages / seconds << " messages/s, " << streams / seconds << " streams/s, " << bytes / seconds / 1e6 << " MB/s\n";
+    std::cout << "Latency     : commit to delivery of the entire commit\n";
+    std::cout << "Latency p50 : " << GetPercentile(latencies, 0.50) << " ms\n";
+    std::cout << "Latency p99 : " << GetPercentile(latencies, 0.99) << " ms\n";
+    std::cout << "Latency max : " << GetPercentile(latencies, 1.0) << " ms" << std::endl;
+
+    // Disconnect all clients before the server
+    for (const ComRef<RemoteClientBridge>& client : clients) {
+        client->Stop();
+    }
+
+    // OK
+    return 0;
+}
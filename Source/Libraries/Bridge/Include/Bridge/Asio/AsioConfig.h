@@ -29,6 +29,7 @@
 // Bridge
 #include "AsioDebug.h"
 #include "AsioProtocol.h"
+#include "AsioSendQueue.h"
 
 // Std
 #include <cstdint>
@@ -43,6 +44,9 @@ struct AsioConfig {
 
     /// Optional, reserved token
     AsioHostClientToken reservedToken{};
+
+    /// Outbound queue limits per client
+    AsioSendQueueConfig sendQueue;
 };
 
 /// Remote endpoint config
@@ -41,7 +41,7 @@ struct AsioHostServer {
     /// Constructor
     /// \param config the shared configuration
     /// \param info general information about the server
-    AsioHostServer(const AsioConfig& config, const AsioHostClientInfo& info) : info(info), resolveClient(kAsioLocalhost, config.hostResolvePort) {
+    AsioHostServer(const AsioConfig& config, const AsioHostClientInfo& info) : info(info), sendQueueConfig(config.sendQueue), resolveClient(kAsioLocalhost, config.hostResolvePort) {
         resolveClient.SetReadCallback([this](AsioSocketHandler& handler, const void *data, uint64_t size) {
             return OnReadAsync(handler, data, size);
         });
@@ -67,6 +67,42 @@ struct AsioHostServer {
         server->WriteAsync(data, size);
     }
 
+    /// Broadcast a packet to all clients through their bounded send queues
+    /// \param header header to be sent, copied
+    /// \param headerSize byte count of the header
+    /// \param data data to be sent, copied
+    /// \param size byte count of data
+    /// \param priority priority of the packet
+    void BroadcastServerQueuedAsync(const void* header, uint64_t headerSize, const void *data, uint64_t size, AsioSendPriority priority) {
+        if (!server) {
+            return;
+        }
+
+        server->WriteQueuedAsync(header, headerSize, data, size, priority);
+    }
+
+    /// Get the send queue statistics of all clients
+    /// \param out destination statistics, one per client
+    void GetClientSendQueueStats(std::vector<AsioSendQueueStats>& out) {
+        if (!server) {
+            return;
+        }
+
+        server->GetSendQueueStats(out);
+    }
+
+    /// Check if a client is still connected
+    /// \param uid client handler guid
+    /// \return false if closed or not found
+    bool IsClientOpen(const GlobalUID& uid) {
+        if (!server) {
+            return false;
+        }
+
+        std::shared_ptr<AsioSocketHandler> handler = server->GetSocketHandler(uid);
+        return handler && handler->IsOpen();
+    }
+
     /// Is the resolver still open?
     bool IsOpen() {
         return resolveClient.IsOpen();
@@ -206,6 +242,9 @@ protected:
         // Set callbacks
         server->SetReadCallback(onRead);
 
+        // Bound all client queues
+        server->SetSendQueueConfig(sendQueueConfig);
+
         // Start the runner
         serverRunner.RunAsync(*server);
     }
@@ -213,6 +252,9 @@ protected:
 private:
     AsioHostClientInfo info;
 
+    /// Send queue configuration of all clients
+    AsioSendQueueConfig sendQueueConfig;
+
     /// Allocated token
     AsioHostClientToken token{};
 
@@ -0,0 +1,213 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Std
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+/// Priority of a queued packet
+enum class AsioSendPriority : uint32_t {
+    /// May be sampled or dropped under overload, such as export streams
+    Low,
+
+    /// Always delivered
+    Control
+};
+
+/// Outbound queue configuration
+struct AsioSendQueueConfig {
+    /// Number of queued bytes after which low priority packets are sampled
+    uint64_t sampleWaterMark = 16'000'000;
+
+    /// Number of queued bytes after which low priority packets are dropped
+    uint64_t highWaterMark = 64'000'000;
+
+    /// While sampling, one in every interval low priority packets is kept
+    uint32_t sampleInterval = 8;
+
+    /// Maximum number of bytes coalesced into a single write
+    uint64_t maxCoalescedBytes = 4'000'000;
+};
+
+/// Outbound queue statistics
+struct AsioSendQueueStats {
+    /// Number of bytes pending, including the write in flight
+    uint64_t queuedBytes{0};
+
+    /// Number of packets pending, excluding the write in flight
+    uint64_t queuedPackets{0};
+
+    /// Highest number of pending bytes observed
+    uint64_t peakQueuedBytes{0};
+
+    /// Number of low priority packets dropped
+    uint64_t droppedPackets{0};
+
+    /// Number of low priority bytes dropped
+    uint64_t droppedBytes{0};
+};
+
+/// Bounded outbound packet queue of a single connection
+/// Packets are copied on enqueue, consecutive packets are coalesced into single writes
+class AsioSendQueue {
+public:
+    /// Set the configuration
+    /// \param value new configuration, applies to future packets
+    void SetConfig(const AsioSendQueueConfig& value) {
+        std::lock_guard guard(mutex);
+        config = value;
+    }
+
+    /// Enqueue a packet, composed of a header and its payload
+    /// \param header header data, copied
+    /// \param headerSize byte size of the header
+    /// \param data payload data, copied
+    /// \param dataSize byte size of the payload
+    /// \param priority priority of the packet
+    /// \return false if dropped
+    bool Enqueue(const void* header, uint64_t headerSize, const void* data, uint64_t dataSize, AsioSendPriority priority) {
+        std::lock_guard guard(mutex);
+
+        // Total byte size of the packet
+        const uint64_t size = headerSize + dataSize;
+
+        // Low priority packets are subject to the water marks
+        if (priority == AsioSendPriority::Low && !Admit()) {
+            stats.droppedPackets++;
+            stats.droppedBytes += size;
+            return false;
+        }
+
+        // Copy the packet
+        std::vector<char>& packet = packets.emplace_back(size);
+        if (headerSize) {
+            std::memcpy(packet.data(), header, headerSize);
+        }
+        if (dataSize) {
+            std::memcpy(packet.data() + headerSize, data, dataSize);
+        }
+
+        // Accounting
+        stats.queuedBytes += size;
+        stats.queuedPackets++;
+        stats.peakQueuedBytes = std::max(stats.peakQueuedBytes, stats.queuedBytes);
+        return true;
+    }
+
+    /// Acquire the next write, coalesced from all consecutive packets within limits
+    /// Only a single write may be in flight at any time
+    /// \return nullptr if nothing to write or a write is already in flight
+    const std::vector<char>* AcquireWrite() {
+        std::lock_guard guard(mutex);
+
+        // Nothing to do?
+        if (inFlight || packets.empty()) {
+            return nullptr;
+        }
+
+        // Take the first packet as is, avoids copies for large packets
+        flight = std::move(packets.front());
+        packets.pop_front();
+
+        // Coalesce all small successors
+        while (!packets.empty() && flight.size() + packets.front().size() <= config.maxCoalescedBytes) {
+            flight.insert(flight.end(), packets.front().begin(), packets.front().end());
+            packets.pop_front();
+        }
+
+        // Accounting
+        stats.queuedPackets = packets.size();
+
+        // OK
+        inFlight = true;
+        return &flight;
+    }
+
+    /// Release the current write
+    void ReleaseWrite() {
+        std::lock_guard guard(mutex);
+
+        // Accounting
+        stats.queuedBytes -= flight.size();
+
+        // Keep the allocation around for the next write
+        flight.clear();
+        inFlight = false;
+    }
+
+    /// Get the current statistics
+    AsioSendQueueStats GetStats() {
+        std::lock_guard guard(mutex);
+        return stats;
+    }
+
+private:
+    /// Check if a low priority packet may be admitted
+    /// \return false if it should be dropped
+    bool Admit() {
+        // Overloaded?
+        if (stats.queuedBytes >= config.highWaterMark) {
+            return false;
+        }
+
+        // Sampling?
+        if (stats.queuedBytes >= config.sampleWaterMark) {
+            return (sampleCounter++ % std::max(1u, config.sampleInterval)) == 0;
+        }
+
+        // Reset sampling on recovery
+        sampleCounter = 0;
+        return true;
+    }
+
+private:
+    /// Current configuration
+    AsioSendQueueConfig config;
+
+    /// Current statistics
+    AsioSendQueueStats stats;
+
+    /// All pending packets
+    std::deque<std::vector<char>> packets;
+
+    /// The write in flight
+    std::vector<char> flight;
+
+    /// Is a write in flight?
+    bool inFlight{false};
+
+    /// Number of low priority packets seen while sampling
+    uint32_t sampleCounter{0};
+
+    /// Shared lock
+    std::mutex mutex;
+};
@@ -91,6 +91,51 @@ public:
         }
     }
 
+    /// Write through the bounded send queues of all non-redirected connections, async
+    /// \param header header to be sent, copied
+    /// \param headerSize byte count of the header
+    /// \param data data to be sent, copied
+    /// \param size byte count of data
+    /// \param priority priority of the packet
+    void WriteQueuedAsync(const void* header, uint64_t headerSize, const void *data, uint64_t size, AsioSendPriority priority) {
+        std::lock_guard guard(mutex);
+
+        // Prune beforehand
+        Prune();
+
+        // Write to handlers
+        for (const std::shared_ptr<AsioSocketHandler>& connection : connections) {
+            // Redirected handlers are written to by their owner
+            if (connection->IsRedirected()) {
+                continue;
+            }
+
+            connection->WriteQueuedAsync(header, headerSize, data, size, priority);
+        }
+    }
+
+    /// Set the send queue configuration of all current and future connections
+    /// \param config queue configuration
+    void SetSendQueueConfig(const AsioSendQueueConfig& config) {
+        std::lock_guard guard(mutex);
+        sendQueueConfig = config;
+
+        // Propagate to children
+        for (const std::shared_ptr<AsioSocketHandler>& connection : connections) {
+            connection->SetSendQueueConfig(config);
+        }
+    }
+
+    /// Get the send queue statistics of all connections
+    /// \param out destination statistics, one per connection
+    void GetSendQueueStats(std::vector<AsioSendQueueStats>& out) {
+        std::lock_guard guard(mutex);
+
+        for (const std::shared_ptr<AsioSocketHandler>& connection : connections) {
+            out.push_back(connection->GetSendQueueStats());
+        }
+    }
+
     /// Get a socket handler
     /// \param uuid the socket handler guid
     /// \return nullptr if not found
@@ -154,6 +199,7 @@ private:
             // Add as valid connection
             {
                 std::lock_guard guard(mutex);
+                connection->SetSendQueueConfig(sendQueueConfig);
                 connections.emplace_back(connection);
             }
 
@@ -215,6 +261,9 @@ private:
     AsioReadDelegate onRead;
     AsioErrorDelegate onError;
 
+    /// Send queue configuration of all connections
+    AsioSendQueueConfig sendQueueConfig;
+
     /// Acceptor helper
     asio::ip::tcp::acceptor acceptor;
 };
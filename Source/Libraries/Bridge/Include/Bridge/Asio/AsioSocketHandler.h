@@ -30,6 +30,7 @@
 #include "Asio.h"
 #include "AsioDelegates.h"
 #include "AsioConfig.h"
+#include "AsioSendQueue.h"
 
 // Common
 #include <Common/Assert.h>
@@ -133,6 +134,45 @@ public:
         }
     }
 
+    /// Write through the bounded send queue, async
+    /// \param header header to be sent, copied
+    /// \param headerSize byte count of the header
+    /// \param data data to be sent, copied
+    /// \param size byte count of data
+    /// \param priority priority of the packet, low priority packets may be dropped under overload
+    /// \return false if dropped
+    bool WriteQueuedAsync(const void* header, uint64_t headerSize, const void *data, uint64_t size, AsioSendPriority priority) {
+        if (!sendQueue.Enqueue(header, headerSize, data, size, priority)) {
+            return false;
+        }
+
+        // Kick the queue if idle
+        FlushQueue();
+        return true;
+    }
+
+    /// Set the send queue configuration
+    /// \param config queue configuration
+    void SetSendQueueConfig(const AsioSendQueueConfig& config) {
+        sendQueue.SetConfig(config);
+    }
+
+    /// Get the send queue statistics
+    AsioSendQueueStats GetSendQueueStats() {
+        return sendQueue.GetStats();
+    }
+
+    /// Set the redirection state, redirected handlers are skipped by queued broadcasts
+    /// \param value true if the peer is served by another transport
+    void SetRedirected(bool value) {
+        redirected = value;
+    }
+
+    /// Check if this handler is redirected
+    bool IsRedirected() const {
+        return redirected;
+    }
+
     /// Set the GUID
     void SetGlobalUID(const GlobalUID& value) {
         uuid = value;
@@ -201,6 +241,42 @@ private:
         Read();
     }
 
+    /// Write the next coalesced batch of the send queue, if any and not in flight
+    void FlushQueue() {
+        const std::vector<char>* batch = sendQueue.AcquireWrite();
+        if (!batch) {
+            return;
+        }
+
+        try {
+            // Batch is owned by the queue until released
+            asio::async_write(
+                socket,
+                asio::buffer(batch->data(), batch->size()),
+                [this](const std::error_code &error, size_t bytes) {
+                    OnQueuedWrite(error, bytes);
+                }
+            );
+        } catch (asio::system_error) {
+            sendQueue.ReleaseWrite();
+        }
+    }
+
+    /// Async queued write callback
+    /// \param error error code
+    /// \param bytes number of bytes written
+    void OnQueuedWrite(const std::error_code &error, size_t bytes) {
+        sendQueue.ReleaseWrite();
+
+        // Stop on errors
+        if (!CheckError(error)) {
+            return;
+        }
+
+        // Write the next batch
+        FlushQueue();
+    }
+
     /// Async write callback
     /// \param error error code
     /// \param bytes number of bytes written
@@ -245,6 +321,12 @@ private:
     /// Current enqueued data
     std::vector<char> enqueuedBuffer;
 
+    /// Bounded outbound queue
+    AsioSendQueue sendQueue;
+
+    /// Served by another transport?
+    std::atomic<bool> redirected{false};
+
     /// Streaming buffer
     std::unique_ptr<char[]> buffer;
 };
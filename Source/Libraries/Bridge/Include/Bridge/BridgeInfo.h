@@ -35,4 +35,13 @@ struct BridgeInfo {
 
     /// Total number of bytes read
     uint64_t bytesRead{0};
+
+    /// Number of bytes pending in the outbound queues, largest of all clients
+    uint64_t bytesQueued{0};
+
+    /// Total number of low priority streams dropped under overload, across all clients
+    uint64_t streamsDropped{0};
+
+    /// Total number of low priority bytes dropped under overload, across all clients
+    uint64_t bytesDropped{0};
 };
@@ -0,0 +1,70 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+#include <Message/MessageStream.h>
+
+/// Direction of a captured stream, relative to the recorded bridge
+enum class BridgeCaptureDirection : uint32_t {
+    /// Dispatched to listeners of the bridge
+    Inbound,
+
+    /// Committed to the bridge output
+    Outbound
+};
+
+struct BridgeCaptureHeaderProtocol {
+    static constexpr uint64_t kMagic = 'GRSR';
+    static constexpr uint32_t kVersion = 1;
+
+    /// Magic header for validation
+    uint64_t magic = kMagic;
+
+    /// Version of the capture format
+    uint32_t version = kVersion;
+    uint32_t : 32;
+};
+
+struct BridgeCaptureRecordProtocol {
+    /// Time since the start of the capture, in nanoseconds
+    uint64_t timeStamp{};
+
+    /// Schema of the stream
+    MessageSchema schema;
+
+    /// Version of the stream
+    uint32_t versionID{};
+
+    /// Direction of the stream
+    BridgeCaptureDirection direction{};
+
+    /// Size of the succeeding stream
+    uint64_t size{};
+};
+
+static_assert(sizeof(BridgeCaptureHeaderProtocol) == 16, "Unexpected capture header protocol size");
+static_assert(sizeof(BridgeCaptureRecordProtocol) == 32, "Unexpected capture record protocol size");
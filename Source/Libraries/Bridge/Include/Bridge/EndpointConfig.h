@@ -28,6 +28,7 @@
 
 // Bridge
 #include "Asio/AsioProtocol.h"
+#include "Asio/AsioSendQueue.h"
 
 // Std
 #include <cstdint>
@@ -57,6 +58,15 @@ struct EndpointConfig {
 
     /// Device configuration
     EndpointDeviceConfig device;
+
+    /// Outbound queue limits per connected client
+    AsioSendQueueConfig sendQueue;
+
+    /// Allow same host connections to negotiate a shared memory channel, falls back to TCP otherwise
+    bool sharedMemory{true};
+
+    /// Byte capacity of each shared memory ring, decided by the connecting client
+    uint64_t sharedMemoryCapacity{16'000'000};
 };
 
 struct EndpointResolve {
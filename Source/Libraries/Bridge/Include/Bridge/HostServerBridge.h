@@ -29,14 +29,18 @@
 // Bridge
 #include "MemoryBridge.h"
 #include "EndpointConfig.h"
+#include "Asio/AsioSendQueue.h"
+#include "SharedMemory/SharedMemoryChannel.h"
 
 // Std
 #include <thread>
 #include <atomic>
 #include <condition_variable>
+#include <memory>
 
 // Forward declarations
 struct AsioHostServer;
+class AsioSocketHandler;
 
 /// Network Bridge
 class HostServerBridge final : public IBridge {
@@ -51,6 +55,10 @@ public:
     /// \param config given configuration
     void UpdateDeviceConfig(const EndpointDeviceConfig& config);
 
+    /// Get the outbound queue statistics of all connected clients
+    /// \param out destination statistics, one per client
+    void GetClientQueueStats(std::vector<AsioSendQueueStats>& out);
+
     /// Overrides
     void Register(MessageID mid, const ComRef<IBridgeListener>& listener) override;
     void Deregister(MessageID mid, const ComRef<IBridgeListener>& listener) override;
@@ -61,12 +69,52 @@ public:
     BridgeInfo GetInfo() override;
     void Commit() override;
 
+    /// Get the send priority of a stream
+    /// \param stream stream to be sent
+    /// \return priority
+    static AsioSendPriority GetStreamPriority(const MessageStream& stream);
+
 private:
     /// Async read callback
+    /// \param handler the reading handler
+    /// \param data the enqueued data
+    /// \param size the enqueued size
+    /// \return number of consumed bytes
+    uint64_t OnReadAsync(AsioSocketHandler& handler, const void* data, uint64_t size);
+
+    /// Async stream read callback, shared by all transports
+    /// \param data the enqueued data
+    /// \param size the enqueued size
+    /// \return number of consumed bytes
+    uint64_t OnStreamReadAsync(const void* data, uint64_t size);
+
+    /// Async shared memory negotiation callback
+    /// \param handler the reading handler
     /// \param data the enqueued data
     /// \param size the enqueued size
     /// \return number of consumed bytes
-    uint64_t OnReadAsync(const void* data, uint64_t size);
+    uint64_t OnNegotiationAsync(AsioSocketHandler& handler, const void* data, uint64_t size);
+
+    /// Release all shared memory clients that are no longer connected
+    void PruneSharedMemoryClients();
+
+private:
+    struct SharedMemoryClient {
+        /// Guid of the redirected handler
+        GlobalUID uid;
+
+        /// Negotiated channel
+        std::unique_ptr<SharedMemoryChannel> channel;
+    };
+
+    /// All clients served over shared memory
+    std::vector<SharedMemoryClient> sharedMemoryClients;
+
+    /// Accept shared memory negotiations
+    bool sharedMemoryEnabled{true};
+
+    /// Send queue configuration of all shared memory clients
+    AsioSendQueueConfig sharedMemorySendQueue;
 
 private:
     /// Current endpoint
@@ -87,6 +135,9 @@ private:
     /// Cache for commits
     std::vector<MessageStream> streamCache;
 
+    /// Cache for queue statistics
+    std::vector<AsioSendQueueStats> queueStatsCache;
+
     /// Shared lock
     Mutex mutex;
 };
@@ -46,3 +46,35 @@ struct MessageStreamHeaderProtocol {
 };
 
 static_assert(sizeof(MessageStreamHeaderProtocol) == 32, "Unexpected message stream protocol size");
+
+struct SharedMemoryNegotiationProtocol {
+    static constexpr uint64_t kMagic = 'GRSN';
+
+    /// Maximum length of the channel name
+    static constexpr uint32_t kMaxNameLength = 64;
+
+    enum class Type : uint32_t {
+        /// Client to host, the client has created a channel
+        Request,
+
+        /// Host to client, the host has opened the channel or declined
+        Response,
+
+        /// Client to host, all succeeding client streams are written to the channel
+        Switch
+    };
+
+    /// Magic header for validation, shared offset with stream headers
+    uint64_t magic = kMagic;
+
+    /// Type of this packet
+    Type type{Type::Request};
+
+    /// Response state
+    uint32_t accepted{0};
+
+    /// Null terminated channel name
+    char name[kMaxNameLength]{};
+};
+
+static_assert(sizeof(SharedMemoryNegotiationProtocol) == 80, "Unexpected shared memory negotiation protocol size");
@@ -0,0 +1,108 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Bridge
+#include "IBridge.h"
+#include "Capture/BridgeCaptureProtocol.h"
+
+// Message
+#include <Message/OrderedMessageStorage.h>
+
+// Common
+#include <Common/Dispatcher/Mutex.h>
+
+// Std
+#include <filesystem>
+#include <fstream>
+#include <chrono>
+#include <set>
+
+// Forward declarations
+class BridgeCaptureListener;
+
+/// Recording bridge, captures all traffic of another bridge for later replays
+class RecordingBridge final : public IBridge {
+public:
+    ~RecordingBridge();
+
+    /// Install this bridge
+    /// \param bridge the bridge to be recorded, all usage must go through this bridge
+    /// \param path destination path of the capture
+    /// \return success state
+    bool Install(const ComRef<IBridge>& bridge, const std::filesystem::path& path);
+
+    /// Record a set of streams, thread safe
+    /// \param streams the streams, length of [count]
+    /// \param count the number of streams
+    /// \param direction direction of all streams
+    void Record(const MessageStream* streams, uint32_t count, BridgeCaptureDirection direction);
+
+    /// Flush all recorded streams to disk
+    void Flush();
+
+    /// Overrides
+    void Register(MessageID mid, const ComRef<IBridgeListener>& listener) override;
+    void Deregister(MessageID mid, const ComRef<IBridgeListener>& listener) override;
+    void Register(const ComRef<IBridgeListener>& listener) override;
+    void Deregister(const ComRef<IBridgeListener>& listener) override;
+    IMessageStorage *GetInput() override;
+    IMessageStorage *GetOutput() override;
+    BridgeInfo GetInfo() override;
+    void Commit() override;
+
+private:
+    /// Recorded bridge
+    ComRef<IBridge> bridge;
+
+    /// Inbound listener, registered ahead of all user listeners
+    ComRef<BridgeCaptureListener> captureListener;
+
+    /// All captured message ids
+    std::set<MessageID> capturedMessages;
+
+    /// Are ordered streams captured?
+    bool capturedOrdered{false};
+
+    /// Local storage
+    OrderedMessageStorage storage;
+
+    /// Cache for commits
+    std::vector<MessageStream> streamCache;
+
+    /// Destination capture
+    std::ofstream out;
+
+    /// Start of the capture
+    std::chrono::steady_clock::time_point startTimeStamp;
+
+    /// Capture write lock, taken by the recorded bridge while dispatching
+    Mutex writeMutex;
+
+    /// Capture registration lock, never taken while recording
+    Mutex registrationMutex;
+};
@@ -31,10 +31,14 @@
 #include "EndpointConfig.h"
 #include "Asio/AsioProtocol.h"
 #include "Asio/AsioDelegates.h"
+#include "NetworkProtocol.h"
+#include "SharedMemory/SharedMemoryChannel.h"
 
 // Std
 #include <thread>
 #include <atomic>
+#include <memory>
+#include <mutex>
 
 // Forward declarations
 struct AsioRemoteClient;
@@ -105,6 +109,21 @@ private:
     /// \return number of consumed bytes
     uint64_t OnReadAsync(const void* data, uint64_t size);
 
+    /// Async stream read callback, shared by all transports
+    /// \param data the enqueued data
+    /// \param size the enqueued size
+    /// \return number of consumed bytes
+    uint64_t OnStreamReadAsync(const void* data, uint64_t size);
+
+    /// Async shared memory negotiation callback
+    /// \param data the enqueued data
+    /// \param size the enqueued size
+    /// \return number of consumed bytes
+    uint64_t OnNegotiationAsync(const void* data, uint64_t size);
+
+    /// Request a shared memory channel from the connected server
+    void NegotiateSharedMemory();
+
 private:
     /// Current endpoint
     AsioRemoteClient* client{nullptr};
@@ -123,4 +142,21 @@ private:
 
     /// Cache for commits
     std::vector<MessageStream> streamCache;
+
+    /// Transport configuration
+    bool sharedMemoryEnabled{true};
+    uint64_t sharedMemoryCapacity{SharedMemoryChannel::kDefaultCapacity};
+
+    /// Channel pending or accepted by the server
+    std::unique_ptr<SharedMemoryChannel> sharedMemoryChannel;
+
+    /// Are outbound streams written to the channel?
+    bool sharedMemorySwitched{false};
+
+    /// Negotiation packets, lifetime bound to the async writes
+    SharedMemoryNegotiationProtocol negotiationRequest;
+    SharedMemoryNegotiationProtocol negotiationSwitch;
+
+    /// Serializes commits against transport switches
+    std::mutex commitMutex;
 };
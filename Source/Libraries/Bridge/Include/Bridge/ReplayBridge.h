@@ -0,0 +1,84 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Bridge
+#include "MemoryBridge.h"
+#include "Capture/BridgeCaptureProtocol.h"
+
+// Std
+#include <filesystem>
+#include <vector>
+
+/// Replay bridge, feeds the inbound streams of a capture to all listeners
+class ReplayBridge final : public IBridge {
+public:
+    /// Install this bridge
+    /// \param path path of the capture, see RecordingBridge
+    /// \return success state
+    bool Install(const std::filesystem::path& path);
+
+    /// Replay all captured inbound streams on the calling thread, may be invoked multiple times
+    /// Streams captured within the same batch are committed together
+    /// \param speed playback rate relative to the capture, zero replays as fast as possible
+    /// \return number of replayed streams
+    uint64_t Replay(float speed = 0.0f);
+
+    /// Get the number of captured inbound streams
+    uint64_t GetStreamCount() const {
+        return capturedStreamCount;
+    }
+
+    /// Overrides
+    void Register(MessageID mid, const ComRef<IBridgeListener>& listener) override;
+    void Deregister(MessageID mid, const ComRef<IBridgeListener>& listener) override;
+    void Register(const ComRef<IBridgeListener>& listener) override;
+    void Deregister(const ComRef<IBridgeListener>& listener) override;
+    IMessageStorage *GetInput() override;
+    IMessageStorage *GetOutput() override;
+    BridgeInfo GetInfo() override;
+    void Commit() override;
+
+private:
+    /// Entire capture, excluding the header
+    std::vector<uint8_t> capture;
+
+    /// Number of captured inbound streams
+    uint64_t capturedStreamCount{0};
+
+    /// Local storage, outbound streams are discarded on commits
+    OrderedMessageStorage storage;
+
+    /// Piggybacked memory bridge
+    MemoryBridge memoryBridge;
+
+    /// Info across lifetime
+    BridgeInfo info;
+
+    /// Cache for commits
+    std::vector<MessageStream> streamCache;
+};
@@ -0,0 +1,219 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Bridge
+#include "SharedMemoryRing.h"
+#include "SharedMemorySegment.h"
+#include "../Asio/AsioSendQueue.h"
+
+// Std
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <string>
+#include <chrono>
+
+/// Read delegate
+using SharedMemoryReadDelegate = std::function<uint64_t(const void *data, uint64_t size)>;
+
+/// State of a channel endpoint
+enum class SharedMemoryEndpointState : uint32_t {
+    Pending,
+    Open,
+    Closed
+};
+
+/// Layout of a channel within shared memory, both rings follow
+struct SharedMemoryChannelHeader {
+    static constexpr uint64_t kMagic = 'GRSC';
+
+    /// Magic header for validation
+    uint64_t magic;
+
+    /// Byte capacity of each ring
+    uint64_t capacity;
+
+    /// State of the creating and opening endpoint
+    std::atomic<SharedMemoryEndpointState> states[2];
+};
+
+/// Duplex channel over a pair of shared memory rings
+class SharedMemoryChannel {
+public:
+    /// Default ring capacity
+    static constexpr uint64_t kDefaultCapacity = 16'000'000;
+
+    /// Time after which a blocked writer assumes the peer is lost
+    static constexpr std::chrono::milliseconds kWriteStallTimeout{10'000};
+
+    ~SharedMemoryChannel();
+
+    /// Create a new channel
+    /// \param name system wide name of the channel
+    /// \param capacity byte capacity of each ring
+    /// \return success state
+    bool Create(const std::string& name, uint64_t capacity = kDefaultCapacity);
+
+    /// Open an existing channel
+    /// \param name system wide name of the channel
+    /// \return success state
+    bool Open(const std::string& name);
+
+    /// Set the async read callback, must be set before installing
+    /// \param delegate invoked on the reader thread
+    void SetReadCallback(const SharedMemoryReadDelegate& delegate) {
+        onRead = delegate;
+    }
+
+    /// Set the configuration of the queued writes
+    /// \param config new configuration, applies to future packets
+    void SetSendQueueConfig(const AsioSendQueueConfig& config) {
+        sendQueue.SetConfig(config);
+    }
+
+    /// Start reading from the peer, and writing queued packets
+    void Install();
+
+    /// Close this channel, the peer is notified
+    /// Pending writes are cancelled
+    void Close();
+
+    /// Write a packet, blocks until written, thread safe
+    /// A failed write may leave a partial packet behind, after which this endpoint is closed
+    /// \param header header to be sent
+    /// \param headerSize byte count of the header
+    /// \param data data to be sent
+    /// \param size byte count of data
+    /// \return false if the peer has closed or stopped reading
+    bool Write(const void* header, uint64_t headerSize, const void* data, uint64_t size);
+
+    /// Enqueue a packet for writing once installed, never blocks, thread safe
+    /// \param header header to be sent, copied
+    /// \param headerSize byte count of the header
+    /// \param data data to be sent, copied
+    /// \param size byte count of data
+    /// \param priority low priority packets are dropped when the queue is behind
+    /// \return false if dropped or closed
+    bool WriteQueued(const void* header, uint64_t headerSize, const void* data, uint64_t size, AsioSendPriority priority);
+
+    /// Get the statistics of the queued writes
+    AsioSendQueueStats GetSendQueueStats() {
+        return sendQueue.GetStats();
+    }
+
+    /// Write a packet if it fits entirely, never blocks, thread safe
+    /// \param header header to be sent
+    /// \param headerSize byte count of the header
+    /// \param data data to be sent
+    /// \param size byte count of data
+    /// \return false if the packet was not written
+    bool TryWrite(const void* header, uint64_t headerSize, const void* data, uint64_t size);
+
+    /// Check if the peer has not closed
+    bool IsPeerOpen() const;
+
+    /// Check if neither endpoint has closed
+    bool IsOpen() const;
+
+    /// Get the name of this channel
+    const std::string& GetName() const {
+        return name;
+    }
+
+private:
+    /// Map both rings from the segment
+    /// \return false if the rings do not match the channel
+    bool MapRings();
+
+    /// Close this endpoint after a failed write, the stream can no longer be parsed
+    void CloseEndpoint();
+
+    /// Write the entire range to the peer
+    /// \param data data to be sent
+    /// \param size byte count of data
+    /// \return false if the peer has closed or stopped reading
+    bool WriteRange(const void* data, uint64_t size);
+
+    /// Reader thread entry point
+    void ReadWorker();
+
+    /// Writer thread entry point
+    void WriteWorker();
+
+    /// Get the byte offset of the first ring
+    static constexpr uint64_t GetRingOffset() {
+        return (sizeof(SharedMemoryChannelHeader) + 63) & ~63ull;
+    }
+
+private:
+    /// Name of this channel
+    std::string name;
+
+    /// Underlying memory
+    SharedMemorySegment segment;
+
+    /// Shared header
+    SharedMemoryChannelHeader* header{nullptr};
+
+    /// Index of this endpoint, the creator writes to the first ring
+    uint32_t endpoint{0};
+
+    /// Validated byte capacity of each ring
+    uint64_t capacity{0};
+
+    /// Outbound and inbound rings
+    SharedMemoryRing writeRing;
+    SharedMemoryRing readRing;
+
+    /// Serializes writers, the ring itself is single producer
+    std::mutex writeMutex;
+
+    /// Reader thread
+    std::thread readThread;
+
+    /// Queued packets, written by the writer thread
+    AsioSendQueue sendQueue;
+
+    /// Writer thread
+    std::thread writeThread;
+
+    /// Wakes the writer on new packets
+    std::condition_variable writeCondition;
+    std::mutex writeConditionMutex;
+
+    /// Exit flag for all waits
+    std::atomic<bool> exitFlag{false};
+
+    /// Delegates
+    SharedMemoryReadDelegate onRead;
+
+    /// Current enqueued data
+    std::vector<char> enqueuedBuffer;
+};
@@ -0,0 +1,168 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Common
+#include <Common/Assert.h>
+
+// Std
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+/// Layout of a ring within shared memory, the data region immediately follows
+struct SharedMemoryRingHeader {
+    /// Total number of bytes ever written, only modified by the producer
+    alignas(64) std::atomic<uint64_t> head;
+
+    /// Total number of bytes ever read, only modified by the consumer
+    alignas(64) std::atomic<uint64_t> tail;
+
+    /// Byte capacity of the data region
+    alignas(64) uint64_t capacity;
+};
+
+/// Cross process atomics must not rely on process local locks
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory rings require lock free 64 bit atomics");
+
+/// Single producer, single consumer byte ring over externally owned memory
+class SharedMemoryRing {
+public:
+    /// Get the total byte size required for a ring
+    /// \param capacity byte capacity of the data region
+    /// \return total byte size, including the header
+    static constexpr uint64_t GetByteSize(uint64_t capacity) {
+        return sizeof(SharedMemoryRingHeader) + capacity;
+    }
+
+    /// Create a new ring in the given memory
+    /// \param memory base memory, must be at least GetByteSize(capacity) bytes
+    /// \param capacity byte capacity of the data region
+    void Create(void* memory, uint64_t capacity) {
+        header = new (memory) SharedMemoryRingHeader;
+        header->head.store(0, std::memory_order_relaxed);
+        header->tail.store(0, std::memory_order_relaxed);
+        header->capacity = capacity;
+        data = reinterpret_cast<uint8_t*>(header + 1);
+        localCapacity = capacity;
+    }
+
+    /// Attach to an existing ring in the given memory
+    /// The shared capacity is written by the peer, it is only validated, never trusted
+    /// \param memory base memory, must be created by Create
+    /// \param capacity expected byte capacity of the data region, must fit the mapping
+    /// \return false if the ring does not match the expected capacity
+    bool Attach(void* memory, uint64_t capacity) {
+        auto* candidate = static_cast<SharedMemoryRingHeader*>(memory);
+        if (!capacity || candidate->capacity != capacity) {
+            return false;
+        }
+
+        header = candidate;
+        data = reinterpret_cast<uint8_t*>(header + 1);
+        localCapacity = capacity;
+        return true;
+    }
+
+    /// Write up to size bytes, producer only
+    /// \param source source data
+    /// \param size byte count of the source
+    /// \return number of bytes written, may be less than size if the ring is full
+    uint64_t Write(const void* source, uint64_t size) {
+        const uint64_t head = header->head.load(std::memory_order_relaxed);
+        const uint64_t tail = header->tail.load(std::memory_order_acquire);
+
+        // Number of bytes we can write, a corrupt tail is treated as full
+        const uint64_t used = head - tail;
+        const uint64_t count = used < localCapacity ? std::min(size, localCapacity - used) : 0;
+        if (!count) {
+            return 0;
+        }
+
+        // Copy, may wrap around
+        const uint64_t offset = head % localCapacity;
+        const uint64_t first = std::min(count, localCapacity - offset);
+        std::memcpy(data + offset, source, first);
+        std::memcpy(data, static_cast<const uint8_t*>(source) + first, count - first);
+
+        // Publish to consumer
+        header->head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /// Read up to size bytes, consumer only
+    /// \param dest destination data
+    /// \param size byte count of the destination
+    /// \return number of bytes read
+    uint64_t Read(void* dest, uint64_t size) {
+        const uint64_t tail = header->tail.load(std::memory_order_relaxed);
+        const uint64_t head = header->head.load(std::memory_order_acquire);
+
+        // Number of bytes we can read, never more than the ring holds
+        const uint64_t count = std::min({size, head - tail, localCapacity});
+        if (!count) {
+            return 0;
+        }
+
+        // Copy, may wrap around
+        const uint64_t offset = tail % localCapacity;
+        const uint64_t first = std::min(count, localCapacity - offset);
+        std::memcpy(dest, data + offset, first);
+        std::memcpy(static_cast<uint8_t*>(dest) + first, data, count - first);
+
+        // Release space to producer
+        header->tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /// Get the number of bytes available for reading
+    uint64_t GetReadable() const {
+        return std::min(header->head.load(std::memory_order_acquire) - header->tail.load(std::memory_order_relaxed), localCapacity);
+    }
+
+    /// Get the number of bytes available for writing
+    uint64_t GetWritable() const {
+        const uint64_t used = header->head.load(std::memory_order_relaxed) - header->tail.load(std::memory_order_acquire);
+        return used < localCapacity ? localCapacity - used : 0;
+    }
+
+    /// Get the byte capacity of the data region
+    uint64_t GetCapacity() const {
+        return localCapacity;
+    }
+
+private:
+    /// Shared header
+    SharedMemoryRingHeader* header{nullptr};
+
+    /// Shared data region
+    uint8_t* data{nullptr};
+
+    /// Validated capacity, the shared capacity is never read after attaching
+    uint64_t localCapacity{0};
+};
@@ -0,0 +1,222 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Std
+#include <cstdint>
+#include <string>
+
+// System
+#ifdef _WIN64
+#include <Windows.h>
+#else // _WIN64
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // _WIN64
+
+/// Named, process shared memory segment
+class SharedMemorySegment {
+public:
+    SharedMemorySegment() = default;
+
+    /// No copy or move
+    SharedMemorySegment(const SharedMemorySegment&) = delete;
+    SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+
+    ~SharedMemorySegment() {
+        Close();
+    }
+
+    /// Create a new segment, fails if it already exists
+    /// \param name system wide name of the segment
+    /// \param byteSize size of the segment
+    /// \return success state
+    bool Create(const std::string& name, uint64_t byteSize) {
+#ifdef _WIN64
+        // Create the mapping from the page file
+        mappingHandle = CreateFileMappingA(
+            INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(byteSize >> 32), static_cast<DWORD>(byteSize),
+            GetSystemName(name).c_str()
+        );
+
+        // Existing mappings are never reused
+        if (!mappingHandle || GetLastError() == ERROR_ALREADY_EXISTS) {
+            Close();
+            return false;
+        }
+#else // _WIN64
+        // Create the exclusive object
+        fileDescriptor = shm_open(GetSystemName(name).c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+        if (fileDescriptor < 0) {
+            return false;
+        }
+
+        // Owner unlinks on close
+        systemName = GetSystemName(name);
+
+        // Reserve backing storage
+        if (ftruncate(fileDescriptor, static_cast<off_t>(byteSize)) != 0) {
+            Close();
+            return false;
+        }
+#endif // _WIN64
+
+        return Map(byteSize);
+    }
+
+    /// Open an existing segment
+    /// \param name system wide name of the segment
+    /// \return success state
+    bool Open(const std::string& name) {
+#ifdef _WIN64
+        mappingHandle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, GetSystemName(name).c_str());
+        if (!mappingHandle) {
+            return false;
+        }
+
+        // Size determined on mapping
+        return Map(0);
+#else // _WIN64
+        fileDescriptor = shm_open(GetSystemName(name).c_str(), O_RDWR, 0);
+        if (fileDescriptor < 0) {
+            return false;
+        }
+
+        // Query size of the segment
+        struct stat fileStat{};
+        if (fstat(fileDescriptor, &fileStat) != 0) {
+            Close();
+            return false;
+        }
+
+        return Map(static_cast<uint64_t>(fileStat.st_size));
+#endif // _WIN64
+    }
+
+    /// Close this segment, the name is released if owned
+    void Close() {
+#ifdef _WIN64
+        if (base) {
+            UnmapViewOfFile(base);
+        }
+
+        if (mappingHandle) {
+            CloseHandle(mappingHandle);
+            mappingHandle = nullptr;
+        }
+#else // _WIN64
+        if (base) {
+            munmap(base, byteSize);
+        }
+
+        if (fileDescriptor >= 0) {
+            close(fileDescriptor);
+            fileDescriptor = -1;
+        }
+
+        // Mapped memory remains valid for all other openers
+        if (!systemName.empty()) {
+            shm_unlink(systemName.c_str());
+            systemName.clear();
+        }
+#endif // _WIN64
+
+        base = nullptr;
+        byteSize = 0;
+    }
+
+    /// Get the mapped memory
+    void* GetData() const {
+        return base;
+    }
+
+    /// Get the mapped byte size
+    uint64_t GetByteSize() const {
+        return byteSize;
+    }
+
+private:
+    /// Map the segment into this process
+    /// \param size byte size to map, zero for the entire segment
+    /// \return success state
+    bool Map(uint64_t size) {
+#ifdef _WIN64
+        base = MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, static_cast<SIZE_T>(size));
+        if (!base) {
+            Close();
+            return false;
+        }
+
+        // Query the mapped size
+        MEMORY_BASIC_INFORMATION info{};
+        VirtualQuery(base, &info, sizeof(info));
+        byteSize = info.RegionSize;
+#else // _WIN64
+        base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+        if (base == MAP_FAILED) {
+            base = nullptr;
+            Close();
+            return false;
+        }
+
+        byteSize = size;
+#endif // _WIN64
+
+        // OK
+        return true;
+    }
+
+    /// Get the platform specific name
+    /// \param name segment name
+    /// \return platform name
+    static std::string GetSystemName(const std::string& name) {
+#ifdef _WIN64
+        return "Local\\" + name;
+#else // _WIN64
+        return "/" + name;
+#endif // _WIN64
+    }
+
+private:
+    /// Mapped memory
+    void* base{nullptr};
+
+    /// Mapped byte size
+    uint64_t byteSize{0};
+
+#ifdef _WIN64
+    HANDLE mappingHandle{nullptr};
+#else // _WIN64
+    int fileDescriptor{-1};
+
+    /// Name to unlink, only set for owners
+    std::string systemName;
+#endif // _WIN64
+};
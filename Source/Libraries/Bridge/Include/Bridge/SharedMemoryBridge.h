@@ -0,0 +1,86 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Bridge
+#include "MemoryBridge.h"
+#include "SharedMemory/SharedMemoryChannel.h"
+
+/// Same host bridge over shared memory
+class SharedMemoryBridge final : public IBridge {
+public:
+    ~SharedMemoryBridge();
+
+    /// Install this bridge as the creating endpoint
+    /// \param name system wide name of the channel
+    /// \param capacity byte capacity of each ring
+    /// \return success state
+    bool Create(const std::string& name, uint64_t capacity = SharedMemoryChannel::kDefaultCapacity);
+
+    /// Install this bridge as the opening endpoint
+    /// \param name system wide name of the channel, must be created
+    /// \return success state
+    bool Open(const std::string& name);
+
+    /// Check if the peer has not closed
+    bool IsPeerOpen() const {
+        return channel.IsPeerOpen();
+    }
+
+    /// Overrides
+    void Register(MessageID mid, const ComRef<IBridgeListener>& listener) override;
+    void Deregister(MessageID mid, const ComRef<IBridgeListener>& listener) override;
+    void Register(const ComRef<IBridgeListener>& listener) override;
+    void Deregister(const ComRef<IBridgeListener>& listener) override;
+    IMessageStorage *GetInput() override;
+    IMessageStorage *GetOutput() override;
+    BridgeInfo GetInfo() override;
+    void Commit() override;
+
+private:
+    /// Async read callback
+    /// \param data the enqueued data
+    /// \param size the enqueued size
+    /// \return number of consumed bytes
+    uint64_t OnReadAsync(const void* data, uint64_t size);
+
+private:
+    /// Underlying channel
+    SharedMemoryChannel channel;
+
+    /// Local storage
+    OrderedMessageStorage storage;
+
+    /// Piggybacked memory bridge
+    MemoryBridge memoryBridge;
+
+    /// Info across lifetime
+    BridgeInfo info;
+
+    /// Cache for commits
+    std::vector<MessageStream> streamCache;
+};
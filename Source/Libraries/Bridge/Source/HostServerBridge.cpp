@@ -36,11 +36,19 @@
 // Message
 #include <Message/MessageStream.h>
 
+// Std
+#include <algorithm>
+
 bool HostServerBridge::Install(const EndpointConfig &config) {
     // Port config
     AsioConfig asioConfig;
     asioConfig.hostResolvePort = config.sharedPort;
     asioConfig.reservedToken = config.reservedToken;
+    asioConfig.sendQueue = config.sendQueue;
+
+    // Transport config
+    sharedMemoryEnabled = config.sharedMemory;
+    sharedMemorySendQueue = config.sendQueue;
 
     // Local info
     asioInfo.deviceUid = config.device.deviceUID;
@@ -59,7 +67,7 @@ bool HostServerBridge::Install(const EndpointConfig &config) {
 
     // Set read callback
     server->SetServerReadCallback([this](AsioSocketHandler& handler, const void *data, uint64_t size) {
-        return OnReadAsync(data, size);
+        return OnReadAsync(handler, data, size);
     });
 
     // OK
@@ -80,9 +88,92 @@ void HostServerBridge::UpdateDeviceConfig(const EndpointDeviceConfig& config) {
 HostServerBridge::~HostServerBridge() {
     // Release endpoint
     destroy(server, allocators);
+
+    // Stop all readers
+    sharedMemoryClients.clear();
+}
+
+uint64_t HostServerBridge::OnReadAsync(AsioSocketHandler& handler, const void *data, uint64_t size) {
+    // Magic present?
+    if (size < sizeof(uint64_t)) {
+        return 0;
+    }
+
+    // Negotiation packets share the magic offset with streams
+    if (*static_cast<const uint64_t*>(data) == SharedMemoryNegotiationProtocol::kMagic) {
+        return OnNegotiationAsync(handler, data, size);
+    }
+
+    // Assume stream
+    return OnStreamReadAsync(data, size);
+}
+
+uint64_t HostServerBridge::OnNegotiationAsync(AsioSocketHandler& handler, const void *data, uint64_t size) {
+    auto *protocol = static_cast<const SharedMemoryNegotiationProtocol *>(data);
+
+    // Entire packet present?
+    if (size < sizeof(SharedMemoryNegotiationProtocol)) {
+        return 0;
+    }
+
+    MutexGuard guard(mutex);
+
+    switch (protocol->type) {
+        default: {
+            ASSERT(false, "Unexpected negotiation type");
+            break;
+        }
+        case SharedMemoryNegotiationProtocol::Type::Request: {
+            SharedMemoryNegotiationProtocol response;
+            response.type = SharedMemoryNegotiationProtocol::Type::Response;
+            std::memcpy(response.name, protocol->name, sizeof(response.name));
+            response.name[sizeof(response.name) - 1] = '\0';
+
+            // Try to open the client channel, fails if not on the same host
+            auto channel = std::make_unique<SharedMemoryChannel>();
+            response.accepted = sharedMemoryEnabled && channel->Open(response.name);
+
+            // Respond before any stream is redirected
+            handler.WriteQueuedAsync(&response, sizeof(response), nullptr, 0, AsioSendPriority::Control);
+
+            // Declined, client remains on TCP
+            if (!response.accepted) {
+                break;
+            }
+
+            // Outbound streams are queued with the same limits as the TCP send queues
+            channel->SetSendQueueConfig(sharedMemorySendQueue);
+
+            // Client streams are read once the client has switched
+            channel->SetReadCallback([this](const void *data, uint64_t size) {
+                return OnStreamReadAsync(data, size);
+            });
+
+            // Redirect all succeeding streams
+            handler.SetRedirected(true);
+            sharedMemoryClients.push_back(SharedMemoryClient {
+                .uid = handler.GetGlobalUID(),
+                .channel = std::move(channel)
+            });
+            break;
+        }
+        case SharedMemoryNegotiationProtocol::Type::Switch: {
+            // All prior client streams have been read from TCP, start reading the channel and writing queued streams
+            for (SharedMemoryClient& client : sharedMemoryClients) {
+                if (client.uid == handler.GetGlobalUID()) {
+                    client.channel->Install();
+                }
+            }
+            break;
+        }
+    }
+
+    // Consume packet
+    info.bytesRead += sizeof(SharedMemoryNegotiationProtocol);
+    return sizeof(SharedMemoryNegotiationProtocol);
 }
 
-uint64_t HostServerBridge::OnReadAsync(const void *data, uint64_t size) {
+uint64_t HostServerBridge::OnStreamReadAsync(const void *data, uint64_t size) {
     auto *protocol = static_cast<const MessageStreamHeaderProtocol *>(data);
 
     // Entire stream present?
@@ -108,6 +199,12 @@ uint64_t HostServerBridge::OnReadAsync(const void *data, uint64_t size) {
     return bytes;
 }
 
+void HostServerBridge::PruneSharedMemoryClients() {
+    sharedMemoryClients.erase(std::remove_if(sharedMemoryClients.begin(), sharedMemoryClients.end(), [&](const SharedMemoryClient& client) {
+        return !client.channel->IsOpen() || !server->IsClientOpen(client.uid);
+    }), sharedMemoryClients.end());
+}
+
 void HostServerBridge::Register(MessageID mid, const ComRef<IBridgeListener>& listener) {
     memoryBridge.Register(mid, listener);
 }
@@ -133,7 +230,49 @@ IMessageStorage *HostServerBridge::GetOutput() {
 }
 
 BridgeInfo HostServerBridge::GetInfo() {
-    return info;
+    MutexGuard guard(mutex);
+
+    // Copy general info
+    BridgeInfo out = info;
+
+    // Get all queues
+    queueStatsCache.clear();
+    if (server) {
+        server->GetClientSendQueueStats(queueStatsCache);
+    }
+
+    // Get all shared memory queues
+    for (const SharedMemoryClient& client : sharedMemoryClients) {
+        queueStatsCache.push_back(client.channel->GetSendQueueStats());
+    }
+
+    // Summarize queues
+    for (const AsioSendQueueStats& stats : queueStatsCache) {
+        out.bytesQueued = std::max(out.bytesQueued, stats.queuedBytes);
+        out.streamsDropped += stats.droppedPackets;
+        out.bytesDropped += stats.droppedBytes;
+    }
+
+    // OK
+    return out;
+}
+
+void HostServerBridge::GetClientQueueStats(std::vector<AsioSendQueueStats> &out) {
+    MutexGuard guard(mutex);
+
+    if (server) {
+        server->GetClientSendQueueStats(out);
+    }
+
+    // Shared memory clients are queued separately
+    for (const SharedMemoryClient& client : sharedMemoryClients) {
+        out.push_back(client.channel->GetSendQueueStats());
+    }
+}
+
+AsioSendPriority HostServerBridge::GetStreamPriority(const MessageStream &stream) {
+    // Only streams explicitly marked lossy, i.e. bulk shader exports, may be dropped under overload
+    return stream.IsLossy() ? AsioSendPriority::Low : AsioSendPriority::Control;
 }
 
 void HostServerBridge::Commit() {
@@ -152,6 +291,9 @@ void HostServerBridge::Commit() {
     streamCache.resize(streamCount);
     storage.ConsumeStreams(&streamCount, streamCache.data());
 
+    // Release lost shared memory clients
+    PruneSharedMemoryClients();
+
     // Push all streams
     for (uint32_t i = 0; i < streamCount; i++) {
         const MessageStream &stream = streamCache[i];
@@ -162,9 +304,16 @@ void HostServerBridge::Commit() {
         protocol.versionID = stream.GetVersionID();
         protocol.size = stream.GetByteSize();
 
-        // Send header and stream data (sync)
-        server->BroadcastServerAsync(&protocol, sizeof(protocol));
-        server->BroadcastServerAsync(stream.GetDataBegin(), protocol.size);
+        // Get priority
+        AsioSendPriority priority = GetStreamPriority(stream);
+
+        // Enqueue header and stream data to all TCP clients, never blocks the commit
+        server->BroadcastServerQueuedAsync(&protocol, sizeof(protocol), stream.GetDataBegin(), protocol.size, priority);
+
+        // Enqueue to all shared memory clients, written by the channel, never blocks the commit
+        for (const SharedMemoryClient& client : sharedMemoryClients) {
+            client.channel->WriteQueued(&protocol, sizeof(protocol), stream.GetDataBegin(), protocol.size, priority);
+        }
 
         // Tracking
         info.bytesWritten += sizeof(protocol);
@@ -0,0 +1,171 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <Bridge/RecordingBridge.h>
+#include <Bridge/IBridgeListener.h>
+#include <Bridge/Capture/BridgeCaptureListener.h>
+
+// Message
+#include <Message/MessageStream.h>
+
+// Common
+#include <Common/Registry.h>
+
+RecordingBridge::~RecordingBridge() {
+    if (!bridge) {
+        return;
+    }
+
+    // Stop capturing
+    for (MessageID mid : capturedMessages) {
+        bridge->Deregister(mid, captureListener);
+    }
+
+    // Stop capturing ordered streams
+    if (capturedOrdered) {
+        bridge->Deregister(captureListener);
+    }
+}
+
+bool RecordingBridge::Install(const ComRef<IBridge> &recorded, const std::filesystem::path &path) {
+    ASSERT(registry, "Recording bridge must be created through a registry");
+    bridge = recorded;
+
+    // Try to open destination
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out.good()) {
+        return false;
+    }
+
+    // Write header
+    BridgeCaptureHeaderProtocol header;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Create inbound listener
+    captureListener = registry->New<BridgeCaptureListener>(this);
+
+    // Time stamps are relative to the installation
+    startTimeStamp = std::chrono::steady_clock::now();
+
+    // OK
+    return true;
+}
+
+void RecordingBridge::Record(const MessageStream *streams, uint32_t count, BridgeCaptureDirection direction) {
+    // All streams of a batch share the same time stamp
+    const uint64_t timeStamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTimeStamp).count();
+
+    MutexGuard guard(writeMutex);
+
+    // Write all streams
+    for (uint32_t i = 0; i < count; i++) {
+        const MessageStream &stream = streams[i];
+
+        // Setup protocol header
+        BridgeCaptureRecordProtocol protocol;
+        protocol.timeStamp = timeStamp;
+        protocol.schema = stream.GetSchema();
+        protocol.versionID = stream.GetVersionID();
+        protocol.direction = direction;
+        protocol.size = stream.GetByteSize();
+
+        // Write header and stream data
+        out.write(reinterpret_cast<const char*>(&protocol), sizeof(protocol));
+        out.write(reinterpret_cast<const char*>(stream.GetDataBegin()), protocol.size);
+    }
+}
+
+void RecordingBridge::Flush() {
+    MutexGuard guard(writeMutex);
+    out.flush();
+}
+
+void RecordingBridge::Register(MessageID mid, const ComRef<IBridgeListener>& listener) {
+    // Capture ahead of the first listener, once per message
+    //   ! The recorded bridge may record while holding its own lock, never register under the write lock
+    {
+        MutexGuard guard(registrationMutex);
+        if (capturedMessages.insert(mid).second) {
+            bridge->Register(mid, captureListener);
+        }
+    }
+
+    bridge->Register(mid, listener);
+}
+
+void RecordingBridge::Deregister(MessageID mid, const ComRef<IBridgeListener>& listener) {
+    bridge->Deregister(mid, listener);
+}
+
+void RecordingBridge::Register(const ComRef<IBridgeListener>& listener) {
+    // Capture ahead of the first listener
+    {
+        MutexGuard guard(registrationMutex);
+        if (!capturedOrdered) {
+            bridge->Register(captureListener);
+            capturedOrdered = true;
+        }
+    }
+
+    bridge->Register(listener);
+}
+
+void RecordingBridge::Deregister(const ComRef<IBridgeListener>& listener) {
+    bridge->Deregister(listener);
+}
+
+IMessageStorage *RecordingBridge::GetInput() {
+    return bridge->GetInput();
+}
+
+IMessageStorage *RecordingBridge::GetOutput() {
+    return &storage;
+}
+
+BridgeInfo RecordingBridge::GetInfo() {
+    return bridge->GetInfo();
+}
+
+void RecordingBridge::Commit() {
+    // Get number of streams
+    uint32_t streamCount;
+    storage.ConsumeStreams(&streamCount, nullptr);
+
+    // Get all streams
+    streamCache.resize(streamCount);
+    storage.ConsumeStreams(&streamCount, streamCache.data());
+
+    // Record all outbound streams
+    Record(streamCache.data(), streamCount, BridgeCaptureDirection::Outbound);
+
+    // Pass through to the recorded bridge
+    for (uint32_t i = 0; i < streamCount; i++) {
+        bridge->GetOutput()->AddStream(streamCache[i]);
+    }
+
+    // Commit the recorded bridge, dispatches inbound streams to the capture listener
+    bridge->Commit();
+}
@@ -36,6 +36,9 @@
 // Schemas
 #include <Schemas/HostResolve.h>
 
+// Common
+#include <Common/GlobalUID.h>
+
 
 RemoteClientBridge::RemoteClientBridge() {
     // Create the client
@@ -55,6 +58,9 @@ RemoteClientBridge::RemoteClientBridge() {
 RemoteClientBridge::~RemoteClientBridge() {
     // Release endpoint
     destroy(client, allocators);
+
+    // Stop reading
+    sharedMemoryChannel.reset();
 }
 
 bool RemoteClientBridge::Install(const EndpointResolve &resolve) {
@@ -62,6 +68,10 @@ bool RemoteClientBridge::Install(const EndpointResolve &resolve) {
     AsioRemoteConfig asioConfig;
     asioConfig.hostResolvePort = resolve.config.sharedPort;
     asioConfig.ipvxAddress = resolve.ipvxAddress;
+
+    // Transport config
+    sharedMemoryEnabled = resolve.config.sharedMemory;
+    sharedMemoryCapacity = resolve.config.sharedMemoryCapacity;
     
     // Try to connect
     return client->Connect(asioConfig);
@@ -73,6 +83,10 @@ void RemoteClientBridge::InstallAsync(const EndpointResolve &resolve) {
     asioConfig.hostResolvePort = resolve.config.sharedPort;
     asioConfig.ipvxAddress = resolve.ipvxAddress;
 
+    // Transport config
+    sharedMemoryEnabled = resolve.config.sharedMemory;
+    sharedMemoryCapacity = resolve.config.sharedMemoryCapacity;
+
     // Try to connect
     client->ConnectAsync(asioConfig);
 }
@@ -98,6 +112,11 @@ void RemoteClientBridge::RequestClientAsync(const AsioHostClientToken &guid) {
 }
 
 void RemoteClientBridge::OnConnected(const AsioHostResolverClientRequest::ServerResponse& response) {
+    // Try to upgrade the transport
+    if (response.accepted) {
+        NegotiateSharedMemory();
+    }
+
     MessageStream stream;
 
     MessageStreamView view(stream);
@@ -188,7 +207,91 @@ void RemoteClientBridge::OnDiscovery(const AsioRemoteServerResolverDiscoveryRequ
     }
 }
 
+void RemoteClientBridge::NegotiateSharedMemory() {
+    std::lock_guard guard(commitMutex);
+
+    // Release channels of previous connections
+    sharedMemoryChannel.reset();
+    sharedMemorySwitched = false;
+
+    // Disabled?
+    if (!sharedMemoryEnabled) {
+        return;
+    }
+
+    // Unique name per connection
+    std::string name = "GRS.Bridge." + GlobalUID::New().ToString();
+    ASSERT(name.length() < SharedMemoryNegotiationProtocol::kMaxNameLength, "Channel name too long");
+
+    // Create the channel, the server must be able to open it
+    sharedMemoryChannel = std::make_unique<SharedMemoryChannel>();
+    if (!sharedMemoryChannel->Create(name, sharedMemoryCapacity)) {
+        sharedMemoryChannel.reset();
+        return;
+    }
+
+    // Setup request
+    negotiationRequest.type = SharedMemoryNegotiationProtocol::Type::Request;
+    std::strncpy(negotiationRequest.name, name.c_str(), sizeof(negotiationRequest.name) - 1);
+
+    // Request the channel
+    client->WriteAsync(&negotiationRequest, sizeof(negotiationRequest));
+}
+
 uint64_t RemoteClientBridge::OnReadAsync(const void *data, uint64_t size) {
+    // Magic present?
+    if (size < sizeof(uint64_t)) {
+        return 0;
+    }
+
+    // Negotiation packets share the magic offset with streams
+    if (*static_cast<const uint64_t*>(data) == SharedMemoryNegotiationProtocol::kMagic) {
+        return OnNegotiationAsync(data, size);
+    }
+
+    // Assume stream
+    return OnStreamReadAsync(data, size);
+}
+
+uint64_t RemoteClientBridge::OnNegotiationAsync(const void *data, uint64_t size) {
+    auto *protocol = static_cast<const SharedMemoryNegotiationProtocol *>(data);
+
+    // Entire packet present?
+    if (size < sizeof(SharedMemoryNegotiationProtocol)) {
+        return 0;
+    }
+
+    // Validate type
+    ASSERT(protocol->type == SharedMemoryNegotiationProtocol::Type::Response, "Unexpected negotiation type");
+
+    // Switch between commits
+    std::lock_guard guard(commitMutex);
+
+    // Accepted by server?
+    if (protocol->accepted && sharedMemoryChannel) {
+        // Server streams are now written to the channel
+        sharedMemoryChannel->SetReadCallback([this](const void *data, uint64_t size) {
+            return OnStreamReadAsync(data, size);
+        });
+
+        // Start reading
+        sharedMemoryChannel->Install();
+
+        // Notify the server that all succeeding streams are written to the channel
+        negotiationSwitch.type = SharedMemoryNegotiationProtocol::Type::Switch;
+        client->WriteAsync(&negotiationSwitch, sizeof(negotiationSwitch));
+        sharedMemorySwitched = true;
+    } else {
+        // Declined, remain on TCP
+        sharedMemoryChannel.reset();
+    }
+
+    // Consume packet
+    info.bytesRead += sizeof(SharedMemoryNegotiationProtocol);
+    return sizeof(SharedMemoryNegotiationProtocol);
+}
+
+uint64_t RemoteClientBridge::OnStreamReadAsync(const void *data, uint64_t size) {
     auto *protocol = static_cast<const MessageStreamHeaderProtocol *>(data);
 
     // Entire stream present?
@@ -248,6 +351,8 @@ BridgeInfo RemoteClientBridge::GetInfo() {
 }
 
 void RemoteClientBridge::Commit() {
+    std::lock_guard guard(commitMutex);
+
     // Get number of streams
     uint32_t streamCount;
     storage.ConsumeStreams(&streamCount, nullptr);
@@ -266,9 +371,13 @@ void RemoteClientBridge::Commit() {
         protocol.versionID = stream.GetVersionID();
         protocol.size = stream.GetByteSize();
 
-        // Send header and stream data (sync)
-        client->WriteAsync(&protocol, sizeof(protocol));
-        client->WriteAsync(stream.GetDataBegin(), protocol.size);
+        // Send header and stream data
+        if (sharedMemorySwitched) {
+            sharedMemoryChannel->Write(&protocol, sizeof(protocol), stream.GetDataBegin(), protocol.size);
+        } else {
+            client->WriteAsync(&protocol, sizeof(protocol));
+            client->WriteAsync(stream.GetDataBegin(), protocol.size);
+        }
 
         // Tracking
         info.bytesWritten += sizeof(protocol);
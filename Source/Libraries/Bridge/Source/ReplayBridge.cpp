@@ -0,0 +1,187 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <Bridge/ReplayBridge.h>
+#include <Bridge/IBridgeListener.h>
+
+// Message
+#include <Message/MessageStream.h>
+
+// Std
+#include <fstream>
+#include <thread>
+#include <chrono>
+
+bool ReplayBridge::Install(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.good()) {
+        return false;
+    }
+
+    // Determine size
+    const uint64_t size = in.tellg();
+    in.seekg(0);
+
+    // Read and validate header
+    BridgeCaptureHeaderProtocol header;
+    if (size < sizeof(header) || !in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+
+    // Validate header
+    if (header.magic != BridgeCaptureHeaderProtocol::kMagic || header.version != BridgeCaptureHeaderProtocol::kVersion) {
+        return false;
+    }
+
+    // Read all records
+    capture.resize(size - sizeof(header));
+    if (!in.read(reinterpret_cast<char*>(capture.data()), capture.size())) {
+        return false;
+    }
+
+    // Validate all records, a truncated capture is replayed up to the last complete record
+    uint64_t offset = 0;
+    capturedStreamCount = 0;
+    while (offset + sizeof(BridgeCaptureRecordProtocol) <= capture.size()) {
+        auto* protocol = reinterpret_cast<const BridgeCaptureRecordProtocol*>(capture.data() + offset);
+
+        // Entire stream present?
+        if (capture.size() - offset - sizeof(BridgeCaptureRecordProtocol) < protocol->size) {
+            break;
+        }
+
+        // Count replayed streams
+        if (protocol->direction == BridgeCaptureDirection::Inbound) {
+            capturedStreamCount++;
+        }
+
+        offset += sizeof(BridgeCaptureRecordProtocol) + protocol->size;
+    }
+
+    // Trim incomplete records
+    capture.resize(offset);
+
+    // OK
+    return true;
+}
+
+uint64_t ReplayBridge::Replay(float speed) {
+    const auto startTimeStamp = std::chrono::steady_clock::now();
+
+    // Number of replayed streams
+    uint64_t replayed = 0;
+
+    // Time stamp of the pending batch
+    uint64_t batchTimeStamp = 0;
+    bool batchPending = false;
+
+    for (uint64_t offset = 0; offset < capture.size();) {
+        auto* protocol = reinterpret_cast<const BridgeCaptureRecordProtocol*>(capture.data() + offset);
+        const uint8_t* data = capture.data() + offset + sizeof(BridgeCaptureRecordProtocol);
+
+        // Next!
+        offset += sizeof(BridgeCaptureRecordProtocol) + protocol->size;
+
+        // Outbound streams were produced by the consumer, not replayed
+        if (protocol->direction != BridgeCaptureDirection::Inbound) {
+            continue;
+        }
+
+        // New batch?
+        if (batchPending && protocol->timeStamp != batchTimeStamp) {
+            memoryBridge.Commit();
+            batchPending = false;
+        }
+
+        // Wait until the captured time, relative to the playback rate
+        if (!batchPending && speed > 0.0f) {
+            std::this_thread::sleep_until(startTimeStamp + std::chrono::nanoseconds(static_cast<uint64_t>(protocol->timeStamp / speed)));
+        }
+
+        // Create the stream
+        MessageStream stream(protocol->schema);
+        stream.SetVersionID(protocol->versionID);
+        stream.SetData(data, protocol->size, 0);
+        memoryBridge.GetOutput()->AddStream(stream);
+
+        // Tracking
+        info.bytesRead += sizeof(BridgeCaptureRecordProtocol) + protocol->size;
+        batchTimeStamp = protocol->timeStamp;
+        batchPending = true;
+        replayed++;
+    }
+
+    // Commit last batch
+    if (batchPending) {
+        memoryBridge.Commit();
+    }
+
+    // OK
+    return replayed;
+}
+
+void ReplayBridge::Register(MessageID mid, const ComRef<IBridgeListener>& listener) {
+    memoryBridge.Register(mid, listener);
+}
+
+void ReplayBridge::Deregister(MessageID mid, const ComRef<IBridgeListener>& listener) {
+    memoryBridge.Deregister(mid, listener);
+}
+
+void ReplayBridge::Register(const ComRef<IBridgeListener>& listener) {
+    memoryBridge.Register(listener);
+}
+
+void ReplayBridge::Deregister(const ComRef<IBridgeListener>& listener) {
+    memoryBridge.Deregister(listener);
+}
+
+IMessageStorage *ReplayBridge::GetInput() {
+    return memoryBridge.GetInput();
+}
+
+IMessageStorage *ReplayBridge::GetOutput() {
+    return &storage;
+}
+
+BridgeInfo ReplayBridge::GetInfo() {
+    return info;
+}
+
+void ReplayBridge::Commit() {
+    // Get number of streams
+    uint32_t streamCount;
+    storage.ConsumeStreams(&streamCount, nullptr);
+
+    // Discard all streams, there is no producer to respond
+    streamCache.resize(streamCount);
+    storage.ConsumeStreams(&streamCount, streamCache.data());
+
+    // Tracking
+    for (uint32_t i = 0; i < streamCount; i++) {
+        info.bytesWritten += streamCache[i].GetByteSize();
+    }
+}
@@ -0,0 +1,333 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <Bridge/SharedMemory/SharedMemoryChannel.h>
+
+/// Number of idle polls before the reader starts sleeping
+static constexpr uint32_t kSharedMemoryIdleYieldCount = 1024;
+
+SharedMemoryChannel::~SharedMemoryChannel() {
+    Close();
+}
+
+bool SharedMemoryChannel::Create(const std::string& channelName, uint64_t ringCapacity) {
+    name = channelName;
+    endpoint = 0;
+
+    // Keep rings cache line aligned
+    capacity = (ringCapacity + 63) & ~63ull;
+
+    // Create memory for the header and both rings
+    if (!segment.Create(name, GetRingOffset() + 2 * SharedMemoryRing::GetByteSize(capacity))) {
+        return false;
+    }
+
+    // Setup header
+    header = new (segment.GetData()) SharedMemoryChannelHeader;
+    header->capacity = capacity;
+    header->states[0].store(SharedMemoryEndpointState::Open);
+    header->states[1].store(SharedMemoryEndpointState::Pending);
+
+    // Create both rings
+    auto* base = static_cast<uint8_t*>(segment.GetData()) + GetRingOffset();
+    SharedMemoryRing ring;
+    ring.Create(base, capacity);
+    ring.Create(base + SharedMemoryRing::GetByteSize(capacity), capacity);
+
+    // Mark as valid, name is only shared after creation
+    header->magic = SharedMemoryChannelHeader::kMagic;
+
+    // OK
+    return MapRings();
+}
+
+bool SharedMemoryChannel::Open(const std::string& channelName) {
+    name = channelName;
+    endpoint = 1;
+
+    // Try to open the memory
+    if (!segment.Open(name) || segment.GetByteSize() < GetRingOffset()) {
+        segment.Close();
+        return false;
+    }
+
+    // Validate header
+    header = static_cast<SharedMemoryChannelHeader*>(segment.GetData());
+    if (header->magic != SharedMemoryChannelHeader::kMagic) {
+        header = nullptr;
+        segment.Close();
+        return false;
+    }
+
+    // Largest ring capacity the mapping can hold
+    const uint64_t ringSpace = (segment.GetByteSize() - GetRingOffset()) / 2;
+    const uint64_t maxCapacity = ringSpace > sizeof(SharedMemoryRingHeader) ? ringSpace - sizeof(SharedMemoryRingHeader) : 0;
+
+    // Read the shared capacity once, and validate it against the mapping
+    capacity = header->capacity;
+    if (!capacity || (capacity & 63) || capacity > maxCapacity) {
+        header = nullptr;
+        segment.Close();
+        return false;
+    }
+
+    // Only a single peer may open
+    SharedMemoryEndpointState expected = SharedMemoryEndpointState::Pending;
+    if (!header->states[1].compare_exchange_strong(expected, SharedMemoryEndpointState::Open)) {
+        header = nullptr;
+        segment.Close();
+        return false;
+    }
+
+    // Rings must match the channel
+    if (!MapRings()) {
+        header->states[1].store(SharedMemoryEndpointState::Closed);
+        header = nullptr;
+        segment.Close();
+        return false;
+    }
+
+    // OK
+    return true;
+}
+
+bool SharedMemoryChannel::MapRings() {
+    auto* base = static_cast<uint8_t*>(segment.GetData()) + GetRingOffset();
+    uint8_t* rings[2] = { base, base + SharedMemoryRing::GetByteSize(capacity) };
+
+    // Creator writes to the first ring, the opener to the second
+    return writeRing.Attach(rings[endpoint], capacity) && readRing.Attach(rings[1 - endpoint], capacity);
+}
+
+void SharedMemoryChannel::Install() {
+    ASSERT(header, "Channel not created");
+    readThread = std::thread([this] { ReadWorker(); });
+    writeThread = std::thread([this] { WriteWorker(); });
+}
+
+void SharedMemoryChannel::Close() {
+    // Set under the condition lock, the writer may be about to wait
+    {
+        std::lock_guard guard(writeConditionMutex);
+        exitFlag = true;
+    }
+
+    // Wake the writer
+    writeCondition.notify_all();
+
+    // Wait for the reader and writer
+    if (readThread.joinable()) {
+        readThread.join();
+    }
+    if (writeThread.joinable()) {
+        writeThread.join();
+    }
+
+    // Wait for pending writers, released by the exit flag
+    std::lock_guard guard(writeMutex);
+
+    // Notify peer
+    if (header) {
+        header->states[endpoint].store(SharedMemoryEndpointState::Closed);
+        header = nullptr;
+    }
+
+    // Release memory
+    segment.Close();
+}
+
+bool SharedMemoryChannel::IsPeerOpen() const {
+    return header && header->states[1 - endpoint].load() != SharedMemoryEndpointState::Closed;
+}
+
+bool SharedMemoryChannel::IsOpen() const {
+    return IsPeerOpen() && header->states[endpoint].load() != SharedMemoryEndpointState::Closed;
+}
+
+void SharedMemoryChannel::CloseEndpoint() {
+    if (header) {
+        header->states[endpoint].store(SharedMemoryEndpointState::Closed);
+    }
+}
+
+bool SharedMemoryChannel::Write(const void *packetHeader, uint64_t headerSize, const void *data, uint64_t size) {
+    std::lock_guard guard(writeMutex);
+
+    // Closed after a previous failure?
+    if (!IsOpen()) {
+        return false;
+    }
+
+    // Header and data must be contiguous in the stream
+    if (WriteRange(packetHeader, headerSize) && WriteRange(data, size)) {
+        return true;
+    }
+
+    // A partial packet may be left in the ring, the peer consumes what was written and stops
+    CloseEndpoint();
+    return false;
+}
+
+bool SharedMemoryChannel::WriteQueued(const void *packetHeader, uint64_t headerSize, const void *data, uint64_t size, AsioSendPriority priority) {
+    if (!IsOpen()) {
+        return false;
+    }
+
+    // Enqueue under the condition lock, the writer may be about to wait
+    {
+        std::lock_guard guard(writeConditionMutex);
+        if (!sendQueue.Enqueue(packetHeader, headerSize, data, size, priority)) {
+            return false;
+        }
+    }
+
+    // Wake the writer
+    writeCondition.notify_one();
+    return true;
+}
+
+bool SharedMemoryChannel::TryWrite(const void *packetHeader, uint64_t headerSize, const void *data, uint64_t size) {
+    std::lock_guard guard(writeMutex);
+
+    // Entire packet must fit, partial packets would block the next write
+    if (!IsOpen() || writeRing.GetWritable() < headerSize + size) {
+        return false;
+    }
+
+    // Guaranteed not to block
+    writeRing.Write(packetHeader, headerSize);
+    writeRing.Write(data, size);
+    return true;
+}
+
+bool SharedMemoryChannel::WriteRange(const void *data, uint64_t size) {
+    auto* bytes = static_cast<const uint8_t*>(data);
+
+    // Last time the reader made progress
+    auto progressStamp = std::chrono::steady_clock::now();
+
+    // Write until exhausted, larger ranges are streamed through the ring
+    while (size) {
+        uint64_t written = writeRing.Write(bytes, size);
+
+        // Full, wait for the reader
+        if (!written) {
+            if (exitFlag || !IsPeerOpen()) {
+                return false;
+            }
+
+            // A crashed peer never marks itself as closed
+            if (std::chrono::steady_clock::now() - progressStamp > kWriteStallTimeout) {
+                return false;
+            }
+
+            std::this_thread::yield();
+            continue;
+        }
+
+        progressStamp = std::chrono::steady_clock::now();
+        bytes += written;
+        size -= written;
+    }
+
+    // OK
+    return true;
+}
+
+void SharedMemoryChannel::ReadWorker() {
+    uint32_t idleCount = 0;
+
+    while (!exitFlag) {
+        uint64_t readable = readRing.GetReadable();
+
+        // Nothing to read?
+        if (!readable) {
+            // Peer is gone and everything has been consumed
+            if (!IsPeerOpen() && !readRing.GetReadable()) {
+                break;
+            }
+
+            // Back off progressively
+            if (idleCount++ < kSharedMemoryIdleYieldCount) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            continue;
+        }
+
+        idleCount = 0;
+
+        // Read directly into the enqueued data
+        const size_t offset = enqueuedBuffer.size();
+        enqueuedBuffer.resize(offset + readable);
+        readRing.Read(enqueuedBuffer.data() + offset, readable);
+
+        // Consume enqueued data
+        if (onRead) {
+            // Reduce removal until reads are done
+            uint64_t consumptionHead = 0;
+
+            // Consume all chunks possible
+            while (consumptionHead < enqueuedBuffer.size()) {
+                uint64_t consumed = onRead(enqueuedBuffer.data() + consumptionHead, enqueuedBuffer.size() - consumptionHead);
+                if (!consumed) {
+                    break;
+                }
+
+                // Next!
+                consumptionHead += consumed;
+            }
+
+            enqueuedBuffer.erase(enqueuedBuffer.begin(), enqueuedBuffer.begin() + consumptionHead);
+        }
+    }
+}
+
+void SharedMemoryChannel::WriteWorker() {
+    while (!exitFlag) {
+        // Coalesced packets, written without holding any bridge lock
+        const std::vector<char>* packets = sendQueue.AcquireWrite();
+
+        // Nothing queued, wait for the next packet
+        if (!packets) {
+            std::unique_lock lock(writeConditionMutex);
+            writeCondition.wait(lock, [this] {
+                return exitFlag || sendQueue.GetStats().queuedPackets;
+            });
+            continue;
+        }
+
+        // Blocks while the peer is behind
+        bool written = Write(packets->data(), packets->size(), nullptr, 0);
+        sendQueue.ReleaseWrite();
+
+        // Closed or stalled, all remaining packets are discarded with the channel
+        if (!written) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,154 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <Bridge/SharedMemoryBridge.h>
+#include <Bridge/IBridgeListener.h>
+#include <Bridge/NetworkProtocol.h>
+
+// Message
+#include <Message/MessageStream.h>
+
+SharedMemoryBridge::~SharedMemoryBridge() {
+    // Stop reading before the bridge is released
+    channel.Close();
+}
+
+bool SharedMemoryBridge::Create(const std::string &name, uint64_t capacity) {
+    if (!channel.Create(name, capacity)) {
+        return false;
+    }
+
+    // Set read callback
+    channel.SetReadCallback([this](const void *data, uint64_t size) {
+        return OnReadAsync(data, size);
+    });
+
+    // Start reading
+    channel.Install();
+    return true;
+}
+
+bool SharedMemoryBridge::Open(const std::string &name) {
+    if (!channel.Open(name)) {
+        return false;
+    }
+
+    // Set read callback
+    channel.SetReadCallback([this](const void *data, uint64_t size) {
+        return OnReadAsync(data, size);
+    });
+
+    // Start reading
+    channel.Install();
+    return true;
+}
+
+uint64_t SharedMemoryBridge::OnReadAsync(const void *data, uint64_t size) {
+    auto *protocol = static_cast<const MessageStreamHeaderProtocol *>(data);
+
+    // Entire stream present?
+    if (size < sizeof(MessageStreamHeaderProtocol) ||
+        size < sizeof(MessageStreamHeaderProtocol) + protocol->size) {
+        return 0;
+    }
+
+    // Validate header
+    ASSERT(protocol->magic == MessageStreamHeaderProtocol::kMagic, "Unexpected magic header");
+
+    // Create the stream
+    MessageStream stream(protocol->schema);
+    stream.SetVersionID(protocol->versionID);
+    stream.SetData(static_cast<const uint8_t*>(data) + sizeof(MessageStreamHeaderProtocol), protocol->size, 0);
+    memoryBridge.GetOutput()->AddStream(stream);
+
+    // Determine byte count
+    const size_t bytes = sizeof(MessageStreamHeaderProtocol) + protocol->size;
+    info.bytesRead += bytes;
+
+    // Consume entire stream
+    return bytes;
+}
+
+void SharedMemoryBridge::Register(MessageID mid, const ComRef<IBridgeListener>& listener) {
+    memoryBridge.Register(mid, listener);
+}
+
+void SharedMemoryBridge::Deregister(MessageID mid, const ComRef<IBridgeListener>& listener) {
+    memoryBridge.Deregister(mid, listener);
+}
+
+void SharedMemoryBridge::Register(const ComRef<IBridgeListener>& listener) {
+    memoryBridge.Register(listener);
+}
+
+void SharedMemoryBridge::Deregister(const ComRef<IBridgeListener>& listener) {
+    memoryBridge.Deregister(listener);
+}
+
+IMessageStorage *SharedMemoryBridge::GetInput() {
+    return memoryBridge.GetInput();
+}
+
+IMessageStorage *SharedMemoryBridge::GetOutput() {
+    return &storage;
+}
+
+BridgeInfo SharedMemoryBridge::GetInfo() {
+    return info;
+}
+
+void SharedMemoryBridge::Commit() {
+    // Get number of streams
+    uint32_t streamCount;
+    storage.ConsumeStreams(&streamCount, nullptr);
+
+    // Get all streams
+    streamCache.resize(streamCount);
+    storage.ConsumeStreams(&streamCount, streamCache.data());
+
+    // Push all streams
+    for (uint32_t i = 0; i < streamCount; i++) {
+        const MessageStream &stream = streamCache[i];
+
+        // Setup protocol header
+        MessageStreamHeaderProtocol protocol;
+        protocol.schema = stream.GetSchema();
+        protocol.versionID = stream.GetVersionID();
+        protocol.size = stream.GetByteSize();
+
+        // Write header and stream data, blocks if the peer is behind
+        if (!channel.Write(&protocol, sizeof(protocol), stream.GetDataBegin(), protocol.size)) {
+            break;
+        }
+
+        // Tracking
+        info.bytesWritten += sizeof(protocol);
+        info.bytesWritten += protocol.size;
+    }
+
+    // Commit all inbound streams
+    memoryBridge.Commit();
+}
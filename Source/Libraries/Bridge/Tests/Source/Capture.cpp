@@ -0,0 +1,126 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <catch2/catch.hpp>
+
+// Bridge
+#include <Bridge/MemoryBridge.h>
+#include <Bridge/RecordingBridge.h>
+#include <Bridge/ReplayBridge.h>
+#include <Bridge/IBridgeListener.h>
+
+// Message
+#include <Message/MessageStream.h>
+#include <Message/IMessageStorage.h>
+
+// Common
+#include <Common/Registry.h>
+
+// Schemas
+#include <Schemas/PingPong.h>
+
+// Std
+#include <filesystem>
+
+/// Accumulates all received time stamps
+class PingPongAccumulator : public TComponent<PingPongAccumulator>, public IBridgeListener {
+public:
+    COMPONENT(PingPongAccumulator);
+
+    /// Overrides
+    void Handle(const MessageStream *streams, uint32_t count) override {
+        for (uint32_t i = 0; i < count; i++) {
+            ConstMessageStreamView<PingPongMessage> view(streams[i]);
+
+            for (auto it = view.GetIterator(); it; ++it) {
+                messageCount++;
+                timeStampSum += it->timeStamp;
+            }
+        }
+    }
+
+    /// Totals
+    uint64_t messageCount{0};
+    uint64_t timeStampSum{0};
+};
+
+TEST_CASE("Bridge.Capture") {
+    Registry registry;
+
+    // Destination capture
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "GRS.Bridge.Tests.Capture.bin";
+
+    auto recorded = registry.New<PingPongAccumulator>();
+    {
+        // Record an in memory bridge, all outbound streams loop back
+        auto memory = registry.New<MemoryBridge>();
+        auto recording = registry.New<RecordingBridge>();
+        REQUIRE(recording->Install(memory, path));
+        recording->Register(PingPongMessage::kID, recorded);
+
+        // Produce a set of streams
+        for (uint32_t i = 0; i < 3; i++) {
+            MessageStream stream;
+            MessageStreamView<PingPongMessage> view(stream);
+
+            // Varying message counts
+            for (uint32_t j = 0; j <= i; j++) {
+                view.Add()->timeStamp = i * 100 + j;
+            }
+
+            recording->GetOutput()->AddStream(stream);
+        }
+
+        recording->Commit();
+        recording->Flush();
+
+        // Listeners receive the streams unmodified
+        REQUIRE(recorded->messageCount == 6);
+        recording->Deregister(PingPongMessage::kID, recorded);
+    }
+
+    // Load capture
+    auto replay = registry.New<ReplayBridge>();
+    REQUIRE(replay->Install(path));
+    REQUIRE(replay->GetStreamCount() == 3);
+
+    // Replays are repeatable
+    for (uint32_t i = 0; i < 2; i++) {
+        auto replayed = registry.New<PingPongAccumulator>();
+        replay->Register(PingPongMessage::kID, replayed);
+
+        // Replay as fast as possible
+        REQUIRE(replay->Replay() == 3);
+
+        // Identical contents
+        REQUIRE(replayed->messageCount == recorded->messageCount);
+        REQUIRE(replayed->timeStampSum == recorded->timeStampSum);
+        replay->Deregister(PingPongMessage::kID, replayed);
+    }
+
+    // Cleanup
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,158 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <catch2/catch.hpp>
+
+// Bridge
+#include <Bridge/Asio/AsioSendQueue.h>
+#include <Bridge/HostServerBridge.h>
+
+// Message
+#include <Message/MessageStream.h>
+
+/// Enqueue a packet of a given payload size
+static bool EnqueuePacket(AsioSendQueue& queue, uint64_t size, AsioSendPriority priority) {
+    uint32_t header = 0xABCD;
+    std::vector<char> data(size, 1);
+    return queue.Enqueue(&header, sizeof(header), data.data(), data.size(), priority);
+}
+
+TEST_CASE("Bridge.SendQueue.Coalescing") {
+    AsioSendQueue queue;
+
+    // Small packets
+    for (uint32_t i = 0; i < 16; i++) {
+        REQUIRE(EnqueuePacket(queue, 60, AsioSendPriority::Low));
+    }
+
+    // All small packets are coalesced into a single write
+    const std::vector<char>* batch = queue.AcquireWrite();
+    REQUIRE(batch);
+    REQUIRE(batch->size() == 16 * 64);
+
+    // Only one write in flight
+    REQUIRE(EnqueuePacket(queue, 60, AsioSendPriority::Low));
+    REQUIRE(!queue.AcquireWrite());
+
+    // Release and pick up the remaining packet
+    queue.ReleaseWrite();
+    batch = queue.AcquireWrite();
+    REQUIRE(batch);
+    REQUIRE(batch->size() == 64);
+    queue.ReleaseWrite();
+
+    // Everything was written
+    AsioSendQueueStats stats = queue.GetStats();
+    REQUIRE(stats.queuedBytes == 0);
+    REQUIRE(stats.queuedPackets == 0);
+    REQUIRE(stats.droppedPackets == 0);
+}
+
+TEST_CASE("Bridge.SendQueue.Backpressure") {
+    AsioSendQueueConfig config;
+    config.sampleWaterMark = 1024;
+    config.highWaterMark = 4096;
+    config.sampleInterval = 4;
+
+    AsioSendQueue queue;
+    queue.SetConfig(config);
+
+    // Fill up to the sampling mark, all accepted
+    for (uint32_t i = 0; i < 4; i++) {
+        REQUIRE(EnqueuePacket(queue, 252, AsioSendPriority::Low));
+    }
+
+    // Sampling, one in every four kept
+    uint32_t accepted = 0;
+    for (uint32_t i = 0; i < 8; i++) {
+        accepted += EnqueuePacket(queue, 60, AsioSendPriority::Low);
+    }
+    REQUIRE(accepted == 2);
+
+    // Exceed the high water mark with control packets
+    REQUIRE(EnqueuePacket(queue, 4092, AsioSendPriority::Control));
+
+    // Low priority is dropped entirely, control is always delivered
+    REQUIRE(!EnqueuePacket(queue, 60, AsioSendPriority::Low));
+    REQUIRE(EnqueuePacket(queue, 60, AsioSendPriority::Control));
+
+    // Validate accounting
+    AsioSendQueueStats stats = queue.GetStats();
+    REQUIRE(stats.droppedPackets == 7);
+    REQUIRE(stats.droppedBytes == 7 * 64);
+    REQUIRE(stats.queuedBytes == 4 * 256 + 2 * 64 + 4096 + 64);
+    REQUIRE(stats.peakQueuedBytes == stats.queuedBytes);
+
+    // Drain the queue
+    while (queue.AcquireWrite()) {
+        queue.ReleaseWrite();
+    }
+
+    // Recovered, low priority accepted again
+    REQUIRE(queue.GetStats().queuedBytes == 0);
+    REQUIRE(EnqueuePacket(queue, 60, AsioSendPriority::Low));
+}
+
+TEST_CASE("Bridge.SendQueue.StaticControlStream") {
+    AsioSendQueueConfig config;
+    config.sampleWaterMark = 1024;
+    config.highWaterMark = 4096;
+
+    AsioSendQueue queue;
+    queue.SetConfig(config);
+
+    // Static stream not produced by the export streamer, e.g. resource versions
+    MessageStream controlStream(StaticMessageSchema::GetSchema(1));
+    controlStream.SetData(std::vector<char>(60, 1).data(), 60, 1);
+
+    // Same schema, but bulk export data
+    MessageStream exportStream(StaticMessageSchema::GetSchema(1));
+    exportStream.SetData(std::vector<char>(60, 1).data(), 60, 1);
+    exportStream.SetLossy(true);
+
+    // Only explicitly lossy streams are low priority
+    REQUIRE(HostServerBridge::GetStreamPriority(controlStream) == AsioSendPriority::Control);
+    REQUIRE(HostServerBridge::GetStreamPriority(exportStream) == AsioSendPriority::Low);
+
+    // Appending export data to control data must not make it lossy
+    MessageStream mixedStream;
+    mixedStream.Append(controlStream);
+    mixedStream.Append(exportStream);
+    REQUIRE(HostServerBridge::GetStreamPriority(mixedStream) == AsioSendPriority::Control);
+
+    // Overload the queue
+    REQUIRE(EnqueuePacket(queue, 8192, AsioSendPriority::Control));
+
+    // Export streams are dropped, the static control stream survives
+    uint32_t header = 0xABCD;
+    REQUIRE(!queue.Enqueue(&header, sizeof(header), exportStream.GetDataBegin(), exportStream.GetByteSize(), HostServerBridge::GetStreamPriority(exportStream)));
+    REQUIRE(queue.Enqueue(&header, sizeof(header), controlStream.GetDataBegin(), controlStream.GetByteSize(), HostServerBridge::GetStreamPriority(controlStream)));
+
+    // Validate accounting
+    AsioSendQueueStats stats = queue.GetStats();
+    REQUIRE(stats.droppedPackets == 1);
+    REQUIRE(stats.queuedBytes == 8196 + 64);
+}
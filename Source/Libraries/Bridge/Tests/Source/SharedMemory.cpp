@@ -0,0 +1,247 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <catch2/catch.hpp>
+
+// Bridge
+#include <Bridge/SharedMemory/SharedMemoryRing.h>
+#include <Bridge/SharedMemory/SharedMemoryChannel.h>
+
+// Std
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+/// Get a name unique to this run
+static std::string GetChannelName(const char* name) {
+    return std::string("GRS.Bridge.Tests.") + name + "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+/// Test packet header
+struct TestPacketHeader {
+    uint32_t index;
+    uint32_t size;
+};
+
+TEST_CASE("Bridge.SharedMemory.Ring") {
+    struct alignas(64) Memory {
+        uint8_t data[SharedMemoryRing::GetByteSize(64)];
+    } memory;
+
+    SharedMemoryRing producer;
+    producer.Create(&memory, 64);
+
+    SharedMemoryRing consumer;
+    REQUIRE(consumer.Attach(&memory, 64));
+
+    // Capacity must match the expected capacity
+    SharedMemoryRing mismatched;
+    REQUIRE(!mismatched.Attach(&memory, 128));
+
+    // Sequential data
+    uint8_t source[128];
+    for (uint32_t i = 0; i < 128; i++) {
+        source[i] = static_cast<uint8_t>(i);
+    }
+
+    // Partial read
+    REQUIRE(producer.Write(source, 48) == 48);
+    uint8_t dest[128];
+    REQUIRE(consumer.Read(dest, 32) == 32);
+
+    // Wraps around, limited by the capacity
+    REQUIRE(producer.GetWritable() == 48);
+    REQUIRE(producer.Write(source + 48, 80) == 48);
+    REQUIRE(producer.Write(source, 8) == 0);
+
+    // Everything is read in order
+    REQUIRE(consumer.GetReadable() == 64);
+    REQUIRE(consumer.Read(dest + 32, 128) == 64);
+    for (uint32_t i = 0; i < 96; i++) {
+        REQUIRE(dest[i] == i);
+    }
+
+    // Empty
+    REQUIRE(consumer.Read(dest, 8) == 0);
+}
+
+TEST_CASE("Bridge.SharedMemory.Channel") {
+    const std::string name = GetChannelName("Channel");
+
+    // Create both endpoints
+    SharedMemoryChannel owner;
+    REQUIRE(owner.Create(name, 4096));
+
+    SharedMemoryChannel peer;
+    REQUIRE(peer.Open(name));
+
+    // Only a single peer per channel
+    SharedMemoryChannel other;
+    REQUIRE(!other.Open(name));
+
+    // Number of packets to send, sizes exceed the ring capacity
+    constexpr uint32_t kPacketCount = 2000;
+    constexpr uint32_t kMaxPacketSize = 10'000;
+
+    std::atomic<uint32_t> receivedCount{0};
+    std::atomic<bool> failed{false};
+
+    // Validate ordering and contents
+    peer.SetReadCallback([&](const void *data, uint64_t size) -> uint64_t {
+        auto* header = static_cast<const TestPacketHeader*>(data);
+        if (size < sizeof(TestPacketHeader) || size < sizeof(TestPacketHeader) + header->size) {
+            return 0;
+        }
+
+        // Must be in order
+        failed = failed || header->index != receivedCount;
+
+        // Check contents
+        auto* payload = reinterpret_cast<const uint8_t*>(header + 1);
+        for (uint32_t i = 0; i < header->size; i++) {
+            failed = failed || payload[i] != static_cast<uint8_t>(header->index + i);
+        }
+
+        receivedCount++;
+        return sizeof(TestPacketHeader) + header->size;
+    });
+    peer.Install();
+
+    // Write from another thread
+    std::thread producer([&] {
+        std::vector<uint8_t> payload;
+
+        for (uint32_t i = 0; i < kPacketCount; i++) {
+            TestPacketHeader header{ .index = i, .size = (i * 7919) % kMaxPacketSize };
+
+            // Fill payload
+            payload.resize(header.size);
+            for (uint32_t j = 0; j < header.size; j++) {
+                payload[j] = static_cast<uint8_t>(i + j);
+            }
+
+            failed = failed || !owner.Write(&header, sizeof(header), payload.data(), payload.size());
+        }
+    });
+    producer.join();
+
+    // Wait for all packets
+    for (uint32_t i = 0; i < 1000 && receivedCount != kPacketCount; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    REQUIRE(!failed);
+    REQUIRE(receivedCount == kPacketCount);
+
+    // Packets that do not fit are not partially written
+    std::vector<uint8_t> large(8192);
+    TestPacketHeader header{ .index = kPacketCount, .size = static_cast<uint32_t>(large.size()) };
+    REQUIRE(!owner.TryWrite(&header, sizeof(header), large.data(), large.size()));
+
+    // Closing notifies the other endpoint
+    peer.Close();
+    REQUIRE(!owner.IsPeerOpen());
+    REQUIRE(!owner.Write(&header, sizeof(header), large.data(), large.size()));
+    REQUIRE(!owner.IsOpen());
+}
+
+TEST_CASE("Bridge.SharedMemory.ChannelQueued") {
+    const std::string name = GetChannelName("ChannelQueued");
+
+    // Create both endpoints
+    SharedMemoryChannel owner;
+    REQUIRE(owner.Create(name, 4096));
+
+    SharedMemoryChannel peer;
+    REQUIRE(peer.Open(name));
+
+    // Small queue, low priority packets are dropped past 64kb
+    owner.SetSendQueueConfig(AsioSendQueueConfig {
+        .sampleWaterMark = 64'000,
+        .highWaterMark = 64'000
+    });
+
+    constexpr uint32_t kPacketCount = 100;
+    constexpr uint32_t kPacketSize = 1'000;
+
+    std::atomic<uint32_t> receivedCount{0};
+    std::atomic<bool> failed{false};
+
+    // Validate ordering
+    peer.SetReadCallback([&](const void *data, uint64_t size) -> uint64_t {
+        auto* header = static_cast<const TestPacketHeader*>(data);
+        if (size < sizeof(TestPacketHeader) || size < sizeof(TestPacketHeader) + header->size) {
+            return 0;
+        }
+
+        failed = failed || header->index != receivedCount;
+        receivedCount++;
+        return sizeof(TestPacketHeader) + header->size;
+    });
+    peer.Install();
+
+    // Enqueue before the writer is installed, never blocks although the ring is far smaller
+    std::vector<uint8_t> payload(kPacketSize);
+    for (uint32_t i = 0; i < kPacketCount; i++) {
+        TestPacketHeader header{ .index = i, .size = kPacketSize };
+        REQUIRE(owner.WriteQueued(&header, sizeof(header), payload.data(), payload.size(), AsioSendPriority::Control));
+    }
+
+    // Low priority packets are subject to the limits
+    TestPacketHeader dropped{ .index = kPacketCount, .size = kPacketSize };
+    REQUIRE(!owner.WriteQueued(&dropped, sizeof(dropped), payload.data(), payload.size(), AsioSendPriority::Low));
+    REQUIRE(owner.GetSendQueueStats().droppedPackets == 1);
+
+    // Start writing
+    owner.Install();
+
+    // Wait for all packets
+    for (uint32_t i = 0; i < 1000 && receivedCount != kPacketCount; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    REQUIRE(!failed);
+    REQUIRE(receivedCount == kPacketCount);
+}
+
+TEST_CASE("Bridge.SharedMemory.ChannelValidation") {
+    const std::string name = GetChannelName("ChannelValidation");
+
+    SharedMemoryChannel owner;
+    REQUIRE(owner.Create(name, 4096));
+
+    // Corrupt the shared capacity beyond the mapping
+    {
+        SharedMemorySegment segment;
+        REQUIRE(segment.Open(name));
+        static_cast<SharedMemoryChannelHeader*>(segment.GetData())->capacity = UINT64_MAX & ~63ull;
+    }
+
+    // Must not map rings outside the segment
+    SharedMemoryChannel peer;
+    REQUIRE(!peer.Open(name));
+}
@@ -0,0 +1,187 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Common
+#include <Common/Allocators.h>
+#include <Common/Assert.h>
+
+// Std
+#include <atomic>
+#include <cstdint>
+
+/// Append only log, appends are lock free
+///   ! Indices are stable, entries below the truncation base are released
+///   ! At most CHUNK_LENGTH * MAX_CHUNKS entries are live at any time
+template<typename T, uint32_t CHUNK_LENGTH = 4096, uint32_t MAX_CHUNKS = 16384>
+class AppendLog {
+public:
+    /// Maximum number of live entries
+    static constexpr uint32_t kCapacity = CHUNK_LENGTH * MAX_CHUNKS;
+
+    /// Constructor
+    /// \param allocators chunk allocators
+    AppendLog(const Allocators& allocators = {}) : allocators(allocators) {
+        
+    }
+
+    /// Destructor
+    ~AppendLog() {
+        for (std::atomic<Chunk*>& chunk : chunks) {
+            if (Chunk* ptr = chunk.load(std::memory_order_acquire)) {
+                destroy(ptr, allocators);
+            }
+        }
+    }
+
+    /// No copy
+    AppendLog(const AppendLog&) = delete;
+    AppendLog& operator=(const AppendLog&) = delete;
+
+    /// Try to append a new entry
+    /// \param value value to append
+    /// \param index destination index of the entry
+    /// \return false if the log is full, truncate and try again
+    bool TryAppend(const T& value, uint32_t& index) {
+        // Reserve the index, only if within the live window
+        index = reserved.load(std::memory_order_relaxed);
+        do {
+            if (index - base.load(std::memory_order_acquire) >= kCapacity) {
+                return false;
+            }
+        } while (!reserved.compare_exchange_weak(index, index + 1u, std::memory_order_relaxed));
+
+        // Write the entry
+        Entry& entry = GetOrAllocateChunk(ChunkSlot(index))->entries[index % CHUNK_LENGTH];
+        entry.value = value;
+
+        // Visible to readers
+        entry.ready.store(true, std::memory_order_release);
+        return true;
+    }
+
+    /// Get the number of contiguous readable entries
+    /// \param from index known to be readable, all entries prior must be readable, must not be below the base
+    /// \return total number of readable entries
+    uint32_t GetReadableCount(uint32_t from) const {
+        uint32_t end = reserved.load(std::memory_order_acquire);
+
+        // Walk until the first entry in flight
+        for (; from < end; from++) {
+            Chunk* chunk = chunks[ChunkSlot(from)].load(std::memory_order_acquire);
+            if (!chunk || !chunk->entries[from % CHUNK_LENGTH].ready.load(std::memory_order_acquire)) {
+                break;
+            }
+        }
+
+        // OK
+        return from;
+    }
+
+    /// Get an entry
+    /// \param index must be readable, and not below the base
+    /// \return entry value
+    const T& Get(uint32_t index) const {
+        ASSERT(index >= base.load(std::memory_order_relaxed), "Entry has been truncated");
+        return chunks[ChunkSlot(index)].load(std::memory_order_acquire)->entries[index % CHUNK_LENGTH].value;
+    }
+
+    /// Release all entries below an index, only whole chunks are released
+    ///   ! Not thread safe with respect to readers, appends may be in flight
+    /// \param index all entries prior must be readable
+    void Truncate(uint32_t index) {
+        uint32_t current = base.load(std::memory_order_relaxed);
+
+        // Release all whole chunks below the index
+        for (; current + CHUNK_LENGTH <= index; current += CHUNK_LENGTH) {
+            if (Chunk* chunk = chunks[ChunkSlot(current)].exchange(nullptr, std::memory_order_acq_rel)) {
+                destroy(chunk, allocators);
+            }
+        }
+
+        // Slots are free before the window moves
+        base.store(current, std::memory_order_release);
+    }
+
+    /// Get the lowest live index
+    uint32_t GetBase() const {
+        return base.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Entry {
+        /// Entry value
+        T value;
+
+        /// Has the value been written?
+        std::atomic<bool> ready{false};
+    };
+
+    struct Chunk {
+        /// All entries
+        Entry entries[CHUNK_LENGTH];
+    };
+
+    /// Get the chunk slot of an index
+    /// \param index entry index
+    /// \return slot
+    static uint32_t ChunkSlot(uint32_t index) {
+        return (index / CHUNK_LENGTH) % MAX_CHUNKS;
+    }
+
+    /// Get a chunk, allocate if not present
+    /// \param index chunk index
+    /// \return chunk
+    Chunk* GetOrAllocateChunk(uint32_t index) {
+        Chunk* chunk = chunks[index].load(std::memory_order_acquire);
+        if (chunk) {
+            return chunk;
+        }
+
+        // Try to install a new chunk
+        auto* candidate = new (allocators) Chunk();
+        if (chunks[index].compare_exchange_strong(chunk, candidate, std::memory_order_acq_rel)) {
+            return candidate;
+        }
+
+        // Another writer installed it first
+        destroy(candidate, allocators);
+        return chunk;
+    }
+
+private:
+    Allocators allocators;
+
+    /// All chunks, indexed by slot
+    std::atomic<Chunk*> chunks[MAX_CHUNKS]{};
+
+    /// Number of reserved entries
+    std::atomic<uint32_t> reserved{0};
+
+    /// Lowest live entry, always chunk aligned
+    std::atomic<uint32_t> base{0};
+};
@@ -0,0 +1,140 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Common
+#include <Common/Assert.h>
+
+// Std
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+/// Bounded lock-free queue for trivially copyable objects
+///   Multiple producers and consumers, neither ever blocks
+template<typename T>
+struct LockFreeQueue {
+    /// Constructor
+    /// \param capacity number of slots, must be a power of two
+    LockFreeQueue(size_t capacity) : cells(new Cell[capacity]), mask(capacity - 1) {
+        ASSERT(capacity && !(capacity & mask), "Capacity must be a power of two");
+
+        // Initial sequences
+        for (size_t i = 0; i < capacity; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /// No copy
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    /// Try to push an object
+    /// \param value object to push
+    /// \return false if full
+    bool TryPush(const T& value) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+
+        for (;;) {
+            Cell& cell = cells[position & mask];
+
+            // Compare the cell sequence against the expected position
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t delta = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            // Free cell, try to claim it
+            if (delta == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (delta < 0) {
+                // Cell not yet consumed, full
+                return false;
+            } else {
+                // Another producer claimed it
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Try to pop an object
+    /// \param out filled object
+    /// \return false if empty
+    bool TryPop(T& out) {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+
+        for (;;) {
+            Cell& cell = cells[position & mask];
+
+            // Compare the cell sequence against the expected position
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t delta = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+            // Filled cell, try to claim it
+            if (delta == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    out = cell.value;
+                    cell.sequence.store(position + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (delta < 0) {
+                // Cell not yet produced, empty
+                return false;
+            } else {
+                // Another consumer claimed it
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Check if the queue is empty, approximate under contention
+    bool IsEmpty() const {
+        return enqueuePosition.load(std::memory_order_acquire) == dequeuePosition.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Cell {
+        /// Sequence, position of the next expected operation on this cell
+        std::atomic<size_t> sequence;
+
+        /// Stored value
+        T value;
+    };
+
+    /// All cells
+    std::unique_ptr<Cell[]> cells;
+
+    /// Wrapping mask
+    size_t mask;
+
+    /// Separate cache lines for producers and consumers
+    alignas(64) std::atomic<size_t> enqueuePosition{0};
+    alignas(64) std::atomic<size_t> dequeuePosition{0};
+};
@@ -36,6 +36,11 @@ struct Library {
     /// \return success state
     bool Load(const std::string& path);
 
+    /// Get the platform path of a library
+    /// \param path path of the library, without extension
+    /// \return platform path
+    static std::string GetPlatformPath(const std::string& path);
+
     /// Free a library
     void Free();
 
@@ -0,0 +1,123 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Common
+#include <Common/Plugin/PluginInfo.h>
+
+// Std
+#include <filesystem>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+
+/// File stamp used for invalidation
+struct PluginManifestStamp {
+    /// Check if two stamps are equal
+    bool operator==(const PluginManifestStamp& other) const {
+        return writeTime == other.writeTime && size == other.size;
+    }
+
+    /// Last write time, implementation defined epoch
+    uint64_t writeTime{0};
+
+    /// Byte size of the file
+    uint64_t size{0};
+};
+
+/// All plugins of a single spec category
+struct PluginManifestCategory {
+    /// Name of the category
+    std::string name;
+
+    /// All plugin handle names
+    std::vector<std::string> plugins;
+};
+
+/// Binary cache of parsed plugin specs and plugin infos, invalidated on file changes
+class PluginManifestCache {
+public:
+    /// Get the stamp of a file
+    /// \param path path of the file
+    /// \return empty stamp if not found
+    static PluginManifestStamp GetStamp(const std::filesystem::path& path);
+
+    /// Load a cache from disk
+    /// \param path path of the cache
+    /// \return false if not found or invalid
+    bool Load(const std::filesystem::path& path);
+
+    /// Store this cache to disk if modified
+    /// \param path path of the cache
+    /// \return success state
+    bool Store(const std::filesystem::path& path);
+
+    /// Find the categories of a spec
+    /// \param name name of the spec
+    /// \param stamp expected stamp of the spec
+    /// \return nullptr if not found or out of date
+    const std::vector<PluginManifestCategory>* FindSpec(const std::string& name, const PluginManifestStamp& stamp) const;
+
+    /// Set the categories of a spec
+    /// \param name name of the spec
+    /// \param stamp stamp of the spec
+    /// \param categories all categories
+    void SetSpec(const std::string& name, const PluginManifestStamp& stamp, const std::vector<PluginManifestCategory>& categories);
+
+    /// Find the info of a plugin
+    /// \param name handle name of the plugin
+    /// \param stamp expected stamp of the plugin library
+    /// \return nullptr if not found or out of date
+    const PluginInfo* FindInfo(const std::string& name, const PluginManifestStamp& stamp) const;
+
+    /// Set the info of a plugin
+    /// \param name handle name of the plugin
+    /// \param stamp stamp of the plugin library
+    /// \param info the plugin info
+    void SetInfo(const std::string& name, const PluginManifestStamp& stamp, const PluginInfo& info);
+
+private:
+    struct SpecEntry {
+        PluginManifestStamp stamp;
+        std::vector<PluginManifestCategory> categories;
+    };
+
+    struct InfoEntry {
+        PluginManifestStamp stamp;
+        PluginInfo info;
+    };
+
+    /// All cached specs
+    std::map<std::string, SpecEntry> specs;
+
+    /// All cached plugin infos
+    std::map<std::string, InfoEntry> infos;
+
+    /// Modified since load?
+    bool dirty{false};
+};
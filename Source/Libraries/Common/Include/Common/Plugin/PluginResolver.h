@@ -33,6 +33,7 @@
 #include <Common/Plugin/PluginInfo.h>
 #include <Common/Plugin/PluginList.h>
 #include <Common/Plugin/PluginResolveFlag.h>
+#include <Common/Plugin/PluginManifestCache.h>
 
 // Std
 #include <string_view>
@@ -40,11 +41,6 @@
 #include <string>
 #include <map>
 
-// Forward declarations
-namespace tinyxml2 {
-    class XMLNode;
-}
-
 class PluginResolver : public TComponent<PluginResolver> {
 public:
     COMPONENT(PluginResolver);
@@ -68,7 +64,11 @@ public:
     void Uninstall();
 
 private:
-    bool FindPluginAtNode(tinyxml2::XMLNode* catChildNode, PluginList* list);
+    /// Find a plugin, the library is only loaded if its info is not cached
+    /// \param name handle name of the plugin
+    /// \param list the output list
+    /// \return true if successful
+    bool FindPlugin(const std::string& name, PluginList* list);
 
     bool InstallPlugin(const PluginEntry& entry);
 
@@ -76,6 +76,7 @@ private:
     /// Internal plugin mode
     enum class PluginMode {
         None,
+        Discovered,
         Loaded,
         Installed
     };
@@ -87,7 +88,7 @@ private:
         PluginMode mode{PluginMode::None};
     };
 
-    /// Get a plugin, load if not already loaded
+    /// Get a plugin, load if not already loaded or only discovered
     /// \param path path of the plugin
     /// \return the state
     PluginState& GetPluginOrLoad(const std::string& path);
@@ -96,6 +97,12 @@ private:
     /// Plugins path
     std::filesystem::path pluginPath;
 
-    /// All loaded plugins
+    /// All discovered or loaded plugins
     std::map<std::string, PluginState> plugins;
+
+    /// Cached specs and plugin infos
+    PluginManifestCache manifestCache;
+
+    /// Has the manifest cache been loaded?
+    bool manifestCacheLoaded{false};
 };
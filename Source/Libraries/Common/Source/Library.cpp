@@ -36,11 +36,15 @@
 // Implementation
 #ifdef WIN32
 bool Library::Load(const std::string &path) {
-    sourcePath = path + ".dll";
+    sourcePath = GetPlatformPath(path);
     handle = LoadLibrary(sourcePath.c_str());
     return handle != nullptr;
 }
 
+std::string Library::GetPlatformPath(const std::string &path) {
+    return path + ".dll";
+}
+
 void Library::Free() {
     FreeLibrary(static_cast<HINSTANCE>(handle));
     handle = nullptr;
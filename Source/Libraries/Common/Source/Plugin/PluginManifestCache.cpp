@@ -0,0 +1,321 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <Common/Plugin/PluginManifestCache.h>
+#include <Common/GlobalUID.h>
+
+// Std
+#include <fstream>
+
+/// Magic header of the cache
+static constexpr uint32_t kManifestMagic = 0x4D505247;
+
+/// Version of the cache layout, bump on changes
+static constexpr uint32_t kManifestVersion = 1;
+
+/// Minimum serialized sizes, name length + stamp + category count
+static constexpr uint64_t kMinSpecSize = sizeof(uint32_t) + sizeof(PluginManifestStamp) + sizeof(uint32_t);
+
+/// Name length + plugin count
+static constexpr uint64_t kMinCategorySize = sizeof(uint32_t) * 2;
+
+/// Handle name length + stamp + name, description length, dependency count
+static constexpr uint64_t kMinInfoSize = sizeof(uint32_t) + sizeof(PluginManifestStamp) + sizeof(uint32_t) * 3;
+
+/// Write a trivial value
+template<typename T>
+static void Write(std::ofstream& stream, const T& value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/// Write a string
+static void Write(std::ofstream& stream, const std::string& value) {
+    Write(stream, static_cast<uint32_t>(value.length()));
+    stream.write(value.data(), value.length());
+}
+
+/// Write a list of strings
+static void Write(std::ofstream& stream, const std::vector<std::string>& values) {
+    Write(stream, static_cast<uint32_t>(values.size()));
+    for (const std::string& value : values) {
+        Write(stream, value);
+    }
+}
+
+/// Check if a number of bytes can still be read
+/// \param stream source stream
+/// \param end end offset of the stream
+/// \param bytes number of bytes to read
+/// \return false if past the end
+static bool CanRead(std::ifstream& stream, uint64_t end, uint64_t bytes) {
+    std::streamoff position = stream.tellg();
+    return position >= 0 && static_cast<uint64_t>(position) <= end && bytes <= end - static_cast<uint64_t>(position);
+}
+
+/// Read a trivial value
+template<typename T>
+static bool Read(std::ifstream& stream, T& value) {
+    return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/// Read an element count, validated against the remaining bytes
+/// \param minElementSize minimum serialized size of a single element
+template<typename T>
+static bool ReadCount(std::ifstream& stream, uint64_t end, uint64_t minElementSize, T& count) {
+    return Read(stream, count) && CanRead(stream, end, static_cast<uint64_t>(count) * minElementSize);
+}
+
+/// Read a string
+static bool Read(std::ifstream& stream, uint64_t end, std::string& value) {
+    uint32_t length;
+    if (!ReadCount(stream, end, 1u, length)) {
+        return false;
+    }
+
+    value.resize(length);
+    return static_cast<bool>(stream.read(value.data(), length));
+}
+
+/// Read a list of strings
+static bool Read(std::ifstream& stream, uint64_t end, std::vector<std::string>& values) {
+    uint32_t count;
+    if (!ReadCount(stream, end, sizeof(uint32_t), count)) {
+        return false;
+    }
+
+    values.resize(count);
+    for (std::string& value : values) {
+        if (!Read(stream, end, value)) {
+            return false;
+        }
+    }
+
+    // OK
+    return true;
+}
+
+PluginManifestStamp PluginManifestCache::GetStamp(const std::filesystem::path &path) {
+    std::error_code error;
+
+    // Get the write time
+    std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, error);
+    if (error) {
+        return {};
+    }
+
+    // Get the size
+    uintmax_t size = std::filesystem::file_size(path, error);
+    if (error) {
+        return {};
+    }
+
+    // OK
+    return PluginManifestStamp {
+        .writeTime = static_cast<uint64_t>(writeTime.time_since_epoch().count()),
+        .size = static_cast<uint64_t>(size)
+    };
+}
+
+bool PluginManifestCache::Load(const std::filesystem::path &path) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.good()) {
+        return false;
+    }
+
+    // Get the end offset, all lengths are validated against it
+    stream.seekg(0, std::ios::end);
+    std::streamoff endOffset = stream.tellg();
+    stream.seekg(0, std::ios::beg);
+    if (endOffset < 0 || !stream.good()) {
+        return false;
+    }
+
+    // Corrupt lengths are treated as a miss
+    const uint64_t end = static_cast<uint64_t>(endOffset);
+
+    // Validate header
+    uint32_t magic, version;
+    if (!Read(stream, magic) || !Read(stream, version) || magic != kManifestMagic || version != kManifestVersion) {
+        return false;
+    }
+
+    // Read all specs
+    uint32_t specCount;
+    if (!ReadCount(stream, end, kMinSpecSize, specCount)) {
+        return false;
+    }
+
+    // Read into a staging map, partial caches are discarded
+    std::map<std::string, SpecEntry> loadedSpecs;
+    for (uint32_t i = 0; i < specCount; i++) {
+        std::string name;
+        SpecEntry entry;
+
+        // Read spec
+        uint32_t categoryCount;
+        if (!Read(stream, end, name) || !Read(stream, entry.stamp) || !ReadCount(stream, end, kMinCategorySize, categoryCount)) {
+            return false;
+        }
+
+        // Read all categories
+        entry.categories.resize(categoryCount);
+        for (PluginManifestCategory& category : entry.categories) {
+            if (!Read(stream, end, category.name) || !Read(stream, end, category.plugins)) {
+                return false;
+            }
+        }
+
+        loadedSpecs[name] = std::move(entry);
+    }
+
+    // Read all infos
+    uint32_t infoCount;
+    if (!ReadCount(stream, end, kMinInfoSize, infoCount)) {
+        return false;
+    }
+
+    // Read into a staging map, partial caches are discarded
+    std::map<std::string, InfoEntry> loadedInfos;
+    for (uint32_t i = 0; i < infoCount; i++) {
+        std::string name;
+        InfoEntry entry;
+
+        // Read info
+        if (!Read(stream, end, name) ||
+            !Read(stream, entry.stamp) ||
+            !Read(stream, end, entry.info.name) ||
+            !Read(stream, end, entry.info.description) ||
+            !Read(stream, end, entry.info.dependencies)) {
+            return false;
+        }
+
+        loadedInfos[name] = std::move(entry);
+    }
+
+    // OK
+    specs = std::move(loadedSpecs);
+    infos = std::move(loadedInfos);
+    dirty = false;
+    return true;
+}
+
+bool PluginManifestCache::Store(const std::filesystem::path &path) {
+    if (!dirty) {
+        return true;
+    }
+
+    // Multiple processes may store at the same time, write to a unique file and swap
+    std::filesystem::path stagingPath = path;
+    stagingPath += "." + GlobalUID::New().ToString();
+
+    // Write contents
+    {
+        std::ofstream stream(stagingPath, std::ios::binary);
+        if (!stream.good()) {
+            return false;
+        }
+
+        // Write header
+        Write(stream, kManifestMagic);
+        Write(stream, kManifestVersion);
+
+        // Write all specs
+        Write(stream, static_cast<uint32_t>(specs.size()));
+        for (auto&& [name, entry] : specs) {
+            Write(stream, name);
+            Write(stream, entry.stamp);
+            Write(stream, static_cast<uint32_t>(entry.categories.size()));
+
+            for (const PluginManifestCategory& category : entry.categories) {
+                Write(stream, category.name);
+                Write(stream, category.plugins);
+            }
+        }
+
+        // Write all infos
+        Write(stream, static_cast<uint32_t>(infos.size()));
+        for (auto&& [name, entry] : infos) {
+            Write(stream, name);
+            Write(stream, entry.stamp);
+            Write(stream, entry.info.name);
+            Write(stream, entry.info.description);
+            Write(stream, entry.info.dependencies);
+        }
+
+        // Failed to write?
+        if (!stream.good()) {
+            stream.close();
+
+            std::error_code error;
+            std::filesystem::remove(stagingPath, error);
+            return false;
+        }
+    }
+
+    // Replace the existing cache
+    std::error_code error;
+    std::filesystem::rename(stagingPath, path, error);
+    if (error) {
+        std::filesystem::remove(stagingPath, error);
+        return false;
+    }
+
+    // OK
+    dirty = false;
+    return true;
+}
+
+const std::vector<PluginManifestCategory>* PluginManifestCache::FindSpec(const std::string &name, const PluginManifestStamp &stamp) const {
+    auto it = specs.find(name);
+    if (it == specs.end() || !(it->second.stamp == stamp)) {
+        return nullptr;
+    }
+
+    return &it->second.categories;
+}
+
+void PluginManifestCache::SetSpec(const std::string &name, const PluginManifestStamp &stamp, const std::vector<PluginManifestCategory> &categories) {
+    SpecEntry& entry = specs[name];
+    entry.stamp = stamp;
+    entry.categories = categories;
+    dirty = true;
+}
+
+const PluginInfo* PluginManifestCache::FindInfo(const std::string &name, const PluginManifestStamp &stamp) const {
+    auto it = infos.find(name);
+    if (it == infos.end() || !(it->second.stamp == stamp)) {
+        return nullptr;
+    }
+
+    return &it->second.info;
+}
+
+void PluginManifestCache::SetInfo(const std::string &name, const PluginManifestStamp &stamp, const PluginInfo &info) {
+    InfoEntry& entry = infos[name];
+    entry.stamp = stamp;
+    entry.info = info;
+    dirty = true;
+}
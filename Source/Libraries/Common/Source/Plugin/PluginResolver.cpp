@@ -38,43 +38,116 @@ PluginResolver::PluginResolver() {
     pluginPath = GetBaseModuleDirectory() / "Plugins";
 }
 
+/// Name of the manifest cache
+static constexpr const char* kManifestCacheName = "PluginManifest.bin";
+
+/// Parse all categories of a plugin spec
+/// \param path path of the spec
+/// \param categories output categories
+/// \return false if malformed
+static bool ParseSpec(const std::filesystem::path& path, std::vector<PluginManifestCategory>& categories) {
+    // Attempt to open the xml
+    tinyxml2::XMLDocument document;
+    if (document.LoadFile(path.string().c_str()) != tinyxml2::XML_SUCCESS) {
+        std::cerr << "Failed to parse plugin xml: " << path << std::endl;
+        return false;
+    }
+
+    // Get the root spec
+    tinyxml2::XMLElement *specNode = document.FirstChildElement("spec");
+    if (!specNode) {
+        std::cerr << "Failed to find root spec in xml" << std::endl;
+        return false;
+    }
+
+    // Process all nodes
+    for (tinyxml2::XMLNode *catNode = specNode->FirstChild(); catNode; catNode = catNode->NextSibling()) {
+        tinyxml2::XMLElement *cat = catNode->ToElement();
+        if (!cat) {
+            continue;
+        }
+
+        // Create category
+        PluginManifestCategory& category = categories.emplace_back();
+        category.name = cat->Name();
+
+        // Process all plugins
+        for (tinyxml2::XMLNode *catChildNode = cat->FirstChild(); catChildNode; catChildNode = catChildNode->NextSibling()) {
+            tinyxml2::XMLElement *catChild = catChildNode->ToElement();
+            if (!catChild) {
+                continue;
+            }
+
+            // Must be plugin under categories
+            if (std::strcmp(catChild->Name(), "plugin")) {
+                std::cerr << "Category child must be plugin in line: " << catChild->GetLineNum() << std::endl;
+                return false;
+            }
+
+            // Get the name
+            const char *name = catChild->Attribute("name", nullptr);
+            if (!name) {
+                std::cerr << "Malformed command in line: " << catChild->GetLineNum() << ", name not found" << std::endl;
+                return false;
+            }
+
+            // Add plugin
+            category.plugins.emplace_back(name);
+        }
+    }
+
+    // OK
+    return true;
+}
+
 bool PluginResolver::FindPlugins(const std::string_view &category, PluginList* list, PluginResolveFlagSet flags) {
+    std::filesystem::path manifestCachePath = GetIntermediateCachePath() / kManifestCacheName;
+
+    // Load the cache on first use, missing or invalid caches are rebuilt
+    if (!manifestCacheLoaded) {
+        manifestCache.Load(manifestCachePath);
+        manifestCacheLoaded = true;
+    }
+
     for (const auto & entry : std::filesystem::directory_iterator(pluginPath)) {
         // TODO: Casing?
         if (entry.path().extension() != ".xml") {
             continue;
         }
 
-        // Attempt to open the xml
-        tinyxml2::XMLDocument document;
-        if (document.LoadFile(entry.path().string().c_str()) != tinyxml2::XML_SUCCESS) {
-            std::cerr << "Failed to parse plugin xml: " << entry.path() << std::endl;
-            return false;
-        }
+        // Cached specs are keyed on the file stamp
+        std::string specName = entry.path().filename().string();
+        PluginManifestStamp specStamp = PluginManifestCache::GetStamp(entry.path());
 
-        // Get the root spec
-        tinyxml2::XMLElement *specNode = document.FirstChildElement("spec");
-        if (!specNode) {
-            std::cerr << "Failed to find root spec in xml" << std::endl;
-            return false;
-        }
+        // Try to find the parsed spec
+        const std::vector<PluginManifestCategory>* categories = manifestCache.FindSpec(specName, specStamp);
+        if (!categories) {
+            std::vector<PluginManifestCategory> parsed;
+            if (!ParseSpec(entry.path(), parsed)) {
+                if (flags & PluginResolveFlag::ContinueOnFailure) {
+                    continue;
+                }
 
-        // Process all nodes
-        for (tinyxml2::XMLNode *catNode = specNode->FirstChild(); catNode; catNode = catNode->NextSibling()) {
-            tinyxml2::XMLElement *cat = catNode->ToElement();
-            if (!cat) {
-                continue;
+                // Considered failure
+                return false;
             }
 
+            // Cache the parsed spec
+            manifestCache.SetSpec(specName, specStamp, parsed);
+            categories = manifestCache.FindSpec(specName, specStamp);
+        }
+
+        // Process all categories
+        for (const PluginManifestCategory& cat : *categories) {
             // Not a match?
-            if (category != cat->Name()) {
+            if (category != cat.name) {
                 continue;
             }
 
             // Process all plugins
-            for (tinyxml2::XMLNode *catChildNode = cat->FirstChild(); catChildNode; catChildNode = catChildNode->NextSibling()) {
-                // Attempt to pre-load
-                if (!FindPluginAtNode(catChildNode, list)) {
+            for (const std::string& plugin : cat.plugins) {
+                // Attempt to find
+                if (!FindPlugin(plugin, list)) {
                     if (flags & PluginResolveFlag::ContinueOnFailure) {
                         continue;
                     }
@@ -86,45 +159,59 @@ bool PluginResolver::FindPlugins(const std::string_view &category, PluginList* l
         }
     }
 
+    // Store any changes, failure only affects subsequent lookups
+    manifestCache.Store(manifestCachePath);
+
     // OK
     return true;
 }
 
-bool PluginResolver::FindPluginAtNode(tinyxml2::XMLNode *catChildNode, PluginList* list) {
-    tinyxml2::XMLElement *catChild = catChildNode->ToElement();
+bool PluginResolver::FindPlugin(const std::string& name, PluginList* list) {
+    auto it = plugins.find(name);
+
+    // Not seen yet?
+    if (it == plugins.end()) {
+        // Cached infos are keyed on the library stamp
+        PluginManifestStamp stamp = PluginManifestCache::GetStamp(Library::GetPlatformPath((pluginPath / name).string()));
+
+        // If cached, defer loading of the library until installation
+        if (const PluginInfo* info = manifestCache.FindInfo(name, stamp)) {
+            PluginState& state = plugins[name];
+            state.info = *info;
+            state.mode = PluginMode::Discovered;
+        } else {
+            // Attempt to load
+            PluginState &state = GetPluginOrLoad(name);
+            if (!state.library.IsGood()) {
+                return false;
+            }
 
-    // Must be plugin under categories
-    if (std::strcmp(catChild->Name(), "plugin")) {
-        std::cerr << "Category child must be plugin in line: " << catChild->GetLineNum() << std::endl;
-        return false;
-    }
+            // Get the info delegate
+            auto* delegate = state.library.GetProcAddr<PluginInfoDelegate>(PLUGIN_INFO_S);
+            if (!delegate) {
+                std::cerr << "Plugin '" << name << "' missing entrypoint '" << PLUGIN_INFO_S << "'" << std::endl;
+                return false;
+            }
 
-    // Get the name
-    const char *name = catChild->Attribute("name", nullptr);
-    if (!name) {
-        std::cerr << "Malformed command in line: " << catChild->GetLineNum() << ", name not found" << std::endl;
-        return false;
-    }
+            // Invoke info delegate
+            delegate(&state.info);
 
-    // Attempt to load
-    PluginState &state = GetPluginOrLoad(name);
-    if (!state.library.IsGood()) {
-        return false;
+            // Cache the info
+            manifestCache.SetInfo(name, stamp, state.info);
+        }
+
+        // Get the new state
+        it = plugins.find(name);
     }
 
-    // Get the info delegate
-    auto* delegate = state.library.GetProcAddr<PluginInfoDelegate>(PLUGIN_INFO_S);
-    if (!delegate) {
-        std::cerr << "Plugin '" << name << "' missing entrypoint '" << PLUGIN_INFO_S << "'" << std::endl;
+    // Failed to load previously?
+    if (it->second.mode == PluginMode::None) {
         return false;
     }
 
-    // Invoke info delegate
-    delegate(&state.info);
-
     // Add entry
     PluginEntry pluginEntry{};
-    pluginEntry.info = state.info;
+    pluginEntry.info = it->second.info;
     pluginEntry.plugin = name;
     list->plugins.push_back(pluginEntry);
 
@@ -207,10 +294,11 @@ bool PluginResolver::InstallPlugins(const PluginList &list, PluginResolveFlagSet
 
 PluginResolver::PluginState &PluginResolver::GetPluginOrLoad(const std::string &path) {
     auto it = plugins.find(path);
-    if (it != plugins.end()) {
+    if (it != plugins.end() && it->second.mode != PluginMode::Discovered) {
         return it->second;
     }
 
+    // Discovered plugins keep their cached info
     PluginState& state = plugins[path];
     if (!state.library.Load((pluginPath / path).string().c_str())) {
         std::cerr << "Failed to load plugin '" << path << "'" << std::endl;
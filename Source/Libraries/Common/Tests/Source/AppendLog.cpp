@@ -0,0 +1,126 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+// Catch2
+#include <catch2/catch.hpp>
+
+// Common
+#include <Common/Containers/AppendLog.h>
+
+// Std
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+/// Small log for exhaustion tests, 4 chunks of 4 entries
+using SmallAppendLog = AppendLog<uint32_t, 4, 4>;
+
+TEST_CASE("Common.AppendLog.Append") {
+    SmallAppendLog log;
+
+    // Fill the log
+    for (uint32_t i = 0; i < SmallAppendLog::kCapacity; i++) {
+        uint32_t index;
+        REQUIRE(log.TryAppend(i * 3u, index));
+        REQUIRE(index == i);
+    }
+
+    // All entries readable, in order
+    REQUIRE(log.GetReadableCount(0) == SmallAppendLog::kCapacity);
+    for (uint32_t i = 0; i < SmallAppendLog::kCapacity; i++) {
+        REQUIRE(log.Get(i) == i * 3u);
+    }
+
+    // Full, must fail without writing
+    uint32_t index;
+    REQUIRE(!log.TryAppend(0u, index));
+    REQUIRE(log.GetReadableCount(0) == SmallAppendLog::kCapacity);
+}
+
+TEST_CASE("Common.AppendLog.Truncate") {
+    SmallAppendLog log;
+
+    uint32_t index;
+    for (uint32_t i = 0; i < SmallAppendLog::kCapacity; i++) {
+        REQUIRE(log.TryAppend(i, index));
+    }
+
+    // Partial chunks are kept
+    log.Truncate(3);
+    REQUIRE(log.GetBase() == 0);
+    REQUIRE(!log.TryAppend(0u, index));
+
+    // Release the first two chunks
+    log.Truncate(9);
+    REQUIRE(log.GetBase() == 8);
+
+    // Released slots are reused, indices keep increasing
+    for (uint32_t i = 0; i < 8; i++) {
+        REQUIRE(log.TryAppend(100u + i, index));
+        REQUIRE(index == SmallAppendLog::kCapacity + i);
+    }
+    REQUIRE(!log.TryAppend(0u, index));
+
+    // Live window is intact
+    REQUIRE(log.GetReadableCount(8) == SmallAppendLog::kCapacity + 8);
+    for (uint32_t i = 8; i < SmallAppendLog::kCapacity; i++) {
+        REQUIRE(log.Get(i) == i);
+    }
+    for (uint32_t i = 0; i < 8; i++) {
+        REQUIRE(log.Get(SmallAppendLog::kCapacity + i) == 100u + i);
+    }
+}
+
+TEST_CASE("Common.AppendLog.Concurrent") {
+    AppendLog<uint32_t, 64, 64> log;
+
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kAppendCount = 512;
+
+    // Append from all threads
+    std::vector<std::thread> threads;
+    for (uint32_t thread = 0; thread < kThreadCount; thread++) {
+        threads.emplace_back([&log, thread] {
+            for (uint32_t i = 0; i < kAppendCount; i++) {
+                uint32_t index;
+                REQUIRE(log.TryAppend(thread * kAppendCount + i, index));
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Every value must be present exactly once
+    REQUIRE(log.GetReadableCount(0) == kThreadCount * kAppendCount);
+
+    std::vector<uint32_t> counts(kThreadCount * kAppendCount, 0);
+    for (uint32_t i = 0; i < kThreadCount * kAppendCount; i++) {
+        counts[log.Get(i)]++;
+    }
+    REQUIRE(std::all_of(counts.begin(), counts.end(), [](uint32_t count) { return count == 1; }));
+}
@@ -0,0 +1,119 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+// Catch2
+#include <catch2/catch.hpp>
+
+// Common
+#include <Common/Containers/LockFreeQueue.h>
+
+// Std
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Common.LockFreeQueue.PushPop") {
+    LockFreeQueue<uint32_t> queue(4);
+    REQUIRE(queue.IsEmpty());
+
+    // Fill the queue
+    for (uint32_t i = 0; i < 4; i++) {
+        REQUIRE(queue.TryPush(i));
+    }
+
+    // Full, must fail
+    REQUIRE(!queue.TryPush(4u));
+
+    // Pop in order
+    for (uint32_t i = 0; i < 4; i++) {
+        uint32_t value;
+        REQUIRE(queue.TryPop(value));
+        REQUIRE(value == i);
+    }
+
+    // Empty, must fail
+    uint32_t value;
+    REQUIRE(!queue.TryPop(value));
+    REQUIRE(queue.IsEmpty());
+
+    // Wrapped slots are reusable
+    for (uint32_t i = 0; i < 6; i++) {
+        REQUIRE(queue.TryPush(10u + i));
+        REQUIRE(queue.TryPop(value));
+        REQUIRE(value == 10u + i);
+    }
+}
+
+TEST_CASE("Common.LockFreeQueue.Concurrent") {
+    LockFreeQueue<uint32_t> queue(64);
+
+    constexpr uint32_t kProducerCount = 4;
+    constexpr uint32_t kConsumerCount = 4;
+    constexpr uint32_t kPushCount = 4096;
+    constexpr uint32_t kTotalCount = kProducerCount * kPushCount;
+
+    // Consumer destination, written once per value
+    std::vector<std::atomic<uint32_t>> counts(kTotalCount);
+    std::atomic<uint32_t> poppedCount{0};
+
+    // Push from all producers, spin on a full queue
+    std::vector<std::thread> threads;
+    for (uint32_t producer = 0; producer < kProducerCount; producer++) {
+        threads.emplace_back([&queue, producer] {
+            for (uint32_t i = 0; i < kPushCount; i++) {
+                while (!queue.TryPush(producer * kPushCount + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Pop from all consumers until every value is accounted for
+    for (uint32_t consumer = 0; consumer < kConsumerCount; consumer++) {
+        threads.emplace_back([&queue, &counts, &poppedCount] {
+            while (poppedCount.load() < kTotalCount) {
+                uint32_t value;
+                if (!queue.TryPop(value)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                counts[value]++;
+                poppedCount++;
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Every value must be popped exactly once
+    REQUIRE(queue.IsEmpty());
+    REQUIRE(std::all_of(counts.begin(), counts.end(), [](const std::atomic<uint32_t>& count) { return count.load() == 1; }));
+}
@@ -0,0 +1,143 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+// Catch2
+#include <catch2/catch.hpp>
+
+// Common
+#include <Common/Plugin/PluginManifestCache.h>
+#include <Common/GlobalUID.h>
+
+// Std
+#include <filesystem>
+#include <fstream>
+
+/// Get a unique cache path
+static std::filesystem::path GetTemporaryCachePath() {
+    return std::filesystem::temp_directory_path() / ("PluginManifest." + GlobalUID::New().ToString() + ".bin");
+}
+
+/// Populate a cache with a single spec and info
+static void Populate(PluginManifestCache& cache) {
+    cache.SetSpec("Features.xml", PluginManifestStamp { .writeTime = 1, .size = 2 }, {
+        PluginManifestCategory { .name = "features", .plugins = { "GRS.Features.A", "GRS.Features.B" } }
+    });
+
+    cache.SetInfo("GRS.Features.A", PluginManifestStamp { .writeTime = 3, .size = 4 }, PluginInfo {
+        .name = "A",
+        .description = "Feature A",
+        .dependencies = { "B" }
+    });
+}
+
+TEST_CASE("Common.PluginManifestCache.RoundTrip") {
+    std::filesystem::path path = GetTemporaryCachePath();
+
+    PluginManifestCache cache;
+    Populate(cache);
+    REQUIRE(cache.Store(path));
+
+    // Reload into a fresh cache
+    PluginManifestCache loaded;
+    REQUIRE(loaded.Load(path));
+
+    // Validate spec
+    const std::vector<PluginManifestCategory>* categories = loaded.FindSpec("Features.xml", PluginManifestStamp { .writeTime = 1, .size = 2 });
+    REQUIRE(categories);
+    REQUIRE(categories->size() == 1);
+    REQUIRE(categories->at(0).name == "features");
+    REQUIRE((categories->at(0).plugins == std::vector<std::string> { "GRS.Features.A", "GRS.Features.B" }));
+
+    // Validate info
+    const PluginInfo* info = loaded.FindInfo("GRS.Features.A", PluginManifestStamp { .writeTime = 3, .size = 4 });
+    REQUIRE(info);
+    REQUIRE(info->name == "A");
+    REQUIRE(info->description == "Feature A");
+    REQUIRE((info->dependencies == std::vector<std::string> { "B" }));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Common.PluginManifestCache.Invalidation") {
+    PluginManifestCache cache;
+    Populate(cache);
+
+    // Any stamp change is a miss
+    REQUIRE(!cache.FindSpec("Features.xml", PluginManifestStamp { .writeTime = 5, .size = 2 }));
+    REQUIRE(!cache.FindSpec("Features.xml", PluginManifestStamp { .writeTime = 1, .size = 6 }));
+    REQUIRE(!cache.FindInfo("GRS.Features.A", PluginManifestStamp { .writeTime = 3, .size = 7 }));
+
+    // Unknown entries are a miss
+    REQUIRE(!cache.FindSpec("Other.xml", PluginManifestStamp { .writeTime = 1, .size = 2 }));
+    REQUIRE(!cache.FindInfo("GRS.Features.B", PluginManifestStamp { .writeTime = 3, .size = 4 }));
+
+    // Updated entries hit on the new stamp only
+    cache.SetInfo("GRS.Features.A", PluginManifestStamp { .writeTime = 8, .size = 4 }, PluginInfo { .name = "A2" });
+    REQUIRE(!cache.FindInfo("GRS.Features.A", PluginManifestStamp { .writeTime = 3, .size = 4 }));
+    REQUIRE(cache.FindInfo("GRS.Features.A", PluginManifestStamp { .writeTime = 8, .size = 4 })->name == "A2");
+}
+
+TEST_CASE("Common.PluginManifestCache.Corrupt") {
+    std::filesystem::path path = GetTemporaryCachePath();
+
+    PluginManifestCache cache;
+    Populate(cache);
+    REQUIRE(cache.Store(path));
+
+    // Every truncation must be a miss
+    uintmax_t size = std::filesystem::file_size(path);
+    for (uintmax_t length = 0; length < size; length++) {
+        std::filesystem::resize_file(path, length);
+
+        PluginManifestCache truncated;
+        REQUIRE(!truncated.Load(path));
+    }
+
+    // Valid header followed by a spec with an oversized name length
+    {
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+
+        const uint32_t words[] = { 0x4D505247, 1, 1, 0xFFFFFFFF };
+        stream.write(reinterpret_cast<const char*>(words), sizeof(words));
+    }
+
+    PluginManifestCache oversized;
+    REQUIRE(!oversized.Load(path));
+
+    // Oversized counts must be rejected before allocation
+    {
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+
+        const uint32_t words[] = { 0x4D505247, 1, 0xFFFFFFFF };
+        stream.write(reinterpret_cast<const char*>(words), sizeof(words));
+    }
+
+    PluginManifestCache overcounted;
+    REQUIRE(!overcounted.Load(path));
+
+    std::filesystem::remove(path);
+}
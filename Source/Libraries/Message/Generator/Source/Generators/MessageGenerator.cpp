@@ -54,6 +54,10 @@ bool MessageGenerator::GenerateCPP(const Message &message, MessageStream &out) {
     std::stringstream byteSize;
     std::stringstream allocationParameters;
 
+    // Batch decoding columns
+    std::stringstream batchColumns;
+    std::stringstream batchDecode;
+
     // Any dynamic parameters?
     bool anyDynamic = false;
 
@@ -111,6 +115,13 @@ bool MessageGenerator::GenerateCPP(const Message &message, MessageStream &out) {
 
         // Primitive?
         if (auto it = primitiveTypeMap.types.find(field.type); it != primitiveTypeMap.types.end()) {
+            // Column for batch decoding
+            batchColumns << "\t\t" << it->second.cxxType << "* " << field.name << "{nullptr};\n";
+
+            // Each column is decoded in its own loop, from unaligned loads of the packed storage
+            batchDecode << "\t\tif (batch." << field.name << ") {\n";
+            batchDecode << "\t\t\tfor (uint32_t i = 0; i < count; i++) {\n";
+
             if (bits) {
                 int32_t bitCount = std::atoi(bits->value.c_str());
 
@@ -123,6 +134,11 @@ bool MessageGenerator::GenerateCPP(const Message &message, MessageStream &out) {
 
                 out.members << "\t" << bitFieldType.cxxType << " " << field.name << " : " << bitCount << ";\n";
 
+                // Extract from the storage unit
+                batchDecode << "\t\t\t\t" << bitFieldType.cxxType << " unit;\n";
+                batchDecode << "\t\t\t\tstd::memcpy(&unit, base + i * sizeof(" << message.name << "Message) + " << (cxxSizeType - bitFieldType.size) << ", sizeof(unit));\n";
+                batchDecode << "\t\t\t\tbatch." << field.name << "[i] = static_cast<" << it->second.cxxType << ">((unit >> " << (bitFieldOffset % bitSize) << ") & " << (~0ull >> (64u - bitCount)) << "ull);\n";
+
                 const uint32_t bitElementBefore = static_cast<uint32_t>(bitFieldOffset / bitFieldType.size);
                 const uint32_t bitElementAfter = static_cast<uint32_t>(bitFieldOffset / bitFieldType.size);
 
@@ -133,6 +149,9 @@ bool MessageGenerator::GenerateCPP(const Message &message, MessageStream &out) {
 
                 bitFieldOffset += bitCount;
             } else {
+                // Direct copy
+                batchDecode << "\t\t\t\tstd::memcpy(&batch." << field.name << "[i], base + i * sizeof(" << message.name << "Message) + " << cxxSizeType << ", " << it->second.size << ");\n";
+
                 cxxSizeType += it->second.size;
 
                 byteSize << "\t\t\tsize += " << it->second.size << ";\n";
@@ -145,6 +164,10 @@ bool MessageGenerator::GenerateCPP(const Message &message, MessageStream &out) {
 
                 out.members << ";\n";
             }
+
+            // End column
+            batchDecode << "\t\t\t}\n";
+            batchDecode << "\t\t}\n";
         } else if (field.type ==  "array") {
             // Get the type
             const Attribute* elementTypeName = field.attributes.Get("element");
@@ -422,6 +445,27 @@ bool MessageGenerator::GenerateCPP(const Message &message, MessageStream &out) {
     // End allocation info
     out.types << "\t};\n";
 
+    // Structure of arrays batch decoding
+    if (message.attributes.GetBool("batch")) {
+        if (anyDynamic) {
+            std::cerr << "Malformed message in line: " << message.line << ", batch decoding requires a static or chunked message" << std::endl;
+            return false;
+        }
+
+        // Destination columns, null columns are skipped
+        out.types << "\n";
+        out.types << "\tstruct Batch {\n";
+        out.types << batchColumns.str();
+        out.types << "\t};\n";
+
+        // Decoder, reads the primary values only
+        out.types << "\n";
+        out.types << "\tstatic void DecodeBatch(const " << message.name << "Message* messages, uint32_t count, const Batch& batch) {\n";
+        out.types << "\t\tconst auto* base = reinterpret_cast<const uint8_t*>(messages);\n";
+        out.types << batchDecode.str();
+        out.types << "\t}\n";
+    }
+
     // Size check
     out.schema.footer << "static_assert(sizeof(" << message.name << "Message) == " << cxxSizeType << ", \"Unexpected compiler packing\");\n";
 
@@ -31,6 +31,9 @@
 
 // Std
 #include <vector>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
 
 // Message
 #include "Message.h"
@@ -76,6 +79,12 @@ struct MessageStream {
         versionID = value;
     }
 
+    /// Mark this stream as lossy, transports may drop lossy streams under overload
+    /// \param value
+    void SetLossy(bool value) {
+        lossy = value;
+    }
+
     /// Validate against a schema or set a new one
     /// \param value
     void ValidateOrSetSchema(const MessageSchema& value) {
@@ -170,6 +179,7 @@ struct MessageStream {
         count = 0;
         schema = {};
         versionID = 0;
+        lossy = false;
         buffer.clear();
     }
 
@@ -180,6 +190,7 @@ struct MessageStream {
 
         std::swap(count, other.count);
         std::swap(versionID, other.versionID);
+        std::swap(lossy, other.lossy);
         buffer.swap(other.buffer);
     }
 
@@ -197,6 +208,13 @@ struct MessageStream {
         // Destination offset
         const size_t offset = buffer.size();
 
+        // Mixed contents are only lossy if all contents are
+        bool otherLossy = false;
+        if constexpr (std::is_same_v<T, MessageStream>) {
+            otherLossy = other.IsLossy();
+        }
+        lossy = offset ? (lossy && otherLossy) : otherLossy;
+
         // Copy all data
         buffer.resize(offset + other.GetByteSize());
         std::memcpy(buffer.data() + offset, other.GetDataBegin(), other.GetByteSize());
@@ -236,6 +254,12 @@ struct MessageStream {
         return versionID;
     }
 
+    /// Check if this stream may be dropped under overload
+    [[nodiscard]]
+    bool IsLossy() const {
+        return lossy;
+    }
+
     /// Get the number of messages within this stream
     [[nodiscard]]
     uint64_t GetCount() const {
@@ -258,6 +282,9 @@ private:
     /// Version of this stream
     uint32_t versionID{0};
 
+    /// May this stream be dropped under overload
+    bool lossy{false};
+
     /// The underlying memory
     std::vector<uint8_t> buffer;
 };
@@ -324,6 +351,20 @@ struct MessageStreamSchema<StaticMessageSchema, STREAM> {
         return iterator;
     }
 
+    /// Read a batch of messages, messages are contiguous and read in place
+    /// \param iterator iterator to advance
+    /// \param scratch unused
+    /// \param limit maximum number of messages to read
+    /// \param messages destination batch
+    /// \return number of messages read
+    template<typename T>
+    uint32_t ReadBatch(ConstIterator<T>& iterator, T* scratch, uint32_t limit, const T** messages) const {
+        auto count = static_cast<uint32_t>(std::min<uint64_t>(limit, (iterator.end - iterator.ptr) / sizeof(T)));
+        *messages = iterator.Get();
+        iterator.ptr += sizeof(T) * count;
+        return count;
+    }
+
     /// Get the message stream
     [[nodiscard]]
     STREAM& GetStream() const {
@@ -392,6 +433,22 @@ struct MessageStreamSchema<ChunkedMessageSchema, STREAM> {
         return iterator;
     }
 
+    /// Read a batch of messages, the primary values are gathered into the scratch
+    /// \param iterator iterator to advance
+    /// \param scratch gathered messages, must hold the limit
+    /// \param limit maximum number of messages to read
+    /// \param messages destination batch
+    /// \return number of messages read
+    template<typename T>
+    uint32_t ReadBatch(ConstIterator<T>& iterator, T* scratch, uint32_t limit, const T** messages) const {
+        uint32_t count = 0;
+        for (; count < limit && iterator; ++iterator) {
+            std::memcpy(scratch + count++, iterator.ptr, sizeof(T));
+        }
+        *messages = scratch;
+        return count;
+    }
+
     /// Get the message stream
     [[nodiscard]]
     STREAM& GetStream() const {
@@ -602,6 +659,16 @@ struct MessageStreamView {
         return schema.template GetIterator<T>();
     }
 
+    /// Read a batch of messages, only valid for static and chunked schemas
+    /// \param iterator iterator to advance
+    /// \param scratch scratch messages, may be used for non-contiguous schemas, must hold the limit
+    /// \param limit maximum number of messages to read
+    /// \param messages destination batch, valid until the stream or scratch changes
+    /// \return number of messages read
+    uint32_t ReadBatch(ConstIterator& iterator, T* scratch, uint32_t limit, const T** messages) const {
+        return schema.template ReadBatch<T>(iterator, scratch, limit, messages);
+    }
+
     /// Get the message stream
     [[nodiscard]]
     MessageStream& GetStream() const {
@@ -665,6 +732,16 @@ struct ConstMessageStreamView {
         return schema.template GetIterator<T>();
     }
 
+    /// Read a batch of messages, only valid for static and chunked schemas
+    /// \param iterator iterator to advance
+    /// \param scratch scratch messages, may be used for non-contiguous schemas, must hold the limit
+    /// \param limit maximum number of messages to read
+    /// \param messages destination batch, valid until the stream or scratch changes
+    /// \return number of messages read
+    uint32_t ReadBatch(ConstIterator& iterator, T* scratch, uint32_t limit, const T** messages) const {
+        return schema.template ReadBatch<T>(iterator, scratch, limit, messages);
+    }
+
     /// Get the message stream
     [[nodiscard]]
     MessageStream& GetStream() const {
@@ -104,15 +104,20 @@ void OrderedMessageStorage::Free(const MessageStream &stream) {
 
     MutexGuard guard(mutex);
 
+    // Recycled streams are swapped back into producers, never carry over the lossy state
+    MessageStream* recycled;
+
     // Ordered?
     if (schema == OrderedMessageSchema::GetSchema()) {
-        freeOrderedStreams.push_back(stream);
-        return;
+        recycled = &freeOrderedStreams.emplace_back(stream);
+    } else {
+        // Let the bucket acquire it
+        MessageBucket& bucket = messageBuckets[schema.id];
+        recycled = &bucket.freeStreams.emplace_back(stream);
     }
 
-    // Let the bucket acquire it
-    MessageBucket& bucket = messageBuckets[schema.id];
-    bucket.freeStreams.push_back(stream);
+    // Reset
+    recycled->SetLossy(false);
 }
 
 uint32_t OrderedMessageStorage::StreamCount() {
@@ -0,0 +1,131 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <catch2/catch.hpp>
+
+#include <Message/MessageStream.h>
+
+// Schema
+#include <Schemas/Schema.h>
+
+// Std
+#include <vector>
+
+/// Number of messages per batch
+static constexpr uint32_t kBatchSize = 256;
+
+/// Fill a stream with synthetic messages
+static void FillStream(MessageStream& stream, uint32_t count) {
+    MessageStreamView<PackedExportMessage> view(stream);
+
+    for (uint32_t i = 0; i < count; i++) {
+        auto&& message = view.Add();
+        message->sguid = i & 0xFFFF;
+        message->isWrite = i & 0x1;
+        message->token = (i * 7) & 0x7FFF;
+    }
+}
+
+TEST_CASE("Message.Batch.Decode") {
+    MessageStream stream;
+    FillStream(stream, 1000);
+
+    // Decoded columns
+    std::vector<uint32_t> sguids(kBatchSize);
+    std::vector<uint32_t> tokens(kBatchSize);
+
+    // Columns of interest, isWrite is skipped
+    PackedExportMessage::Batch batch;
+    batch.sguid = sguids.data();
+    batch.token = tokens.data();
+
+    // Decode all messages in batches
+    MessageStreamView<PackedExportMessage> view(stream);
+    PackedExportMessage scratch[kBatchSize];
+
+    // Reference iterator
+    auto reference = view.GetIterator();
+
+    uint32_t total = 0;
+    for (auto it = view.GetIterator(); it;) {
+        const PackedExportMessage* messages;
+        uint32_t count = view.ReadBatch(it, scratch, kBatchSize, &messages);
+        PackedExportMessage::DecodeBatch(messages, count, batch);
+
+        // Validate against the per message path
+        for (uint32_t i = 0; i < count; i++, ++reference) {
+            REQUIRE(sguids[i] == reference->sguid);
+            REQUIRE(tokens[i] == reference->token);
+        }
+
+        total += count;
+    }
+
+    REQUIRE(total == 1000);
+    REQUIRE(!reference);
+}
+
+TEST_CASE("Message.Batch.Benchmark", "[!benchmark]") {
+    MessageStream stream;
+    FillStream(stream, 1u << 20);
+
+    // Decoded columns
+    std::vector<uint32_t> sguids(kBatchSize);
+    std::vector<uint32_t> isWrites(kBatchSize);
+    std::vector<uint32_t> tokens(kBatchSize);
+
+    MessageStreamView<PackedExportMessage> view(stream);
+
+    BENCHMARK("PerMessage") {
+        uint64_t accum = 0;
+        for (auto it = view.GetIterator(); it; ++it) {
+            accum += it->sguid + it->isWrite + it->token;
+        }
+        return accum;
+    };
+
+    BENCHMARK("Batched") {
+        PackedExportMessage::Batch batch;
+        batch.sguid = sguids.data();
+        batch.isWrite = isWrites.data();
+        batch.token = tokens.data();
+
+        PackedExportMessage scratch[kBatchSize];
+
+        uint64_t accum = 0;
+        for (auto it = view.GetIterator(); it;) {
+            const PackedExportMessage* messages;
+            uint32_t count = view.ReadBatch(it, scratch, kBatchSize, &messages);
+            PackedExportMessage::DecodeBatch(messages, count, batch);
+
+            for (uint32_t i = 0; i < count; i++) {
+                accum += sguids[i] + isWrites[i] + tokens[i];
+            }
+        }
+        return accum;
+    };
+}